@@ -0,0 +1,152 @@
+/**
+ * @file arena.c
+ * @brief Implementation file of the arena header
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#include "arena.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+// header of a block, padded to a multiple of the alignment
+#define BLOCK_HEADER_SIZE ((sizeof(ArenaBlock) + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT)
+
+static _Thread_local Arena thread_arena;
+static _Thread_local bool thread_arena_ready = false;
+
+//////////////////////////////////////////
+
+void arena_init(Arena *arena, size_t block_size)
+{
+    if (!arena) return;
+
+    arena->blocks = NULL;
+    arena->block_size = block_size > 0 ? block_size : ARENA_DEFAULT_BLOCK_SIZE;
+    arena->allocated = 0;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, first aligned byte at or after the used bytes of the block
+ */
+static uintptr_t block_next(const ArenaBlock *block)
+{
+    uintptr_t next = (uintptr_t)block + BLOCK_HEADER_SIZE + block->used;
+    return (next + ARENA_ALIGNMENT - 1) & ~(uintptr_t)(ARENA_ALIGNMENT - 1);
+}
+
+//////////////////////////////////////////
+
+void* arena_alloc(Arena *arena, size_t size)
+{
+    if (!arena) return NULL;
+    if (size == 0) size = 1;
+
+    ArenaBlock *block = arena->blocks;
+    if (block)
+    {
+        uintptr_t next = block_next(block);
+        uintptr_t end = (uintptr_t)block + BLOCK_HEADER_SIZE + block->size;
+
+        if (next <= end && size <= end - next)
+        {
+            block->used = next + size - ((uintptr_t)block + BLOCK_HEADER_SIZE);
+            arena->allocated += size;
+            return (void*)next;
+        }
+    }
+
+    // a new block, with room for the alignment padding of a malloc'ed address
+    size_t block_size = size + ARENA_ALIGNMENT > arena->block_size ? size + ARENA_ALIGNMENT : arena->block_size;
+    if (block_size > SIZE_MAX - BLOCK_HEADER_SIZE) return NULL;
+
+    block = (ArenaBlock*)malloc(BLOCK_HEADER_SIZE + block_size);
+    if (!block) return NULL;
+
+    block->next = arena->blocks;
+    block->size = block_size;
+    block->used = 0;
+    arena->blocks = block;
+
+    uintptr_t next = block_next(block);
+    block->used = next + size - ((uintptr_t)block + BLOCK_HEADER_SIZE);
+    arena->allocated += size;
+    return (void*)next;
+}
+
+//////////////////////////////////////////
+
+void arena_reset(Arena *arena)
+{
+    if (!arena) return;
+
+    ArenaBlock *kept = NULL;
+    ArenaBlock *block = arena->blocks;
+
+    while (block)
+    {
+        ArenaBlock *next = block->next;
+        if (!kept || block->size > kept->size)
+        {
+            free(kept);
+            kept = block;
+        }
+        else
+        {
+            free(block);
+        }
+        block = next;
+    }
+
+    if (kept)
+    {
+        kept->next = NULL;
+        kept->used = 0;
+    }
+    arena->blocks = kept;
+    arena->allocated = 0;
+}
+
+//////////////////////////////////////////
+
+void arena_free(Arena *arena)
+{
+    if (!arena) return;
+
+    ArenaBlock *block = arena->blocks;
+    while (block)
+    {
+        ArenaBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+    arena->blocks = NULL;
+    arena->allocated = 0;
+}
+
+//////////////////////////////////////////
+
+Arena* arena_thread_local(void)
+{
+    if (!thread_arena_ready)
+    {
+        arena_init(&thread_arena, ARENA_DEFAULT_BLOCK_SIZE);
+        thread_arena_ready = true;
+    }
+    return &thread_arena;
+}
+
+//////////////////////////////////////////
+
+void arena_thread_local_free(void)
+{
+    if (!thread_arena_ready) return;
+
+    arena_free(&thread_arena);
+    thread_arena_ready = false;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file arena.h
+ * @brief Header of a bump allocator for the memory of one file or chunk
+ *
+ *  Allocations are taken in order from blocks of block_size bytes, and never released one by one:
+ *  arena_reset makes the whole arena available again (keeping one block to reuse), arena_free
+ *  returns it to the system. The error paths only need one call, whatever was allocated before.
+ *
+ *  An arena is not thread safe. Every worker thread gets its own with arena_thread_local,
+ *  so the threads don't contend on the system allocator for their temporary buffers.
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#ifndef ARENA_H_INCLUDED
+#define ARENA_H_INCLUDED
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define ARENA_DEFAULT_BLOCK_SIZE (1u << 20)
+#define ARENA_ALIGNMENT 64                      // a cache line, for the columns given to the batch kernels
+
+/**
+ * @struct ArenaBlock
+ * @brief  Header of a block, the bytes follow it
+ */
+typedef struct ARENA_BLOCK
+{
+    struct ARENA_BLOCK *next;                   // block allocated before this one
+    size_t              size;                   // bytes after the header
+    size_t              used;
+} ArenaBlock;
+
+/**
+ * @struct Arena
+ * @brief  Chain of blocks, the newest first
+ */
+typedef struct ARENA
+{
+    ArenaBlock *blocks;
+    size_t      block_size;
+    size_t      allocated;                      // bytes given by arena_alloc since the last reset
+} Arena;
+
+/**
+ * @brief Initializes an empty arena, the first block is allocated on the first use
+ *
+ * @param[out] arena        Pointer to the arena to initialize
+ * @param[in]  block_size   Bytes of every block, 0 for ARENA_DEFAULT_BLOCK_SIZE. Bigger requests get a block of their own
+ */
+void arena_init(Arena *arena, size_t block_size);
+
+/**
+ * @brief Allocates size bytes, aligned to ARENA_ALIGNMENT
+ *
+ * @return pointer to the memory, valid until the next arena_reset or arena_free, NULL if the memory ran out
+ */
+void* arena_alloc(Arena *arena, size_t size);
+
+/**
+ * @brief Releases every allocation at once. The biggest block is kept for the next ones
+ */
+void arena_reset(Arena *arena);
+
+/**
+ * @brief Returns all the blocks to the system. Safe to call twice
+ */
+void arena_free(Arena *arena);
+
+/**
+ * @brief Arena of the calling thread, initialized on the first call of each thread
+ *
+ * @return the arena, only to be used by this thread
+ */
+Arena* arena_thread_local(void);
+
+/**
+ * @brief Frees the arena of the calling thread, before the thread exits
+ */
+void arena_thread_local_free(void);
+
+#endif // ARENA_H
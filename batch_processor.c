@@ -0,0 +1,496 @@
+/**
+ * @file batch_processor.c
+ * @brief Implementation file of the batch_processor header
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#include "batch_processor.h"
+#include "arena.h"
+#include "frame_index.h"
+#include "mapped_frame_reader.h"
+#include "parallel_decode.h"
+#include "run_merge.h"
+#include "telemetry_store.h"
+#include "work_pool.h"
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#endif
+
+struct BATCH_FILE_JOB;
+
+/**
+ * @struct BatchChunkTask
+ * @brief  Argument of the decode task of one chunk of a file
+ */
+typedef struct BATCH_CHUNK_TASK
+{
+    struct BATCH_FILE_JOB  *job;
+    size_t                  chunk;
+} BatchChunkTask;
+
+/**
+ * @struct BatchFileJob
+ * @brief  State and telemetry of one file of the batch
+ */
+typedef struct BATCH_FILE_JOB
+{
+    WorkPool                       *pool;
+    BeaconHeader                    header;
+    const char                     *filename;
+    MappedFrameFile                 file;
+    FrameChunkSet                   chunks;
+    BatchChunkTask                 *chunk_tasks;
+    atomic_size_t                   chunks_left;        // the last chunk to finish builds the telemetry
+    Arena                           arena;              // owns thermal and sun_sensors, until the merge
+    ThermalTelemetryCalibrated     *thermal;
+    SunSensorsTelemetryCalibrated  *sun_sensors;
+    size_t                          length;             // rows of both arrays
+    size_t                          duplicates_dropped;
+    bool                            skip_wrong_frames;
+    FrameIntegrityStats             integrity;          // of the file, kept when it is closed
+    size_t                          file_size;          // kept when it is closed
+    bool                            ok;
+    ReadFailureCause                failure;            // why the file was skipped, when not ok
+} BatchFileJob;
+
+//////////////////////////////////////////
+
+static int filename_comparator(const void *a, const void *b)
+{
+    return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, true if the name ends with BATCH_INPUT_EXTENSION
+ */
+static bool has_input_extension(const char *name)
+{
+    size_t length = strlen(name);
+    size_t extension_length = strlen(BATCH_INPUT_EXTENSION);
+    return length > extension_length && strcmp(name + length - extension_length, BATCH_INPUT_EXTENSION) == 0;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, appends a copy of directory/name to the names
+ */
+static bool push_filename(DynamicArray *filenames, const char *directory, const char *name)
+{
+    size_t directory_length = directory ? strlen(directory) : 0;
+    char *filename = (char*)malloc(directory_length + 1 + strlen(name) + 1);
+    if (!filename) return false;
+
+    if (directory) sprintf(filename, "%s/%s", directory, name);
+    else strcpy(filename, name);
+
+    if (!dynamic_array_push(filenames, &filename))
+    {
+        free(filename);
+        return false;
+    }
+    return true;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, appends the input files of the directory, in name order
+ */
+static bool push_directory(DynamicArray *filenames, const char *directory)
+{
+    size_t first = filenames->length;
+
+#ifdef _WIN32
+    char pattern[MAX_PATH];
+    snprintf(pattern, sizeof pattern, "%s\\*%s", directory, BATCH_INPUT_EXTENSION);
+
+    WIN32_FIND_DATAA entry;
+    HANDLE search = FindFirstFileA(pattern, &entry);
+    if (search == INVALID_HANDLE_VALUE) return GetLastError() == ERROR_FILE_NOT_FOUND;
+
+    bool ok = true;
+    do
+    {
+        if (!(entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) && has_input_extension(entry.cFileName))
+        {
+            ok = push_filename(filenames, directory, entry.cFileName);
+        }
+    } while (ok && FindNextFileA(search, &entry));
+    FindClose(search);
+#else
+    DIR *stream = opendir(directory);
+    if (!stream)
+    {
+        perror(directory);
+        return false;
+    }
+
+    bool ok = true;
+    struct dirent *entry;
+    while (ok && (entry = readdir(stream)) != NULL)
+    {
+        if (entry->d_name[0] != '.' && has_input_extension(entry->d_name))
+        {
+            ok = push_filename(filenames, directory, entry->d_name);
+        }
+    }
+    closedir(stream);
+#endif
+
+    // the directory order depends on the file system, the name order doesn't
+    char **names = (char**)filenames->data;
+    qsort(names + first, filenames->length - first, sizeof *names, filename_comparator);
+    return ok;
+}
+
+//////////////////////////////////////////
+
+bool batch_collect_inputs(char *const paths[], size_t path_count, DynamicArray *filenames)
+{
+    if (!paths || !filenames || filenames->element_size != sizeof(char*)) return false;
+
+    for (size_t i = 0; i < path_count; ++i)
+    {
+        struct stat info;
+        if (stat(paths[i], &info) != 0)
+        {
+            perror(paths[i]);
+            return false;
+        }
+
+        bool ok = S_ISDIR(info.st_mode) ? push_directory(filenames, paths[i]) : push_filename(filenames, NULL, paths[i]);
+        if (!ok) return false;
+    }
+    return true;
+}
+
+//////////////////////////////////////////
+
+void batch_free_filenames(DynamicArray *filenames)
+{
+    if (!filenames) return;
+
+    char **names = (char**)filenames->data;
+    for (size_t i = 0; i < filenames->length; ++i) free(names[i]);
+    dynamic_array_free(filenames);
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, sorted index, calibration and array-of-structs telemetry of the file, once decoded.
+ *        The index and the columns are only needed here: they go to the arena of the worker, reset at the end
+ */
+static bool finish_file(BatchFileJob *job, Arena *scratch)
+{
+    DynamicArray index;
+    TelemetryStore store;
+
+    job->failure = READ_FAILURE_OUT_OF_MEMORY;
+    if (frame_chunks_stitch(&job->chunks) == READ_FAIL)
+    {
+        job->failure = mapped_file_read_failure(&job->file, job->header);
+        return false;
+    }
+    if (!dynamic_array_init_arena(&index, sizeof(FrameIndexEntry), 0, scratch) ||
+        frame_chunks_merge_sorted(&job->chunks, &index, 1, &job->duplicates_dropped) == READ_FAIL ||
+        !telemetry_store_init_arena(&store, index.length, scratch))
+    {
+        return false;
+    }
+    frame_chunks_free(&job->chunks);
+
+    if (!telemetry_store_load(&store, &job->file, &index)) return false;
+
+    job->thermal = (ThermalTelemetryCalibrated*)arena_alloc(&job->arena, (store.thermal.length + 1) * sizeof *job->thermal);
+    job->sun_sensors =
+        (SunSensorsTelemetryCalibrated*)arena_alloc(&job->arena, (store.sun_sensors.length + 1) * sizeof *job->sun_sensors);
+    if (!job->thermal || !job->sun_sensors) return false;
+
+    job->length = thermal_columns_to_array(&store.thermal, 0, store.thermal.length, job->thermal);
+    sun_sensors_columns_to_array(&store.sun_sensors, 0, store.sun_sensors.length, job->sun_sensors);
+    return true;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, tells why a file is skipped (only the robust mode reads the frames around a bad one)
+ */
+static void report_skipped_file(const BatchFileJob *job)
+{
+    const size_t frame_header = job->file.position - BEACON_HEADER_SIZE;
+    BeaconFrame frame;
+    char description[96];
+
+    switch (job->failure)
+    {
+        case READ_FAILURE_TRUNCATED_FRAME:
+            fprintf(stderr, "Skipping %s: its last frame is truncated at byte %zu (--robust reads the frames before it)\n",
+                    job->filename, frame_header);
+            break;
+        case READ_FAILURE_WRONG_FRAME:
+            decode_beacon_frame_sections(job->file.data + job->file.position, job->file.byte_order, FRAME_SECTION_NONE, &frame);
+            describe_wrong_section_id(&frame, description, sizeof description);
+            fprintf(stderr, "Skipping %s: %s, in the frame at byte %zu (--robust skips the wrong frames)\n",
+                    job->filename, description, frame_header);
+            break;
+        case READ_FAILURE_OUT_OF_MEMORY:
+            fprintf(stderr, "Skipping %s: not enough memory\n", job->filename);
+            break;
+    }
+}
+
+//////////////////////////////////////////
+
+static void chunk_task(void *argument)
+{
+    BatchChunkTask *task = (BatchChunkTask*)argument;
+    BatchFileJob *job = task->job;
+
+    frame_chunks_decode(&job->chunks, task->chunk);
+    if (atomic_fetch_sub(&job->chunks_left, 1) != 1) return;
+
+    // every chunk of the file is decoded
+    Arena *scratch = arena_thread_local();
+    job->ok = finish_file(job, scratch);
+    arena_reset(scratch);
+    if (!job->ok) report_skipped_file(job);
+
+    frame_chunks_free(&job->chunks);
+    free(job->chunk_tasks);
+    job->chunk_tasks = NULL;
+    job->integrity = job->file.integrity;
+    job->file_size = job->file.size;
+    mapped_file_close(&job->file);
+}
+
+//////////////////////////////////////////
+
+static void file_task(void *argument)
+{
+    BatchFileJob *job = (BatchFileJob*)argument;
+
+    if (!mapped_file_open(job->filename, &job->file))
+    {
+        perror(job->filename);
+        return;
+    }
+    job->file.skip_wrong_frames = job->skip_wrong_frames;
+
+    size_t chunk_count = job->file.size / BATCH_CHUNK_SIZE + 1;
+    if (!frame_chunks_init(&job->chunks, &job->file, job->header, chunk_count, false) ||
+        !(job->chunk_tasks = (BatchChunkTask*)malloc(job->chunks.chunk_count * sizeof *job->chunk_tasks)))
+    {
+        fprintf(stderr, "Skipping %s: not enough memory\n", job->filename);
+        frame_chunks_free(&job->chunks);
+        mapped_file_close(&job->file);
+        return;
+    }
+
+    atomic_store(&job->chunks_left, job->chunks.chunk_count);
+    for (size_t k = 0; k < job->chunks.chunk_count; ++k)
+    {
+        job->chunk_tasks[k].job = job;
+        job->chunk_tasks[k].chunk = k;
+    }
+
+    // the other chunks go to this worker's deque, for the idle workers to steal. The first one is decoded here
+    for (size_t k = 1; k < job->chunks.chunk_count; ++k)
+    {
+        if (!work_pool_submit(job->pool, chunk_task, &job->chunk_tasks[k])) chunk_task(&job->chunk_tasks[k]);
+    }
+    chunk_task(&job->chunk_tasks[0]);
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, merges the runs into one allocated array, in rounds of RUN_MERGE_MAX_RUNS runs.
+ *        The runs of a round stay in order, so the first run keeps its priority for the duplicates
+ *
+ * @return the merged array (length in merged_length), NULL if the memory ran out
+ */
+static void* merge_all_runs(SortedRun *runs, size_t run_count, size_t element_size, size_t key_offset,
+                            size_t thread_count, size_t *merged_length)
+{
+    void **round_buffers = NULL;            // arrays allocated by the previous round
+    size_t round_buffer_count = 0;
+    void *merged = NULL;
+
+    for (;;)
+    {
+        size_t group_count = (run_count + RUN_MERGE_MAX_RUNS - 1) / RUN_MERGE_MAX_RUNS;
+        if (group_count == 0) group_count = 1;
+
+        void **buffers = (void**)calloc(group_count, sizeof *buffers);
+        if (!buffers) break;
+
+        bool ok = true;
+        for (size_t g = 0; ok && g < group_count; ++g)
+        {
+            size_t first = g * RUN_MERGE_MAX_RUNS;
+            size_t count = run_count - first < RUN_MERGE_MAX_RUNS ? run_count - first : RUN_MERGE_MAX_RUNS;
+            size_t total = 0;
+            for (size_t r = first; r < first + count; ++r) total += runs[r].length;
+
+            buffers[g] = malloc((total + 1) * element_size);
+            size_t length = buffers[g] ? run_merge_deduplicate_parallel(runs + first, count, element_size, key_offset,
+                                                                        buffers[g], thread_count) : (size_t)-1;
+            ok = length != (size_t)-1;
+
+            // the groups of the next round, in the same order
+            runs[g].data = buffers[g];
+            runs[g].length = ok ? length : 0;
+        }
+
+        for (size_t b = 0; b < round_buffer_count; ++b) free(round_buffers[b]);
+        free(round_buffers);
+        round_buffers = buffers;
+        round_buffer_count = group_count;
+
+        if (!ok) break;
+        if (group_count == 1)
+        {
+            merged = buffers[0];
+            *merged_length = runs[0].length;
+            round_buffer_count = 0;
+            break;
+        }
+        run_count = group_count;
+    }
+
+    for (size_t b = 0; b < round_buffer_count; ++b) free(round_buffers[b]);
+    free(round_buffers);
+    return merged;
+}
+
+//////////////////////////////////////////
+
+bool batch_process
+(
+    const DynamicArray *filenames,
+    const BeaconHeader header,
+    size_t thread_count,
+    bool skip_wrong_frames,
+    BatchResult *result
+)
+{
+    if (!filenames || !result || filenames->element_size != sizeof(char*)) return false;
+    memset(result, 0, sizeof *result);
+
+    const size_t file_count = filenames->length;
+    BatchFileJob *jobs = (BatchFileJob*)calloc(file_count + 1, sizeof *jobs);
+    SortedRun *runs = (SortedRun*)malloc((file_count + 1) * sizeof *runs);
+    WorkPool pool;
+
+    if (!jobs || !runs || !work_pool_init(&pool, parallel_decode_thread_count(thread_count)))
+    {
+        free(jobs);
+        free(runs);
+        return false;
+    }
+
+    // the biggest files could be submitted first, but the stealing already keeps the workers busy
+    char *const *names = (char* const*)filenames->data;
+    for (size_t i = 0; i < file_count; ++i)
+    {
+        jobs[i].pool = &pool;
+        jobs[i].header = header;
+        jobs[i].filename = names[i];
+        jobs[i].skip_wrong_frames = skip_wrong_frames;
+        arena_init(&jobs[i].arena, 0);
+        if (!work_pool_submit(&pool, file_task, &jobs[i])) file_task(&jobs[i]);
+    }
+    work_pool_wait(&pool);
+    result->tasks_stolen = pool.tasks_stolen;
+    work_pool_free(&pool);
+
+    // one run per file, in input order
+    size_t run_count = 0;
+    size_t total = 0;
+    for (size_t i = 0; i < file_count; ++i)
+    {
+        if (!jobs[i].ok)
+        {
+            result->files_failed++;
+            continue;
+        }
+        result->files_processed++;
+        result->frames_indexed += jobs[i].length;
+        result->bytes_read += jobs[i].file_size;
+        result->duplicates_in_files += jobs[i].duplicates_dropped;
+        result->integrity.frames_wrong += jobs[i].integrity.frames_wrong;
+        result->integrity.frames_truncated += jobs[i].integrity.frames_truncated;
+        result->integrity.bytes_skipped += jobs[i].integrity.bytes_skipped;
+        result->integrity.resyncs += jobs[i].integrity.resyncs;
+        total += jobs[i].length;
+    }
+
+    bool ok = true;
+    const size_t merge_threads = parallel_decode_thread_count(thread_count);
+
+    for (size_t i = 0; i < file_count; ++i)
+    {
+        if (!jobs[i].ok) continue;
+        runs[run_count].data = jobs[i].thermal;
+        runs[run_count++].length = jobs[i].length;
+    }
+    result->thermal = (ThermalTelemetryCalibrated*)merge_all_runs(runs, run_count, sizeof(ThermalTelemetryCalibrated),
+                                                 offsetof(ThermalTelemetryCalibrated, thermal_telemetry_timestamp),
+                                                 merge_threads, &result->thermal_length);
+    ok = ok && result->thermal;
+
+    run_count = 0;
+    for (size_t i = 0; i < file_count; ++i)
+    {
+        if (!jobs[i].ok) continue;
+        runs[run_count].data = jobs[i].sun_sensors;
+        runs[run_count++].length = jobs[i].length;
+    }
+    result->sun_sensors = (SunSensorsTelemetryCalibrated*)merge_all_runs(runs, run_count, sizeof(SunSensorsTelemetryCalibrated),
+                                                 offsetof(SunSensorsTelemetryCalibrated, sun_sensors_telemetry_timestamp),
+                                                 merge_threads, &result->sun_sensors_length);
+    ok = ok && result->sun_sensors;
+
+    if (ok) result->duplicates_between_files = total - result->thermal_length;
+
+    for (size_t i = 0; i < file_count; ++i) arena_free(&jobs[i].arena);
+    free(jobs);
+    free(runs);
+
+    // the tasks that could not be submitted ran on this thread
+    arena_thread_local_free();
+
+    if (!ok) batch_result_free(result);
+    return ok;
+}
+
+//////////////////////////////////////////
+
+void batch_result_free(BatchResult *result)
+{
+    if (!result) return;
+
+    free(result->thermal);
+    free(result->sun_sensors);
+    result->thermal = NULL;
+    result->sun_sensors = NULL;
+    result->thermal_length = 0;
+    result->sun_sensors_length = 0;
+}
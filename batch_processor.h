@@ -0,0 +1,97 @@
+/**
+ * @file batch_processor.h
+ * @brief Header of the batch processing of many telemetry files
+ *
+ *  Every file is a task of a work-stealing pool (see work_pool.h). A file bigger than BATCH_CHUNK_SIZE
+ *  submits one more task per chunk (see FrameChunkSet), and the last of its chunks to finish builds the
+ *  sorted index and the calibrated telemetry of the file. Small and big files share the same workers,
+ *  so a few huge passes are decoded by every core while the small ones are still queued.
+ *
+ *  The per-file telemetry is already sorted and without duplicates, so the files are merged (see
+ *  run_merge.h) into one time ordered output. The same rtc_s in two files (e.g. the same pass seen by
+ *  two ground stations) is kept from the first file of the input list.
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#ifndef BATCH_PROCESSOR_H_INCLUDED
+#define BATCH_PROCESSOR_H_INCLUDED
+
+#include "beacon_frame_schema.h"
+#include "dynamic_array.h"
+#include "thermal_calibrated.h"
+#include "sun_sensors_calibrated.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define BATCH_INPUT_EXTENSION ".bin"            // files taken from a directory
+#define BATCH_CHUNK_SIZE (8u << 20)             // bytes per decode task of a big file
+
+/**
+ * @struct BatchResult
+ * @brief  Merged telemetry of all the files, and the batch counters
+ */
+typedef struct BATCH_RESULT
+{
+    ThermalTelemetryCalibrated     *thermal;                // time ordered, one per rtc_s
+    size_t                          thermal_length;
+    SunSensorsTelemetryCalibrated  *sun_sensors;            // time ordered, one per rtc_s
+    size_t                          sun_sensors_length;
+    size_t                          files_processed;
+    size_t                          files_failed;           // could not be opened, or with a wrong or truncated frame
+    size_t                          frames_indexed;         // unique frames of each file, summed
+    size_t                          bytes_read;             // size of the files processed, summed
+    size_t                          duplicates_in_files;    // repeated rtc_s inside a file
+    size_t                          duplicates_between_files;
+    size_t                          tasks_stolen;
+    FrameIntegrityStats             integrity;              // wrong frames skipped, summed over the files processed
+} BatchResult;
+
+/**
+ * @brief Lists the input files: the files given, and the BATCH_INPUT_EXTENSION files of the directories given
+ *
+ * @param[in]  paths        Files or directories
+ * @param[in]  path_count   Number of paths
+ * @param[out] filenames    Initialized DynamicArray of char*, allocated copies of the file names, in the
+ *                          order of the paths (a directory in name order). See batch_free_filenames
+ *
+ * @return true on success, false if a path can't be read or if the memory ran out
+ */
+bool batch_collect_inputs(char *const paths[], size_t path_count, DynamicArray *filenames);
+
+/**
+ * @brief Releases the names and the array of batch_collect_inputs
+ */
+void batch_free_filenames(DynamicArray *filenames);
+
+/**
+ * @brief Decodes, sorts, deduplicates and calibrates every file, and merges them
+ *
+ * @param[in]  filenames        DynamicArray of char*, in duplicate priority order
+ * @param[in]  header           Constant structure that holds the beacon header ID to search for
+ * @param[in]  thread_count     Number of workers (see parallel_decode_thread_count)
+ * @param[in]  skip_wrong_frames    true to skip the wrong frames of a file (see MappedFrameFile), false to skip the file
+ * @param[out] result           Merged telemetry. A file that failed is skipped and counted. See batch_result_free
+ *
+ * @return true on success (even if some files failed), false if the memory ran out or the pool could not start
+ */
+bool batch_process
+(
+    const DynamicArray *filenames,
+    const BeaconHeader header,
+    size_t thread_count,
+    bool skip_wrong_frames,
+    BatchResult *result
+);
+
+/**
+ * @brief Releases the arrays of the result
+ *
+ * @param[in,out] result    Pointer to the result. Safe to call twice
+ */
+void batch_result_free(BatchResult *result);
+
+#endif // BATCH_PROCESSOR_H
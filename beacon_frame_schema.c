@@ -10,166 +10,496 @@
  */
 
 #include "beacon_frame_schema.h"
+#include "header_scanner.h"
 
 #include <stdbool.h>
 #include <stdio.h>
-
-//Used to read field by field, and avoid struct padding problems with the file
-#define READ_FIELD(file, ptr) (fread((ptr), 1, sizeof(*(ptr)), (file)) == sizeof(*(ptr)))
+#include <string.h>
 
 //////////////////////////////////////////
 
-ReadFileReturnType read_data_frame
-(
-    FILE *file,
-    const BeaconHeader header,
-    BeaconFrame *out
-)
+/**
+ * @brief Internal helpers, one unaligned load (memcpy is compiled to a plain mov) plus the swap if requested
+ */
+static inline uint16_t load_u16(const uint8_t *frame_bytes, size_t offset, bool swap)
 {
-    if (!file || !out) return READ_FAIL;
+    uint16_t value;
+    memcpy(&value, frame_bytes + offset, sizeof value);
+    return swap ? __builtin_bswap16(value) : value;
+}
 
-    unsigned char header_match[3] = {0,0,0};
-    size_t header_index = 0;
+static inline uint32_t load_u32(const uint8_t *frame_bytes, size_t offset, bool swap)
+{
+    uint32_t value;
+    memcpy(&value, frame_bytes + offset, sizeof value);
+    return swap ? __builtin_bswap32(value) : value;
+}
 
-    //search for the beaconID using a sliding mask
-    for (;;)
+//////////////////////////////////////////
+
+bool describe_wrong_section_id(const BeaconFrame *frame, char *out, size_t out_size)
+{
+    if (!frame || !out || out_size == 0) return false;
+    out[0] = '\0';
+
+    const struct
+    {
+        uint16_t    read_id;
+        FrameID     expected_id;
+        const char *section_name;
+    } sections[] =
     {
-        int byte_read = fgetc(file);
-        if (byte_read == EOF) return READ_EOF;
+        { frame->platform.platform_telemetry_id, PLATFORM_ID, "PLATFORM" },
+        { frame->memory.memory_telemetry_id,     MEMORY_ID,   "MEMORY" },
+        { frame->cdh.cdh_id,                     CDH_ID,      "CDH" },
+        { frame->power.power_telemetry_id,       POWER_ID,    "POWER" },
+        { frame->thermal.thermal_telemetry_id,   THERMAL_ID,  "THERMAL" },
+        { frame->aocs.aocs_telemetry_id,         AOCS_ID,     "AOCS" },
+        { frame->payload.payload_telemetry_id,   PAYLOAD_ID,  "PAYLOAD" },
+    };
 
-        if (header_index < 3)
-        {
-            header_match[header_index++] = byte_read;
-        }
-        else
-        {
-            header_match[0] = header_match[1];
-            header_match[1] = header_match[2];
-            header_match[2] = byte_read;
-        }
-        if (header_index == 3 &&
-            header_match[0] == header.beacon_id.b[0] &&
-            header_match[1] == header.beacon_id.b[1] &&
-            header_match[2] == header.beacon_id.b[2])
+    for (size_t i = 0; i < sizeof sections / sizeof sections[0]; ++i)
+    {
+        if (sections[i].read_id != sections[i].expected_id)
         {
-            break;
+            snprintf(out, out_size, "WRONG %s ID IN FRAME, read %x, expected %x",
+                     sections[i].section_name, sections[i].read_id, sections[i].expected_id);
+            return true;
         }
     }
-    // Beacon ID found, now on to read the frame
-    // because of struct padding, the "fastest" way of preventing reading problems
-    // is to read each field separately. Yeah, this is because I've used the full structure
-    // I could have just read the stream of bytes for the thermal data, but.. here we are
+    return false;
+}
 
-    /* PLATFORM */
-    if (!READ_FIELD(file, &out->platform.platform_telemetry_id)) return READ_FAIL;
+//////////////////////////////////////////
 
-    if (PLATFORM_ID != (IS_BIG_ENDIAN?byte16_swap(out->platform.platform_telemetry_id):out->platform.platform_telemetry_id))
+/**
+ * @brief Internal helper, decodes the fields of the selected sections. Always inlined with a constant swap
+ *        (and a constant mask for the full decode), so each copy has no other branches than the sections
+ */
+static inline __attribute__((always_inline))
+void decode_frame_fields(const uint8_t *frame_bytes, bool swap, FrameSectionMask sections, BeaconFrame *out)
+{
+    // the section IDs and the timestamp, whatever the mask is
+    out->platform.platform_telemetry_id     = load_u16(frame_bytes, OFFSET_PLATFORM_TELEMETRY_ID, swap);
+    out->platform.rtc_s                     = load_u32(frame_bytes, OFFSET_RTC_S, swap);
+    out->memory.memory_telemetry_id         = load_u16(frame_bytes, OFFSET_MEMORY_TELEMETRY_ID, swap);
+    out->cdh.cdh_id                         = load_u16(frame_bytes, OFFSET_CDH_ID, swap);
+    out->power.power_telemetry_id           = load_u16(frame_bytes, OFFSET_POWER_TELEMETRY_ID, swap);
+    out->thermal.thermal_telemetry_id       = load_u16(frame_bytes, OFFSET_THERMAL_TELEMETRY_ID, swap);
+    out->aocs.aocs_telemetry_id             = load_u16(frame_bytes, OFFSET_AOCS_TELEMETRY_ID, swap);
+    out->payload.payload_telemetry_id       = load_u16(frame_bytes, OFFSET_PAYLOAD_TELEMETRY_ID, swap);
+
+    /* PLATFORM */
+    if (sections & FRAME_SECTION_PLATFORM)
     {
-        printf("WRONG PLATFORM ID IN FRAME, read %x, expected %x", byte16_swap(out->platform.platform_telemetry_id), PLATFORM_ID);
-        return READ_FAIL;
+        out->platform.uptime_s              = load_u32(frame_bytes, OFFSET_UPTIME_S, swap);
+        memcpy(&out->platform.resetCount, frame_bytes + OFFSET_RESET_COUNT, sizeof out->platform.resetCount);
+        out->platform.currentMode           = frame_bytes[OFFSET_CURRENT_MODE];
+        out->platform.lastBootReason        = load_u32(frame_bytes, OFFSET_LAST_BOOT_REASON, swap);
     }
 
-    if (!READ_FIELD(file, &out->platform.uptime_s))              return READ_FAIL;
-    if (!READ_FIELD(file, &out->platform.rtc_s))                 return READ_FAIL;
-    if (!READ_FIELD(file, &out->platform.resetCount))            return READ_FAIL;
-    if (!READ_FIELD(file, &out->platform.currentMode))           return READ_FAIL;
-    if (!READ_FIELD(file, &out->platform.lastBootReason))        return READ_FAIL;
-
     /* MEMORY */
-    if (!READ_FIELD(file, &out->memory.memory_telemetry_id))     return READ_FAIL;
-
-    if (MEMORY_ID != (IS_BIG_ENDIAN?byte16_swap(out->memory.memory_telemetry_id):out->memory.memory_telemetry_id))
+    if (sections & FRAME_SECTION_MEMORY)
     {
-        printf("WRONG MEMORY ID IN FRAME, read %x, expected %x", byte16_swap(out->memory.memory_telemetry_id), MEMORY_ID);
-        return READ_FAIL;
+        out->memory.heap_free_bytes         = load_u32(frame_bytes, OFFSET_HEAP_FREE_BYTES, swap);
     }
 
-    if (!READ_FIELD(file, &out->memory.heap_free_bytes))         return READ_FAIL;
-
     /* CDH */
-    if (!READ_FIELD(file, &out->cdh.cdh_id))                     return READ_FAIL;
+    if (sections & FRAME_SECTION_CDH)
+    {
+        out->cdh.lastSeenSequenceNumber     = load_u32(frame_bytes, OFFSET_LAST_SEEN_SEQUENCE, swap);
+        out->cdh.antennaDeployStatus        = frame_bytes[OFFSET_ANTENNA_DEPLOY_STATUS];
+    }
 
-    if (CDH_ID != (IS_BIG_ENDIAN?byte16_swap(out->cdh.cdh_id):out->cdh.cdh_id))
+    /* POWER */
+    if (sections & FRAME_SECTION_POWER)
     {
-        printf("WRONG CDH ID IN FRAME, read %x, expected %x", byte16_swap(out->cdh.cdh_id), CDH_ID);
-        return READ_FAIL;
+        out->power.low_voltage_counter      = load_u16(frame_bytes, OFFSET_LOW_VOLTAGE_COUNTER, swap);
+        out->power.nice_battery_mV          = load_u16(frame_bytes, OFFSET_NICE_BATTERY_MV, swap);
+        out->power.raw_battery_mV           = load_u16(frame_bytes, OFFSET_RAW_BATTERY_MV, swap);
+        out->power.battery_A                = load_u16(frame_bytes, OFFSET_BATTERY_A, swap);
+        out->power.pcm_3v3_V                = load_u16(frame_bytes, OFFSET_PCM_3V3_V, swap);
+        out->power.pcm_3v3_A                = load_u16(frame_bytes, OFFSET_PCM_3V3_A, swap);
+        out->power.pcm_5v_V                 = load_u16(frame_bytes, OFFSET_PCM_5V_V, swap);
+        out->power.pcm_5v_A                 = load_u16(frame_bytes, OFFSET_PCM_5V_A, swap);
     }
 
-    if (!READ_FIELD(file, &out->cdh.lastSeenSequenceNumber))     return READ_FAIL;
-    if (!READ_FIELD(file, &out->cdh.antennaDeployStatus))        return READ_FAIL;
+    /* THERMAL */
+    if (sections & FRAME_SECTION_THERMAL)
+    {
+        out->thermal.CPU_C                  = (int16_t)load_u16(frame_bytes, OFFSET_CPU_C, swap);
+        out->thermal.mirror_cell_C          = (int16_t)load_u16(frame_bytes, OFFSET_MIRROR_CELL_C, swap);
+    }
 
-    /* POWER */
-    if (!READ_FIELD(file, &out->power.power_telemetry_id))       return READ_FAIL;
+    /* AOCS */
+    if (sections & FRAME_SECTION_AOCS)
+    {
+        out->aocs.aocs_mode                 = load_u32(frame_bytes, OFFSET_AOCS_MODE, swap);
+        out->aocs.sunvectorX                = (int16_t)load_u16(frame_bytes, OFFSET_SUNVECTOR_X, swap);
+        out->aocs.sunvectorY                = (int16_t)load_u16(frame_bytes, OFFSET_SUNVECTOR_Y, swap);
+        out->aocs.sunvectorZ                = (int16_t)load_u16(frame_bytes, OFFSET_SUNVECTOR_Z, swap);
+        out->aocs.magnetometerX_mg          = (int16_t)load_u16(frame_bytes, OFFSET_MAGNETOMETER_X, swap);
+        out->aocs.magnetometerY_mg          = (int16_t)load_u16(frame_bytes, OFFSET_MAGNETOMETER_Y, swap);
+        out->aocs.magnetometerZ_mg          = (int16_t)load_u16(frame_bytes, OFFSET_MAGNETOMETER_Z, swap);
+        out->aocs.gyroX_dps                 = (int16_t)load_u16(frame_bytes, OFFSET_GYRO_X, swap);
+        out->aocs.gyroY_dps                 = (int16_t)load_u16(frame_bytes, OFFSET_GYRO_Y, swap);
+        out->aocs.gyroZ_dps                 = (int16_t)load_u16(frame_bytes, OFFSET_GYRO_Z, swap);
+        out->aocs.temperature_IMU_C         = (int16_t)load_u16(frame_bytes, OFFSET_TEMPERATURE_IMU, swap);
+        out->aocs.fine_gyroX_dps            = (int32_t)load_u32(frame_bytes, OFFSET_FINE_GYRO_X, swap);
+        out->aocs.fine_gyroY_dps            = (int32_t)load_u32(frame_bytes, OFFSET_FINE_GYRO_Y, swap);
+        out->aocs.fine_gyroZ_dps            = (int32_t)load_u32(frame_bytes, OFFSET_FINE_GYRO_Z, swap);
+        out->aocs.wheel_1_radsec            = (int16_t)load_u16(frame_bytes, OFFSET_WHEEL_1, swap);
+        out->aocs.wheel_2_radsec            = (int16_t)load_u16(frame_bytes, OFFSET_WHEEL_2, swap);
+        out->aocs.wheel_3_radsec            = (int16_t)load_u16(frame_bytes, OFFSET_WHEEL_3, swap);
+        out->aocs.wheel_4_radsec            = (int16_t)load_u16(frame_bytes, OFFSET_WHEEL_4, swap);
+    }
 
-    if (POWER_ID != (IS_BIG_ENDIAN?byte16_swap(out->power.power_telemetry_id):out->power.power_telemetry_id))
+    /* PAYLOAD */
+    if (sections & FRAME_SECTION_PAYLOAD)
     {
-        printf("WRONG POWER ID IN FRAME, read %x, expected %x", byte16_swap(out->power.power_telemetry_id), POWER_ID);
-        return READ_FAIL;
+        out->payload.experimentsRun         = load_u16(frame_bytes, OFFSET_EXPERIMENTS_RUN, swap);
+        out->payload.experimentsFailed      = load_u16(frame_bytes, OFFSET_EXPERIMENTS_FAILED, swap);
+        out->payload.lastExperimentRun      = (int16_t)load_u16(frame_bytes, OFFSET_LAST_EXPERIMENT_RUN, swap);
+        out->payload.currentState           = frame_bytes[OFFSET_CURRENT_STATE];
     }
+}
 
-    if (!READ_FIELD(file, &out->power.low_voltage_counter))      return READ_FAIL;
-    if (!READ_FIELD(file, &out->power.nice_battery_mV))          return READ_FAIL;
-    if (!READ_FIELD(file, &out->power.raw_battery_mV))           return READ_FAIL;
-    if (!READ_FIELD(file, &out->power.battery_A))                return READ_FAIL;
-    if (!READ_FIELD(file, &out->power.pcm_3v3_V))                return READ_FAIL;
-    if (!READ_FIELD(file, &out->power.pcm_3v3_A))                return READ_FAIL;
-    if (!READ_FIELD(file, &out->power.pcm_5v_V))                 return READ_FAIL;
-    if (!READ_FIELD(file, &out->power.pcm_5v_A))                 return READ_FAIL;
+//////////////////////////////////////////
 
-    /* THERMAL */
-    if (!READ_FIELD(file, &out->thermal.thermal_telemetry_id))   return READ_FAIL;
+/**
+ * @brief Internal helper, the section IDs as they are in the file bytes, for each byte order (the "magic" of the frame).
+ *        The expected values are swapped once, here, instead of every load
+ */
+#define FRAME_ID_IN_FILE(id, swap) ((uint16_t)((swap) ? __builtin_bswap16((uint16_t)(id)) : (uint16_t)(id)))
+#define FRAME_ID_SIGNATURE(swap) \
+    { \
+        FRAME_ID_IN_FILE(PLATFORM_ID, swap), FRAME_ID_IN_FILE(MEMORY_ID, swap), FRAME_ID_IN_FILE(CDH_ID, swap), \
+        FRAME_ID_IN_FILE(POWER_ID, swap), FRAME_ID_IN_FILE(THERMAL_ID, swap), FRAME_ID_IN_FILE(AOCS_ID, swap), \
+        FRAME_ID_IN_FILE(PAYLOAD_ID, swap) \
+    }
+static const uint16_t frame_id_signatures[2][7] = { FRAME_ID_SIGNATURE(false), FRAME_ID_SIGNATURE(true) };
+#undef FRAME_ID_SIGNATURE
+#undef FRAME_ID_IN_FILE
+
+/**
+ * @brief Internal helper, true if the section IDs of the frame match in the given byte order
+ */
+static bool section_ids_match(const uint8_t *frame_bytes, FrameByteOrder byte_order)
+{
+    const uint16_t *signature = frame_id_signatures[byte_order != HOST_BYTE_ORDER];
+    unsigned wrong_ids = (load_u16(frame_bytes, OFFSET_PLATFORM_TELEMETRY_ID, false) ^ signature[0])
+                       | (load_u16(frame_bytes, OFFSET_MEMORY_TELEMETRY_ID, false)   ^ signature[1])
+                       | (load_u16(frame_bytes, OFFSET_CDH_ID, false)                ^ signature[2])
+                       | (load_u16(frame_bytes, OFFSET_POWER_TELEMETRY_ID, false)    ^ signature[3])
+                       | (load_u16(frame_bytes, OFFSET_THERMAL_TELEMETRY_ID, false)  ^ signature[4])
+                       | (load_u16(frame_bytes, OFFSET_AOCS_TELEMETRY_ID, false)     ^ signature[5])
+                       | (load_u16(frame_bytes, OFFSET_PAYLOAD_TELEMETRY_ID, false)  ^ signature[6]);
+    return wrong_ids == 0;
+}
 
-    if (THERMAL_ID != (IS_BIG_ENDIAN?byte16_swap(out->thermal.thermal_telemetry_id):out->thermal.thermal_telemetry_id))
+//////////////////////////////////////////
+
+bool beacon_frame_ids_match(const uint8_t *frame_bytes, FrameByteOrder byte_order)
+{
+    if (!frame_bytes) return false;
+    return section_ids_match(frame_bytes, byte_order);
+}
+
+//////////////////////////////////////////
+
+FrameByteOrder detect_frame_byte_order(const uint8_t *frame_bytes)
+{
+    if (!frame_bytes) return FRAME_BYTE_ORDER_UNKNOWN;
+    if (section_ids_match(frame_bytes, FRAME_BYTE_ORDER_BIG_ENDIAN)) return FRAME_BYTE_ORDER_BIG_ENDIAN;
+    if (section_ids_match(frame_bytes, FRAME_BYTE_ORDER_LITTLE_ENDIAN)) return FRAME_BYTE_ORDER_LITTLE_ENDIAN;
+    return FRAME_BYTE_ORDER_UNKNOWN;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, body of decode_beacon_frame and decode_beacon_frame_sections
+ */
+static inline __attribute__((always_inline))
+bool decode_frame(const uint8_t *frame_bytes, FrameByteOrder byte_order, FrameSectionMask sections, BeaconFrame *out)
+{
+    // the frame is converted to host order here, and only here
+    if (byte_order != HOST_BYTE_ORDER) decode_frame_fields(frame_bytes, true, sections, out);
+    else decode_frame_fields(frame_bytes, false, sections, out);
+
+    // all the section IDs in one branch, a wrong one is the exception (reported by the caller, see
+    // describe_wrong_section_id: the frames are decoded on several threads, and some modes skip the wrong ones)
+    unsigned wrong_ids = (out->platform.platform_telemetry_id ^ PLATFORM_ID)
+                       | (out->memory.memory_telemetry_id     ^ MEMORY_ID)
+                       | (out->cdh.cdh_id                     ^ CDH_ID)
+                       | (out->power.power_telemetry_id       ^ POWER_ID)
+                       | (out->thermal.thermal_telemetry_id   ^ THERMAL_ID)
+                       | (out->aocs.aocs_telemetry_id         ^ AOCS_ID)
+                       | (out->payload.payload_telemetry_id   ^ PAYLOAD_ID);
+
+    return __builtin_expect(wrong_ids == 0, 1);
+}
+
+//////////////////////////////////////////
+
+bool decode_beacon_frame(const uint8_t *frame_bytes, FrameByteOrder byte_order, BeaconFrame *out)
+{
+    return decode_frame(frame_bytes, byte_order, FRAME_SECTIONS_ALL, out);
+}
+
+//////////////////////////////////////////
+
+bool decode_beacon_frame_sections(const uint8_t *frame_bytes, FrameByteOrder byte_order, FrameSectionMask sections, BeaconFrame *out)
+{
+    return decode_frame(frame_bytes, byte_order, sections, out);
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, returns the known byte order, or detects it from the frame and keeps it.
+ *        If it can't be detected, big endian (the ground station default) is used so the frame is still decoded and reported
+ */
+static FrameByteOrder resolve_byte_order(const uint8_t *frame_bytes, FrameByteOrder *known_byte_order)
+{
+    if (*known_byte_order != FRAME_BYTE_ORDER_UNKNOWN) return *known_byte_order;
+
+    FrameByteOrder detected = detect_frame_byte_order(frame_bytes);
+    if (detected == FRAME_BYTE_ORDER_UNKNOWN) return FRAME_BYTE_ORDER_BIG_ENDIAN;
+
+    *known_byte_order = detected;
+    return detected;
+}
+
+//////////////////////////////////////////
+
+ReadFileReturnType read_data_frame
+(
+    FILE *file,
+    const BeaconHeader header,
+    BeaconFrame *out
+)
+{
+    return read_data_frame_sections(file, header, FRAME_SECTIONS_ALL, out);
+}
+
+//////////////////////////////////////////
+
+ReadFileReturnType read_data_frame_sections
+(
+    FILE *file,
+    const BeaconHeader header,
+    FrameSectionMask sections,
+    BeaconFrame *out
+)
+{
+    if (!file || !out) return READ_FAIL;
+
+    // one header plus one frame per read. Whatever the position of the header in the block is,
+    // the block never holds bytes past the end of the frame, so nothing has to be pushed back
+    // into the stream (pipes can't seek)
+    uint8_t block[BEACON_HEADER_SIZE + BEACON_FRAME_SIZE];
+    size_t available = 0;
+    size_t found;
+
+    //search for the beaconID block by block
+    for (;;)
     {
-        printf("WRONG THERMAL ID IN FRAME, read %x, expected %x", byte16_swap(out->thermal.thermal_telemetry_id), THERMAL_ID);
-        return READ_FAIL;
-    }
+        size_t read_bytes = fread(block + available, 1, sizeof block - available, file);
+        available += read_bytes;
 
-    if (!READ_FIELD(file, &out->thermal.CPU_C))                  return READ_FAIL;
-    if (!READ_FIELD(file, &out->thermal.mirror_cell_C))          return READ_FAIL;
+        found = find_beacon_header(block, available, header);
+        if (found < available) break;
 
-    /* AOCS */
-    if (!READ_FIELD(file, &out->aocs.aocs_telemetry_id))         return READ_FAIL;
+        if (read_bytes == 0) return READ_EOF;
+
+        // keep the last bytes, a header may be split between two blocks
+        size_t kept = available < BEACON_HEADER_SIZE - 1 ? available : BEACON_HEADER_SIZE - 1;
+        memmove(block, block + available - kept, kept);
+        available = kept;
+    }
 
-    if (AOCS_ID != (IS_BIG_ENDIAN?byte16_swap(out->aocs.aocs_telemetry_id):out->aocs.aocs_telemetry_id))
+    // Beacon ID found, complete the frame that follows it
+    const size_t frame_start = found + BEACON_HEADER_SIZE;
+    if (frame_start > 0)
     {
-        printf("WRONG AOCS ID IN FRAME, read %x, expected %x", byte16_swap(out->aocs.aocs_telemetry_id), AOCS_ID);
-        return READ_FAIL;
+        memmove(block, block + frame_start, available - frame_start);
+        available -= frame_start;
+        available += fread(block + available, 1, BEACON_FRAME_SIZE - available, file);
     }
 
-    if (!READ_FIELD(file, &out->aocs.aocs_mode))                 return READ_FAIL;
-    if (!READ_FIELD(file, &out->aocs.sunvectorX))                return READ_FAIL;
-    if (!READ_FIELD(file, &out->aocs.sunvectorY))                return READ_FAIL;
-    if (!READ_FIELD(file, &out->aocs.sunvectorZ))                return READ_FAIL;
-    if (!READ_FIELD(file, &out->aocs.magnetometerX_mg))          return READ_FAIL;
-    if (!READ_FIELD(file, &out->aocs.magnetometerY_mg))          return READ_FAIL;
-    if (!READ_FIELD(file, &out->aocs.magnetometerZ_mg))          return READ_FAIL;
-    if (!READ_FIELD(file, &out->aocs.gyroX_dps))                 return READ_FAIL;
-    if (!READ_FIELD(file, &out->aocs.gyroY_dps))                 return READ_FAIL;
-    if (!READ_FIELD(file, &out->aocs.gyroZ_dps))                 return READ_FAIL;
-    if (!READ_FIELD(file, &out->aocs.temperature_IMU_C))         return READ_FAIL;
-    if (!READ_FIELD(file, &out->aocs.fine_gyroX_dps))            return READ_FAIL;
-    if (!READ_FIELD(file, &out->aocs.fine_gyroY_dps))            return READ_FAIL;
-    if (!READ_FIELD(file, &out->aocs.fine_gyroZ_dps))            return READ_FAIL;
-    if (!READ_FIELD(file, &out->aocs.wheel_1_radsec))            return READ_FAIL;
-    if (!READ_FIELD(file, &out->aocs.wheel_2_radsec))            return READ_FAIL;
-    if (!READ_FIELD(file, &out->aocs.wheel_3_radsec))            return READ_FAIL;
-    if (!READ_FIELD(file, &out->aocs.wheel_4_radsec))            return READ_FAIL;
+    // a short read leaves the frame incomplete
+    if (available < BEACON_FRAME_SIZE) return READ_FAIL;
 
-    /* PAYLOAD */
-    if (!READ_FIELD(file, &out->payload.payload_telemetry_id))   return READ_FAIL;
+    // without a place to keep it between calls, the byte order comes from each frame
+    FrameByteOrder byte_order = FRAME_BYTE_ORDER_UNKNOWN;
+    if (!decode_beacon_frame_sections(block, resolve_byte_order(block, &byte_order), sections, out)) return READ_FAIL;
 
-    if (PAYLOAD_ID != (IS_BIG_ENDIAN?byte16_swap(out->payload.payload_telemetry_id):out->payload.payload_telemetry_id))
+    return READ_OK;
+}
+
+//////////////////////////////////////////
+
+ReadFileReturnType read_data_frame_from_buffer
+(
+    const uint8_t *buffer,
+    size_t buffer_size,
+    size_t *position,
+    FrameByteOrder *byte_order,
+    const BeaconHeader header,
+    BeaconFrame *out
+)
+{
+    return read_data_frame_from_buffer_sections(buffer, buffer_size, position, byte_order, header, FRAME_SECTIONS_ALL, out);
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, searchs the next header of the buffer, and checks a whole frame follows it
+ *
+ * @return READ_OK with *position at the first byte of the frame, READ_EOF if no header is left,
+ *         READ_FAIL if the frame is truncated (*position right after the header, in both cases)
+ */
+static ReadFileReturnType find_buffer_frame
+(
+    const uint8_t *buffer,
+    size_t buffer_size,
+    size_t *position,
+    const BeaconHeader header
+)
+{
+    if (*position >= buffer_size) return READ_EOF;
+
+    size_t found = *position + find_beacon_header(buffer + *position, buffer_size - *position, header);
+    if (found >= buffer_size)
     {
-        printf("WRONG PAYLOAD ID IN FRAME, read %x, expected %x", byte16_swap(out->payload.payload_telemetry_id), PAYLOAD_ID);
-        return READ_FAIL;
+        *position = buffer_size;
+        return READ_EOF;
     }
 
-    if (!READ_FIELD(file, &out->payload.experimentsRun))         return READ_FAIL;
-    if (!READ_FIELD(file, &out->payload.experimentsFailed))      return READ_FAIL;
-    if (!READ_FIELD(file, &out->payload.lastExperimentRun))      return READ_FAIL;
-    if (!READ_FIELD(file, &out->payload.currentState))           return READ_FAIL;
+    // a failed frame leaves the position right after the header, so the caller could resync from there
+    *position = found + BEACON_HEADER_SIZE;
+
+    if (buffer_size - *position < BEACON_FRAME_SIZE) return READ_FAIL;
+    return READ_OK;
+}
+
+//////////////////////////////////////////
+
+ReadFileReturnType read_data_frame_from_buffer_sections
+(
+    const uint8_t *buffer,
+    size_t buffer_size,
+    size_t *position,
+    FrameByteOrder *byte_order,
+    const BeaconHeader header,
+    FrameSectionMask sections,
+    BeaconFrame *out
+)
+{
+    if (!buffer || !position || !byte_order || !out) return READ_FAIL;
 
-    // all fields read correctly
+    ReadFileReturnType state = find_buffer_frame(buffer, buffer_size, position, header);
+    if (state != READ_OK) return state;
+
+    const uint8_t *frame_bytes = buffer + *position;
+    if (!decode_beacon_frame_sections(frame_bytes, resolve_byte_order(frame_bytes, byte_order), sections, out)) return READ_FAIL;
+
+    // all fields read correctly, move the position to the end of the frame
+    *position += BEACON_FRAME_SIZE;
     return READ_OK;
 }
+
+//////////////////////////////////////////
+
+bool beacon_frame_view_init(const uint8_t *frame_bytes, FrameByteOrder byte_order, BeaconFrameView *out)
+{
+    if (!frame_bytes || !out) return false;
+
+    if (__builtin_expect(!section_ids_match(frame_bytes, byte_order), 0)) return false;
+
+    out->bytes = frame_bytes;
+    out->swap = byte_order != HOST_BYTE_ORDER;
+    return true;
+}
+
+//////////////////////////////////////////
+
+ReadFileReturnType read_frame_view_from_buffer
+(
+    const uint8_t *buffer,
+    size_t buffer_size,
+    size_t *position,
+    FrameByteOrder *byte_order,
+    const BeaconHeader header,
+    BeaconFrameView *out
+)
+{
+    if (!buffer || !position || !byte_order || !out) return READ_FAIL;
+
+    ReadFileReturnType state = find_buffer_frame(buffer, buffer_size, position, header);
+    if (state != READ_OK) return state;
+
+    const uint8_t *frame_bytes = buffer + *position;
+    if (!beacon_frame_view_init(frame_bytes, resolve_byte_order(frame_bytes, byte_order), out)) return READ_FAIL;
+
+    *position += BEACON_FRAME_SIZE;
+    return READ_OK;
+}
+
+//////////////////////////////////////////
+
+ReadFileReturnType read_frame_view_from_buffer_robust
+(
+    const uint8_t *buffer,
+    size_t buffer_size,
+    size_t *position,
+    FrameByteOrder *byte_order,
+    const BeaconHeader header,
+    FrameIntegrityStats *stats,
+    BeaconFrameView *out
+)
+{
+    if (!buffer || !position || !byte_order || !stats || !out) return READ_EOF;
+
+    const size_t start = *position < buffer_size ? *position : buffer_size;
+
+    for (;;)
+    {
+        ReadFileReturnType state = find_buffer_frame(buffer, buffer_size, position, header);
+        if (state != READ_OK)
+        {
+            // the end of the buffer, maybe after the header of a truncated frame
+            if (state == READ_FAIL)
+            {
+                stats->frames_truncated++;
+                stats->truncated_header = *position - BEACON_HEADER_SIZE;
+            }
+            stats->bytes_skipped += buffer_size - start;
+            *position = buffer_size;
+            return READ_EOF;
+        }
+
+        const uint8_t *frame_bytes = buffer + *position;
+        const FrameByteOrder frame_byte_order = resolve_byte_order(frame_bytes, byte_order);
+
+        if (__builtin_expect(section_ids_match(frame_bytes, frame_byte_order), 1))
+        {
+            const size_t skipped = *position - BEACON_HEADER_SIZE - start;
+            if (skipped > 0)
+            {
+                stats->bytes_skipped += skipped;
+                stats->resyncs++;
+            }
+
+            out->bytes = frame_bytes;
+            out->swap = frame_byte_order != HOST_BYTE_ORDER;
+            *position += BEACON_FRAME_SIZE;
+            return READ_OK;
+        }
+
+        // the position is right after the wrong header, the search goes on from there
+        stats->frames_wrong++;
+    }
+}
@@ -18,10 +18,17 @@
 
 #include "extended_tools.h"
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <stdint.h>
+#include <string.h>
 
-#define IS_BIG_ENDIAN 1
+#define BEACON_HEADER_SIZE 3                // bytes of the beacon ID
+#define BEACON_FRAME_SIZE 110               // bytes of the frame following the beacon ID, PLATFORM to PAYLOAD
+
+// upper bound of the frames a file of file_size bytes can hold, to presize the buffers
+#define BEACON_FRAME_COUNT_ESTIMATE(file_size) ((size_t)(file_size) / (BEACON_HEADER_SIZE + BEACON_FRAME_SIZE))
 
 /**
     @enum defines the data id's for each section of the frame
@@ -38,6 +45,45 @@ typedef enum
     PAYLOAD_ID = 0x0601
 } FrameID;
 
+/**
+    @enum byte order of the 16/32 bit fields in a file
+    @note the ground stations don't agree on this one, it is detected from the section IDs of the frames
+**/
+typedef enum
+{
+    FRAME_BYTE_ORDER_UNKNOWN,
+    FRAME_BYTE_ORDER_BIG_ENDIAN,
+    FRAME_BYTE_ORDER_LITTLE_ENDIAN
+} FrameByteOrder;
+
+/**
+    @enum sections of the frame to decode (projection of the decoder), one bit per section
+    @note the seven section IDs and PLATFORM rtc_s (the key of every output) are always decoded,
+          the IDs are always checked. The fields of the other sections are left untouched in the BeaconFrame
+**/
+typedef enum
+{
+    FRAME_SECTION_NONE      = 0,
+    FRAME_SECTION_PLATFORM  = 1u << 0,
+    FRAME_SECTION_MEMORY    = 1u << 1,
+    FRAME_SECTION_CDH       = 1u << 2,
+    FRAME_SECTION_POWER     = 1u << 3,
+    FRAME_SECTION_THERMAL   = 1u << 4,
+    FRAME_SECTION_AOCS      = 1u << 5,
+    FRAME_SECTION_PAYLOAD   = 1u << 6,
+    FRAME_SECTIONS_ALL      = (1u << 7) - 1
+} FrameSection;
+
+// a set of FrameSection bits
+typedef unsigned FrameSectionMask;
+
+// byte order of the machine running the decoder
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define HOST_BYTE_ORDER FRAME_BYTE_ORDER_BIG_ENDIAN
+#else
+#define HOST_BYTE_ORDER FRAME_BYTE_ORDER_LITTLE_ENDIAN
+#endif
+
 typedef enum
 {
     READ_OK,
@@ -45,13 +91,31 @@ typedef enum
     READ_EOF
 } ReadFileReturnType;
 
+/**
+ * @struct FrameIntegrityStats
+ * @brief  Counters of the reads that skip the wrong frames instead of failing (see read_frame_view_from_buffer_robust)
+ *
+ * @note The frame has no CRC of its own (frame_crc of the index is computed by the reader, for the
+ *       deduplication), so a frame is wrong when one of its seven section IDs doesn't match
+ */
+typedef struct FRAME_INTEGRITY_STATS
+{
+    size_t  frames_wrong;               // headers followed by a wrong section ID, skipped
+    size_t  frames_truncated;           // a header with less than a frame after it, at the end of the data
+    size_t  truncated_header;           // offset of that header in the data, when frames_truncated is not 0
+    size_t  bytes_skipped;              // bytes outside the valid headers and frames
+    size_t  resyncs;                    // valid frames found after skipped bytes
+} FrameIntegrityStats;
+
 /**
     @file Frame Reader Schema Structures and file reading
     @brief Frame reader organization schema defined in the stream docs.
 
     @note All the fields are directly translated from the documentation, and used to read the file
-          The user of this schema has to read and convert to calibrated values according to docs
-    @note For this sample, only temperature and sun_sensor data from AOCS has the calibration implemented.
+          The fields hold the raw values in host byte order (uint24_t fields keep the file byte order).
+          The user of this schema has to convert them to calibrated values according to docs
+    @note The calibration of every documented field is in calibration_table.h. Temperature and sun_sensor
+          data from AOCS also have their own calibrated structs (thermal_calibrated.h, sun_sensors_calibrated.h)
 **/
 
 /* ---- HEADER ---- */
@@ -147,6 +211,72 @@ typedef struct PAYLOAD_SCHEMA
     uint8_t  currentState;
 } PayloadTelemetrySchema;
 
+/**
+    @enum wire offset of every field of the frame, relative to the first byte after the header
+    @note the frame in the file is packed, the structs above are not. Each offset is the previous one
+          plus the size of the previous field, so adding a field only means adding its line here
+**/
+typedef enum
+{
+    /* PLATFORM */
+    OFFSET_PLATFORM_TELEMETRY_ID    = 0,
+    OFFSET_UPTIME_S                 = OFFSET_PLATFORM_TELEMETRY_ID + 2,
+    OFFSET_RTC_S                    = OFFSET_UPTIME_S + 4,
+    OFFSET_RESET_COUNT              = OFFSET_RTC_S + 4,
+    OFFSET_CURRENT_MODE             = OFFSET_RESET_COUNT + 3,
+    OFFSET_LAST_BOOT_REASON         = OFFSET_CURRENT_MODE + 1,
+    /* MEMORY */
+    OFFSET_MEMORY_TELEMETRY_ID      = OFFSET_LAST_BOOT_REASON + 4,
+    OFFSET_HEAP_FREE_BYTES          = OFFSET_MEMORY_TELEMETRY_ID + 2,
+    /* CDH */
+    OFFSET_CDH_ID                   = OFFSET_HEAP_FREE_BYTES + 4,
+    OFFSET_LAST_SEEN_SEQUENCE       = OFFSET_CDH_ID + 2,
+    OFFSET_ANTENNA_DEPLOY_STATUS    = OFFSET_LAST_SEEN_SEQUENCE + 4,
+    /* POWER */
+    OFFSET_POWER_TELEMETRY_ID       = OFFSET_ANTENNA_DEPLOY_STATUS + 1,
+    OFFSET_LOW_VOLTAGE_COUNTER      = OFFSET_POWER_TELEMETRY_ID + 2,
+    OFFSET_NICE_BATTERY_MV          = OFFSET_LOW_VOLTAGE_COUNTER + 2,
+    OFFSET_RAW_BATTERY_MV           = OFFSET_NICE_BATTERY_MV + 2,
+    OFFSET_BATTERY_A                = OFFSET_RAW_BATTERY_MV + 2,
+    OFFSET_PCM_3V3_V                = OFFSET_BATTERY_A + 2,
+    OFFSET_PCM_3V3_A                = OFFSET_PCM_3V3_V + 2,
+    OFFSET_PCM_5V_V                 = OFFSET_PCM_3V3_A + 2,
+    OFFSET_PCM_5V_A                 = OFFSET_PCM_5V_V + 2,
+    /* THERMAL */
+    OFFSET_THERMAL_TELEMETRY_ID     = OFFSET_PCM_5V_A + 2,
+    OFFSET_CPU_C                    = OFFSET_THERMAL_TELEMETRY_ID + 2,
+    OFFSET_MIRROR_CELL_C            = OFFSET_CPU_C + 2,
+    /* AOCS */
+    OFFSET_AOCS_TELEMETRY_ID        = OFFSET_MIRROR_CELL_C + 2,
+    OFFSET_AOCS_MODE                = OFFSET_AOCS_TELEMETRY_ID + 2,
+    OFFSET_SUNVECTOR_X              = OFFSET_AOCS_MODE + 4,
+    OFFSET_SUNVECTOR_Y              = OFFSET_SUNVECTOR_X + 2,
+    OFFSET_SUNVECTOR_Z              = OFFSET_SUNVECTOR_Y + 2,
+    OFFSET_MAGNETOMETER_X           = OFFSET_SUNVECTOR_Z + 2,
+    OFFSET_MAGNETOMETER_Y           = OFFSET_MAGNETOMETER_X + 2,
+    OFFSET_MAGNETOMETER_Z           = OFFSET_MAGNETOMETER_Y + 2,
+    OFFSET_GYRO_X                   = OFFSET_MAGNETOMETER_Z + 2,
+    OFFSET_GYRO_Y                   = OFFSET_GYRO_X + 2,
+    OFFSET_GYRO_Z                   = OFFSET_GYRO_Y + 2,
+    OFFSET_TEMPERATURE_IMU          = OFFSET_GYRO_Z + 2,
+    OFFSET_FINE_GYRO_X              = OFFSET_TEMPERATURE_IMU + 2,
+    OFFSET_FINE_GYRO_Y              = OFFSET_FINE_GYRO_X + 4,
+    OFFSET_FINE_GYRO_Z              = OFFSET_FINE_GYRO_Y + 4,
+    OFFSET_WHEEL_1                  = OFFSET_FINE_GYRO_Z + 4,
+    OFFSET_WHEEL_2                  = OFFSET_WHEEL_1 + 2,
+    OFFSET_WHEEL_3                  = OFFSET_WHEEL_2 + 2,
+    OFFSET_WHEEL_4                  = OFFSET_WHEEL_3 + 2,
+    /* PAYLOAD */
+    OFFSET_PAYLOAD_TELEMETRY_ID     = OFFSET_WHEEL_4 + 2,
+    OFFSET_EXPERIMENTS_RUN          = OFFSET_PAYLOAD_TELEMETRY_ID + 2,
+    OFFSET_EXPERIMENTS_FAILED       = OFFSET_EXPERIMENTS_RUN + 2,
+    OFFSET_LAST_EXPERIMENT_RUN      = OFFSET_EXPERIMENTS_FAILED + 2,
+    OFFSET_CURRENT_STATE            = OFFSET_LAST_EXPERIMENT_RUN + 2,
+    OFFSET_FRAME_END                = OFFSET_CURRENT_STATE + 1
+} BeaconFrameWireOffset;
+
+_Static_assert(OFFSET_FRAME_END == BEACON_FRAME_SIZE, "wire offsets don't add up to BEACON_FRAME_SIZE");
+
 /* ---- FULL FRAME STRUCT ---- */
 typedef struct FRAME_SCHEMA
 {
@@ -159,11 +289,201 @@ typedef struct FRAME_SCHEMA
     PayloadTelemetrySchema  payload;
 } BeaconFrame;
 
+/* ---- FRAME VIEW ---- */
+
+/**
+ * @struct BeaconFrameView
+ * @brief  Read-only view of a packed frame, in place (e.g. in a mapped file) instead of decoded into a BeaconFrame
+ *
+ * @note Each accessor below loads its field at its BeaconFrameWireOffset and converts it to host byte order,
+ *       so a user reading a few fields of many frames (the index, the calibration engine) only pays for those.
+ *       The view is valid while the bytes it points to are (e.g. until mapped_file_close)
+ */
+typedef struct BEACON_FRAME_VIEW
+{
+    const uint8_t  *bytes;                  // first byte after the header, BEACON_FRAME_SIZE bytes
+    bool            swap;                   // the byte order of the bytes is not the host one
+} BeaconFrameView;
+
+/**
+ * @brief Raw loads of a view, at a wire offset, in host byte order (memcpy is compiled to a plain mov)
+ */
+static inline uint8_t beacon_frame_view_load_u8(const BeaconFrameView *view, size_t wire_offset)
+{
+    return view->bytes[wire_offset];
+}
+
+static inline uint16_t beacon_frame_view_load_u16(const BeaconFrameView *view, size_t wire_offset)
+{
+    uint16_t value;
+    memcpy(&value, view->bytes + wire_offset, sizeof value);
+    return view->swap ? __builtin_bswap16(value) : value;
+}
+
+static inline uint32_t beacon_frame_view_load_u32(const BeaconFrameView *view, size_t wire_offset)
+{
+    uint32_t value;
+    memcpy(&value, view->bytes + wire_offset, sizeof value);
+    return view->swap ? __builtin_bswap32(value) : value;
+}
+
+// X(field, type, raw load, wire offset), one line per field of the frame (resetCount is the 3 byte one, below)
+#define BEACON_FRAME_VIEW_FIELDS(X) \
+    /* PLATFORM */ \
+    X(platform_telemetry_id,    uint16_t, u16, OFFSET_PLATFORM_TELEMETRY_ID) \
+    X(uptime_s,                 uint32_t, u32, OFFSET_UPTIME_S) \
+    X(rtc_s,                    uint32_t, u32, OFFSET_RTC_S) \
+    X(currentMode,              uint8_t,  u8,  OFFSET_CURRENT_MODE) \
+    X(lastBootReason,           uint32_t, u32, OFFSET_LAST_BOOT_REASON) \
+    /* MEMORY */ \
+    X(memory_telemetry_id,      uint16_t, u16, OFFSET_MEMORY_TELEMETRY_ID) \
+    X(heap_free_bytes,          uint32_t, u32, OFFSET_HEAP_FREE_BYTES) \
+    /* CDH */ \
+    X(cdh_id,                   uint16_t, u16, OFFSET_CDH_ID) \
+    X(lastSeenSequenceNumber,   uint32_t, u32, OFFSET_LAST_SEEN_SEQUENCE) \
+    X(antennaDeployStatus,      uint8_t,  u8,  OFFSET_ANTENNA_DEPLOY_STATUS) \
+    /* POWER */ \
+    X(power_telemetry_id,       uint16_t, u16, OFFSET_POWER_TELEMETRY_ID) \
+    X(low_voltage_counter,      uint16_t, u16, OFFSET_LOW_VOLTAGE_COUNTER) \
+    X(nice_battery_mV,          uint16_t, u16, OFFSET_NICE_BATTERY_MV) \
+    X(raw_battery_mV,           uint16_t, u16, OFFSET_RAW_BATTERY_MV) \
+    X(battery_A,                uint16_t, u16, OFFSET_BATTERY_A) \
+    X(pcm_3v3_V,                uint16_t, u16, OFFSET_PCM_3V3_V) \
+    X(pcm_3v3_A,                uint16_t, u16, OFFSET_PCM_3V3_A) \
+    X(pcm_5v_V,                 uint16_t, u16, OFFSET_PCM_5V_V) \
+    X(pcm_5v_A,                 uint16_t, u16, OFFSET_PCM_5V_A) \
+    /* THERMAL */ \
+    X(thermal_telemetry_id,     uint16_t, u16, OFFSET_THERMAL_TELEMETRY_ID) \
+    X(CPU_C,                    int16_t,  u16, OFFSET_CPU_C) \
+    X(mirror_cell_C,            int16_t,  u16, OFFSET_MIRROR_CELL_C) \
+    /* AOCS */ \
+    X(aocs_telemetry_id,        uint16_t, u16, OFFSET_AOCS_TELEMETRY_ID) \
+    X(aocs_mode,                uint32_t, u32, OFFSET_AOCS_MODE) \
+    X(sunvectorX,               int16_t,  u16, OFFSET_SUNVECTOR_X) \
+    X(sunvectorY,               int16_t,  u16, OFFSET_SUNVECTOR_Y) \
+    X(sunvectorZ,               int16_t,  u16, OFFSET_SUNVECTOR_Z) \
+    X(magnetometerX_mg,         int16_t,  u16, OFFSET_MAGNETOMETER_X) \
+    X(magnetometerY_mg,         int16_t,  u16, OFFSET_MAGNETOMETER_Y) \
+    X(magnetometerZ_mg,         int16_t,  u16, OFFSET_MAGNETOMETER_Z) \
+    X(gyroX_dps,                int16_t,  u16, OFFSET_GYRO_X) \
+    X(gyroY_dps,                int16_t,  u16, OFFSET_GYRO_Y) \
+    X(gyroZ_dps,                int16_t,  u16, OFFSET_GYRO_Z) \
+    X(temperature_IMU_C,        int16_t,  u16, OFFSET_TEMPERATURE_IMU) \
+    X(fine_gyroX_dps,           int32_t,  u32, OFFSET_FINE_GYRO_X) \
+    X(fine_gyroY_dps,           int32_t,  u32, OFFSET_FINE_GYRO_Y) \
+    X(fine_gyroZ_dps,           int32_t,  u32, OFFSET_FINE_GYRO_Z) \
+    X(wheel_1_radsec,           int16_t,  u16, OFFSET_WHEEL_1) \
+    X(wheel_2_radsec,           int16_t,  u16, OFFSET_WHEEL_2) \
+    X(wheel_3_radsec,           int16_t,  u16, OFFSET_WHEEL_3) \
+    X(wheel_4_radsec,           int16_t,  u16, OFFSET_WHEEL_4) \
+    /* PAYLOAD */ \
+    X(payload_telemetry_id,     uint16_t, u16, OFFSET_PAYLOAD_TELEMETRY_ID) \
+    X(experimentsRun,           uint16_t, u16, OFFSET_EXPERIMENTS_RUN) \
+    X(experimentsFailed,        uint16_t, u16, OFFSET_EXPERIMENTS_FAILED) \
+    X(lastExperimentRun,        int16_t,  u16, OFFSET_LAST_EXPERIMENT_RUN) \
+    X(currentState,             uint8_t,  u8,  OFFSET_CURRENT_STATE)
+
+/**
+ * @brief Typed accessors of a view: beacon_frame_view_<field>(view), e.g. beacon_frame_view_rtc_s(&view)
+ */
+#define BEACON_FRAME_VIEW_ACCESSOR(field, type, load, wire_offset) \
+    static inline type beacon_frame_view_##field(const BeaconFrameView *view) \
+    { \
+        return (type)beacon_frame_view_load_##load(view, wire_offset); \
+    }
+BEACON_FRAME_VIEW_FIELDS(BEACON_FRAME_VIEW_ACCESSOR)
+#undef BEACON_FRAME_VIEW_ACCESSOR
+
+static inline uint24_t beacon_frame_view_resetCount(const BeaconFrameView *view)
+{
+    // kept in the file byte order, as in the BeaconFrame
+    uint24_t value;
+    memcpy(&value, view->bytes + OFFSET_RESET_COUNT, sizeof value);
+    return value;
+}
+
+
+/**
+ * @brief Detects the byte order of a packed frame from its section IDs
+ *
+ * @param[in]   frame_bytes     Pointer to the first byte after the header, at least BEACON_FRAME_SIZE bytes
+ *
+ * @return The byte order in which all the seven section IDs match, FRAME_BYTE_ORDER_UNKNOWN if none
+ */
+FrameByteOrder detect_frame_byte_order(const uint8_t *frame_bytes);
+
+/**
+ * @brief Decodes a packed frame (the BEACON_FRAME_SIZE bytes after the header) into a BeaconFrame
+ *
+ *  Every field is read at its BeaconFrameWireOffset with a single load, converted to host byte order.
+ *  The seven section IDs are checked together after the decoding. A wrong one is not printed (see describe_wrong_section_id).
+ *
+ * @param[in]   frame_bytes     Pointer to the first byte after the header, at least BEACON_FRAME_SIZE bytes
+ * @param[in]   byte_order      Byte order of the file
+ * @param[out]  out             Pointer to the return structure holding the frame values
+ *
+ * @return true if every section ID matches its FrameID, false otherwise
+ */
+bool decode_beacon_frame(const uint8_t *frame_bytes, FrameByteOrder byte_order, BeaconFrame *out);
+
+/**
+ * @brief Same as decode_beacon_frame, but only the fields of the given sections are decoded
+ *
+ *  The fields of the skipped sections are jumped over by their wire offsets. The section IDs and
+ *  rtc_s are decoded, and the IDs checked, whatever the mask is.
+ *
+ * @param[in]   frame_bytes     Pointer to the first byte after the header, at least BEACON_FRAME_SIZE bytes
+ * @param[in]   byte_order      Byte order of the file
+ * @param[in]   sections        FrameSection bits of the sections to decode
+ * @param[out]  out             Pointer to the return structure holding the frame values
+ *
+ * @return true if every section ID matches its FrameID, false otherwise
+ */
+bool decode_beacon_frame_sections(const uint8_t *frame_bytes, FrameByteOrder byte_order, FrameSectionMask sections, BeaconFrame *out);
+
+/**
+ * @brief Points a view to a packed frame, after checking its section IDs as decode_beacon_frame does
+ *
+ *  Nothing is decoded or copied, the fields are read later by the accessors. A wrong ID is not
+ *  printed either.
+ *
+ * @param[in]   frame_bytes     Pointer to the first byte after the header, at least BEACON_FRAME_SIZE bytes
+ * @param[in]   byte_order      Byte order of the frame bytes
+ * @param[out]  out             View of the frame bytes
+ *
+ * @return true if every section ID matches its FrameID, false otherwise
+ */
+bool beacon_frame_view_init(const uint8_t *frame_bytes, FrameByteOrder byte_order, BeaconFrameView *out);
+
+/**
+ * @brief Checks the seven section IDs of a packed frame, all of them at once and without reporting anything
+ *
+ * @param[in]   frame_bytes     Pointer to the first byte after the header, at least BEACON_FRAME_SIZE bytes
+ * @param[in]   byte_order      Byte order of the frame bytes
+ *
+ * @return true if every section ID matches its FrameID
+ */
+bool beacon_frame_ids_match(const uint8_t *frame_bytes, FrameByteOrder byte_order);
+
+/**
+ * @brief Describes the first section ID of a frame that doesn't match, for the caller that stops on it
+ *
+ *  The decoder prints nothing: the frames are decoded on several threads, and the robust and live modes
+ *  count the wrong ones instead. The caller reports the frame once, from a failed decode.
+ *
+ * @param[in]  frame        Frame of a failed decode (its section IDs are always decoded)
+ * @param[out] out          "WRONG <section> ID IN FRAME, read <id>, expected <id>", empty if every ID matches
+ * @param[in]  out_size     Size of out
+ *
+ * @return true if a section ID doesn't match
+ */
+bool describe_wrong_section_id(const BeaconFrame *frame, char *out, size_t out_size);
 
 /**
  * @brief Searchs for the header in the file and then reads a data frame element
  *
- *  When the header is found, reads a frame of data and returns a BeaconFrame struct with the raw values
+ *  When the header is found, reads a frame of data and returns a BeaconFrame struct with the raw values,
+ *  already in host byte order. The stream keeps no state, so the byte order is detected on every frame
  *
  * @param[in]   file        File pointer to the data
  * @param[in]   header      Constant structure that holds the beacon header ID to search for
@@ -179,4 +499,99 @@ ReadFileReturnType read_data_frame
     BeaconFrame *out
 );
 
+/**
+ * @brief Same as read_data_frame, decoding only the given sections (see decode_beacon_frame_sections)
+ *
+ * @param[in]   file        File pointer to the data
+ * @param[in]   header      Constant structure that holds the beacon header ID to search for
+ * @param[in]   sections    FrameSection bits of the sections to decode
+ * @param[out]  out         Pointer to the return structure holding the frame values
+ *
+ * @return Read file return state
+ */
+ReadFileReturnType read_data_frame_sections
+(
+    FILE *file,
+    const BeaconHeader header,
+    FrameSectionMask sections,
+    BeaconFrame *out
+);
+
+/**
+ * @brief Searchs for the header in a byte buffer and then decodes a data frame element
+ *
+ *  Same behaviour as read_data_frame, but the frame is decoded straight from memory
+ *  (e.g. a memory mapped file). Every field access is bounds checked against buffer_size.
+ *
+ * @param[in]       buffer          Pointer to the start of the data
+ * @param[in]       buffer_size     Size of the data in bytes
+ * @param[in,out]   position        Offset to start the search from. On READ_OK it is moved to the end of the frame,
+ *                                  on READ_FAIL right after the header that was found
+ * @param[in,out]   byte_order      Byte order of the buffer. If FRAME_BYTE_ORDER_UNKNOWN, it is detected from
+ *                                  the frame and kept for the next calls
+ * @param[in]       header          Constant structure that holds the beacon header ID to search for
+ * @param[out]      out             Pointer to the return structure holding the frame values
+ *
+ * @return Read file return state
+ *
+ */
+ReadFileReturnType read_data_frame_from_buffer
+(
+    const uint8_t *buffer,
+    size_t buffer_size,
+    size_t *position,
+    FrameByteOrder *byte_order,
+    const BeaconHeader header,
+    BeaconFrame *out
+);
+
+/**
+ * @brief Same as read_data_frame_from_buffer, but the frame is not decoded: out views it in the buffer
+ *        (see beacon_frame_view_init), and is valid while the buffer is
+ */
+ReadFileReturnType read_frame_view_from_buffer
+(
+    const uint8_t *buffer,
+    size_t buffer_size,
+    size_t *position,
+    FrameByteOrder *byte_order,
+    const BeaconHeader header,
+    BeaconFrameView *out
+);
+
+/**
+ * @brief Same as read_frame_view_from_buffer, but a wrong frame doesn't stop the read: it is counted in stats,
+ *        and the search goes on right after its header. Nothing is printed
+ *
+ *  A truncated frame at the end of the buffer is counted as well (and the offset of its header kept), and ends the read.
+ *
+ * @param[in,out]   stats       Counters to add to (see FrameIntegrityStats)
+ *
+ * @return READ_OK, or READ_EOF once the whole buffer was read
+ */
+ReadFileReturnType read_frame_view_from_buffer_robust
+(
+    const uint8_t *buffer,
+    size_t buffer_size,
+    size_t *position,
+    FrameByteOrder *byte_order,
+    const BeaconHeader header,
+    FrameIntegrityStats *stats,
+    BeaconFrameView *out
+);
+
+/**
+ * @brief Same as read_data_frame_from_buffer, decoding only the given sections (see decode_beacon_frame_sections)
+ */
+ReadFileReturnType read_data_frame_from_buffer_sections
+(
+    const uint8_t *buffer,
+    size_t buffer_size,
+    size_t *position,
+    FrameByteOrder *byte_order,
+    const BeaconHeader header,
+    FrameSectionMask sections,
+    BeaconFrame *out
+);
+
 #endif // BEACON_FRAME_SCHEMA_H
@@ -0,0 +1,200 @@
+/**
+ * @file beacon_reader_api.c
+ * @brief Implementation file of the beacon_reader_api header
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#include "beacon_reader_api.h"
+#include "arena.h"
+#include "dynamic_array.h"
+#include "frame_index.h"
+#include "mapped_frame_reader.h"
+#include "parallel_decode.h"
+#include "telemetry_store.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @struct BeaconReaderContext
+ * @brief  Options and memory of one caller of the library
+ */
+struct BEACON_READER_CONTEXT
+{
+    BeaconReaderOptions     options;
+    Arena                   arena;                  // columns of the last decode, reset by the next one
+    TelemetryStore          store;
+};
+
+//////////////////////////////////////////
+
+uint32_t beacon_reader_api_version(void)
+{
+    return BEACON_READER_API_VERSION;
+}
+
+//////////////////////////////////////////
+
+void beacon_reader_default_options(BeaconReaderOptions *options)
+{
+    if (!options) return;
+
+    memset(options, 0, sizeof *options);
+    options->thread_count = 0;
+    options->skip_wrong_frames = 0;
+    options->range_first_s = 0;
+    options->range_last_s = UINT32_MAX;
+    options->header[0] = 0xFF;
+    options->header[1] = 0xFF;
+    options->header[2] = 0xF0;
+}
+
+//////////////////////////////////////////
+
+BeaconReaderContext* beacon_reader_create(const BeaconReaderOptions *options)
+{
+    BeaconReaderContext *context = (BeaconReaderContext*)calloc(1, sizeof *context);
+    if (!context) return NULL;
+
+    if (options) context->options = *options;
+    else beacon_reader_default_options(&context->options);
+
+    arena_init(&context->arena, 0);
+    return context;
+}
+
+//////////////////////////////////////////
+
+void beacon_reader_destroy(BeaconReaderContext *context)
+{
+    if (!context) return;
+
+    arena_free(&context->arena);
+    free(context);
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, the columns of the store
+ */
+static void store_columns(const TelemetryStore *store, BeaconReaderColumns *columns)
+{
+    columns->length = store->thermal.length;
+    columns->rtc_s = store->thermal.timestamp;
+    columns->CPU_C = store->thermal.CPU_C;
+    columns->mirror_cell_C = store->thermal.mirror_cell_C;
+    columns->sun_vector_x = store->sun_sensors.sun_vector_x;
+    columns->sun_vector_y = store->sun_sensors.sun_vector_y;
+    columns->sun_vector_z = store->sun_sensors.sun_vector_z;
+}
+
+//////////////////////////////////////////
+
+BeaconReaderStatus beacon_reader_decode
+(
+    BeaconReaderContext *context,
+    const uint8_t *data,
+    size_t length,
+    BeaconReaderColumns *columns,
+    BeaconReaderStats *stats
+)
+{
+    if (!columns) return BEACON_READER_INVALID_ARGUMENT;
+    memset(columns, 0, sizeof *columns);
+    if (stats) memset(stats, 0, sizeof *stats);
+
+    MappedFrameFile file;
+    if (!context || !mapped_file_from_buffer(data, length, &file)) return BEACON_READER_INVALID_ARGUMENT;
+
+    const BeaconReaderOptions *options = &context->options;
+    const BeaconHeader header = { .beacon_id = { { options->header[0], options->header[1], options->header[2] } } };
+
+    // the columns of the previous decode are not valid anymore
+    arena_reset(&context->arena);
+    if (length == 0) return BEACON_READER_OK;       // no frames, empty columns
+
+    file.skip_wrong_frames = options->skip_wrong_frames != 0;
+
+    DynamicArray index;
+    size_t duplicates_dropped = 0;
+    const size_t thread_count = parallel_decode_thread_count(options->thread_count);
+
+    if (!dynamic_array_init(&index, sizeof(FrameIndexEntry), 0)) return BEACON_READER_OUT_OF_MEMORY;
+
+    // the first frame of each rtc_s is kept, as the in-memory mode does by default
+    ReadFileReturnType result = frame_index_build_sorted_parallel(&file, header, &index, thread_count, &duplicates_dropped);
+
+    // a pass usually ends in the middle of a frame: the frames before it are indexed again, without it
+    // (skip_wrong_frames counts it without failing)
+    if (result == READ_FAIL && !file.skip_wrong_frames &&
+        mapped_file_read_failure(&file, header) == READ_FAILURE_TRUNCATED_FRAME)
+    {
+        const size_t truncated_header = file.position - BEACON_HEADER_SIZE;
+        index.length = 0;
+        duplicates_dropped = 0;
+        mapped_file_from_buffer(data, truncated_header, &file);
+        result = frame_index_build_sorted_parallel(&file, header, &index, thread_count, &duplicates_dropped);
+        file.integrity.frames_truncated = 1;
+        file.integrity.bytes_skipped = length - truncated_header;
+    }
+
+    if (result == READ_FAIL)
+    {
+        const bool wrong_frame = !file.skip_wrong_frames && mapped_file_read_failure(&file, header) == READ_FAILURE_WRONG_FRAME;
+        dynamic_array_free(&index);
+        mapped_file_close(&file);
+        return wrong_frame ? BEACON_READER_WRONG_FRAME : BEACON_READER_OUT_OF_MEMORY;
+    }
+
+    if (stats)
+    {
+        stats->bytes_read = length;
+        stats->frames_read = index.length + duplicates_dropped;
+        stats->frames_unique = index.length;
+        stats->duplicates_dropped = duplicates_dropped;
+        stats->frames_wrong = file.integrity.frames_wrong;
+        stats->frames_truncated = file.integrity.frames_truncated;
+        stats->bytes_skipped = file.integrity.bytes_skipped;
+        stats->resyncs = file.integrity.resyncs;
+    }
+
+    if (options->range_first_s > 0 || options->range_last_s < UINT32_MAX)
+    {
+        frame_index_keep_range(&index, options->range_first_s, options->range_last_s);
+    }
+
+    BeaconReaderStatus status = BEACON_READER_OK;
+    if (!telemetry_store_init_arena(&context->store, index.length, &context->arena) ||
+        !telemetry_store_load_parallel(&context->store, &file, &index, thread_count))
+    {
+        status = BEACON_READER_OUT_OF_MEMORY;
+    }
+    else
+    {
+        store_columns(&context->store, columns);
+    }
+
+    dynamic_array_free(&index);
+    mapped_file_close(&file);
+    return status;
+}
+
+//////////////////////////////////////////
+
+const char* beacon_reader_status_text(BeaconReaderStatus status)
+{
+    switch (status)
+    {
+        case BEACON_READER_OK:                  return "ok";
+        case BEACON_READER_INVALID_ARGUMENT:    return "invalid argument";
+        case BEACON_READER_OUT_OF_MEMORY:       return "out of memory";
+        case BEACON_READER_WRONG_FRAME:         return "wrong frame";
+        case BEACON_READER_READ_FAIL:           return "read failed";
+    }
+    return "unknown status";
+}
@@ -0,0 +1,166 @@
+/**
+ * @file beacon_reader_api.h
+ * @brief Public header of libbeaconreader (Library target of the code::blocks project), the decoding of a
+ *        telemetry byte span into calibrated columns, for services that embed it instead of running BeaconReader
+ *
+ *  A BeaconReaderContext holds the options and the memory of one caller: the bytes given to
+ *  beacon_reader_decode are read in place (never copied), indexed by rtc_s, sorted and deduplicated as
+ *  in the in-memory mode, and calibrated into one column per field (structure of arrays). There is no
+ *  global state, so different contexts can decode at the same time on different threads. A context
+ *  is used by one thread at a time. The library writes nothing to the console, the calls return a status.
+ *
+ *  Only this header is needed by the callers, it depends on the C standard headers alone, and every
+ *  structure is made of fixed size fields (see beaconreader.py, the Python binding).
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#ifndef BEACON_READER_API_H_INCLUDED
+#define BEACON_READER_API_H_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// BEACON_READER_BUILD_LIBRARY is defined by the Library target only
+#if defined(_WIN32) && defined(BEACON_READER_BUILD_LIBRARY)
+#define BEACON_READER_API __declspec(dllexport)
+#elif defined(_WIN32) && defined(BEACON_READER_USE_LIBRARY)
+#define BEACON_READER_API __declspec(dllimport)
+#elif defined(__GNUC__)
+#define BEACON_READER_API __attribute__((visibility("default")))
+#else
+#define BEACON_READER_API
+#endif
+
+// changed when a structure or a function of this header changes
+#define BEACON_READER_API_VERSION 3          // 2: BEACON_READER_READ_FAIL, 3: a truncated last frame is not an error
+
+/**
+    @enum result of the calls of the library
+**/
+typedef enum
+{
+    BEACON_READER_OK = 0,
+    BEACON_READER_INVALID_ARGUMENT = 1,
+    BEACON_READER_OUT_OF_MEMORY = 2,
+    BEACON_READER_WRONG_FRAME = 3,          // a frame with a wrong section ID, without skip_wrong_frames
+    BEACON_READER_READ_FAIL = 4             // not returned since version 3, the failures of the index are told apart
+} BeaconReaderStatus;
+
+/**
+ * @struct BeaconReaderOptions
+ * @brief  Options of a context, see beacon_reader_default_options
+ */
+typedef struct BEACON_READER_OPTIONS
+{
+    uint32_t    thread_count;               // 0 for one per online processor, 1 to decode on the calling thread
+    uint32_t    skip_wrong_frames;          // 1 to skip the frames with a wrong section ID instead of failing
+    uint32_t    range_first_s;              // only the frames of [range_first_s, range_last_s]
+    uint32_t    range_last_s;
+    uint8_t     header[3];                  // beacon ID before each frame
+    uint8_t     reserved;
+} BeaconReaderOptions;
+
+/**
+ * @struct BeaconReaderStats
+ * @brief  Counters of the last decode
+ */
+typedef struct BEACON_READER_STATS
+{
+    uint64_t    bytes_read;
+    uint64_t    frames_read;                // valid frames, duplicates included
+    uint64_t    frames_unique;              // rows of the columns, before the time range
+    uint64_t    duplicates_dropped;         // frames with an rtc_s already read
+    uint64_t    frames_wrong;               // skipped with skip_wrong_frames
+    uint64_t    frames_truncated;           // a frame cut by the end of the span, its bytes are in bytes_skipped
+    uint64_t    bytes_skipped;
+    uint64_t    resyncs;
+} BeaconReaderStats;
+
+/**
+ * @struct BeaconReaderColumns
+ * @brief  Calibrated columns of the last decode, one row per unique frame sorted by rtc_s
+ *
+ * @note The columns belong to the context, valid until its next decode or beacon_reader_destroy
+ */
+typedef struct BEACON_READER_COLUMNS
+{
+    uint64_t        length;                 // rows of every column
+    const uint32_t *rtc_s;
+    const float    *CPU_C;                  // [C]
+    const float    *mirror_cell_C;          // [C]
+    const float    *sun_vector_x;
+    const float    *sun_vector_y;
+    const float    *sun_vector_z;
+} BeaconReaderColumns;
+
+typedef struct BEACON_READER_CONTEXT BeaconReaderContext;
+
+/**
+ * @brief BEACON_READER_API_VERSION of the library, to check it against the header of the caller
+ */
+BEACON_READER_API uint32_t beacon_reader_api_version(void);
+
+/**
+ * @brief Default options: one thread per processor, stop at the first wrong frame, every rtc_s, header FF FF F0
+ *
+ * @param[out] options  Options to initialize
+ */
+BEACON_READER_API void beacon_reader_default_options(BeaconReaderOptions *options);
+
+/**
+ * @brief Creates a context
+ *
+ * @param[in] options   Options of the context (copied), NULL for the defaults
+ *
+ * @return the context, NULL if the memory could not be allocated
+ */
+BEACON_READER_API BeaconReaderContext* beacon_reader_create(const BeaconReaderOptions *options);
+
+/**
+ * @brief Releases a context and its columns
+ *
+ * @param[in] context   Context to release, NULL does nothing
+ */
+BEACON_READER_API void beacon_reader_destroy(BeaconReaderContext *context);
+
+/**
+ * @brief Decodes and calibrates the frames of a byte span, e.g. a whole telemetry file or a received pass
+ *
+ * @param[in,out] context   Context of the caller, the columns of its previous decode are released
+ * @param[in]     data      Telemetry bytes, only read during the call
+ * @param[in]     length    Number of bytes
+ * @param[out]    columns   Calibrated columns, empty on error
+ * @param[out]    stats     Optional, counters of the decode
+ *
+ * @return BEACON_READER_OK, or the error: BEACON_READER_WRONG_FRAME for a wrong section ID without
+ *         skip_wrong_frames, BEACON_READER_OUT_OF_MEMORY if the frames could not be indexed or calibrated
+ *
+ * @note A last frame cut by the end of the span (a pass still arriving) is not an error: the frames
+ *       before it are decoded, and it is counted in stats->frames_truncated
+ */
+BEACON_READER_API BeaconReaderStatus beacon_reader_decode
+(
+    BeaconReaderContext *context,
+    const uint8_t *data,
+    size_t length,
+    BeaconReaderColumns *columns,
+    BeaconReaderStats *stats
+);
+
+/**
+ * @brief Text of a status, for the logs of the caller
+ */
+BEACON_READER_API const char* beacon_reader_status_text(BeaconReaderStatus status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BEACON_READER_API_H
@@ -0,0 +1,218 @@
+#!/usr/bin/env python3
+"""Python binding of libbeaconreader (beacon_reader_api.h), through ctypes
+
+The telemetry bytes are given as bytes or any writable buffer (bytearray, mmap, numpy array...) and
+read in place by the library. The calibrated columns come back as read only memoryviews over the memory
+of the context (numpy.asarray wraps them without a copy), so nothing is copied either way. A view keeps
+the memory of its decode alive, after close() too: a decode while the views of the previous one are still
+referenced gets a new context instead of reusing it. A Decoder is used by one thread at a time, use one
+per thread.
+
+    with Decoder(threads=4) as decoder:
+        columns, stats = decoder.decode(open("TITAraw_tlmy.bin", "rb").read())
+        print(numpy.asarray(columns["CPU_C"]).mean(), stats["frames_unique"])
+
+The library is searched in BEACONREADER_LIBRARY, then in bin/Library next to this file.
+"""
+import ctypes
+import os
+import sys
+import weakref
+
+API_VERSION = 3
+
+STATUS_TEXT = {0: "ok", 1: "invalid argument", 2: "out of memory", 3: "wrong frame", 4: "read failed"}
+
+FLOAT_COLUMNS = ("CPU_C", "mirror_cell_C", "sun_vector_x", "sun_vector_y", "sun_vector_z")
+
+
+class Options(ctypes.Structure):
+    _fields_ = [
+        ("thread_count", ctypes.c_uint32),
+        ("skip_wrong_frames", ctypes.c_uint32),
+        ("range_first_s", ctypes.c_uint32),
+        ("range_last_s", ctypes.c_uint32),
+        ("header", ctypes.c_uint8 * 3),
+        ("reserved", ctypes.c_uint8),
+    ]
+
+
+class Stats(ctypes.Structure):
+    _fields_ = [(name, ctypes.c_uint64) for name in (
+        "bytes_read", "frames_read", "frames_unique", "duplicates_dropped",
+        "frames_wrong", "frames_truncated", "bytes_skipped", "resyncs")]
+
+
+class Columns(ctypes.Structure):
+    _fields_ = [("length", ctypes.c_uint64), ("rtc_s", ctypes.POINTER(ctypes.c_uint32))] + \
+               [(name, ctypes.POINTER(ctypes.c_float)) for name in FLOAT_COLUMNS]
+
+
+class BeaconReaderError(RuntimeError):
+    pass
+
+
+def _library_candidates():
+    if os.environ.get("BEACONREADER_LIBRARY"):
+        yield os.environ["BEACONREADER_LIBRARY"]
+    folder = os.path.join(os.path.dirname(os.path.abspath(__file__)), "bin", "Library")
+    if sys.platform == "win32":
+        names = ("beaconreader.dll", "libbeaconreader.dll")
+    elif sys.platform == "darwin":
+        names = ("libbeaconreader.dylib",)
+    else:
+        names = ("libbeaconreader.so",)
+    for name in names:
+        yield os.path.join(folder, name)
+
+
+def load_library():
+    """Loads libbeaconreader and declares its functions"""
+    errors = []
+    for path in _library_candidates():
+        try:
+            library = ctypes.CDLL(path)
+            break
+        except OSError as error:
+            errors.append(str(error))
+    else:
+        raise BeaconReaderError("libbeaconreader not found: " + "; ".join(errors))
+
+    library.beacon_reader_api_version.restype = ctypes.c_uint32
+    library.beacon_reader_api_version.argtypes = []
+    library.beacon_reader_default_options.restype = None
+    library.beacon_reader_default_options.argtypes = [ctypes.POINTER(Options)]
+    library.beacon_reader_create.restype = ctypes.c_void_p
+    library.beacon_reader_create.argtypes = [ctypes.POINTER(Options)]
+    library.beacon_reader_destroy.restype = None
+    library.beacon_reader_destroy.argtypes = [ctypes.c_void_p]
+    library.beacon_reader_decode.restype = ctypes.c_int
+    library.beacon_reader_decode.argtypes = [ctypes.c_void_p, ctypes.c_void_p, ctypes.c_size_t,
+                                             ctypes.POINTER(Columns), ctypes.POINTER(Stats)]
+
+    version = library.beacon_reader_api_version()
+    if version != API_VERSION:
+        raise BeaconReaderError(f"libbeaconreader API version {version}, this binding expects {API_VERSION}")
+    return library
+
+
+_library = None
+
+
+def _get_library():
+    global _library
+    if _library is None:
+        _library = load_library()
+    return _library
+
+
+class _Context:
+    """A BeaconReaderContext, destroyed when neither its Decoder nor the views of its columns refer to it"""
+
+    def __init__(self, library, options):
+        self._library = library
+        self.handle = library.beacon_reader_create(ctypes.byref(options))
+        if not self.handle:
+            raise MemoryError("beacon_reader_create")
+        self.views = []                 # weak references to the arrays of the last decode
+
+    def in_use(self):
+        return any(view() is not None for view in self.views)
+
+    def __del__(self):
+        if self.handle:
+            self._library.beacon_reader_destroy(self.handle)
+            self.handle = None
+
+
+class Decoder:
+    """A context of the library: its options, and the memory of the columns of the last decode"""
+
+    def __init__(self, threads=0, skip_wrong_frames=False, range_first_s=0, range_last_s=0xFFFFFFFF):
+        self._library = _get_library()
+        self._options = Options()
+        self._library.beacon_reader_default_options(ctypes.byref(self._options))
+        self._options.thread_count = threads
+        self._options.skip_wrong_frames = 1 if skip_wrong_frames else 0
+        self._options.range_first_s = range_first_s
+        self._options.range_last_s = range_last_s
+        self._closed = False
+        self._context = _Context(self._library, self._options)
+
+    def close(self):
+        # the views still referenced keep the context, it is destroyed with the last one
+        self._closed = True
+        self._context = None
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
+
+    def __del__(self):
+        self.close()
+
+    def decode(self, data):
+        """Returns ({column name: memoryview}, {counter: int}) for the telemetry bytes of data"""
+        if self._closed:
+            raise BeaconReaderError("the decoder is closed")
+
+        address, length = _buffer_address(data)
+        # the decode releases the columns of the previous one, they can't be released under their views
+        if self._context.in_use():
+            self._context = _Context(self._library, self._options)
+        context = self._context
+        context.views = []
+
+        columns = Columns()
+        stats = Stats()
+        status = self._library.beacon_reader_decode(context.handle, address, length,
+                                                    ctypes.byref(columns), ctypes.byref(stats))
+        if status != 0:
+            raise BeaconReaderError(STATUS_TEXT.get(status, f"status {status}"))
+
+        result = {"rtc_s": _column_view(context, columns.rtc_s, columns.length, ctypes.c_uint32, "I")}
+        for name in FLOAT_COLUMNS:
+            result[name] = _column_view(context, getattr(columns, name), columns.length, ctypes.c_float, "f")
+        return result, {name: getattr(stats, name) for name, _ in Stats._fields_}
+
+
+def _buffer_address(data):
+    """Address and size in bytes of the memory of a buffer, without copying it"""
+    if isinstance(data, bytes):
+        # c_char_p points to the bytes object itself
+        return ctypes.cast(ctypes.c_char_p(data), ctypes.c_void_p).value, len(data)
+
+    view = memoryview(data)
+    if not view.c_contiguous:
+        raise BeaconReaderError("the telemetry buffer must be contiguous")
+    if view.readonly:
+        raise BeaconReaderError("read only buffers other than bytes can't be read in place, give bytes(data)")
+    if view.nbytes == 0:
+        return None, 0
+    return ctypes.addressof(ctypes.c_char.from_buffer(view.cast("B"))), view.nbytes
+
+
+def _column_view(context, pointer, length, value_type, view_format):
+    # ctypes exports "<f"; a native format ("f", "I") makes the views indexable, numpy reads both
+    values = (value_type * length).from_address(ctypes.addressof(pointer.contents)) if length else (value_type * 0)()
+    # the memoryview refers to the array, and the array to the context of its memory
+    values._owner = context
+    context.views.append(weakref.ref(values))
+    return memoryview(values).cast("B").cast(view_format).toreadonly()
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 2:
+        print(f"usage: {sys.argv[0]} TELEMETRY_FILE")
+        sys.exit(1)
+
+    with open(sys.argv[1], "rb") as f:
+        telemetry = f.read()
+    with Decoder() as decoder:
+        columns, stats = decoder.decode(telemetry)
+        print(stats)
+        for name, values in columns.items():
+            if len(values):
+                print(f"{name:14s} rows={len(values)} min={min(values)} max={max(values)}")
@@ -0,0 +1,1086 @@
+/**
+ * @file benchmark.c
+ * @brief Entry point of the BeaconReader benchmarks (Benchmark target of the code::blocks project)
+ *
+ *  Every benchmark builds its own synthetic input, so it can run without any telemetry file.
+ *  Each one reports frames/s (or the records and values standing for them) and MB/s, to track them over time.
+ *  Usage: BeaconReaderBenchmark [benchmark_name [arguments]]   (no name runs all of them)
+ *         BeaconReaderBenchmark sort [max_records]            (default 10^7, up to 10^8 and beyond)
+ *         BeaconReaderBenchmark file_pipeline [frames [out_of_order [duplicates [corruption]]]]
+ *         BeaconReaderBenchmark index_sidecar [frames]       (also checks an append after a truncated last frame)
+ *         BeaconReaderBenchmark generate FILE [frames [out_of_order [duplicates [corruption [max_gap_bytes]]]]]
+ *                                                             (only writes a synthetic file, see synthetic_telemetry.h)
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#include "beacon_frame_schema.h"
+#include "calibration_engine.h"
+#include "csv_tool.h"
+#include "dynamic_array.h"
+#include "extended_tools.h"
+#include "frame_index.h"
+#include "header_scanner.h"
+#include "index_sidecar.h"
+#include "mapped_frame_reader.h"
+#include "parallel_decode.h"
+#include "run_merge.h"
+#include "synthetic_telemetry.h"
+#include "thermal_calibrated.h"
+#include "timestamp_sort.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#define HEADER_SCAN_BUFFER_SIZE (64u << 20)     // bytes of synthetic noise
+#define HEADER_SCAN_FRAME_SPACING (64u << 10)   // average distance between two valid frames
+#define HEADER_SCAN_REPETITIONS 5
+
+#define FRAME_DECODE_FRAME_COUNT (1u << 18)     // frames decoded per repetition
+#define FRAME_DECODE_REPETITIONS 5
+
+#define SORT_MIN_RECORDS 10000
+#define SORT_DEFAULT_MAX_RECORDS 10000000
+#define SORT_REORDER_DISTANCE 64                // nearly sorted input: elements moved at most this far
+
+#define MERGE_RECORD_COUNT 10000000              // nearly sorted records, split in runs as the decoding threads do
+#define MERGE_MAX_RUNS 16
+
+#define CSV_FORMAT_RECORD_COUNT (1u << 20)      // thermal lines formatted and written per repetition
+#define CSV_FORMAT_REPETITIONS 5
+#define CSV_FORMAT_FILENAME "benchmark_thermal_data.csv"
+
+#define CALIBRATE_VALUE_COUNT (1u << 22)        // raw int16_t values calibrated per repetition
+#define CALIBRATE_REPETITIONS 5
+
+#define FILE_PIPELINE_FRAME_COUNT (1u << 20)    // frames of the synthetic file, about 150 MB with the gaps
+#define FILE_PIPELINE_OUT_OF_ORDER_RATE 0.05
+#define FILE_PIPELINE_DUPLICATE_RATE 0.05
+#define FILE_PIPELINE_CORRUPTION_RATE 0.001
+#define FILE_PIPELINE_REPETITIONS 3
+#define FILE_PIPELINE_FILENAME "benchmark_synthetic_tlmy.bin"
+#define FILE_PIPELINE_CSV_FILENAME "benchmark_calibrated_fields.csv"
+
+#define INDEX_SIDECAR_FRAME_COUNT (1u << 20)    // frames of the synthetic file, with the rates of file_pipeline
+#define INDEX_SIDECAR_CUT_BYTES 50              // bytes of the last frame written before the append
+#define INDEX_SIDECAR_REPETITIONS 3
+#define INDEX_SIDECAR_FILENAME "benchmark_sidecar_tlmy.bin"
+
+#define GENERATE_COMMAND "generate"             // not a benchmark, never run with the others
+
+/**
+ * @struct BenchmarkEntry
+ * @brief  Name and function of one benchmark
+ */
+typedef struct BENCHMARK_ENTRY
+{
+    const char *name;
+    void (*run)(int argc, char *argv[]);            // arguments following the benchmark name
+} BenchmarkEntry;
+
+//////////////////////////////////////////
+
+/**
+ * @brief monotonic clock in seconds
+ */
+static double benchmark_now_seconds(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+#endif
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief xorshift generator, the benchmarks only need fast and repeatable noise
+ */
+static uint32_t benchmark_random(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return (uint32_t)(*state >> 32);
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Prints the throughput of a benchmark row
+ *
+ * @param[in] label     name of the row
+ * @param[in] frames    frames (or records, values) processed
+ * @param[in] bytes     bytes processed
+ * @param[in] seconds   best time of the row
+ */
+static void print_rates(const char *label, double frames, double bytes, double seconds)
+{
+    printf("[BENCH]   %-30s %10.3f Mframes/s %10.1f MB/s\n", label, frames / seconds * 1e-6, bytes / seconds * 1e-6);
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Fills a buffer with noise, and drops a header plus a frame with valid section IDs at random places
+ *
+ * @param[out] buffer           buffer to fill
+ * @param[in]  size             size of the buffer
+ * @param[in]  header           header to insert
+ * @param[in]  ff_burst_noise   if true, the noise is long runs of 0xFF (worst case for the first byte compare)
+ *
+ * @return number of frames inserted
+ */
+static size_t fill_noise_with_frames(uint8_t *buffer, size_t size, const BeaconHeader header, bool ff_burst_noise)
+{
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        uint8_t noise = (uint8_t)benchmark_random(&state);
+        // bursts of 0xFF broken by a few random bytes, never forming a full header
+        if (ff_burst_noise && (noise & 0x0F)) noise = 0xFF;
+        else if (ff_burst_noise && noise == header.beacon_id.b[2]) noise = 0x00;
+        buffer[i] = noise;
+    }
+
+    static const uint16_t section_ids[] = { PLATFORM_ID, MEMORY_ID, CDH_ID, POWER_ID, THERMAL_ID, AOCS_ID, PAYLOAD_ID };
+    static const size_t section_offsets[] =
+    {
+        OFFSET_PLATFORM_TELEMETRY_ID, OFFSET_MEMORY_TELEMETRY_ID, OFFSET_CDH_ID, OFFSET_POWER_TELEMETRY_ID,
+        OFFSET_THERMAL_TELEMETRY_ID, OFFSET_AOCS_TELEMETRY_ID, OFFSET_PAYLOAD_TELEMETRY_ID
+    };
+
+    size_t frames = 0;
+    for (size_t offset = benchmark_random(&state) % HEADER_SCAN_FRAME_SPACING;
+         offset + BEACON_HEADER_SIZE + BEACON_FRAME_SIZE <= size;
+         offset += HEADER_SCAN_FRAME_SPACING / 2 + benchmark_random(&state) % HEADER_SCAN_FRAME_SPACING)
+    {
+        memcpy(buffer + offset, header.beacon_id.b, BEACON_HEADER_SIZE);
+        uint8_t *frame = buffer + offset + BEACON_HEADER_SIZE;
+        for (size_t s = 0; s < sizeof section_ids / sizeof section_ids[0]; ++s)
+        {
+            frame[section_offsets[s]]     = (uint8_t)(section_ids[s] >> 8);
+            frame[section_offsets[s] + 1] = (uint8_t)(section_ids[s] & 0xFF);
+        }
+        ++frames;
+    }
+    return frames;
+}
+
+//////////////////////////////////////////
+
+static void benchmark_header_scan(int argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+    const BeaconHeader header = { .beacon_id = { {0xFF,0xFF,0xF0} } };
+    static const HeaderScanImplementation implementations[] =
+    {
+        HEADER_SCAN_SCALAR, HEADER_SCAN_SSE2, HEADER_SCAN_AVX2, HEADER_SCAN_NEON
+    };
+
+    uint8_t *buffer = (uint8_t*)malloc(HEADER_SCAN_BUFFER_SIZE);
+    if (!buffer)
+    {
+        perror("malloc");
+        return;
+    }
+
+    for (int noise_type = 0; noise_type < 2; ++noise_type)
+    {
+        const bool ff_burst_noise = noise_type == 1;
+        size_t inserted = fill_noise_with_frames(buffer, HEADER_SCAN_BUFFER_SIZE, header, ff_burst_noise);
+        printf("[BENCH] header_scan %s noise, %u MB, %zu frames inserted\n",
+               ff_burst_noise ? "0xFF burst" : "uniform", HEADER_SCAN_BUFFER_SIZE >> 20, inserted);
+
+        for (size_t i = 0; i < sizeof implementations / sizeof implementations[0]; ++i)
+        {
+            if (!header_scanner_select(implementations[i])) continue;
+
+            size_t matches = 0;
+            double best_seconds = 1e30;
+            for (int repetition = 0; repetition < HEADER_SCAN_REPETITIONS; ++repetition)
+            {
+                matches = 0;
+                double start = benchmark_now_seconds();
+                size_t position = 0;
+                for (;;)
+                {
+                    size_t found = position + find_beacon_header(buffer + position, HEADER_SCAN_BUFFER_SIZE - position, header);
+                    if (found >= HEADER_SCAN_BUFFER_SIZE) break;
+                    ++matches;
+                    position = found + 1;
+                }
+                double elapsed = benchmark_now_seconds() - start;
+                if (elapsed < best_seconds) best_seconds = elapsed;
+            }
+
+            char label[64];
+            snprintf(label, sizeof label, "%s (%zu matches)", header_scanner_name(), matches);
+            print_rates(label, (double)matches, (double)HEADER_SCAN_BUFFER_SIZE, best_seconds);
+        }
+    }
+
+    header_scanner_select(HEADER_SCAN_AUTO);
+    free(buffer);
+}
+
+//////////////////////////////////////////
+
+static void benchmark_frame_decode(int argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+    const BeaconHeader header = { .beacon_id = { {0xFF,0xFF,0xF0} } };
+    const size_t stride = BEACON_HEADER_SIZE + BEACON_FRAME_SIZE;
+    const size_t size = (size_t)FRAME_DECODE_FRAME_COUNT * stride;
+
+    uint8_t *buffer = (uint8_t*)malloc(size);
+    if (!buffer)
+    {
+        perror("malloc");
+        return;
+    }
+
+    // back to back frames, with valid section IDs and random field values
+    uint64_t state = 0x2545F4914F6CDD1Dull;
+    static const uint16_t section_ids[] = { PLATFORM_ID, MEMORY_ID, CDH_ID, POWER_ID, THERMAL_ID, AOCS_ID, PAYLOAD_ID };
+    static const size_t section_offsets[] =
+    {
+        OFFSET_PLATFORM_TELEMETRY_ID, OFFSET_MEMORY_TELEMETRY_ID, OFFSET_CDH_ID, OFFSET_POWER_TELEMETRY_ID,
+        OFFSET_THERMAL_TELEMETRY_ID, OFFSET_AOCS_TELEMETRY_ID, OFFSET_PAYLOAD_TELEMETRY_ID
+    };
+    for (size_t i = 0; i < size; ++i) buffer[i] = (uint8_t)benchmark_random(&state);
+    for (size_t f = 0; f < FRAME_DECODE_FRAME_COUNT; ++f)
+    {
+        uint8_t *frame = buffer + f * stride;
+        memcpy(frame, header.beacon_id.b, BEACON_HEADER_SIZE);
+        for (size_t s = 0; s < sizeof section_ids / sizeof section_ids[0]; ++s)
+        {
+            frame[BEACON_HEADER_SIZE + section_offsets[s]]     = (uint8_t)(section_ids[s] >> 8);
+            frame[BEACON_HEADER_SIZE + section_offsets[s] + 1] = (uint8_t)(section_ids[s] & 0xFF);
+        }
+    }
+
+    double best_decode = 1e30, best_projection = 1e30, best_view = 1e30, best_read = 1e30;
+    uint32_t checksum = 0;
+    BeaconFrame frame;
+    BeaconFrameView view;
+    for (int repetition = 0; repetition < FRAME_DECODE_REPETITIONS; ++repetition)
+    {
+        // decoder alone, frames already located
+        double start = benchmark_now_seconds();
+        for (size_t f = 0; f < FRAME_DECODE_FRAME_COUNT; ++f)
+        {
+            if (decode_beacon_frame(buffer + f * stride + BEACON_HEADER_SIZE, FRAME_BYTE_ORDER_BIG_ENDIAN, &frame)) checksum += frame.platform.rtc_s;
+        }
+        double elapsed = benchmark_now_seconds() - start;
+        if (elapsed < best_decode) best_decode = elapsed;
+
+        // projection of a thermal only export
+        start = benchmark_now_seconds();
+        for (size_t f = 0; f < FRAME_DECODE_FRAME_COUNT; ++f)
+        {
+            if (decode_beacon_frame_sections(buffer + f * stride + BEACON_HEADER_SIZE, FRAME_BYTE_ORDER_BIG_ENDIAN,
+                                             FRAME_SECTION_THERMAL, &frame))
+            {
+                checksum += frame.platform.rtc_s;
+            }
+        }
+        elapsed = benchmark_now_seconds() - start;
+        if (elapsed < best_projection) best_projection = elapsed;
+
+        // the same thermal fields, read in place from a view
+        start = benchmark_now_seconds();
+        for (size_t f = 0; f < FRAME_DECODE_FRAME_COUNT; ++f)
+        {
+            if (beacon_frame_view_init(buffer + f * stride + BEACON_HEADER_SIZE, FRAME_BYTE_ORDER_BIG_ENDIAN, &view))
+            {
+                checksum += beacon_frame_view_rtc_s(&view) + (uint32_t)beacon_frame_view_CPU_C(&view) +
+                            (uint32_t)beacon_frame_view_mirror_cell_C(&view);
+            }
+        }
+        elapsed = benchmark_now_seconds() - start;
+        if (elapsed < best_view) best_view = elapsed;
+
+        // header search plus decoder, as the mapped reader does
+        start = benchmark_now_seconds();
+        size_t position = 0;
+        FrameByteOrder byte_order = FRAME_BYTE_ORDER_UNKNOWN;
+        while (read_data_frame_from_buffer(buffer, size, &position, &byte_order, header, &frame) == READ_OK) checksum += frame.platform.rtc_s;
+        elapsed = benchmark_now_seconds() - start;
+        if (elapsed < best_read) best_read = elapsed;
+    }
+
+    printf("[BENCH] frame_decode %u frames (checksum %08x)\n", FRAME_DECODE_FRAME_COUNT, checksum);
+    const double frame_bytes = (double)FRAME_DECODE_FRAME_COUNT * BEACON_FRAME_SIZE;
+    print_rates("decode_beacon_frame", FRAME_DECODE_FRAME_COUNT, frame_bytes, best_decode);
+    print_rates("decode_beacon_frame_sections", FRAME_DECODE_FRAME_COUNT, frame_bytes, best_projection);
+    print_rates("beacon_frame_view_init", FRAME_DECODE_FRAME_COUNT, frame_bytes, best_view);
+    print_rates("read_data_frame_from_buffer", FRAME_DECODE_FRAME_COUNT, (double)size, best_read);
+    printf("[BENCH]   (sections: THERMAL only, view: THERMAL fields read)\n");
+
+    free(buffer);
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Fills thermal records with timestamps as they arrive from the ground stations:
+ *        increasing, but locally shuffled, with a fraction of repeated frames
+ *
+ * @param[in] nearly_sorted     if false, timestamps are uniformly random over a pass-like range instead
+ */
+static void fill_sort_records(ThermalTelemetryCalibrated *records, size_t n, bool nearly_sorted, uint64_t *state)
+{
+    uint32_t timestamp = 1542716400u;
+    for (size_t i = 0; i < n; ++i)
+    {
+        // about one in four frames is a repetition of the previous one
+        if (i == 0 || (benchmark_random(state) & 3) != 0) timestamp += 1 + benchmark_random(state) % 30;
+        records[i].thermal_telemetry_timestamp = nearly_sorted ? timestamp : 1542716400u + benchmark_random(state) % (uint32_t)(n * 8);
+        records[i].CPU_C = (float)i;
+        records[i].mirror_cell_C = 0.0f;
+    }
+
+    if (!nearly_sorted) return;
+    for (size_t i = 0; i + SORT_REORDER_DISTANCE < n; i += 1 + benchmark_random(state) % SORT_REORDER_DISTANCE)
+    {
+        size_t j = i + 1 + benchmark_random(state) % SORT_REORDER_DISTANCE;
+        ThermalTelemetryCalibrated temp = records[i];
+        records[i] = records[j];
+        records[j] = temp;
+    }
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief true if the records are strictly increasing in timestamp
+ */
+static bool records_strictly_sorted(const ThermalTelemetryCalibrated *records, size_t n)
+{
+    for (size_t i = 1; i < n; ++i)
+    {
+        if (records[i].thermal_telemetry_timestamp <= records[i - 1].thermal_telemetry_timestamp) return false;
+    }
+    return true;
+}
+
+//////////////////////////////////////////
+
+static void benchmark_sort(int argc, char *argv[])
+{
+    size_t max_records = argc > 0 ? (size_t)strtoull(argv[0], NULL, 10) : SORT_DEFAULT_MAX_RECORDS;
+    if (max_records < SORT_MIN_RECORDS) max_records = SORT_MIN_RECORDS;
+
+    ThermalTelemetryCalibrated *input = (ThermalTelemetryCalibrated*)malloc(max_records * sizeof *input);
+    ThermalTelemetryCalibrated *work = (ThermalTelemetryCalibrated*)malloc(max_records * sizeof *work);
+    if (!input || !work)
+    {
+        perror("malloc");
+        free(input);
+        free(work);
+        return;
+    }
+
+    printf("[BENCH] sort + deduplication of ThermalTelemetryCalibrated (one record per frame), Mframes/s\n");
+    printf("[BENCH]   %-14s %12s %12s %12s %12s %10s\n", "input", "records", "qsort", "timestamp", "timestamp MB/s", "speedup");
+
+    for (int nearly_sorted = 1; nearly_sorted >= 0; --nearly_sorted)
+    {
+        for (size_t n = SORT_MIN_RECORDS; n <= max_records; n *= 10)
+        {
+            uint64_t state = 0xD1B54A32D192ED03ull;
+            fill_sort_records(input, n, nearly_sorted, &state);
+
+            memcpy(work, input, n * sizeof *work);
+            double start = benchmark_now_seconds();
+            qsort(work, n, sizeof *work, thermal_timestamp_comparator);
+            size_t qsort_length = array_duplicate_removal(work, n, sizeof *work, thermal_timestamp_comparator);
+            double qsort_seconds = benchmark_now_seconds() - start;
+
+            memcpy(work, input, n * sizeof *work);
+            size_t sorted_length = n;
+            start = benchmark_now_seconds();
+            bool sorted = timestamp_sort_deduplicate(work, &sorted_length, sizeof *work,
+                                                     offsetof(ThermalTelemetryCalibrated, thermal_telemetry_timestamp));
+            double sort_seconds = benchmark_now_seconds() - start;
+
+            if (!sorted || sorted_length != qsort_length || !records_strictly_sorted(work, sorted_length))
+            {
+                fprintf(stderr, "[BENCH] sort mismatch at %zu records\n", n);
+                break;
+            }
+
+            printf("[BENCH]   %-14s %12zu %12.1f %12.1f %14.1f %9.1fx\n",
+                   nearly_sorted ? "nearly sorted" : "random", n,
+                   (double)n / qsort_seconds * 1e-6, (double)n / sort_seconds * 1e-6,
+                   (double)(n * sizeof *work) / sort_seconds * 1e-6, qsort_seconds / sort_seconds);
+
+            if (n > max_records / 10) break;
+        }
+    }
+
+    free(input);
+    free(work);
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Sort of the whole array vs sort of each run and k-way merge, both removing the duplicates
+ */
+static void benchmark_merge(int argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+
+    const size_t n = MERGE_RECORD_COUNT;
+    const size_t key_offset = offsetof(ThermalTelemetryCalibrated, thermal_telemetry_timestamp);
+    ThermalTelemetryCalibrated *input = (ThermalTelemetryCalibrated*)malloc(n * sizeof *input);
+    ThermalTelemetryCalibrated *work = (ThermalTelemetryCalibrated*)malloc(n * sizeof *work);
+    ThermalTelemetryCalibrated *merged = (ThermalTelemetryCalibrated*)malloc(n * sizeof *merged);
+    if (!input || !work || !merged)
+    {
+        perror("malloc");
+        free(input);
+        free(work);
+        free(merged);
+        return;
+    }
+
+    uint64_t state = 0xD1B54A32D192ED03ull;
+    fill_sort_records(input, n, true, &state);
+
+    memcpy(work, input, n * sizeof *work);
+    size_t sorted_length = n;
+    double start = benchmark_now_seconds();
+    timestamp_sort_deduplicate(work, &sorted_length, sizeof *work, key_offset);
+    double sort_seconds = benchmark_now_seconds() - start;
+
+    printf("[BENCH] sort of %zu nearly sorted records vs sort per run + merge, Mframes/s\n", n);
+    printf("[BENCH]   %-14s %12s %12s %12s %14s\n", "runs", "sort", "merge", "parallel", "parallel MB/s");
+
+    for (size_t run_count = 2; run_count <= MERGE_MAX_RUNS; run_count *= 2)
+    {
+        SortedRun runs[MERGE_MAX_RUNS];
+
+        memcpy(work, input, n * sizeof *work);
+        for (size_t r = 0; r < run_count; ++r)
+        {
+            size_t first = n / run_count * r;
+            size_t length = (r + 1 == run_count ? n : n / run_count * (r + 1)) - first;
+            timestamp_sort_deduplicate(work + first, &length, sizeof *work, key_offset);
+            runs[r].data = work + first;
+            runs[r].length = length;
+        }
+
+        start = benchmark_now_seconds();
+        size_t merged_length = run_merge_deduplicate(runs, run_count, sizeof *work, key_offset, merged);
+        double merge_seconds = benchmark_now_seconds() - start;
+
+        start = benchmark_now_seconds();
+        size_t parallel_length = run_merge_deduplicate_parallel(runs, run_count, sizeof *work, key_offset, merged, run_count);
+        double parallel_seconds = benchmark_now_seconds() - start;
+
+        if (merged_length != sorted_length || parallel_length != sorted_length || !records_strictly_sorted(merged, parallel_length))
+        {
+            fprintf(stderr, "[BENCH] merge mismatch with %zu runs\n", run_count);
+            break;
+        }
+
+        printf("[BENCH]   %-14zu %12.1f %12.1f %12.1f %14.1f\n", run_count,
+               (double)n / sort_seconds * 1e-6, (double)n / merge_seconds * 1e-6, (double)n / parallel_seconds * 1e-6,
+               (double)(n * sizeof *work) / parallel_seconds * 1e-6);
+    }
+
+    free(input);
+    free(work);
+    free(merged);
+}
+
+//////////////////////////////////////////
+
+static void benchmark_csv_format(int argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+
+    ThermalTelemetryCalibrated *records = (ThermalTelemetryCalibrated*)malloc(CSV_FORMAT_RECORD_COUNT * sizeof *records);
+    if (!records)
+    {
+        perror("malloc");
+        return;
+    }
+
+    // every raw temperature value, calibrated as the reader does
+    uint64_t state = 0x2545F4914F6CDD1Dull;
+    for (size_t i = 0; i < CSV_FORMAT_RECORD_COUNT; ++i)
+    {
+        ThermalTelemetrySchema raw = { THERMAL_ID, (int16_t)benchmark_random(&state), (int16_t)benchmark_random(&state) };
+        records[i] = thermal_to_calibrated(&raw, 1542716400u + (uint32_t)i);
+    }
+
+    char line[MAX_LINE_BUFFER];
+    char reference[MAX_LINE_BUFFER];
+    double best_snprintf = 1e30, best_fast = 1e30, best_write = 1e30, best_batch = 1e30;
+    size_t output_bytes = 0, mismatches = 0;
+
+    for (int repetition = 0; repetition < CSV_FORMAT_REPETITIONS; ++repetition)
+    {
+        double start = benchmark_now_seconds();
+        for (size_t i = 0; i < CSV_FORMAT_RECORD_COUNT; ++i)
+        {
+            output_bytes += (size_t)snprintf(reference, sizeof reference, "%u;%.*f;%.*f", records[i].thermal_telemetry_timestamp,
+                                             2, records[i].CPU_C, 2, records[i].mirror_cell_C);
+        }
+        double snprintf_seconds = benchmark_now_seconds() - start;
+
+        start = benchmark_now_seconds();
+        for (size_t i = 0; i < CSV_FORMAT_RECORD_COUNT; ++i)
+        {
+            output_bytes += (size_t)thermal_calibrated_to_csv_line(&records[i], line, sizeof line, 2);
+        }
+        double fast_seconds = benchmark_now_seconds() - start;
+
+        start = benchmark_now_seconds();
+        write_array_to_csv(CSV_FORMAT_FILENAME, records, CSV_FORMAT_RECORD_COUNT, sizeof *records,
+                           thermal_calibrated_to_csv_line, 2, "rtc_s", "CPU_C", "mirror_cell_C", NULL);
+        double write_seconds = benchmark_now_seconds() - start;
+
+        start = benchmark_now_seconds();
+        write_array_to_csv_batch(CSV_FORMAT_FILENAME, records, CSV_FORMAT_RECORD_COUNT, sizeof *records,
+                                 thermal_calibrated_to_csv_batch, 2, "rtc_s", "CPU_C", "mirror_cell_C", NULL);
+        double batch_seconds = benchmark_now_seconds() - start;
+
+        if (snprintf_seconds < best_snprintf) best_snprintf = snprintf_seconds;
+        if (batch_seconds < best_batch) best_batch = batch_seconds;
+        if (fast_seconds < best_fast) best_fast = fast_seconds;
+        if (write_seconds < best_write) best_write = write_seconds;
+    }
+
+    // the fast formatters must give the same bytes as printf
+    for (size_t i = 0; i < CSV_FORMAT_RECORD_COUNT; ++i)
+    {
+        snprintf(reference, sizeof reference, "%u;%.*f;%.*f", records[i].thermal_telemetry_timestamp,
+                 2, records[i].CPU_C, 2, records[i].mirror_cell_C);
+        thermal_calibrated_to_csv_line(&records[i], line, sizeof line, 2);
+        if (strcmp(line, reference) != 0) mismatches++;
+    }
+
+    FILE *written = fopen(CSV_FORMAT_FILENAME, "rb");
+    long file_size = 0;
+    if (written)
+    {
+        fseek(written, 0, SEEK_END);
+        file_size = ftell(written);
+        fclose(written);
+    }
+    remove(CSV_FORMAT_FILENAME);
+
+    printf("[BENCH] csv_format %u thermal lines (%zu bytes formatted, %zu mismatches)\n",
+           CSV_FORMAT_RECORD_COUNT, output_bytes, mismatches);
+    // one line per frame, MB/s of the CSV bytes
+    print_rates("snprintf \"%u;%.*f;%.*f\"", CSV_FORMAT_RECORD_COUNT, (double)file_size, best_snprintf);
+    print_rates("thermal_calibrated_to_csv_line", CSV_FORMAT_RECORD_COUNT, (double)file_size, best_fast);
+    print_rates("write_array_to_csv", CSV_FORMAT_RECORD_COUNT, (double)file_size, best_write);
+    print_rates("write_array_to_csv_batch", CSV_FORMAT_RECORD_COUNT, (double)file_size, best_batch);
+
+    free(records);
+}
+
+//////////////////////////////////////////
+
+static void benchmark_calibrate(int argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+    int16_t *raw = (int16_t*)malloc(CALIBRATE_VALUE_COUNT * sizeof(int16_t));
+    float *element_out = (float*)malloc(CALIBRATE_VALUE_COUNT * sizeof(float));
+    float *batch_out = (float*)malloc(CALIBRATE_VALUE_COUNT * sizeof(float));
+    if (!raw || !element_out || !batch_out)
+    {
+        perror("malloc");
+        free(raw);
+        free(element_out);
+        free(batch_out);
+        return;
+    }
+
+    // big endian raw values, as gathered from the file
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    for (size_t i = 0; i < CALIBRATE_VALUE_COUNT; ++i) raw[i] = (int16_t)benchmark_random(&state);
+
+    double best_element = 1e30, best_batch = 1e30;
+    for (int repetition = 0; repetition < CALIBRATE_REPETITIONS; ++repetition)
+    {
+        // one element at a time, the way the frames are decoded and calibrated field by field
+        double start = benchmark_now_seconds();
+        for (size_t i = 0; i < CALIBRATE_VALUE_COUNT; ++i)
+        {
+            ThermalTelemetrySchema schema = { 0 };
+            schema.CPU_C = (int16_t)byte16_swap((uint16_t)raw[i]);
+            element_out[i] = thermal_to_calibrated(&schema, 0).CPU_C;
+        }
+        double elapsed = benchmark_now_seconds() - start;
+        if (elapsed < best_element) best_element = elapsed;
+
+        start = benchmark_now_seconds();
+        thermal_calibrate_batch(raw, CALIBRATE_VALUE_COUNT, true, batch_out);
+        elapsed = benchmark_now_seconds() - start;
+        if (elapsed < best_batch) best_batch = elapsed;
+    }
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < CALIBRATE_VALUE_COUNT; ++i)
+    {
+        if (memcmp(&element_out[i], &batch_out[i], sizeof(float)) != 0) mismatches++;
+    }
+
+    printf("[BENCH] calibrate %u values (mismatches %zu)\n", CALIBRATE_VALUE_COUNT, mismatches);
+    // one value per frame, MB/s of the raw values
+    print_rates("thermal_to_calibrated", CALIBRATE_VALUE_COUNT, CALIBRATE_VALUE_COUNT * sizeof(int16_t), best_element);
+    print_rates("thermal_calibrate_batch", CALIBRATE_VALUE_COUNT, CALIBRATE_VALUE_COUNT * sizeof(int16_t), best_batch);
+
+    free(raw);
+    free(element_out);
+    free(batch_out);
+}
+
+/**
+ * @brief Reads the positional options of file_pipeline and generate: frames, then the three rates, then the gap
+ *
+ * @return false if one of them is not a number
+ */
+static bool parse_synthetic_options(int argc, char *argv[], SyntheticTelemetryOptions *options)
+{
+    double *rates[] = { &options->out_of_order_rate, &options->duplicate_rate, &options->corruption_rate };
+    char *end = NULL;
+
+    if (argc > 0)
+    {
+        options->frame_count = strtoull(argv[0], &end, 10);
+        if (options->frame_count == 0 || *end != '\0') return false;
+    }
+    for (int r = 0; r < 3 && r + 1 < argc; ++r)
+    {
+        *rates[r] = strtod(argv[r + 1], &end);
+        if (*end != '\0') return false;
+    }
+    if (argc > 4)
+    {
+        options->max_gap_bytes = (size_t)strtoull(argv[4], &end, 10);
+        if (*end != '\0') return false;
+    }
+    return true;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Prints what the generator wrote
+ */
+static void print_synthetic_stats(const char *filename, const SyntheticTelemetryStats *stats)
+{
+    printf("[BENCH] %s: %llu frames, %llu out of order, %llu duplicated, %llu corrupted, %.1f MB\n", filename,
+           (unsigned long long)stats->frames_written, (unsigned long long)stats->frames_out_of_order,
+           (unsigned long long)stats->frames_duplicated, (unsigned long long)stats->frames_corrupted,
+           (double)stats->bytes_written * 1e-6);
+}
+
+//////////////////////////////////////////
+
+/**
+ * @struct PipelineRowsContext
+ * @brief  Context of the frame index walk of the calibrate stage
+ */
+typedef struct PIPELINE_ROWS_CONTEXT
+{
+    const CalibrationEngine    *engine;
+    DynamicArray               *rows;               // reserved for the whole index
+} PipelineRowsContext;
+
+/**
+ * @brief callback of the frame index walk, calibrates the fields of the engine straight into the next row
+ */
+static bool pipeline_calibrate_row(const BeaconFrameView *view, void *context)
+{
+    PipelineRowsContext *rows_context = (PipelineRowsContext*)context;
+    DynamicArray *rows = rows_context->rows;
+
+    if (rows->length == rows->capacity) return false;
+
+    CalibratedRow *row = (CalibratedRow*)((unsigned char*)rows->data + rows->length * rows->element_size);
+    calibration_engine_calibrate_view(rows_context->engine, view, row);
+    rows->length++;
+    return true;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief The stages of the reader over a generated file: header scan, decode, index, sort and dedupe, calibrate, CSV
+ *
+ *  The wrong frames are skipped as with --robust, so the corruption rate doesn't stop the run
+ */
+static void benchmark_file_pipeline(int argc, char *argv[])
+{
+    const BeaconHeader header = { .beacon_id = { {0xFF,0xFF,0xF0} } };
+    SyntheticTelemetryOptions options;
+    SyntheticTelemetryStats stats;
+
+    synthetic_telemetry_default_options(&options, FILE_PIPELINE_FRAME_COUNT);
+    options.out_of_order_rate = FILE_PIPELINE_OUT_OF_ORDER_RATE;
+    options.duplicate_rate = FILE_PIPELINE_DUPLICATE_RATE;
+    options.corruption_rate = FILE_PIPELINE_CORRUPTION_RATE;
+    if (!parse_synthetic_options(argc, argv, &options))
+    {
+        fprintf(stderr, "[BENCH] file_pipeline [frames [out_of_order [duplicates [corruption]]]]\n");
+        return;
+    }
+
+    double start = benchmark_now_seconds();
+    if (!synthetic_telemetry_write(FILE_PIPELINE_FILENAME, header, &options, &stats)) return;
+    double generate_seconds = benchmark_now_seconds() - start;
+    print_synthetic_stats(FILE_PIPELINE_FILENAME, &stats);
+
+    MappedFrameFile file;
+    CalibrationEngine engine;
+    DynamicArray index, rows;
+    if (!mapped_file_open(FILE_PIPELINE_FILENAME, &file))
+    {
+        perror("mapped_file_open");
+        remove(FILE_PIPELINE_FILENAME);
+        return;
+    }
+    calibration_engine_init(&engine, CALIBRATION_FIELD_MASK_ALL);
+    if (!dynamic_array_init(&index, sizeof(FrameIndexEntry), (size_t)stats.frames_written) ||
+        !dynamic_array_init(&rows, engine.row_size, (size_t)stats.frames_written))
+    {
+        perror("dynamic_array_init");
+        dynamic_array_free(&index);
+        mapped_file_close(&file);
+        remove(FILE_PIPELINE_FILENAME);
+        return;
+    }
+    file.skip_wrong_frames = true;
+
+    const double file_bytes = (double)file.size;
+    double best_scan = 1e30, best_decode = 1e30, best_index = 1e30, best_sort = 1e30, best_calibrate = 1e30, best_csv = 1e30;
+    size_t headers = 0, decoded = 0;
+    long csv_size = 0;
+    bool ok = true;
+    uint32_t checksum = 0;
+
+    for (int repetition = 0; ok && repetition < FILE_PIPELINE_REPETITIONS; ++repetition)
+    {
+        start = benchmark_now_seconds();
+        headers = 0;
+        for (size_t position = 0;;)
+        {
+            size_t found = position + find_beacon_header(file.data + position, file.size - position, header);
+            if (found >= file.size) break;
+            ++headers;
+            position = found + 1;
+        }
+        double elapsed = benchmark_now_seconds() - start;
+        if (elapsed < best_scan) best_scan = elapsed;
+
+        // every frame decoded, wrong ones skipped
+        BeaconFrameView view;
+        BeaconFrame frame;
+        file.position = 0;
+        memset(&file.integrity, 0, sizeof file.integrity);
+        decoded = 0;
+        start = benchmark_now_seconds();
+        while (read_mapped_frame_view(&file, header, &view) == READ_OK)
+        {
+            if (decode_beacon_frame(view.bytes, file.byte_order, &frame)) checksum += frame.platform.rtc_s;
+            ++decoded;
+        }
+        elapsed = benchmark_now_seconds() - start;
+        if (elapsed < best_decode) best_decode = elapsed;
+
+        file.position = 0;
+        memset(&file.integrity, 0, sizeof file.integrity);
+        index.length = 0;
+        start = benchmark_now_seconds();
+        ok = frame_index_build(&file, header, &index) == READ_EOF;
+        elapsed = benchmark_now_seconds() - start;
+        if (elapsed < best_index) best_index = elapsed;
+
+        start = benchmark_now_seconds();
+        frame_index_sort(&index);
+        elapsed = benchmark_now_seconds() - start;
+        if (elapsed < best_sort) best_sort = elapsed;
+
+        PipelineRowsContext context = { &engine, &rows };
+        rows.length = 0;
+        start = benchmark_now_seconds();
+        ok = ok && frame_index_walk(&file, &index, pipeline_calibrate_row, &context);
+        elapsed = benchmark_now_seconds() - start;
+        if (elapsed < best_calibrate) best_calibrate = elapsed;
+
+        start = benchmark_now_seconds();
+        ok = ok && calibration_engine_write_csv(&engine, FILE_PIPELINE_CSV_FILENAME, &rows) == 1;
+        elapsed = benchmark_now_seconds() - start;
+        if (elapsed < best_csv) best_csv = elapsed;
+    }
+
+    FILE *written = fopen(FILE_PIPELINE_CSV_FILENAME, "rb");
+    if (written)
+    {
+        fseek(written, 0, SEEK_END);
+        csv_size = ftell(written);
+        fclose(written);
+    }
+
+    if (!ok)
+    {
+        fprintf(stderr, "[BENCH] file_pipeline failed\n");
+    }
+    else
+    {
+        const uint64_t expected = stats.frames_written - stats.frames_duplicated - stats.frames_corrupted;
+        printf("[BENCH] file_pipeline %zu headers, %zu frames decoded, %zu indexed (%llu expected), "
+               "%zu wrong skipped (checksum %08x)\n", headers, decoded, index.length, (unsigned long long)expected,
+               file.integrity.frames_wrong, checksum);
+        printf("[BENCH]   (MB/s of the file, then of the index entries, the frames and the CSV file)\n");
+        print_rates("synthetic_telemetry_write", (double)stats.frames_written, file_bytes, generate_seconds);
+        print_rates("find_beacon_header", (double)headers, file_bytes, best_scan);
+        print_rates("read_mapped_frame_view+decode", (double)decoded, file_bytes, best_decode);
+        print_rates("frame_index_build", (double)decoded, file_bytes, best_index);
+        print_rates("frame_index_sort", (double)decoded, (double)(decoded * sizeof(FrameIndexEntry)), best_sort);
+        print_rates("calibrate_view (all fields)", (double)index.length,
+                    (double)(index.length * BEACON_FRAME_SIZE), best_calibrate);
+        print_rates("calibration_engine_write_csv", (double)index.length, (double)csv_size, best_csv);
+    }
+
+    dynamic_array_free(&rows);
+    dynamic_array_free(&index);
+    mapped_file_close(&file);
+    remove(FILE_PIPELINE_CSV_FILENAME);
+    remove(FILE_PIPELINE_FILENAME);
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Loading the index sidecar and indexing the appended bytes, against indexing the whole file again
+ *
+ *  The sidecar is saved for the file cut INDEX_SIDECAR_CUT_BYTES into its last frame (skipped as truncated,
+ *  as with --robust), then loaded for the whole file, as --update-index does once the rest was appended.
+ *  Both indexes must have the same entries
+ */
+static void benchmark_index_sidecar(int argc, char *argv[])
+{
+    const BeaconHeader header = { .beacon_id = { {0xFF,0xFF,0xF0} } };
+    SyntheticTelemetryOptions options;
+    SyntheticTelemetryStats stats;
+    char sidecar_filename[256];
+
+    synthetic_telemetry_default_options(&options, INDEX_SIDECAR_FRAME_COUNT);
+    options.out_of_order_rate = FILE_PIPELINE_OUT_OF_ORDER_RATE;
+    options.duplicate_rate = FILE_PIPELINE_DUPLICATE_RATE;
+    options.corruption_rate = FILE_PIPELINE_CORRUPTION_RATE;
+    if (!parse_synthetic_options(argc > 1 ? 1 : argc, argv, &options))
+    {
+        fprintf(stderr, "[BENCH] index_sidecar [frames]\n");
+        return;
+    }
+    if (!index_sidecar_path(INDEX_SIDECAR_FILENAME, sidecar_filename, sizeof sidecar_filename)) return;
+    if (!synthetic_telemetry_write(INDEX_SIDECAR_FILENAME, header, &options, &stats)) return;
+
+    MappedFrameFile file, cut;
+    DynamicArray index, cut_index;
+    if (!mapped_file_open(INDEX_SIDECAR_FILENAME, &file))
+    {
+        perror("mapped_file_open");
+        remove(INDEX_SIDECAR_FILENAME);
+        return;
+    }
+    if (!dynamic_array_init(&index, sizeof(FrameIndexEntry), (size_t)stats.frames_written) ||
+        !dynamic_array_init(&cut_index, sizeof(FrameIndexEntry), (size_t)stats.frames_written))
+    {
+        perror("dynamic_array_init");
+        dynamic_array_free(&index);
+        mapped_file_close(&file);
+        remove(INDEX_SIDECAR_FILENAME);
+        return;
+    }
+    file.skip_wrong_frames = true;
+
+    const size_t thread_count = parallel_decode_thread_count(0);
+    double best_rebuild = 1e30, best_load = 1e30;
+    size_t merged_length = 0, mismatches = 0;
+    bool ok = true;
+
+    for (int repetition = 0; ok && repetition < INDEX_SIDECAR_REPETITIONS; ++repetition)
+    {
+        file.position = 0;
+        memset(&file.integrity, 0, sizeof file.integrity);
+        index.length = 0;
+        double start = benchmark_now_seconds();
+        ok = frame_index_build_sorted_parallel(&file, header, &index, thread_count, NULL) == READ_EOF;
+        double elapsed = benchmark_now_seconds() - start;
+        if (elapsed < best_rebuild) best_rebuild = elapsed;
+    }
+
+    // the last header with a whole frame after it
+    size_t last_header = file.size;
+    const size_t tail_start = file.size > 4 * (BEACON_HEADER_SIZE + BEACON_FRAME_SIZE + options.max_gap_bytes) ?
+                              file.size - 4 * (BEACON_HEADER_SIZE + BEACON_FRAME_SIZE + options.max_gap_bytes) : 0;
+    for (size_t position = tail_start; position < file.size;)
+    {
+        size_t found = position + find_beacon_header(file.data + position, file.size - position, header);
+        if (found >= file.size || file.size - found < BEACON_HEADER_SIZE + BEACON_FRAME_SIZE) break;
+        last_header = found;
+        position = found + 1;
+    }
+
+    ok = ok && last_header < file.size &&
+         mapped_file_from_buffer(file.data, last_header + BEACON_HEADER_SIZE + INDEX_SIDECAR_CUT_BYTES, &cut);
+    if (ok)
+    {
+        cut.skip_wrong_frames = true;
+        ok = frame_index_build_sorted_parallel(&cut, header, &cut_index, thread_count, NULL) == READ_EOF &&
+             index_sidecar_save(sidecar_filename, &cut, header, DEDUP_KEEP_FIRST, false, &cut_index);
+    }
+
+    for (int repetition = 0; ok && repetition < INDEX_SIDECAR_REPETITIONS; ++repetition)
+    {
+        DynamicArray loaded, appended;
+        uint64_t indexed_size = 0;
+        size_t repeated = 0;
+
+        file.position = 0;
+        memset(&file.integrity, 0, sizeof file.integrity);
+        double start = benchmark_now_seconds();
+        if (index_sidecar_load(sidecar_filename, &file, header, DEDUP_KEEP_FIRST, false, &loaded, &indexed_size) !=
+            INDEX_SIDECAR_APPENDED)
+        {
+            ok = false;
+            break;
+        }
+
+        file.position = (size_t)index_sidecar_resume_offset(indexed_size);
+        ok = dynamic_array_init(&appended, sizeof(FrameIndexEntry), 0) &&
+             frame_index_build_sorted_parallel(&file, header, &appended, thread_count, NULL) == READ_EOF &&
+             index_sidecar_merge(&loaded, &appended, DEDUP_KEEP_FIRST, &repeated);
+        double elapsed = benchmark_now_seconds() - start;
+        if (elapsed < best_load) best_load = elapsed;
+
+        merged_length = loaded.length;
+        if (ok && (loaded.length != index.length ||
+                   memcmp(loaded.data, index.data, index.length * sizeof(FrameIndexEntry)) != 0)) mismatches++;
+
+        dynamic_array_free(&appended);
+        dynamic_array_free(&loaded);
+    }
+
+    if (!ok)
+    {
+        fprintf(stderr, "[BENCH] index_sidecar failed\n");
+    }
+    else
+    {
+        if (mismatches > 0) fprintf(stderr, "[BENCH] index_sidecar mismatch with the rebuilt index\n");
+        printf("[BENCH] index_sidecar %zu frames rebuilt, %zu from the sidecar and the append after a truncated "
+               "frame (%zu mismatches)\n", index.length, merged_length, mismatches);
+        print_rates("frame_index_build_sorted_parallel", (double)index.length, (double)file.size, best_rebuild);
+        print_rates("index_sidecar_load+append", (double)index.length, (double)file.size, best_load);
+    }
+
+    dynamic_array_free(&cut_index);
+    dynamic_array_free(&index);
+    mapped_file_close(&file);
+    remove(sidecar_filename);
+    remove(INDEX_SIDECAR_FILENAME);
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Writes a synthetic file to keep, e.g. to run the reader over it
+ *
+ * @return exit code of the benchmark program
+ */
+static int generate_synthetic_file(int argc, char *argv[])
+{
+    const BeaconHeader header = { .beacon_id = { {0xFF,0xFF,0xF0} } };
+    SyntheticTelemetryOptions options;
+    SyntheticTelemetryStats stats;
+
+    synthetic_telemetry_default_options(&options, FILE_PIPELINE_FRAME_COUNT);
+    if (argc < 1 || !parse_synthetic_options(argc - 1, argv + 1, &options))
+    {
+        fprintf(stderr, "Usage: " GENERATE_COMMAND " FILE [frames [out_of_order [duplicates [corruption [max_gap_bytes]]]]]\n");
+        return 1;
+    }
+
+    double start = benchmark_now_seconds();
+    if (!synthetic_telemetry_write(argv[0], header, &options, &stats)) return 1;
+    double seconds = benchmark_now_seconds() - start;
+
+    print_synthetic_stats(argv[0], &stats);
+    print_rates("synthetic_telemetry_write", (double)stats.frames_written, (double)stats.bytes_written, seconds);
+    return 0;
+}
+
+//////////////////////////////////////////
+
+static const BenchmarkEntry benchmarks[] =
+{
+    { "header_scan", benchmark_header_scan },
+    { "frame_decode", benchmark_frame_decode },
+    { "sort", benchmark_sort },
+    { "merge", benchmark_merge },
+    { "csv_format", benchmark_csv_format },
+    { "calibrate", benchmark_calibrate },
+    { "file_pipeline", benchmark_file_pipeline },
+    { "index_sidecar", benchmark_index_sidecar },
+};
+
+int main(int argc, char *argv[])
+{
+    const char *selected = argc > 1 ? argv[1] : NULL;
+    bool any_run = false;
+
+    if (selected && strcmp(selected, GENERATE_COMMAND) == 0) return generate_synthetic_file(argc - 2, argv + 2);
+
+    for (size_t i = 0; i < sizeof benchmarks / sizeof benchmarks[0]; ++i)
+    {
+        if (selected && strcmp(selected, benchmarks[i].name) != 0) continue;
+        benchmarks[i].run(selected ? argc - 2 : 0, selected ? argv + 2 : NULL);
+        any_run = true;
+    }
+
+    if (!any_run)
+    {
+        fprintf(stderr, "Unknown benchmark \"%s\". Available:", selected);
+        for (size_t i = 0; i < sizeof benchmarks / sizeof benchmarks[0]; ++i) fprintf(stderr, " %s", benchmarks[i].name);
+        fprintf(stderr, "\n");
+        return 1;
+    }
+    return 0;
+}
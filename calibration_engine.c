@@ -0,0 +1,247 @@
+/**
+ * @file calibration_engine.c
+ * @brief Implementation file of the calibration_engine header
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#include "calibration_engine.h"
+#include "columnar_tool.h"
+#include "csv_tool.h"
+#include "fast_format.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CALIBRATION_CSV_BLOCK_SIZE (16u << 10)      // lines formatted before each csv_writer_write_text
+#define CALIBRATION_CSV_MAX_LINE (FAST_FORMAT_UINT32_MAX_CHARS + CALIBRATION_FIELD_COUNT * (1 + FAST_FORMAT_FIXED_MAX_CHARS) + 1)
+
+_Static_assert(CALIBRATION_CSV_BLOCK_SIZE >= CALIBRATION_CSV_MAX_LINE, "a CSV block holds at least one line");
+
+// the whole table, expanded once
+#define CALIBRATION_FIELD_DESCRIPTOR(name, member, wire_offset, raw_type, multiplier, divisor, bias, decimals, unit) \
+    { #name, unit, offsetof(BeaconFrame, member), wire_offset, raw_type, multiplier, divisor, bias, decimals },
+static const CalibrationFieldDescriptor calibration_fields[CALIBRATION_FIELD_COUNT] =
+{
+    CALIBRATION_FIELD_TABLE(CALIBRATION_FIELD_DESCRIPTOR)
+};
+#undef CALIBRATION_FIELD_DESCRIPTOR
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, section of the BeaconFrame holding the member at frame_offset
+ */
+static FrameSection section_of_frame_offset(size_t frame_offset)
+{
+    if (frame_offset >= offsetof(BeaconFrame, payload)) return FRAME_SECTION_PAYLOAD;
+    if (frame_offset >= offsetof(BeaconFrame, aocs)) return FRAME_SECTION_AOCS;
+    if (frame_offset >= offsetof(BeaconFrame, thermal)) return FRAME_SECTION_THERMAL;
+    if (frame_offset >= offsetof(BeaconFrame, power)) return FRAME_SECTION_POWER;
+    if (frame_offset >= offsetof(BeaconFrame, cdh)) return FRAME_SECTION_CDH;
+    if (frame_offset >= offsetof(BeaconFrame, memory)) return FRAME_SECTION_MEMORY;
+    return FRAME_SECTION_PLATFORM;
+}
+
+//////////////////////////////////////////
+
+const CalibrationFieldDescriptor* calibration_field_descriptor(CalibrationFieldId id)
+{
+    if ((unsigned)id >= CALIBRATION_FIELD_COUNT) return NULL;
+    return &calibration_fields[id];
+}
+
+//////////////////////////////////////////
+
+bool calibration_field_find(const char *name, CalibrationFieldId *id)
+{
+    if (!name || !id) return false;
+
+    for (size_t i = 0; i < CALIBRATION_FIELD_COUNT; ++i)
+    {
+        if (strcmp(calibration_fields[i].name, name) == 0)
+        {
+            *id = (CalibrationFieldId)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+//////////////////////////////////////////
+
+bool calibration_engine_init(CalibrationEngine *engine, CalibrationFieldMask mask)
+{
+    if (!engine || mask == 0 || (mask & ~CALIBRATION_FIELD_MASK_ALL) != 0) return false;
+
+    engine->field_count = 0;
+    engine->sections = FRAME_SECTION_NONE;
+    for (size_t i = 0; i < CALIBRATION_FIELD_COUNT; ++i)
+    {
+        if (mask & CALIBRATION_FIELD_BIT(i))
+        {
+            engine->fields[engine->field_count++] = &calibration_fields[i];
+            engine->sections |= section_of_frame_offset(calibration_fields[i].frame_offset);
+        }
+    }
+    engine->row_size = sizeof(CalibratedRow) + engine->field_count * sizeof(float);
+    return true;
+}
+
+//////////////////////////////////////////
+
+void calibration_engine_calibrate(const CalibrationEngine *engine, const BeaconFrame *frame, CalibratedRow *row)
+{
+    const unsigned char *frame_bytes = (const unsigned char*)frame;
+
+    row->rtc_s = frame->platform.rtc_s;
+
+    for (size_t i = 0; i < engine->field_count; ++i)
+    {
+        const CalibrationFieldDescriptor *field = engine->fields[i];
+        double raw;
+
+        switch (field->raw_type)
+        {
+            case CALIBRATION_RAW_UINT16:
+            {
+                uint16_t value;
+                memcpy(&value, frame_bytes + field->frame_offset, sizeof value);
+                raw = value;
+                break;
+            }
+            case CALIBRATION_RAW_INT16:
+            {
+                int16_t value;
+                memcpy(&value, frame_bytes + field->frame_offset, sizeof value);
+                raw = value;
+                break;
+            }
+            case CALIBRATION_RAW_INT32:
+            default:
+            {
+                int32_t value;
+                memcpy(&value, frame_bytes + field->frame_offset, sizeof value);
+                raw = value;
+                break;
+            }
+        }
+
+        row->values[i] = (float)(raw * field->multiplier / field->divisor + field->bias);
+    }
+}
+
+//////////////////////////////////////////
+
+void calibration_engine_calibrate_view(const CalibrationEngine *engine, const BeaconFrameView *view, CalibratedRow *row)
+{
+    row->rtc_s = beacon_frame_view_rtc_s(view);
+
+    for (size_t i = 0; i < engine->field_count; ++i)
+    {
+        const CalibrationFieldDescriptor *field = engine->fields[i];
+        double raw;
+
+        // the same conversions, from the wire offset of the field
+        switch (field->raw_type)
+        {
+            case CALIBRATION_RAW_UINT16:
+                raw = beacon_frame_view_load_u16(view, field->wire_offset);
+                break;
+            case CALIBRATION_RAW_INT16:
+                raw = (int16_t)beacon_frame_view_load_u16(view, field->wire_offset);
+                break;
+            case CALIBRATION_RAW_INT32:
+            default:
+                raw = (int32_t)beacon_frame_view_load_u32(view, field->wire_offset);
+                break;
+        }
+
+        row->values[i] = (float)(raw * field->multiplier / field->divisor + field->bias);
+    }
+}
+
+//////////////////////////////////////////
+
+int calibration_engine_write_csv(const CalibrationEngine *engine, const char *filename, const DynamicArray *rows)
+{
+    if (!engine || !filename || !rows || rows->element_size != engine->row_size)
+    {
+        fprintf(stderr, "Error: Invalid argument(s) passed to calibration_engine_write_csv.\n");
+        return -1;
+    }
+
+    const char *column_names[1 + CALIBRATION_FIELD_COUNT];
+    column_names[0] = "rtc_s";
+    for (size_t i = 0; i < engine->field_count; ++i) column_names[1 + i] = engine->fields[i]->name;
+
+    CsvWriter writer;
+    if (csv_writer_open_columns(&writer, filename, 0, column_names, 1 + engine->field_count) != 1) return -1;
+
+    char *block = (char*)malloc(CALIBRATION_CSV_BLOCK_SIZE);
+    if (!block)
+    {
+        fprintf(stderr, "Error: Cannot allocate the CSV block buffer\n");
+        csv_writer_close(&writer);
+        return -1;
+    }
+
+    const unsigned char *row_bytes = (const unsigned char*)rows->data;
+    size_t length = 0;
+    size_t block_rows = 0;
+    int result = 1;
+
+    for (size_t r = 0; result == 1 && r < rows->length; ++r)
+    {
+        const CalibratedRow *row = (const CalibratedRow*)(row_bytes + r * engine->row_size);
+
+        length += format_uint32(block + length, row->rtc_s);
+        for (size_t i = 0; i < engine->field_count; ++i)
+        {
+            block[length++] = SEPARATOR[0];
+            length += format_fixed_float(block + length, row->values[i], engine->fields[i]->decimals);
+        }
+        block[length++] = '\n';
+        block_rows++;
+
+        if (CALIBRATION_CSV_BLOCK_SIZE - length < CALIBRATION_CSV_MAX_LINE)
+        {
+            result = csv_writer_write_text(&writer, block, length, block_rows);
+            length = 0;
+            block_rows = 0;
+        }
+    }
+
+    if (result == 1 && length > 0) result = csv_writer_write_text(&writer, block, length, block_rows);
+    if (csv_writer_close(&writer) != 1) result = -1;
+
+    free(block);
+    return result;
+}
+
+//////////////////////////////////////////
+
+int calibration_engine_write_columnar(const CalibrationEngine *engine, const char *filename, const DynamicArray *rows)
+{
+    if (!engine || !filename || !rows || rows->element_size != engine->row_size)
+    {
+        fprintf(stderr, "Error: Invalid argument(s) passed to calibration_engine_write_columnar.\n");
+        return -1;
+    }
+
+    ColumnarColumn columns[1 + CALIBRATION_FIELD_COUNT];
+    columns[0].name = "rtc_s";
+    columns[0].type = COLUMNAR_UINT32;
+    columns[0].offset = offsetof(CalibratedRow, rtc_s);
+    for (size_t i = 0; i < engine->field_count; ++i)
+    {
+        columns[1 + i].name = engine->fields[i]->name;
+        columns[1 + i].type = COLUMNAR_FLOAT32;
+        columns[1 + i].offset = offsetof(CalibratedRow, values) + i * sizeof(float);
+    }
+
+    return write_array_to_columnar(filename, rows->data, rows->length, engine->row_size, columns, 1 + engine->field_count);
+}
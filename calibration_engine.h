@@ -0,0 +1,137 @@
+/**
+ * @file calibration_engine.h
+ * @brief Header of the generic calibration engine, driven by the field table of calibration_table.h
+ *
+ *  One engine calibrates any subset of the fields of the table, in a single pass over each decoded frame,
+ *  into rows of (rtc_s, value of every selected field). The rows are plain fixed size elements, so they are
+ *  stored in a DynamicArray and written as CSV or columnar files like any other array, with the column
+ *  names and the CSV decimals taken from the table.
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#ifndef CALIBRATION_ENGINE_H_INCLUDED
+#define CALIBRATION_ENGINE_H_INCLUDED
+
+#include "beacon_frame_schema.h"
+#include "calibration_table.h"
+#include "dynamic_array.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @struct CalibrationFieldDescriptor
+ * @brief  One line of CALIBRATION_FIELD_TABLE
+ */
+typedef struct CALIBRATION_FIELD_DESCRIPTOR
+{
+    const char         *name;               // output column
+    const char         *unit;
+    size_t              frame_offset;       // offset of the raw value inside BeaconFrame
+    size_t              wire_offset;        // offset of the raw value in the packed frame
+    CalibrationRawType  raw_type;
+    double              multiplier;
+    double              divisor;
+    double              bias;
+    int                 decimals;           // decimals printed in the CSV files
+} CalibrationFieldDescriptor;
+
+/**
+ * @struct CalibratedRow
+ * @brief  Output element of the engine: the timestamp and the value of every field of the engine, in engine order
+ *
+ * @note The size depends on the engine, see CalibrationEngine.row_size
+ */
+typedef struct CALIBRATED_ROW
+{
+    uint32_t    rtc_s;
+    float       values[];
+} CalibratedRow;
+
+/**
+ * @struct CalibrationEngine
+ * @brief  The selected fields, in table order
+ */
+typedef struct CALIBRATION_ENGINE
+{
+    const CalibrationFieldDescriptor   *fields[CALIBRATION_FIELD_COUNT];
+    size_t                              field_count;
+    size_t                              row_size;           // bytes of a CalibratedRow of this engine
+    FrameSectionMask                    sections;           // sections of the frame holding the fields, for the decoder
+} CalibrationEngine;
+
+/**
+ * @brief Descriptor of a field of the table
+ *
+ * @return NULL if the ID is not in the table
+ */
+const CalibrationFieldDescriptor* calibration_field_descriptor(CalibrationFieldId id);
+
+/**
+ * @brief Searchs a field of the table by its column name
+ *
+ * @param[in]  name     Column name, e.g. "battery_A"
+ * @param[out] id       ID of the field, if found
+ *
+ * @return true if the field exists
+ */
+bool calibration_field_find(const char *name, CalibrationFieldId *id);
+
+/**
+ * @brief Initializes an engine for a set of fields
+ *
+ *  The sections of the frame the engine reads are kept in engine->sections, so only those are decoded
+ *  (see decode_beacon_frame_sections)
+ *
+ * @param[out] engine   Pointer to the engine to initialize
+ * @param[in]  mask     Fields to calibrate, CALIBRATION_FIELD_BIT of each one (or CALIBRATION_FIELD_MASK_ALL)
+ *
+ * @return true on success, false if the mask is empty or has bits outside the table
+ */
+bool calibration_engine_init(CalibrationEngine *engine, CalibrationFieldMask mask);
+
+/**
+ * @brief Calibrates all the fields of the engine from a decoded frame, in one pass
+ *
+ * @param[in]  engine   Initialized engine
+ * @param[in]  frame    Decoded frame, host order values
+ * @param[out] row      Row of engine->row_size bytes
+ */
+void calibration_engine_calibrate(const CalibrationEngine *engine, const BeaconFrame *frame, CalibratedRow *row);
+
+/**
+ * @brief Same as calibration_engine_calibrate, reading the raw values in place from a view of the frame
+ *
+ * @param[in]  engine   Initialized engine
+ * @param[in]  view     View of the frame (see BeaconFrameView), only the fields of the engine are read
+ * @param[out] row      Row of engine->row_size bytes
+ */
+void calibration_engine_calibrate_view(const CalibrationEngine *engine, const BeaconFrameView *view, CalibratedRow *row);
+
+/**
+ * @brief Writes an array of rows of the engine to a CSV file, "rtc_s" plus one column per field
+ *
+ * @param[in] engine    Engine that calibrated the rows
+ * @param[in] filename  The name of the file to create or overwrite.
+ * @param[in] rows      DynamicArray of rows of engine->row_size bytes
+ *
+ * @return int 1 on success, -1 on error.
+ */
+int calibration_engine_write_csv(const CalibrationEngine *engine, const char *filename, const DynamicArray *rows);
+
+/**
+ * @brief Writes an array of rows of the engine to a columnar file (see columnar_tool.h), "rtc_s" plus one column per field
+ *
+ * @param[in] engine    Engine that calibrated the rows
+ * @param[in] filename  The name of the file to create or overwrite.
+ * @param[in] rows      DynamicArray of rows of engine->row_size bytes
+ *
+ * @return int 1 on success, -1 on error.
+ */
+int calibration_engine_write_columnar(const CalibrationEngine *engine, const char *filename, const DynamicArray *rows);
+
+#endif // CALIBRATION_ENGINE_H
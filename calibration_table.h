@@ -0,0 +1,88 @@
+/**
+ * @file calibration_table.h
+ * @brief Declarative table of every calibrated field of the BeaconFrame, expanded at compile time (X-macros)
+ *
+ *  One line per field: where the raw value is (the BeaconFrame member and its wire offset), its raw type,
+ *  the documented conversion, and the output column. Everything else (the field IDs, the descriptors of
+ *  the calibration engine, the column names of the outputs) is generated from CALIBRATION_FIELD_TABLE,
+ *  so adding a calibrated field only means adding its line here.
+ *
+ *  The physical value is  raw * multiplier / divisor + bias  (see the formulas in beacon_frame_schema.h)
+ *
+ *  @note IDs, counters, modes and timestamps are not in the table, they have no calibration
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#ifndef CALIBRATION_TABLE_H_INCLUDED
+#define CALIBRATION_TABLE_H_INCLUDED
+
+#include "beacon_frame_schema.h"
+
+#include <stdint.h>
+
+/**
+    @enum type of the raw value of a calibrated field, as held by the BeaconFrame
+**/
+typedef enum
+{
+    CALIBRATION_RAW_UINT16,
+    CALIBRATION_RAW_INT16,
+    CALIBRATION_RAW_INT32
+} CalibrationRawType;
+
+// X(column name, BeaconFrame member, wire offset, raw type, multiplier, divisor, bias, CSV decimals, unit)
+#define CALIBRATION_FIELD_TABLE(X) \
+    /* POWER */ \
+    X(nice_battery_mV,   power.nice_battery_mV,    OFFSET_NICE_BATTERY_MV,   CALIBRATION_RAW_UINT16, 1.0,      1.0,     0.0,  0, "mV") \
+    X(raw_battery_mV,    power.raw_battery_mV,     OFFSET_RAW_BATTERY_MV,    CALIBRATION_RAW_UINT16, 1.0,      1.0,     0.0,  0, "mV") \
+    X(battery_A,         power.battery_A,          OFFSET_BATTERY_A,         CALIBRATION_RAW_UINT16, 0.005237, 1.0,     0.0,  4, "A") \
+    X(pcm_3v3_V,         power.pcm_3v3_V,          OFFSET_PCM_3V3_V,         CALIBRATION_RAW_UINT16, 0.003988, 1.0,     0.0,  4, "V") \
+    X(pcm_3v3_A,         power.pcm_3v3_A,          OFFSET_PCM_3V3_A,         CALIBRATION_RAW_UINT16, 0.005237, 1.0,     0.0,  4, "A") \
+    X(pcm_5v_V,          power.pcm_5v_V,           OFFSET_PCM_5V_V,          CALIBRATION_RAW_UINT16, 0.005865, 1.0,     0.0,  4, "V") \
+    X(pcm_5v_A,          power.pcm_5v_A,           OFFSET_PCM_5V_A,          CALIBRATION_RAW_UINT16, 0.005237, 1.0,     0.0,  4, "A") \
+    /* THERMAL */ \
+    X(CPU_C,             thermal.CPU_C,            OFFSET_CPU_C,             CALIBRATION_RAW_INT16,  1.0,      100.0,   0.0,  2, "C") \
+    X(mirror_cell_C,     thermal.mirror_cell_C,    OFFSET_MIRROR_CELL_C,     CALIBRATION_RAW_INT16,  1.0,      100.0,   0.0,  2, "C") \
+    /* AOCS */ \
+    X(sun_vector_x,      aocs.sunvectorX,          OFFSET_SUNVECTOR_X,       CALIBRATION_RAW_INT16,  1.0,      16384.0, 0.0,  4, "") \
+    X(sun_vector_y,      aocs.sunvectorY,          OFFSET_SUNVECTOR_Y,       CALIBRATION_RAW_INT16,  1.0,      16384.0, 0.0,  4, "") \
+    X(sun_vector_z,      aocs.sunvectorZ,          OFFSET_SUNVECTOR_Z,       CALIBRATION_RAW_INT16,  1.0,      16384.0, 0.0,  4, "") \
+    X(magnetometer_x_mg, aocs.magnetometerX_mg,    OFFSET_MAGNETOMETER_X,    CALIBRATION_RAW_INT16,  0.5,      1.0,     0.0,  1, "mg") \
+    X(magnetometer_y_mg, aocs.magnetometerY_mg,    OFFSET_MAGNETOMETER_Y,    CALIBRATION_RAW_INT16,  0.5,      1.0,     0.0,  1, "mg") \
+    X(magnetometer_z_mg, aocs.magnetometerZ_mg,    OFFSET_MAGNETOMETER_Z,    CALIBRATION_RAW_INT16,  0.5,      1.0,     0.0,  1, "mg") \
+    X(gyro_x_dps,        aocs.gyroX_dps,           OFFSET_GYRO_X,            CALIBRATION_RAW_INT16,  0.0125,   1.0,     0.0,  4, "dps") \
+    X(gyro_y_dps,        aocs.gyroY_dps,           OFFSET_GYRO_Y,            CALIBRATION_RAW_INT16,  0.0125,   1.0,     0.0,  4, "dps") \
+    X(gyro_z_dps,        aocs.gyroZ_dps,           OFFSET_GYRO_Z,            CALIBRATION_RAW_INT16,  0.0125,   1.0,     0.0,  4, "dps") \
+    X(temperature_IMU_C, aocs.temperature_IMU_C,   OFFSET_TEMPERATURE_IMU,   CALIBRATION_RAW_INT16,  0.14,     1.0,     25.0, 2, "C") \
+    X(fine_gyro_x_dps,   aocs.fine_gyroX_dps,      OFFSET_FINE_GYRO_X,       CALIBRATION_RAW_INT32,  256.0 / 6300.0, 65536.0, 0.0, 6, "dps") \
+    X(fine_gyro_y_dps,   aocs.fine_gyroY_dps,      OFFSET_FINE_GYRO_Y,       CALIBRATION_RAW_INT32,  256.0 / 6300.0, 65536.0, 0.0, 6, "dps") \
+    X(fine_gyro_z_dps,   aocs.fine_gyroZ_dps,      OFFSET_FINE_GYRO_Z,       CALIBRATION_RAW_INT32,  256.0 / 6300.0, 65536.0, 0.0, 6, "dps") \
+    X(wheel_1_radsec,    aocs.wheel_1_radsec,      OFFSET_WHEEL_1,           CALIBRATION_RAW_INT16,  0.3,      1.0,     0.0,  1, "rad/s") \
+    X(wheel_2_radsec,    aocs.wheel_2_radsec,      OFFSET_WHEEL_2,           CALIBRATION_RAW_INT16,  0.3,      1.0,     0.0,  1, "rad/s") \
+    X(wheel_3_radsec,    aocs.wheel_3_radsec,      OFFSET_WHEEL_3,           CALIBRATION_RAW_INT16,  0.3,      1.0,     0.0,  1, "rad/s") \
+    X(wheel_4_radsec,    aocs.wheel_4_radsec,      OFFSET_WHEEL_4,           CALIBRATION_RAW_INT16,  0.3,      1.0,     0.0,  1, "rad/s")
+
+/**
+    @enum ID of every calibrated field, in table order: CALIBRATION_FIELD_<column name>
+**/
+#define CALIBRATION_FIELD_ID(name, member, wire_offset, raw_type, multiplier, divisor, bias, decimals, unit) \
+    CALIBRATION_FIELD_##name,
+typedef enum
+{
+    CALIBRATION_FIELD_TABLE(CALIBRATION_FIELD_ID)
+    CALIBRATION_FIELD_COUNT
+} CalibrationFieldId;
+#undef CALIBRATION_FIELD_ID
+
+// a set of fields, one bit per CalibrationFieldId
+typedef uint64_t CalibrationFieldMask;
+
+#define CALIBRATION_FIELD_BIT(id) ((CalibrationFieldMask)1 << (id))
+#define CALIBRATION_FIELD_MASK_ALL ((CalibrationFieldMask)((1ull << CALIBRATION_FIELD_COUNT) - 1))
+
+_Static_assert(CALIBRATION_FIELD_COUNT < 64, "CalibrationFieldMask has one bit per calibrated field");
+
+#endif // CALIBRATION_TABLE_H
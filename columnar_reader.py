@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+"""Reader of the columnar binary files (.bcol) written by columnar_tool.c
+
+The columns are memory mapped with numpy.memmap, so there is no parsing at all:
+each column is a read only numpy array over the file bytes, with full float precision.
+"""
+import struct
+import sys
+
+MAGIC = b"BRCOLV1\0"
+BYTE_ORDER_MARK = 0x01020304
+HEADER_SIZE = 32
+DESCRIPTOR_SIZE = 48
+
+# ColumnarType of columnar_tool.h -> numpy dtype without byte order
+COLUMN_TYPES = {1: "u4", 2: "i4", 3: "f4", 4: "f8", 5: "u2", 6: "i2"}
+
+
+def is_columnar_file(path):
+    try:
+        with open(path, "rb") as f:
+            return f.read(len(MAGIC)) == MAGIC
+    except OSError:
+        return False
+
+
+def read_columnar(path):
+    """Returns a dict {column name: numpy.memmap}, in file order"""
+    import numpy as np
+
+    with open(path, "rb") as f:
+        header = f.read(HEADER_SIZE)
+        if len(header) != HEADER_SIZE or header[:len(MAGIC)] != MAGIC:
+            raise ValueError(f"{path}: not a columnar file")
+
+        # the file is in the byte order of the host that wrote it
+        if struct.unpack_from("<I", header, 8)[0] == BYTE_ORDER_MARK:
+            order = "<"
+        elif struct.unpack_from(">I", header, 8)[0] == BYTE_ORDER_MARK:
+            order = ">"
+        else:
+            raise ValueError(f"{path}: unknown byte order mark")
+
+        _, _, column_count, row_count, _, _ = struct.unpack(order + "8sIIQII", header)
+        descriptors = f.read(column_count * DESCRIPTOR_SIZE)
+        if len(descriptors) != column_count * DESCRIPTOR_SIZE:
+            raise ValueError(f"{path}: truncated column table")
+
+    columns = {}
+    for c in range(column_count):
+        name, column_type, value_size, offset = struct.unpack_from(order + "32sIIQ", descriptors, c * DESCRIPTOR_SIZE)
+        name = name.split(b"\0", 1)[0].decode("ascii")
+        if column_type not in COLUMN_TYPES:
+            raise ValueError(f"{path}: column {name} has an unknown type {column_type}")
+        dtype = np.dtype(order + COLUMN_TYPES[column_type])
+        if dtype.itemsize != value_size:
+            raise ValueError(f"{path}: column {name} has a wrong value size {value_size}")
+        if row_count == 0:
+            columns[name] = np.empty(0, dtype=dtype)
+        else:
+            columns[name] = np.memmap(path, dtype=dtype, mode="r", offset=offset, shape=(row_count,))
+    return columns
+
+
+def main():
+    if len(sys.argv) != 2:
+        print(f"usage: {sys.argv[0]} file.bcol", file=sys.stderr)
+        return 1
+    columns = read_columnar(sys.argv[1])
+    for name, values in columns.items():
+        print(f"{name}: {values.dtype} x {len(values)}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
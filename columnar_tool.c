@@ -0,0 +1,166 @@
+/**
+ * @file columnar_tool.c
+ * @brief Implementation file of the columnar_tool header
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#include "columnar_tool.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, rounds an offset up to COLUMNAR_ALIGNMENT
+ */
+static inline uint64_t align_offset(uint64_t offset)
+{
+    return (offset + COLUMNAR_ALIGNMENT - 1) & ~(uint64_t)(COLUMNAR_ALIGNMENT - 1);
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, writes zeros up to the next COLUMNAR_ALIGNMENT offset
+ */
+static bool write_padding(FILE* file, uint64_t *position)
+{
+    static const unsigned char zeros[COLUMNAR_ALIGNMENT] = { 0 };
+    size_t padding = (size_t)(align_offset(*position) - *position);
+
+    if (padding > 0 && fwrite(zeros, 1, padding, file) != padding) return false;
+    *position += padding;
+    return true;
+}
+
+//////////////////////////////////////////
+
+size_t columnar_type_size(ColumnarType type)
+{
+    switch (type)
+    {
+        case COLUMNAR_UINT16:
+        case COLUMNAR_INT16:
+            return 2;
+        case COLUMNAR_UINT32:
+        case COLUMNAR_INT32:
+        case COLUMNAR_FLOAT32:
+            return 4;
+        case COLUMNAR_FLOAT64:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+//////////////////////////////////////////
+
+int write_array_to_columnar
+(
+    const char* filename,
+    const void* array_ptr,
+    size_t array_length,
+    size_t element_size,
+    const ColumnarColumn* columns,
+    size_t column_count
+)
+{
+    if (!filename || (!array_ptr && array_length > 0) || element_size == 0 || !columns || column_count == 0 ||
+        column_count > UINT32_MAX)
+    {
+        fprintf(stderr, "Error: Invalid argument(s) passed to write_array_to_columnar.\n");
+        return -1;
+    }
+
+    for (size_t c = 0; c < column_count; ++c)
+    {
+        size_t value_size = columnar_type_size(columns[c].type);
+        if (!columns[c].name || strlen(columns[c].name) >= COLUMNAR_MAX_NAME || value_size == 0 ||
+            columns[c].offset + value_size > element_size)
+        {
+            fprintf(stderr, "Error: Invalid column %zu passed to write_array_to_columnar.\n", c);
+            return -1;
+        }
+    }
+
+    // the whole layout is known before writing anything
+    ColumnarFileHeader header;
+    memset(&header, 0, sizeof header);
+    memcpy(header.magic, COLUMNAR_MAGIC, sizeof COLUMNAR_MAGIC);
+    header.byte_order_mark = COLUMNAR_BYTE_ORDER_MARK;
+    header.column_count = (uint32_t)column_count;
+    header.row_count = array_length;
+
+    uint64_t data_offset = align_offset(COLUMNAR_HEADER_SIZE + (uint64_t)column_count * COLUMNAR_DESCRIPTOR_SIZE);
+    if (data_offset > UINT32_MAX) return -1;
+    header.data_offset = (uint32_t)data_offset;
+
+    ColumnarColumnDescriptor *descriptors = (ColumnarColumnDescriptor*)calloc(column_count, sizeof *descriptors);
+    unsigned char *block = (unsigned char*)malloc(COLUMNAR_GATHER_BLOCK * sizeof(double));
+    if (!descriptors || !block)
+    {
+        fprintf(stderr, "Error: Cannot allocate the columnar buffers\n");
+        free(descriptors);
+        free(block);
+        return -1;
+    }
+
+    uint64_t offset = data_offset;
+    for (size_t c = 0; c < column_count; ++c)
+    {
+        strcpy(descriptors[c].name, columns[c].name);
+        descriptors[c].type = (uint32_t)columns[c].type;
+        descriptors[c].value_size = (uint32_t)columnar_type_size(columns[c].type);
+        descriptors[c].offset = offset;
+        offset = align_offset(offset + (uint64_t)descriptors[c].value_size * array_length);
+    }
+
+    FILE* file = fopen(filename, "wb");
+    if (file == NULL)
+    {
+        fprintf(stderr, "Error: Cannot open file \"%s\" for writing\n", filename);
+        free(descriptors);
+        free(block);
+        return -1;
+    }
+
+    uint64_t position = 0;
+    bool write_ok = fwrite(&header, sizeof header, 1, file) == 1 &&
+                    fwrite(descriptors, sizeof *descriptors, column_count, file) == column_count;
+    position = COLUMNAR_HEADER_SIZE + (uint64_t)column_count * COLUMNAR_DESCRIPTOR_SIZE;
+    write_ok = write_ok && write_padding(file, &position);
+
+    // each column is gathered from the array in blocks, and written with one fwrite per block
+    const unsigned char* elements = (const unsigned char*)array_ptr;
+    for (size_t c = 0; write_ok && c < column_count; ++c)
+    {
+        const size_t value_size = descriptors[c].value_size;
+
+        for (size_t row = 0; write_ok && row < array_length; row += COLUMNAR_GATHER_BLOCK)
+        {
+            size_t block_rows = array_length - row < COLUMNAR_GATHER_BLOCK ? array_length - row : COLUMNAR_GATHER_BLOCK;
+            const unsigned char* source = elements + row * element_size + columns[c].offset;
+
+            for (size_t i = 0; i < block_rows; ++i)
+            {
+                memcpy(block + i * value_size, source + i * element_size, value_size);
+            }
+            write_ok = fwrite(block, value_size, block_rows, file) == block_rows;
+        }
+        position += (uint64_t)value_size * array_length;
+        write_ok = write_ok && write_padding(file, &position);
+    }
+
+    if (fclose(file) != 0) write_ok = false;
+    if (!write_ok) fprintf(stderr, "Error: Failed to write the columnar file \"%s\"\n", filename);
+
+    free(descriptors);
+    free(block);
+    return write_ok ? 1 : -1;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file columnar_tool.h
+ * @brief Header of a generic columnar binary writer for data arrays, sibling of csv_tool
+ *
+ *  Writes each field of an array of structs as one contiguous column of raw values, after a small
+ *  header, so the files can be memory mapped (e.g. numpy.memmap, see columnar_reader.py) with zero
+ *  parsing, and keep the full float precision.
+ *
+ *  File layout (all the header integers, and the column values, in the byte order of the writer host):
+ *      ColumnarFileHeader                      COLUMNAR_HEADER_SIZE bytes
+ *      ColumnarColumnDescriptor[column_count]  COLUMNAR_DESCRIPTOR_SIZE bytes each
+ *      padding to COLUMNAR_ALIGNMENT
+ *      column values                           each column starts at a COLUMNAR_ALIGNMENT offset
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#ifndef COLUMNAR_TOOL_H_INCLUDED
+#define COLUMNAR_TOOL_H_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define COLUMNAR_MAGIC "BRCOLV1"                // 7 chars + '\0'
+#define COLUMNAR_BYTE_ORDER_MARK 0x01020304u    // read back as 0x04030201 by a host of the other byte order
+#define COLUMNAR_ALIGNMENT 64                   // start of every column, a cache line
+#define COLUMNAR_MAX_NAME 32                    // including the '\0'
+#define COLUMNAR_HEADER_SIZE 32
+#define COLUMNAR_DESCRIPTOR_SIZE 48
+#define COLUMNAR_GATHER_BLOCK 4096              // values gathered from the array per fwrite
+
+/**
+    @enum type of the values of a column
+    @note the values are part of the file format, don't reorder them
+**/
+typedef enum
+{
+    COLUMNAR_UINT32 = 1,
+    COLUMNAR_INT32 = 2,
+    COLUMNAR_FLOAT32 = 3,
+    COLUMNAR_FLOAT64 = 4,
+    COLUMNAR_UINT16 = 5,
+    COLUMNAR_INT16 = 6
+} ColumnarType;
+
+/**
+ * @struct ColumnarFileHeader
+ * @brief  First bytes of the file
+ */
+typedef struct COLUMNAR_FILE_HEADER
+{
+    char        magic[8];                   // COLUMNAR_MAGIC
+    uint32_t    byte_order_mark;            // COLUMNAR_BYTE_ORDER_MARK
+    uint32_t    column_count;
+    uint64_t    row_count;
+    uint32_t    data_offset;                // offset of the first column, header and descriptors included
+    uint32_t    reserved;
+} ColumnarFileHeader;
+
+/**
+ * @struct ColumnarColumnDescriptor
+ * @brief  One per column, after the file header
+ */
+typedef struct COLUMNAR_COLUMN_DESCRIPTOR
+{
+    char        name[COLUMNAR_MAX_NAME];
+    uint32_t    type;                       // ColumnarType
+    uint32_t    value_size;                 // bytes of one value
+    uint64_t    offset;                     // offset of the first value in the file
+} ColumnarColumnDescriptor;
+
+_Static_assert(sizeof(ColumnarFileHeader) == COLUMNAR_HEADER_SIZE, "columnar file header size is part of the format");
+_Static_assert(sizeof(ColumnarColumnDescriptor) == COLUMNAR_DESCRIPTOR_SIZE, "columnar descriptor size is part of the format");
+
+/**
+ * @struct ColumnarColumn
+ * @brief  Describes where a column comes from inside the elements of the array
+ */
+typedef struct COLUMNAR_COLUMN
+{
+    const char     *name;                   // up to COLUMNAR_MAX_NAME - 1 chars
+    ColumnarType    type;
+    size_t          offset;                 // offset of the field inside the element (use offsetof)
+} ColumnarColumn;
+
+/**
+ * @brief Writes an array of data to a columnar binary file
+ *
+ * @param[in] filename          The name of the file to create or overwrite.
+ * @param[in] array_ptr         A void* pointer to the beginning of the data array.
+ * @param[in] array_length      The number of elements in the array.
+ * @param[in] element_size      The size of a single element in the array
+ * @param[in] columns           The fields to write, one column each, in this order
+ * @param[in] column_count      Number of columns
+ *
+ * @return int 1 on success, -1 on error.
+ */
+int write_array_to_columnar
+(
+    const char* filename,
+    const void* array_ptr,
+    size_t array_length,
+    size_t element_size,
+    const ColumnarColumn* columns,
+    size_t column_count
+);
+
+/**
+ * @brief Size in bytes of one value of a type, 0 for an unknown type
+ */
+size_t columnar_type_size(ColumnarType type);
+
+#endif // COLUMNAR_TOOL_H
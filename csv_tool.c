@@ -12,31 +12,379 @@
 #include "csv_tool.h"
 
 #include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 #include <stdlib.h>
 
+#define CSV_INSERT_SCAN_BLOCK (64u << 10) // bytes read at a time when searching the rows backwards
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, writes the buffered lines to the file with a single fwrite
+ */
+static int flush_output_buffer(CsvWriter* writer)
+{
+    if (writer->output_length == 0) return 1;
+
+    size_t written = fwrite(writer->output_buffer, 1, writer->output_length, writer->file);
+    if (written != writer->output_length)
+    {
+        fprintf(stderr, "Error: Failed to write %zu bytes of CSV lines.\n", writer->output_length - written);
+        writer->output_length = 0;
+        return -1;
+    }
+    writer->output_length = 0;
+    return 1;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, appends text to the output buffer, flushing it when full
+ */
+static int append_output(CsvWriter* writer, const char* text, size_t length)
+{
+    while (length > 0)
+    {
+        if (writer->output_length == CSV_OUTPUT_BUFFER_SIZE && flush_output_buffer(writer) < 0) return -1;
+
+        size_t room = CSV_OUTPUT_BUFFER_SIZE - writer->output_length;
+        size_t chunk = length < room ? length : room;
+
+        memcpy(writer->output_buffer + writer->output_length, text, chunk);
+        writer->output_length += chunk;
+        text += chunk;
+        length -= chunk;
+    }
+    return 1;
+}
+
 //////////////////////////////////////////
 
 /**
  * @brief Internal (not exposed in the header) helper function to write the header row using variable arguments
  */
-int write_header(FILE* file, const char* first_column_name, va_list args) {
+static int write_header(CsvWriter* writer, const char* first_column_name, va_list args) {
     int total_chars = 0;
     const char* current_column = first_column_name;
 
-    if (current_column) {
-        total_chars += fprintf(file, "%s", current_column);
-    } else {
+    if (!current_column) return -1;
+
+    do {
+        if (total_chars > 0) {
+            if (append_output(writer, SEPARATOR, strlen(SEPARATOR)) < 0) return -1;
+            total_chars += (int)strlen(SEPARATOR);
+        }
+        size_t length = strlen(current_column);
+        if (append_output(writer, current_column, length) < 0) return -1;
+        total_chars += (int)length;
+    } while ((current_column = va_arg(args, const char*)) != NULL);
+
+    if (append_output(writer, "\n", 1) < 0) return -1;
+
+    return total_chars + 1;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal (not exposed in the header) helper function to write the header row from an array of names
+ */
+static int write_header_names(CsvWriter* writer, const char* const* column_names, size_t column_count)
+{
+    int total_chars = 0;
+
+    for (size_t c = 0; c < column_count; ++c)
+    {
+        if (!column_names[c]) return -1;
+        if (c > 0)
+        {
+            if (append_output(writer, SEPARATOR, strlen(SEPARATOR)) < 0) return -1;
+            total_chars += (int)strlen(SEPARATOR);
+        }
+        size_t length = strlen(column_names[c]);
+        if (append_output(writer, column_names[c], length) < 0) return -1;
+        total_chars += (int)length;
+    }
+
+    if (append_output(writer, "\n", 1) < 0) return -1;
+
+    return total_chars + 1;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, allocates the output buffer and opens the file, before the header is written
+ *
+ * @param[in] mode      "w" to create the file, "r+" to write over an existing one
+ */
+static int csv_writer_start(CsvWriter* writer, const char* filename, const char* mode, CsvLineFormatter formatter, int precision)
+{
+    writer->output_buffer = (char*)malloc(CSV_OUTPUT_BUFFER_SIZE);
+    writer->output_length = 0;
+
+    if (writer->output_buffer == NULL)
+    {
+        fprintf(stderr, "Error: Cannot allocate the CSV output buffer\n");
+        writer->file = NULL;
+        return -1;
+    }
+
+    writer->file = fopen(filename, mode);
+
+    if (writer->file == NULL)
+    {
+        fprintf(stderr, "Error: Cannot open file \"%s\" for writing\n", filename);
+        free(writer->output_buffer);
+        writer->output_buffer = NULL;
         return -1;
     }
 
-    while ((current_column = va_arg(args, const char*)) != NULL) {
-        total_chars += fprintf(file, "%s%s", SEPARATOR, current_column);
+    // the output buffer already collects the lines, a second copy in the stdio buffer is not needed
+    setvbuf(writer->file, NULL, _IONBF, 0);
+
+    writer->formatter = formatter;
+    writer->precision = precision;
+    writer->rows_written = 0;
+    return 1;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, undoes csv_writer_start when the header could not be written
+ */
+static int csv_writer_abort_header(CsvWriter* writer)
+{
+    fprintf(stderr, "warning: Failed to write CSV header.\n");
+    fclose(writer->file);
+    writer->file = NULL;
+    free(writer->output_buffer);
+    writer->output_buffer = NULL;
+    return -1;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, csv_writer_open with the column names as a va_list
+ */
+static int csv_writer_open_list
+(
+    CsvWriter* writer,
+    const char* filename,
+    CsvLineFormatter formatter,
+    int precision,
+    const char* first_column_name,
+    va_list args
+)
+{
+    // the formatter can be NULL here, when only batches are written
+    if (!writer || !filename || !first_column_name)
+    {
+        fprintf(stderr, "Error: Invalid argument(s) passed to csv_writer_open.\n");
+        return -1;
     }
 
-    total_chars += fprintf(file, "\n");
+    if (csv_writer_start(writer, filename, "w", formatter, precision) < 0) return -1;
 
-    return total_chars;
+    if (write_header(writer, first_column_name, args) < 0) return csv_writer_abort_header(writer);
+    return 1;
+}
+
+//////////////////////////////////////////
+
+int csv_writer_open
+(
+    CsvWriter* writer,
+    const char* filename,
+    CsvLineFormatter formatter,
+    int precision,
+    const char* first_column_name,
+    ...
+)
+{
+    if (!formatter)
+    {
+        fprintf(stderr, "Error: Invalid argument(s) passed to csv_writer_open.\n");
+        return -1;
+    }
+
+    va_list args;
+    va_start(args, first_column_name);
+
+    int result = csv_writer_open_list(writer, filename, formatter, precision, first_column_name, args);
+
+    va_end(args);
+    return result;
+}
+
+//////////////////////////////////////////
+
+int csv_writer_open_columns
+(
+    CsvWriter* writer,
+    const char* filename,
+    int precision,
+    const char* const* column_names,
+    size_t column_count
+)
+{
+    if (!writer || !filename || !column_names || column_count == 0)
+    {
+        fprintf(stderr, "Error: Invalid argument(s) passed to csv_writer_open_columns.\n");
+        return -1;
+    }
+
+    if (csv_writer_start(writer, filename, "w", NULL, precision) < 0) return -1;
+
+    if (write_header_names(writer, column_names, column_count) < 0) return csv_writer_abort_header(writer);
+    return 1;
+}
+
+//////////////////////////////////////////
+
+int csv_writer_write(CsvWriter* writer, const void* element_ptr)
+{
+    if (!writer || !writer->file || !writer->formatter || !element_ptr) return -1;
+
+    // room for a whole line and its '\n', so the formatter can write in place
+    if (CSV_OUTPUT_BUFFER_SIZE - writer->output_length < MAX_LINE_BUFFER + 1 && flush_output_buffer(writer) < 0)
+    {
+        fprintf(stderr, "Error: Failed to write full line for element %zu.\n", writer->rows_written);
+        return -1;
+    }
+
+    // Usage of the custom function to print the CSV line
+    char* line = writer->output_buffer + writer->output_length;
+    int len = writer->formatter(element_ptr, line, MAX_LINE_BUFFER, writer->precision);
+
+    if (len < 0)
+    {
+        fprintf(stderr, "Warning: Formatting failed for element %zu. Skipping.\n", writer->rows_written);
+        return 0;
+    }
+
+    line[len] = '\n';
+    writer->output_length += (size_t)len + 1;
+
+    writer->rows_written++;
+    return 1;
+}
+
+//////////////////////////////////////////
+
+int csv_writer_write_array
+(
+    CsvWriter* writer,
+    const void* array_ptr,
+    size_t array_length,
+    size_t element_size,
+    CsvBatchFormatter batch_formatter
+)
+{
+    if (!writer || !writer->file || !batch_formatter || (!array_ptr && array_length > 0)) return -1;
+
+    const char* current_element_ptr = (const char*)array_ptr;
+    size_t done = 0;
+
+    while (done < array_length)
+    {
+        if (CSV_OUTPUT_BUFFER_SIZE - writer->output_length < MAX_LINE_BUFFER + 1 && flush_output_buffer(writer) < 0) return -1;
+
+        size_t bytes_written = 0;
+        size_t rows = batch_formatter(current_element_ptr + done * element_size, array_length - done,
+                                      writer->output_buffer + writer->output_length,
+                                      CSV_OUTPUT_BUFFER_SIZE - writer->output_length,
+                                      writer->precision, &bytes_written);
+        if (rows == 0)
+        {
+            fprintf(stderr, "Error: Failed to format element %zu.\n", writer->rows_written);
+            return -1;
+        }
+
+        writer->output_length += bytes_written;
+        writer->rows_written += rows;
+        done += rows;
+    }
+    return 1;
+}
+
+//////////////////////////////////////////
+
+int csv_writer_write_text(CsvWriter* writer, const char* text, size_t length, size_t rows)
+{
+    if (!writer || !writer->file || (!text && length > 0)) return -1;
+
+    if (append_output(writer, text, length) < 0) return -1;
+    writer->rows_written += rows;
+    return 1;
+}
+
+//////////////////////////////////////////
+
+int csv_writer_flush(CsvWriter* writer)
+{
+    if (!writer || !writer->file) return -1;
+
+    if (flush_output_buffer(writer) < 0 || fflush(writer->file) != 0) return -1;
+    return 1;
+}
+
+//////////////////////////////////////////
+
+int csv_writer_reopen
+(
+    CsvWriter* writer,
+    const char* filename,
+    CsvLineFormatter formatter,
+    int precision,
+    long offset,
+    size_t rows_before
+)
+{
+    if (!writer || !filename || !formatter || offset < 0)
+    {
+        fprintf(stderr, "Error: Invalid argument(s) passed to csv_writer_reopen.\n");
+        return -1;
+    }
+
+    if (csv_writer_start(writer, filename, "r+", formatter, precision) < 0) return -1;
+
+    if (fseek(writer->file, offset, SEEK_SET) != 0)
+    {
+        fprintf(stderr, "Error: Cannot seek file \"%s\" to %ld\n", filename, offset);
+        csv_writer_close(writer);
+        return -1;
+    }
+    writer->rows_written = rows_before;
+    return 1;
+}
+
+//////////////////////////////////////////
+
+long csv_writer_tell(CsvWriter* writer)
+{
+    if (!writer || !writer->file || flush_output_buffer(writer) < 0) return -1;
+    return ftell(writer->file);
+}
+
+//////////////////////////////////////////
+
+int csv_writer_close(CsvWriter* writer)
+{
+    if (!writer || !writer->file) return -1;
+
+    int result = flush_output_buffer(writer);
+    if (fclose(writer->file) != 0) result = -1;
+    writer->file = NULL;
+
+    free(writer->output_buffer);
+    writer->output_buffer = NULL;
+    return result;
 }
 
 //////////////////////////////////////////
@@ -58,55 +406,321 @@ int write_array_to_csv(
         return -1;
     }
 
-    FILE *csv_file = fopen(filename, "w");
+    CsvWriter writer;
 
-    if (csv_file == NULL)
+    va_list args;
+    va_start(args, first_column_name);
+
+    int open_result = csv_writer_open_list(&writer, filename, formatter, precision, first_column_name, args);
+
+    va_end(args);
+
+    if (open_result < 0) return -1;
+
+    const char* current_element_ptr = (const char*)array_ptr;
+
+    for (size_t i = 0; i < array_length; ++i)
     {
-        fprintf(stderr, "Error: Cannot open file \"%s\" for writing\n", filename);
+        const void* element_ptr = current_element_ptr + (i * element_size);
+
+        if (csv_writer_write(&writer, element_ptr) < 0)
+        {
+            csv_writer_close(&writer);
+            return -1;
+        }
+    }
+
+    return csv_writer_close(&writer);
+}
+
+//////////////////////////////////////////
+
+int write_array_to_csv_batch(
+    const char* filename,
+    const void* array_ptr,
+    size_t array_length,
+    size_t element_size,
+    CsvBatchFormatter batch_formatter,
+    int precision,
+    const char* first_column_name,
+    ...
+)
+{
+    if (!array_ptr || !filename || !batch_formatter || array_length == 0 || element_size == 0 || !first_column_name)
+    {
+        fprintf(stderr, "Error: Invalid argument(s) passed to write_array_to_csv_batch.\n");
         return -1;
     }
 
+    CsvWriter writer;
+
     va_list args;
     va_start(args, first_column_name);
 
-    int header_result = write_header(csv_file, first_column_name, args);
+    int open_result = csv_writer_open_list(&writer, filename, NULL, precision, first_column_name, args);
 
     va_end(args);
 
-    if (header_result < 0)
+    if (open_result < 0) return -1;
+
+    if (csv_writer_write_array(&writer, array_ptr, array_length, element_size, batch_formatter) < 0)
     {
-        fprintf(stderr, "warning: Failed to write CSV header.\n");
-        fclose(csv_file);
+        csv_writer_close(&writer);
         return -1;
     }
 
-    char csv_line_buffer[MAX_LINE_BUFFER];
-    const char* current_element_ptr = (const char*)array_ptr;
+    return csv_writer_close(&writer);
+}
 
-    for (size_t i = 0; i < array_length; ++i)
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, reads the unsigned integer of the first column of a line
+ */
+static bool parse_row_key(const char* line, size_t length, uint32_t* key)
+{
+    uint64_t value = 0;
+    size_t i = 0;
+
+    while (i < length && line[i] >= '0' && line[i] <= '9')
     {
+        value = value * 10 + (uint64_t)(line[i] - '0');
+        if (value > UINT32_MAX) return false;
+        ++i;
+    }
+    if (i == 0) return false;
 
-        const void* element_ptr = current_element_ptr + (i * element_size);
+    *key = (uint32_t)value;
+    return true;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, offset of the first row with a key not smaller than key, searched from the end.
+ *        The first line of the file is the header, the offset is never before its end
+ *
+ * @return the offset, or -1 on a read error or a line that doesn't start with a key
+ */
+static long find_first_row_from(FILE* file, long size, uint32_t key, char* block)
+{
+    long end = size;                    // the block always ends at the start of a line, or of the file end
+
+    while (end > 0)
+    {
+        const long start = end > (long)CSV_INSERT_SCAN_BLOCK ? end - (long)CSV_INSERT_SCAN_BLOCK : 0;
+        const size_t length = (size_t)(end - start);
 
-        // Usage of the custom function to print the CSV line
-        int len = formatter(element_ptr, csv_line_buffer, MAX_LINE_BUFFER, precision);
+        if (fseek(file, start, SEEK_SET) != 0 || fread(block, 1, length, file) != length) return -1;
 
-        if (len < 0)
+        // the lines starting inside the block, from the last one
+        size_t line_end = length;
+        for (size_t i = length; i-- > 0;)
         {
-            fprintf(stderr, "Warning: Formatting failed for element %zu. Skipping.\n", i);
-            continue;
+            if (block[i] != '\n' || i + 1 == line_end) continue;
+
+            uint32_t row_key;
+            if (!parse_row_key(block + i + 1, line_end - i - 1, &row_key)) return -1;
+            if (row_key < key) return start + (long)line_end;
+            line_end = i + 1;
         }
 
-        int write_result = fprintf(csv_file, "%s\n", csv_line_buffer);
+        // the rest of the block is the header, or a line that starts in the block before
+        if (start == 0) return (long)line_end;
+        if (line_end == length) return -1;
+        end = start + (long)line_end;
+    }
+    return 0;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, merges the rows of the tail of the file and the elements into merged
+ *
+ * @return false if a row of the tail doesn't start with a key
+ */
+static bool merge_sorted_rows
+(
+    const char* tail,
+    size_t tail_length,
+    const unsigned char* elements,
+    size_t count,
+    size_t element_size,
+    size_t key_offset,
+    CsvLineFormatter formatter,
+    int precision,
+    const char* terminator,
+    char* merged,
+    size_t* merged_length,
+    size_t* inserted
+)
+{
+    size_t position = 0;
+    size_t next = 0;
+
+    *merged_length = 0;
+    *inserted = 0;
+
+    while (position < tail_length || next < count)
+    {
+        const char* line = tail + position;
+        const char* line_end = position < tail_length ? (const char*)memchr(line, '\n', tail_length - position) : NULL;
+        size_t line_length = line_end ? (size_t)(line_end - line) + 1 : tail_length - position;
+        uint32_t row_key = 0;
+        uint32_t element_key = 0;
+
+        if (position < tail_length && !parse_row_key(line, line_length, &row_key)) return false;
+        if (next < count) memcpy(&element_key, elements + next * element_size + key_offset, sizeof element_key);
 
-        if (write_result < len)
+        if (next < count && (position == tail_length || element_key < row_key))
         {
-            fprintf(stderr, "Error: Failed to write full line for element %zu.\n", i);
-            fclose(csv_file);
-            return -1;
+            int len = formatter(elements + next * element_size, merged + *merged_length, MAX_LINE_BUFFER, precision);
+            if (len < 0)
+            {
+                fprintf(stderr, "Warning: Formatting failed for an element. Skipping.\n");
+            }
+            else
+            {
+                size_t terminator_length = strlen(terminator);
+                memcpy(merged + *merged_length + len, terminator, terminator_length);
+                *merged_length += (size_t)len + terminator_length;
+                (*inserted)++;
+            }
+            next++;
+            continue;
         }
+
+        // the row already in the file is kept
+        if (next < count && element_key == row_key) next++;
+
+        memcpy(merged + *merged_length, line, line_length);
+        *merged_length += line_length;
+        position += line_length;
     }
+    return true;
+}
 
-    fclose(csv_file);
-    return 1;
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, csv_insert_sorted_rows on an open file, with a scan block of CSV_INSERT_SCAN_BLOCK bytes
+ */
+static int insert_sorted_rows
+(
+    FILE* file,
+    const char* filename,
+    const unsigned char* elements,
+    size_t count,
+    size_t element_size,
+    size_t key_offset,
+    CsvLineFormatter formatter,
+    int precision,
+    char* block,
+    size_t* rows_inserted,
+    long* bytes_inserted
+)
+{
+    uint32_t first_key;
+    memcpy(&first_key, elements + key_offset, sizeof first_key);
+
+    long size;
+    if (fseek(file, 0, SEEK_END) != 0 || (size = ftell(file)) < 0) return -1;
+
+    long from = find_first_row_from(file, size, first_key, block);
+    if (from < 0)
+    {
+        fprintf(stderr, "Error: \"%s\" is not sorted by an integer first column.\n", filename);
+        return -1;
+    }
+
+    // the new rows use the line ending of the file
+    const char* terminator = "\n";
+    if (from >= 2 && fseek(file, from - 2, SEEK_SET) == 0 && fread(block, 1, 2, file) == 2 && block[0] == '\r')
+    {
+        terminator = "\r\n";
+    }
+
+    const size_t tail_length = (size_t)(size - from);
+    char* tail = (char*)malloc(tail_length + 1);
+    char* merged = (char*)malloc(tail_length + count * (MAX_LINE_BUFFER + 2));
+    size_t merged_length = 0;
+    int result = -1;
+
+    if (!tail || !merged)
+    {
+        fprintf(stderr, "Error: Cannot allocate the rows of \"%s\" to rewrite\n", filename);
+    }
+    else if (fseek(file, from, SEEK_SET) != 0 || fread(tail, 1, tail_length, file) != tail_length)
+    {
+        fprintf(stderr, "Error: Cannot read the rows of \"%s\" to rewrite\n", filename);
+    }
+    else if (!merge_sorted_rows(tail, tail_length, elements, count, element_size, key_offset, formatter, precision,
+                                terminator, merged, &merged_length, rows_inserted))
+    {
+        fprintf(stderr, "Error: \"%s\" is not sorted by an integer first column.\n", filename);
+    }
+    else if (fseek(file, from, SEEK_SET) != 0 || fwrite(merged, 1, merged_length, file) != merged_length)
+    {
+        fprintf(stderr, "Error: Failed to write %zu bytes of CSV lines.\n", merged_length);
+    }
+    else
+    {
+        *bytes_inserted = (long)(merged_length - tail_length);
+        result = 1;
+    }
+
+    free(tail);
+    free(merged);
+    return result;
+}
+
+//////////////////////////////////////////
+
+int csv_insert_sorted_rows
+(
+    const char* filename,
+    const void* elements,
+    size_t count,
+    size_t element_size,
+    size_t key_offset,
+    CsvLineFormatter formatter,
+    int precision,
+    size_t* rows_inserted,
+    long* bytes_inserted
+)
+{
+    if (!filename || (!elements && count > 0) || !formatter || key_offset + sizeof(uint32_t) > element_size)
+    {
+        fprintf(stderr, "Error: Invalid argument(s) passed to csv_insert_sorted_rows.\n");
+        return -1;
+    }
+
+    size_t inserted = 0;
+    long grown = 0;
+
+    if (rows_inserted) *rows_inserted = 0;
+    if (bytes_inserted) *bytes_inserted = 0;
+    if (count == 0) return 1;
+
+    // binary mode: the bytes of the rows kept are copied as they are, '\r' included
+    FILE* file = fopen(filename, "r+b");
+    if (!file)
+    {
+        fprintf(stderr, "Error: Cannot open file \"%s\" for writing\n", filename);
+        return -1;
+    }
+
+    char* block = (char*)malloc(CSV_INSERT_SCAN_BLOCK);
+    int result = block ? insert_sorted_rows(file, filename, (const unsigned char*)elements, count, element_size, key_offset,
+                                            formatter, precision, block, &inserted, &grown) : -1;
+    free(block);
+    if (fclose(file) != 0) result = -1;
+
+    if (result == 1)
+    {
+        if (rows_inserted) *rows_inserted = inserted;
+        if (bytes_inserted) *bytes_inserted = grown;
+    }
+    return result;
 }
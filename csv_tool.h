@@ -17,6 +17,7 @@
 
 #define MAX_LINE_BUFFER 256 // A default max size for the buffer
 #define SEPARATOR ";"
+#define CSV_OUTPUT_BUFFER_SIZE (1u << 18) // the lines are collected here and written with one fwrite per buffer
 
 /**
  * @brief Type definition for the required callback function.
@@ -40,6 +41,214 @@ typedef int (*CsvLineFormatter)
     int precision
 );
 
+/**
+ * @brief Type definition for the batch callback, formats many elements of an array per call.
+ *
+ * Same output as calling a CsvLineFormatter per element, but each line ends with '\n'.
+ * Stops before the line that could not fit in the buffer, so the writer can flush and call again.
+ *
+ * @param[in]  array_ptr        A void* pointer to the first element to format.
+ * @param[in]  count            Number of elements available.
+ * @param[out] buffer           A character buffer to write the CSV lines into (no '\0' is added).
+ * @param[in]  buffer_size      The size of the buffer, at least MAX_LINE_BUFFER + 1
+ * @param[in]  precision        The amount of decimals to print for float values
+ * @param[out] bytes_written    Number of chars written to the buffer
+ *
+ * @return size_t               Number of elements formatted
+ */
+typedef size_t (*CsvBatchFormatter)
+(
+    const void* array_ptr,
+    size_t count,
+    char* buffer,
+    size_t buffer_size,
+    int precision,
+    size_t* bytes_written
+);
+
+/**
+ * @struct CsvWriter
+ * @brief  Holds an open CSV file to write one element at a time (streaming mode)
+ *
+ * @note The formatter writes each line straight into output_buffer, which goes to the (unbuffered)
+ *       file when less than MAX_LINE_BUFFER bytes are left, and on close
+ */
+typedef struct CSV_WRITER
+{
+    FILE               *file;
+    CsvLineFormatter    formatter;
+    int                 precision;
+    size_t              rows_written;
+    char               *output_buffer;          // CSV_OUTPUT_BUFFER_SIZE bytes
+    size_t              output_length;          // bytes waiting in output_buffer
+} CsvWriter;
+
+/**
+ * @brief Opens a CSV file and writes the header row
+ *
+ * @param[out] writer            Pointer to the writer to initialize
+ * @param[in] filename          The name of the file to create or overwrite.
+ * @param[in] formatter         The callback function that converts an element to a CSV string.
+ * @param[in] precision         The amount of decimals to print for float values
+ * @param[in] first_column_name The first column name string (required to start the variable list).
+ * @param[in] ...               Remaining column name strings (char*). The list must be terminated by a NULL pointer.
+ *
+ * @return int 1 on success, -1 on error.
+ */
+int csv_writer_open
+(
+    CsvWriter* writer,
+    const char* filename,
+    CsvLineFormatter formatter,
+    int precision,
+    const char* first_column_name,
+    ... // variable number of column name strings, end with NULL
+);
+
+/**
+ * @brief Opens a CSV file and writes the header row, with the column names known at run time
+ *
+ *  There is no line formatter, the lines are given with csv_writer_write_text or csv_writer_write_array
+ *
+ * @param[out] writer           Pointer to the writer to initialize
+ * @param[in] filename          The name of the file to create or overwrite.
+ * @param[in] precision         The amount of decimals to print for float values, given to the batch formatters
+ * @param[in] column_names      The column names, in order
+ * @param[in] column_count      Number of column names, at least 1
+ *
+ * @return int 1 on success, -1 on error.
+ */
+int csv_writer_open_columns
+(
+    CsvWriter* writer,
+    const char* filename,
+    int precision,
+    const char* const* column_names,
+    size_t column_count
+);
+
+/**
+ * @brief Formats and writes one element as a CSV line
+ *
+ * @param[in,out] writer        Pointer to an open writer
+ * @param[in] element_ptr       A void* pointer to the element to write
+ *
+ * @return int 1 on success, 0 if the element could not be formatted (skipped), -1 on write error.
+ */
+int csv_writer_write(CsvWriter* writer, const void* element_ptr);
+
+/**
+ * @brief Formats and writes an array of elements with a batch formatter
+ *
+ * @param[in,out] writer        Pointer to an open writer
+ * @param[in] array_ptr         A void* pointer to the beginning of the data array.
+ * @param[in] array_length      The number of elements in the array.
+ * @param[in] element_size      The size of a single element in the array
+ * @param[in] batch_formatter   The callback function that converts many elements to CSV lines.
+ *
+ * @return int 1 on success, -1 on write error.
+ */
+int csv_writer_write_array
+(
+    CsvWriter* writer,
+    const void* array_ptr,
+    size_t array_length,
+    size_t element_size,
+    CsvBatchFormatter batch_formatter
+);
+
+/**
+ * @brief Writes lines already formatted by the caller
+ *
+ * @param[in,out] writer        Pointer to an open writer
+ * @param[in] text              The CSV lines, each one ending with '\n'
+ * @param[in] length            Number of chars of text
+ * @param[in] rows              Number of lines in text, added to rows_written
+ *
+ * @return int 1 on success, -1 on write error.
+ */
+int csv_writer_write_text(CsvWriter* writer, const char* text, size_t length, size_t rows);
+
+/**
+ * @brief Writes the buffered lines to the file now, so a reader of the file sees them (live mode)
+ *
+ * @param[in,out] writer        Pointer to an open writer
+ *
+ * @return int 1 on success, -1 on write error.
+ */
+int csv_writer_flush(CsvWriter* writer);
+
+/**
+ * @brief Opens an existing CSV file without writing the header, the next rows overwrite it from offset
+ *
+ *  Used to continue a file written by a previous run (incremental mode). The rows from offset
+ *  on are expected to be written again, so the file is never shorter than before
+ *
+ * @param[out] writer           Pointer to the writer to initialize
+ * @param[in] filename          The name of the existing file
+ * @param[in] formatter         The callback function that converts an element to a CSV string
+ * @param[in] precision         The amount of decimals to print for float values
+ * @param[in] offset            Position of the first row to write, as given by csv_writer_tell
+ * @param[in] rows_before       Rows before offset, the initial rows_written
+ *
+ * @return int 1 on success, -1 on error.
+ */
+int csv_writer_reopen
+(
+    CsvWriter* writer,
+    const char* filename,
+    CsvLineFormatter formatter,
+    int precision,
+    long offset,
+    size_t rows_before
+);
+
+/**
+ * @brief Writes the buffered lines and returns the position of the next row in the file
+ *
+ * @return Offset in bytes, or -1 on error.
+ */
+long csv_writer_tell(CsvWriter* writer);
+
+/**
+ * @brief Inserts rows in a closed CSV file sorted by its first column, an unsigned integer (e.g. rtc_s)
+ *
+ *  Only the part of the file from the first row not smaller than the first element is read and written
+ *  again, it is searched backwards from the end of the file. A row already in the file with the key of an
+ *  element is kept, and the element dropped
+ *
+ * @param[in] filename          The name of the file
+ * @param[in] elements          Elements sorted by their key, without repeated keys
+ * @param[in] count             Number of elements
+ * @param[in] element_size      The size of a single element
+ * @param[in] key_offset        Offset of the uint32_t key inside the element (use offsetof)
+ * @param[in] formatter         The callback function that converts an element to a CSV string
+ * @param[in] precision         The amount of decimals to print for float values
+ * @param[out] rows_inserted    Elements written to the file
+ * @param[out] bytes_inserted   Bytes the file grew by
+ *
+ * @return int 1 on success, -1 on error (the file is only written once the new part is complete in memory).
+ */
+int csv_insert_sorted_rows
+(
+    const char* filename,
+    const void* elements,
+    size_t count,
+    size_t element_size,
+    size_t key_offset,
+    CsvLineFormatter formatter,
+    int precision,
+    size_t* rows_inserted,
+    long* bytes_inserted
+);
+
+/**
+ * @brief Writes the buffered lines and closes the file of the writer
+ *
+ * @return int 1 on success, -1 on error.
+ */
+int csv_writer_close(CsvWriter* writer);
+
 /**
  * @brief Writes an array of data to a CSV file
  *
@@ -70,4 +279,30 @@ int write_array_to_csv
     ... // variable number of column name strings, end with NULL
 );
 
+/**
+ * @brief Same as write_array_to_csv, using a batch formatter instead of one call per line
+ *
+ * @param[in] filename          The name of the file to create or overwrite.
+ * @param[in] array_ptr         A void* pointer to the beginning of the data array.
+ * @param[in] array_length      The number of elements in the array.
+ * @param[in] element_size      The size of a single element in the array
+ * @param[in] batch_formatter   The callback function that converts many elements to CSV lines.
+ * @param[in] precision         The amount of decimals to print for float values
+ * @param[in] first_column_name The first column name string (required to start the variable list).
+ * @param[in] ...               Remaining column name strings (char*). The list must be terminated by a NULL pointer.
+ *
+ * @return int 1 on success, -1 on error.
+ */
+int write_array_to_csv_batch
+(
+    const char* filename,
+    const void* array_ptr,
+    size_t array_length,
+    size_t element_size,
+    CsvBatchFormatter batch_formatter,
+    int precision,
+    const char* first_column_name,
+    ... // variable number of column name strings, end with NULL
+);
+
 #endif // CSV_TOOL
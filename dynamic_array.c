@@ -0,0 +1,90 @@
+/**
+ * @file dynamic_array.c
+ * @brief Implementation file of the dynamic_array header
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#include "dynamic_array.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+//////////////////////////////////////////
+
+bool dynamic_array_init(DynamicArray *array, size_t element_size, size_t initial_capacity)
+{
+    return dynamic_array_init_arena(array, element_size, initial_capacity, NULL);
+}
+
+//////////////////////////////////////////
+
+bool dynamic_array_init_arena(DynamicArray *array, size_t element_size, size_t initial_capacity, Arena *arena)
+{
+    if (!array || element_size == 0) return false;
+
+    array->data = NULL;
+    array->length = 0;
+    array->capacity = 0;
+    array->element_size = element_size;
+    array->arena = arena;
+
+    return initial_capacity == 0 || dynamic_array_reserve(array, initial_capacity);
+}
+
+//////////////////////////////////////////
+
+bool dynamic_array_reserve(DynamicArray *array, size_t capacity)
+{
+    if (!array) return false;
+    if (capacity <= array->capacity) return true;
+    if (capacity > SIZE_MAX / array->element_size) return false;
+
+    void *temp_ptr;
+    if (array->arena)
+    {
+        // the old storage stays in the arena until it is reset
+        temp_ptr = arena_alloc(array->arena, capacity * array->element_size);
+        if (temp_ptr && array->length > 0) memcpy(temp_ptr, array->data, array->length * array->element_size);
+    }
+    else
+    {
+        temp_ptr = realloc(array->data, capacity * array->element_size);
+    }
+    if (!temp_ptr) return false;
+
+    array->data = temp_ptr;
+    array->capacity = capacity;
+    return true;
+}
+
+//////////////////////////////////////////
+
+bool dynamic_array_push(DynamicArray *array, const void *element)
+{
+    if (!array || !element) return false;
+
+    if (array->length == array->capacity)
+    {
+        size_t new_capacity = array->capacity ? array->capacity * DYNAMIC_ARRAY_GROWTH_FACTOR : DYNAMIC_ARRAY_MIN_CAPACITY;
+        if (new_capacity < array->capacity || !dynamic_array_reserve(array, new_capacity)) return false;
+    }
+
+    memcpy((unsigned char*)array->data + array->length * array->element_size, element, array->element_size);
+    array->length++;
+    return true;
+}
+
+//////////////////////////////////////////
+
+void dynamic_array_free(DynamicArray *array)
+{
+    if (!array) return;
+    if (!array->arena) free(array->data);
+    array->data = NULL;
+    array->length = 0;
+    array->capacity = 0;
+}
@@ -0,0 +1,76 @@
+/**
+ * @file dynamic_array.h
+ * @brief Header of a generic growable array
+ *
+ *  Elements are stored contiguously (so the data can be given to qsort or write_array_to_csv as is).
+ *  The capacity grows geometrically, so pushing n elements costs O(n) copies in total.
+ *  An array can also live in an arena (see arena.h): it grows by copying into a new arena allocation,
+ *  and is released with the arena instead of dynamic_array_free.
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#ifndef DYNAMIC_ARRAY_H_INCLUDED
+#define DYNAMIC_ARRAY_H_INCLUDED
+
+#include "arena.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define DYNAMIC_ARRAY_MIN_CAPACITY 128      // first allocation when no capacity is requested
+#define DYNAMIC_ARRAY_GROWTH_FACTOR 2
+
+/**
+ * @struct DynamicArray
+ * @brief  Contiguous elements of element_size bytes, length used out of capacity
+ */
+typedef struct DYNAMIC_ARRAY
+{
+    void   *data;
+    size_t  length;
+    size_t  capacity;
+    size_t  element_size;
+    Arena  *arena;                          // NULL: malloc'ed storage
+} DynamicArray;
+
+/**
+ * @brief Initializes an array, allocating initial_capacity elements (nothing if 0)
+ *
+ * @param[out] array            Pointer to the array to initialize
+ * @param[in]  element_size     Size of one element in bytes
+ * @param[in]  initial_capacity Elements to allocate up front, e.g. an estimation of the final length
+ *
+ * @return true on success, false if the memory could not be allocated
+ */
+bool dynamic_array_init(DynamicArray *array, size_t element_size, size_t initial_capacity);
+
+/**
+ * @brief Same as dynamic_array_init, with the storage allocated in an arena
+ *
+ * @param[in] arena             Arena that owns the memory, NULL for dynamic_array_init
+ */
+bool dynamic_array_init_arena(DynamicArray *array, size_t element_size, size_t initial_capacity, Arena *arena);
+
+/**
+ * @brief Makes sure the array can hold capacity elements without reallocating
+ *
+ * @return true on success, false if the memory could not be allocated (the array is left untouched)
+ */
+bool dynamic_array_reserve(DynamicArray *array, size_t capacity);
+
+/**
+ * @brief Copies an element at the end of the array, growing it if needed
+ *
+ * @return true on success, false if the memory could not be allocated (the array is left untouched)
+ */
+bool dynamic_array_push(DynamicArray *array, const void *element);
+
+/**
+ * @brief Releases the memory of the array (left to its arena, if any). Safe to call twice
+ */
+void dynamic_array_free(DynamicArray *array);
+
+#endif // DYNAMIC_ARRAY_H
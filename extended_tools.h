@@ -3,7 +3,8 @@
  * @brief Header of extended tools used
  *
  *  Contains a data definition for 3 byte non-standar types,
- *  a helper function to swap bytes, and a generic array deduplication tool
+ *  a helper function to swap bytes, a generic array deduplication tool, a CRC-32,
+ *  and a file write that replaces the old file only once the new one is complete
  *
  * @author Federico Jose Diaz
  * @date 26/10/2025
@@ -13,6 +14,8 @@
 #ifndef EXTENDED_TOOLS_H_INCLUDED
 #define EXTENDED_TOOLS_H_INCLUDED
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 /**
@@ -60,4 +63,41 @@ size_t array_duplicate_removal
     int (*comparator)(const void*, const void*)
 );
 
+/**
+ * @brief CRC-32 of a byte span, same as zlib crc32 (IEEE polynomial, reflected, init and xorout 0xFFFFFFFF)
+ *
+ * @param[in] data      Pointer to the bytes
+ * @param[in] length    Number of bytes
+ *
+ * @return CRC-32 value
+ */
+uint32_t crc32_compute(const void *data, size_t length);
+
+/**
+ * @brief Continues a CRC-32 with more bytes, same as zlib crc32 (crc32_compute is crc32_update(0, ...))
+ *
+ * @param[in] crc       CRC-32 of the previous bytes, 0 to start
+ * @param[in] data      Pointer to the bytes
+ * @param[in] length    Number of bytes
+ *
+ * @return CRC-32 of the previous bytes and these ones
+ */
+uint32_t crc32_update(uint32_t crc, const void *data, size_t length);
+
+/**
+ * @brief Writes a file made of a header and a body to a temporary file, then renames it over filename
+ *
+ *  A run stopped halfway leaves the old file, or none, never half of one. The temporary file is named
+ *  after the process, so concurrent runs replacing the same file each write their own, the last rename wins
+ *
+ * @param[in] filename      Name of the file to create or replace
+ * @param[in] header        First bytes of the file
+ * @param[in] header_size   Number of bytes of header
+ * @param[in] body          Rest of the file, can be NULL if body_size is 0
+ * @param[in] body_size     Number of bytes of body
+ *
+ * @return true on success, false on error (perror on the allocation or open, the old file is left)
+ */
+bool file_write_replacing(const char *filename, const void *header, size_t header_size, const void *body, size_t body_size);
+
 #endif // EXTENDED_TOOLS_H
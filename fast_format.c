@@ -0,0 +1,176 @@
+/**
+ * @file fast_format.c
+ * @brief Implementation file of the fast_format header
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#include "fast_format.h"
+
+#include <float.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+// above this the integer math below would not fit in 64 bits
+#define FIXED_FAST_PATH_LIMIT 2147483648.0f
+
+static const uint64_t powers_of_10[FAST_FORMAT_MAX_PRECISION + 1] =
+{
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull
+};
+
+//////////////////////////////////////////
+
+// "00" to "99", so the digits are written two at a time
+static const char digit_pairs[201] =
+    "0001020304050607080910111213141516171819202122232425262728293031323334353637383940414243444546474849"
+    "5051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, writes a uint64_t in decimal, padded with zeros up to min_digits
+ */
+static inline size_t write_digits(char *out, uint64_t value, size_t min_digits)
+{
+    char digits[20];
+    size_t position = sizeof digits;
+
+    while (value >= 100)
+    {
+        const unsigned pair = (unsigned)(value % 100) * 2;
+        value /= 100;
+        digits[--position] = digit_pairs[pair + 1];
+        digits[--position] = digit_pairs[pair];
+    }
+    if (value >= 10)
+    {
+        const unsigned pair = (unsigned)value * 2;
+        digits[--position] = digit_pairs[pair + 1];
+        digits[--position] = digit_pairs[pair];
+    }
+    else
+    {
+        digits[--position] = (char)('0' + value);
+    }
+
+    size_t count = sizeof digits - position;
+    size_t length = 0;
+    while (count + length < min_digits) out[length++] = '0';
+
+    memcpy(out + length, digits + position, count);
+    return length + count;
+}
+
+//////////////////////////////////////////
+
+size_t format_uint32(char *out, uint32_t value)
+{
+    return write_digits(out, value, 1);
+}
+
+//////////////////////////////////////////
+
+size_t format_fixed_float(char *out, float value, int precision)
+{
+    if (precision < 0) precision = 0;
+    if (precision > FAST_FORMAT_MAX_PRECISION) precision = FAST_FORMAT_MAX_PRECISION;
+
+    // also false for NaN
+    if (!(value > -FIXED_FAST_PATH_LIMIT && value < FIXED_FAST_PATH_LIMIT))
+    {
+        int written = snprintf(out, FAST_FORMAT_FIXED_MAX_CHARS, "%.*f", precision, value);
+        return written > 0 ? (size_t)written : 0;
+    }
+
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof bits);
+
+    const bool negative = (bits >> 31) != 0;
+    const uint32_t biased_exponent = (bits >> 23) & 0xFFu;
+    const uint32_t fraction = bits & 0x7FFFFFu;
+
+    // |value| = mantissa * 2^exponent exactly
+    uint64_t mantissa = biased_exponent ? (fraction | 0x800000u) : fraction;
+    int exponent = biased_exponent ? (int)biased_exponent - 150 : -149;
+
+    // scaled = |value| * 10^precision, rounded half to even like printf
+    uint64_t scaled = mantissa * powers_of_10[precision];       // < 2^24 * 10^9 < 2^54
+    if (exponent >= 0)
+    {
+        scaled <<= exponent;                                    // |value| < 2^31, so < 2^61
+    }
+    else if (exponent > -64)
+    {
+        const unsigned shift = (unsigned)-exponent;
+        const uint64_t remainder = scaled & ((1ull << shift) - 1);
+        const uint64_t half = 1ull << (shift - 1);
+
+        scaled >>= shift;
+        if (remainder > half || (remainder == half && (scaled & 1))) scaled++;
+    }
+    else
+    {
+        // scaled < 2^54 is below half of 2^64, always rounds to 0
+        scaled = 0;
+    }
+
+    return format_scaled_fixed(out, scaled, negative, precision);
+}
+
+//////////////////////////////////////////
+
+bool scale_floats_to_fixed(const float *values, size_t count, int precision, uint64_t *scaled)
+{
+#if FLT_EVAL_METHOD == 0
+    if (precision < 0) precision = 0;
+    if (precision > FAST_FORMAT_MAX_PRECISION) precision = FAST_FORMAT_MAX_PRECISION;
+
+    const double factor = (double)powers_of_10[precision];
+    bool in_range = true;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        // exact product. Below 2^51, x + 2^52 lands in [2^52, 2^53) where the doubles are the integers,
+        // so the addition rounds x half to even and the integer is left in the low bits of the mantissa
+        double x = __builtin_fabs((double)values[i]) * factor;
+        in_range &= x < 0x1p51;
+
+        double biased = x + 0x1p52;
+        uint64_t bits;
+        memcpy(&bits, &biased, sizeof bits);
+        scaled[i] = bits - 0x4330000000000000ull;
+    }
+    return in_range;
+#else
+    // the intermediate values would not be rounded to double
+    (void)values;
+    (void)count;
+    (void)precision;
+    (void)scaled;
+    return false;
+#endif
+}
+
+//////////////////////////////////////////
+
+size_t format_scaled_fixed(char *out, uint64_t scaled, bool negative, int precision)
+{
+    if (precision < 0) precision = 0;
+    if (precision > FAST_FORMAT_MAX_PRECISION) precision = FAST_FORMAT_MAX_PRECISION;
+
+    // printf keeps the sign of the value even if it rounds to zero ("-0.00")
+    size_t length = 0;
+    if (negative) out[length++] = '-';
+
+    length += write_digits(out + length, scaled / powers_of_10[precision], 1);
+    if (precision > 0)
+    {
+        out[length++] = '.';
+        length += write_digits(out + length, scaled % powers_of_10[precision], (size_t)precision);
+    }
+    return length;
+}
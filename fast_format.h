@@ -0,0 +1,86 @@
+/**
+ * @file fast_format.h
+ * @brief Header of the integer and fixed decimal text formatters used by the CSV lines
+ *
+ *  Replacement of snprintf "%u" and "%.*f" for the CSV hot path. The output is byte identical to
+ *  printf: the float is converted exactly (mantissa * 2^exponent, in integer math) and rounded
+ *  half to even, so no float printf machinery nor locale is involved.
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#ifndef FAST_FORMAT_H_INCLUDED
+#define FAST_FORMAT_H_INCLUDED
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define FAST_FORMAT_MAX_PRECISION 9
+#define FAST_FORMAT_UINT32_MAX_CHARS 10         // "4294967295"
+#define FAST_FORMAT_FIXED_MAX_CHARS 64          // "-" + 39 digits of FLT_MAX + "." + 9 decimals, rounded up
+#define FAST_FORMAT_BLOCK_SIZE 64               // values scaled per call of scale_floats_to_fixed by the batch formatters
+
+/**
+ * @brief Writes a uint32_t in decimal, same as "%u". No '\0' is added
+ *
+ * @param[out] out      Destination, with room for FAST_FORMAT_UINT32_MAX_CHARS
+ * @param[in]  value    Value to write
+ *
+ * @return Number of chars written
+ */
+size_t format_uint32(char *out, uint32_t value);
+
+/**
+ * @brief Writes a float with a fixed amount of decimals, same as "%.*f". No '\0' is added
+ *
+ * @param[out] out          Destination, with room for FAST_FORMAT_FIXED_MAX_CHARS
+ * @param[in]  value        Value to write
+ * @param[in]  precision    Decimals, clamped to [0, FAST_FORMAT_MAX_PRECISION]
+ *
+ * @return Number of chars written
+ *
+ * @note Values with an absolute value of 2^31 or more, NaN and infinities go through snprintf
+ */
+size_t format_fixed_float(char *out, float value, int precision);
+
+/**
+ * @brief Converts a block of floats to round_half_even(|value| * 10^precision), as format_fixed_float does
+ *
+ *  Written as a plain loop over double math so the compiler can vectorize it: the product of a float
+ *  (24 bit mantissa) and 10^precision (5^9 needs 21 bits) is exact in a double, and the rounding is
+ *  done by the FPU itself, adding and removing 2^52.
+ *
+ * @param[in]  values       Values to convert
+ * @param[in]  count        Number of values
+ * @param[in]  precision    Decimals, clamped to [0, FAST_FORMAT_MAX_PRECISION]
+ * @param[out] scaled       count results, only valid if the function returns true
+ *
+ * @return false if a value is too large, NaN or infinity (or the compiler evaluates floats in extended
+ *         precision). The caller then has to use format_fixed_float for that block
+ */
+bool scale_floats_to_fixed(const float *values, size_t count, int precision, uint64_t *scaled);
+
+/**
+ * @brief Writes a value already scaled by scale_floats_to_fixed, same as "%.*f" of the original. No '\0' is added
+ *
+ * @param[out] out          Destination, with room for FAST_FORMAT_FIXED_MAX_CHARS
+ * @param[in]  scaled       round_half_even(|value| * 10^precision)
+ * @param[in]  negative     Sign bit of the original value (printf writes "-0.00" for negative values rounding to 0)
+ * @param[in]  precision    Decimals, clamped to [0, FAST_FORMAT_MAX_PRECISION]
+ *
+ * @return Number of chars written
+ */
+size_t format_scaled_fixed(char *out, uint64_t scaled, bool negative, int precision);
+
+/**
+ * @brief Sign bit of a float, including -0.0f
+ */
+static inline bool float_sign_bit(float value)
+{
+    return __builtin_signbit(value) != 0;
+}
+
+#endif // FAST_FORMAT_H
@@ -0,0 +1,219 @@
+/**
+ * @file frame_index.c
+ * @brief Implementation file of the frame_index header
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#include "frame_index.h"
+#include "extended_tools.h"
+#include "timestamp_sort.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+//////////////////////////////////////////
+
+ReadFileReturnType frame_index_build(MappedFrameFile *file, const BeaconHeader header, DynamicArray *index)
+{
+    if (!file || !index || index->element_size != sizeof(FrameIndexEntry)) return READ_FAIL;
+
+    // the frame size is fixed, so the file size gives an upper bound of the entries
+    if (!dynamic_array_reserve(index, index->length + BEACON_FRAME_COUNT_ESTIMATE(file->size - file->position)))
+    {
+        return READ_FAIL;
+    }
+
+    // the index only needs rtc_s: the frames are viewed in the mapping, not decoded
+    BeaconFrameView view;
+    ReadFileReturnType read_state;
+
+    while ((read_state = read_mapped_frame_view(file, header, &view)) == READ_OK)
+    {
+        FrameIndexEntry entry;
+        entry.rtc_s = beacon_frame_view_rtc_s(&view);
+        entry.frame_crc = 0;
+        entry.frame_offset = (uint64_t)(view.bytes - file->data);
+
+        if (!dynamic_array_push(index, &entry)) return READ_FAIL;
+    }
+    return read_state;
+}
+
+//////////////////////////////////////////
+
+ReadFileReturnType frame_index_build_deduplicated(MappedFrameFile *file, const BeaconHeader header, HashDedupSet *set)
+{
+    if (!file || !set || set->elements.element_size != sizeof(FrameIndexEntry)) return READ_FAIL;
+
+    BeaconFrameView view;
+    ReadFileReturnType read_state;
+
+    while ((read_state = read_mapped_frame_view(file, header, &view)) == READ_OK)
+    {
+        FrameIndexEntry entry;
+        entry.rtc_s = beacon_frame_view_rtc_s(&view);
+        entry.frame_offset = (uint64_t)(view.bytes - file->data);
+        entry.frame_crc = crc32_compute(view.bytes, BEACON_FRAME_SIZE);
+
+        if (hash_dedup_insert(set, &entry, entry.frame_crc) == DEDUP_FAIL) return READ_FAIL;
+    }
+    return read_state;
+}
+
+//////////////////////////////////////////
+
+void frame_index_sort(DynamicArray *index)
+{
+    if (!index || !index->data) return;
+
+    if (!timestamp_sort_deduplicate(index->data, &index->length, sizeof(FrameIndexEntry), offsetof(FrameIndexEntry, rtc_s)))
+    {
+        // not enough memory for the radix sort, the generic tools only need the array
+        // @note qsort is not stable, so which of the duplicated frames is kept is not defined in this case
+        qsort(index->data, index->length, sizeof(FrameIndexEntry), frame_index_timestamp_comparator);
+        index->length = array_duplicate_removal(index->data, index->length, sizeof(FrameIndexEntry), frame_index_timestamp_comparator);
+    }
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, orders by rtc_s and then by position in the file, the order of a stable sort of the read entries
+ */
+static int frame_position_comparator(const void *a, const void *b)
+{
+    const FrameIndexEntry *x = (const FrameIndexEntry*)a;
+    const FrameIndexEntry *y = (const FrameIndexEntry*)b;
+    int order = frame_index_timestamp_comparator(a, b);
+    if (order != 0) return order;
+    return (x->frame_offset > y->frame_offset) - (x->frame_offset < y->frame_offset);
+}
+
+//////////////////////////////////////////
+
+void frame_index_sort_stable(DynamicArray *index)
+{
+    if (!index || !index->data) return;
+
+    if (!timestamp_sort_stable(index->data, index->length, sizeof(FrameIndexEntry), offsetof(FrameIndexEntry, rtc_s)))
+    {
+        // the entries come in file order, so the frame offset breaks the ties as the radix sort would
+        qsort(index->data, index->length, sizeof(FrameIndexEntry), frame_position_comparator);
+    }
+}
+
+//////////////////////////////////////////
+
+bool frame_index_walk(const MappedFrameFile *file, const DynamicArray *index, FrameExtractor extractor, void *context)
+{
+    if (!file || !index || !extractor) return false;
+
+    const FrameIndexEntry *entries = (const FrameIndexEntry*)index->data;
+    BeaconFrameView view;
+
+    for (size_t i = 0; i < index->length; ++i)
+    {
+        // the entries come from valid frames of this same file, a failure means the file changed
+        if (entries[i].frame_offset + BEACON_FRAME_SIZE > file->size) return false;
+        if (!beacon_frame_view_init(file->data + entries[i].frame_offset, file->byte_order, &view)) return false;
+
+        if (!extractor(&view, context)) return false;
+    }
+    return true;
+}
+
+//////////////////////////////////////////
+
+bool frame_index_gather_raw16
+(
+    const MappedFrameFile *file,
+    const DynamicArray *index,
+    size_t first,
+    size_t count,
+    size_t wire_offset,
+    int16_t *out
+)
+{
+    if (!file || !index || !out || first > index->length || count > index->length - first ||
+        wire_offset + sizeof(int16_t) > BEACON_FRAME_SIZE)
+    {
+        return false;
+    }
+
+    const FrameIndexEntry *entries = (const FrameIndexEntry*)index->data + first;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (entries[i].frame_offset + BEACON_FRAME_SIZE > file->size) return false;
+        // the wire fields are not aligned
+        memcpy(&out[i], file->data + entries[i].frame_offset + wire_offset, sizeof(int16_t));
+    }
+    return true;
+}
+
+//////////////////////////////////////////
+
+bool frame_index_gather_timestamps(const DynamicArray *index, size_t first, size_t count, uint32_t *out)
+{
+    if (!index || !out || first > index->length || count > index->length - first) return false;
+
+    const FrameIndexEntry *entries = (const FrameIndexEntry*)index->data + first;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        out[i] = entries[i].rtc_s;
+    }
+    return true;
+}
+
+//////////////////////////////////////////
+
+size_t frame_index_lower_bound(const DynamicArray *index, uint32_t rtc_s)
+{
+    if (!index) return 0;
+
+    const FrameIndexEntry *entries = (const FrameIndexEntry*)index->data;
+    size_t low = 0;
+    size_t high = index->length;
+
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+        if (entries[middle].rtc_s < rtc_s) low = middle + 1;
+        else high = middle;
+    }
+    return low;
+}
+
+//////////////////////////////////////////
+
+void frame_index_keep_range(DynamicArray *index, uint32_t first_s, uint32_t last_s)
+{
+    if (!index) return;
+
+    if (first_s > last_s)
+    {
+        index->length = 0;
+        return;
+    }
+
+    size_t begin = frame_index_lower_bound(index, first_s);
+    size_t end = last_s == UINT32_MAX ? index->length : frame_index_lower_bound(index, last_s + 1);
+
+    if (begin > 0) memmove(index->data, (FrameIndexEntry*)index->data + begin, (end - begin) * sizeof(FrameIndexEntry));
+    index->length = end - begin;
+}
+
+//////////////////////////////////////////
+
+int frame_index_timestamp_comparator(const void *a, const void *b)
+{
+    const FrameIndexEntry *x = (const FrameIndexEntry*)a;
+    const FrameIndexEntry *y = (const FrameIndexEntry*)b;
+    if (x->rtc_s < y->rtc_s) return -1;
+    if (x->rtc_s > y->rtc_s) return 1;
+    return 0;
+}
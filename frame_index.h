@@ -0,0 +1,168 @@
+/**
+ * @file frame_index.h
+ * @brief Header of the frame index: one (rtc_s, frame offset) entry per valid frame of a mapped file
+ *
+ *  The index is sorted and deduplicated once, and then walked in order viewing each frame a single
+ *  time for all the subsystem extractors. The ordering is not computed again per subsystem.
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#ifndef FRAME_INDEX_H_INCLUDED
+#define FRAME_INDEX_H_INCLUDED
+
+#include "beacon_frame_schema.h"
+#include "dynamic_array.h"
+#include "hash_dedup.h"
+#include "mapped_frame_reader.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @struct FrameIndexEntry
+ * @brief  Timestamp of a frame and where it is in the file
+ */
+typedef struct FRAME_INDEX_ENTRY
+{
+    uint32_t    rtc_s;                  // platform timestamp of the frame, host order
+    uint32_t    frame_crc;              // CRC-32 of the frame bytes, only filled by frame_index_build_deduplicated
+    uint64_t    frame_offset;           // offset of the first byte after the header
+} FrameIndexEntry;
+
+/**
+ * @brief Type definition for the callback receiving every frame of the index walk, in index order
+ *
+ * @param[in] view          View of the frame in the mapped file, its fields are read with the accessors
+ * @param[in] context       Pointer given by the user of the walk (e.g. the output arrays)
+ *
+ * @return true to continue, false to stop the walk with an error
+ */
+typedef bool (*FrameExtractor)(const BeaconFrameView *view, void *context);
+
+/**
+ * @brief Reads all the frames of the mapped file, and adds an entry per frame to the index
+ *
+ *  With file->skip_wrong_frames, the wrong frames are skipped and counted in file->integrity, for this
+ *  function and the ones below (see read_mapped_frame_view)
+ *
+ * @param[in,out] file          Mapped file, read from its current position
+ * @param[in]     header        Constant structure that holds the beacon header ID to search for
+ * @param[out]    index         Initialized DynamicArray of FrameIndexEntry
+ *
+ * @return READ_EOF when the whole file was indexed, READ_FAIL on a wrong frame or if the memory ran out
+ */
+ReadFileReturnType frame_index_build(MappedFrameFile *file, const BeaconHeader header, DynamicArray *index);
+
+/**
+ * @brief Same as frame_index_build, but the duplicated frames are solved as they are read, by the policy of the set
+ *
+ *  The CRC-32 of the frame bytes is given to the set with each entry (see hash_dedup_insert),
+ *  so the set can include it in the key or use it in its validator.
+ *
+ * @param[in,out] file          Mapped file, read from its current position
+ * @param[in]     header        Constant structure that holds the beacon header ID to search for
+ * @param[in,out] set           Set initialized for FrameIndexEntry keyed on rtc_s. Its elements are the index
+ *
+ * @return READ_EOF when the whole file was indexed, READ_FAIL on a wrong frame or if the memory ran out
+ */
+ReadFileReturnType frame_index_build_deduplicated(MappedFrameFile *file, const BeaconHeader header, HashDedupSet *set);
+
+/**
+ * @brief Sorts the index by rtc_s and removes the duplicated timestamps, keeping the first frame of the file
+ *
+ * @param[in,out] index     DynamicArray of FrameIndexEntry
+ */
+void frame_index_sort(DynamicArray *index);
+
+/**
+ * @brief Sorts the index by rtc_s keeping every entry, the ones of a same rtc_s in file order
+ *
+ *  For an index already deduplicated by a HashDedupSet: with a key including the CRC, the frames of a
+ *  rtc_s with different content are all kept, and frame_index_sort would drop them again
+ *
+ * @param[in,out] index     DynamicArray of FrameIndexEntry, in file order
+ */
+void frame_index_sort_stable(DynamicArray *index);
+
+/**
+ * @brief Views the frames in index order, and gives each one to the extractor
+ *
+ *  Nothing is decoded: the section IDs are checked, and the extractor only reads the fields it needs
+ *
+ * @param[in] file          Mapped file the index was built from
+ * @param[in] index         DynamicArray of FrameIndexEntry
+ * @param[in] extractor     Callback receiving each frame
+ * @param[in] context       Passed to the callback
+ *
+ * @return true if all the frames were given to the extractor, false if a frame failed or the extractor stopped
+ */
+bool frame_index_walk(const MappedFrameFile *file, const DynamicArray *index, FrameExtractor extractor, void *context);
+
+/**
+ * @brief Copies one int16_t field of the frames [first, first + count) of the index, as they are in the file
+ *
+ *  Nothing is decoded: the values keep the byte order of the file (file->byte_order), so a batch
+ *  kernel can swap a whole column at once (e.g. thermal_calibrate_batch).
+ *
+ * @param[in]  file          Mapped file the index was built from
+ * @param[in]  index         DynamicArray of FrameIndexEntry
+ * @param[in]  first         First entry to copy
+ * @param[in]  count         Number of entries to copy
+ * @param[in]  wire_offset   Offset of the field in the frame (one of the OFFSET_ values)
+ * @param[out] out           count raw values
+ *
+ * @return true on success, false on a wrong range or if a frame is out of the file
+ */
+bool frame_index_gather_raw16
+(
+    const MappedFrameFile *file,
+    const DynamicArray *index,
+    size_t first,
+    size_t count,
+    size_t wire_offset,
+    int16_t *out
+);
+
+/**
+ * @brief Copies the rtc_s of the entries [first, first + count) of the index, already in host order
+ *
+ * @param[in]  index         DynamicArray of FrameIndexEntry
+ * @param[in]  first         First entry to copy
+ * @param[in]  count         Number of entries to copy
+ * @param[out] out           count timestamps
+ *
+ * @return true on success, false on a wrong range
+ */
+bool frame_index_gather_timestamps(const DynamicArray *index, size_t first, size_t count, uint32_t *out);
+
+/**
+ * @brief Position of the first entry with a rtc_s not lower than the given one, in a sorted index
+ *
+ * @param[in] index         DynamicArray of FrameIndexEntry, sorted by rtc_s
+ * @param[in] rtc_s         Timestamp searched
+ *
+ * @return Entry position, index->length if every entry is lower
+ */
+size_t frame_index_lower_bound(const DynamicArray *index, uint32_t rtc_s);
+
+/**
+ * @brief Keeps only the entries with first_s <= rtc_s <= last_s of a sorted index, with two binary searches
+ *
+ * @param[in,out] index     DynamicArray of FrameIndexEntry, sorted by rtc_s
+ * @param[in]     first_s   First timestamp of the range
+ * @param[in]     last_s    Last timestamp of the range, included
+ */
+void frame_index_keep_range(DynamicArray *index, uint32_t first_s, uint32_t last_s);
+
+/**
+ * @brief FrameIndexEntry comparator via timestamps
+ *
+ * @return int value indicating -1: a < b, 0: a == b, 1: a > b
+ */
+int frame_index_timestamp_comparator(const void *a, const void *b);
+
+#endif // FRAME_INDEX_H
@@ -0,0 +1,236 @@
+/**
+ * @file hash_dedup.c
+ * @brief Implementation file of the hash_dedup header
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#include "hash_dedup.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, mixes the key and the CRC so consecutive timestamps spread over the table
+ */
+static inline uint32_t slot_hash(uint32_t key, uint32_t crc)
+{
+    uint32_t h = key ^ (crc * 0x85EBCA6Bu);
+    h ^= h >> 16;
+    h *= 0x7FEB352Du;
+    h ^= h >> 15;
+    h *= 0x846CA68Bu;
+    h ^= h >> 16;
+    return h;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, allocates a table of slot_count slots and moves the used slots to it
+ */
+static bool resize_table(HashDedupSet *set, size_t slot_count)
+{
+    HashDedupSlot *slots = (HashDedupSlot*)calloc(slot_count, sizeof *slots);
+    if (!slots) return false;
+
+    const size_t mask = slot_count - 1;
+    for (size_t i = 0; i < set->slot_count; ++i)
+    {
+        const HashDedupSlot *slot = &set->slots[i];
+        if (slot->element == 0) continue;
+
+        size_t position = slot_hash(slot->key, set->key_includes_crc ? slot->crc : 0) & mask;
+        while (slots[position].element != 0) position = (position + 1) & mask;
+        slots[position] = *slot;
+    }
+
+    free(set->slots);
+    set->slots = slots;
+    set->slot_count = slot_count;
+    return true;
+}
+
+//////////////////////////////////////////
+
+bool hash_dedup_init
+(
+    HashDedupSet *set, size_t element_size, size_t key_offset, size_t expected_elements,
+    DedupPolicy policy, bool key_includes_crc, int (*comparator)(const void*, const void*)
+)
+{
+    if (!set || element_size == 0 || key_offset + sizeof(uint32_t) > element_size) return false;
+
+    set->slots = NULL;
+    set->slot_count = 0;
+    set->key_offset = key_offset;
+    set->key_includes_crc = key_includes_crc;
+    set->policy = policy;
+    set->comparator = comparator;
+    set->validator = NULL;
+    set->validator_context = NULL;
+    set->duplicates_dropped = 0;
+    set->duplicates_replaced = 0;
+
+    if (!dynamic_array_init(&set->elements, element_size, expected_elements)) return false;
+
+    size_t slot_count = HASH_DEDUP_MIN_SLOTS;
+    while (slot_count / HASH_DEDUP_MAX_LOAD_DIVISOR < expected_elements && slot_count < SIZE_MAX / 2) slot_count *= 2;
+
+    if (!resize_table(set, slot_count))
+    {
+        dynamic_array_free(&set->elements);
+        return false;
+    }
+    return true;
+}
+
+//////////////////////////////////////////
+
+void hash_dedup_set_validator(HashDedupSet *set, DedupValidator validator, void *context)
+{
+    if (!set) return;
+    set->validator = validator;
+    set->validator_context = context;
+}
+
+//////////////////////////////////////////
+
+DedupInsertResult hash_dedup_insert(HashDedupSet *set, const void *element, uint32_t crc)
+{
+    if (!set || !set->slots || !element) return DEDUP_FAIL;
+
+    // grown before probing, so the slot found for a new element is still valid when it is used.
+    // If the table can't grow, it keeps working (slower) while there are empty slots
+    if (set->elements.length + 1 > set->slot_count / HASH_DEDUP_MAX_LOAD_DIVISOR &&
+        !resize_table(set, set->slot_count * 2) && set->elements.length + 1 >= set->slot_count)
+    {
+        return DEDUP_FAIL;
+    }
+
+    const size_t element_size = set->elements.element_size;
+    uint32_t key;
+    memcpy(&key, (const unsigned char*)element + set->key_offset, sizeof key);
+
+    const size_t mask = set->slot_count - 1;
+    size_t position = slot_hash(key, set->key_includes_crc ? crc : 0) & mask;
+
+    for (; set->slots[position].element != 0; position = (position + 1) & mask)
+    {
+        HashDedupSlot *slot = &set->slots[position];
+        if (slot->key != key) continue;
+        if (set->key_includes_crc && slot->crc != crc) continue;
+
+        unsigned char *stored = (unsigned char*)set->elements.data + (size_t)(slot->element - 1) * element_size;
+        if (set->comparator && set->comparator(element, stored) != 0) continue;
+
+        // duplicate found, the policy decides which one stays
+        bool replace = false;
+        switch (set->policy)
+        {
+            case DEDUP_KEEP_LAST:
+                replace = true;
+                break;
+            case DEDUP_KEEP_VALID:
+                replace = set->validator &&
+                          !set->validator(stored, slot->crc, set->validator_context) &&
+                          set->validator(element, crc, set->validator_context);
+                break;
+            case DEDUP_KEEP_FIRST:
+            default:
+                break;
+        }
+
+        if (!replace)
+        {
+            set->duplicates_dropped++;
+            return DEDUP_DROPPED;
+        }
+        memcpy(stored, element, element_size);
+        slot->crc = crc;
+        set->duplicates_replaced++;
+        return DEDUP_REPLACED;
+    }
+
+    // new element. The index is kept in 32 bits in the slot
+    if (set->elements.length >= UINT32_MAX) return DEDUP_FAIL;
+    if (!dynamic_array_push(&set->elements, element)) return DEDUP_FAIL;
+
+    set->slots[position].key = key;
+    set->slots[position].crc = crc;
+    set->slots[position].element = (uint32_t)set->elements.length;
+    return DEDUP_INSERTED;
+}
+
+//////////////////////////////////////////
+
+bool hash_dedup_retain(HashDedupSet *set, DedupRetainFilter keep, void *context)
+{
+    if (!set || !set->slots || !keep) return false;
+
+    const size_t count = set->elements.length;
+    const size_t element_size = set->elements.element_size;
+    uint32_t *new_element = (uint32_t*)malloc((count + 1) * sizeof *new_element);
+    HashDedupSlot *slots = (HashDedupSlot*)calloc(set->slot_count, sizeof *slots);
+
+    if (!new_element || !slots)
+    {
+        free(new_element);
+        free(slots);
+        return false;
+    }
+
+    // the kept elements are moved down in order, new_element maps the old slot values to the new ones
+    unsigned char *elements = (unsigned char*)set->elements.data;
+    size_t kept = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const unsigned char *element = elements + i * element_size;
+        new_element[i + 1] = 0;
+        if (!keep(element, context)) continue;
+
+        if (kept != i) memcpy(elements + kept * element_size, element, element_size);
+        new_element[i + 1] = (uint32_t)++kept;
+    }
+
+    const size_t mask = set->slot_count - 1;
+    for (size_t i = 0; i < set->slot_count; ++i)
+    {
+        const HashDedupSlot *slot = &set->slots[i];
+        if (slot->element == 0 || new_element[slot->element] == 0) continue;
+
+        size_t position = slot_hash(slot->key, set->key_includes_crc ? slot->crc : 0) & mask;
+        while (slots[position].element != 0) position = (position + 1) & mask;
+        slots[position] = *slot;
+        slots[position].element = new_element[slot->element];
+    }
+
+    free(new_element);
+    free(set->slots);
+    set->slots = slots;
+    set->elements.length = kept;
+    return true;
+}
+
+//////////////////////////////////////////
+
+void hash_dedup_release_table(HashDedupSet *set)
+{
+    if (!set) return;
+    free(set->slots);
+    set->slots = NULL;
+    set->slot_count = 0;
+}
+
+//////////////////////////////////////////
+
+void hash_dedup_free(HashDedupSet *set)
+{
+    if (!set) return;
+    hash_dedup_release_table(set);
+    dynamic_array_free(&set->elements);
+}
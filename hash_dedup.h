@@ -0,0 +1,162 @@
+/**
+ * @file hash_dedup.h
+ * @brief Header of an open addressing hash set that deduplicates elements as they arrive
+ *
+ *  Elements are keyed on a uint32_t timestamp inside them (e.g. rtc_s), optionally plus a CRC of the
+ *  frame they come from, so there is no need to sort everything before removing the duplicates.
+ *  The kept elements are stored in a DynamicArray, in the order they first arrived.
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#ifndef HASH_DEDUP_H_INCLUDED
+#define HASH_DEDUP_H_INCLUDED
+
+#include "dynamic_array.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// the table is grown when more than 1 / HASH_DEDUP_MAX_LOAD_DIVISOR of the slots are used
+#define HASH_DEDUP_MAX_LOAD_DIVISOR 2
+#define HASH_DEDUP_MIN_SLOTS 256
+
+/**
+    @enum which element is kept when a duplicate arrives
+**/
+typedef enum
+{
+    DEDUP_KEEP_FIRST,                       // the first one that arrived, as array_duplicate_removal after a stable sort
+    DEDUP_KEEP_LAST,                        // the newest one replaces the stored one
+    DEDUP_KEEP_VALID                        // the stored one is replaced only if it is not valid and the new one is
+} DedupPolicy;
+
+typedef enum
+{
+    DEDUP_INSERTED,
+    DEDUP_REPLACED,
+    DEDUP_DROPPED,
+    DEDUP_FAIL
+} DedupInsertResult;
+
+/**
+ * @brief Type definition for the validity check of DEDUP_KEEP_VALID
+ *
+ * @param[in] element       Element to check
+ * @param[in] crc           CRC given with the element on insertion
+ * @param[in] context       Pointer given by the user (e.g. a table of the CRCs sent by the satellite)
+ *
+ * @return true if the element is valid
+ */
+typedef bool (*DedupValidator)(const void *element, uint32_t crc, void *context);
+
+/**
+ * @struct HashDedupSlot
+ * @brief  One slot of the table. The key and CRC are copied here so probing doesn't touch the elements
+ */
+typedef struct HASH_DEDUP_SLOT
+{
+    uint32_t    key;
+    uint32_t    crc;
+    uint32_t    element;                    // index of the element + 1, 0 for an empty slot
+} HashDedupSlot;
+
+/**
+ * @struct HashDedupSet
+ * @brief  Deduplication set state
+ */
+typedef struct HASH_DEDUP_SET
+{
+    DynamicArray    elements;               // kept elements, in first arrival order
+    HashDedupSlot  *slots;
+    size_t          slot_count;             // power of 2
+    size_t          key_offset;             // offset of the uint32_t key inside the element
+    bool            key_includes_crc;       // if true, same key with a different CRC is not a duplicate
+    DedupPolicy     policy;
+    int           (*comparator)(const void*, const void*);  // optional, 0 for duplicates (qsort style)
+    DedupValidator  validator;              // used by DEDUP_KEEP_VALID
+    void           *validator_context;
+    size_t          duplicates_dropped;     // duplicates that didn't make it in the set
+    size_t          duplicates_replaced;    // stored elements replaced by a duplicate
+} HashDedupSet;
+
+/**
+ * @brief Initializes the set
+ *
+ * @param[out] set                  Pointer to the set to initialize
+ * @param[in]  element_size         Size of one element in bytes
+ * @param[in]  key_offset           Offset of the uint32_t key inside the element (use offsetof)
+ * @param[in]  expected_elements    Number of elements expected, to size the table once. Can be 0
+ * @param[in]  policy               Which element is kept of each group of duplicates
+ * @param[in]  key_includes_crc     If true the CRC given on insertion is part of the key
+ * @param[in]  comparator           Optional, NULL to compare only the keys. The comparators of the
+ *                                  calibrated types can be used here, returning 0 for duplicates
+ *
+ * @return true on success, false on invalid arguments or if the memory could not be allocated
+ */
+bool hash_dedup_init
+(
+    HashDedupSet *set, size_t element_size, size_t key_offset, size_t expected_elements,
+    DedupPolicy policy, bool key_includes_crc, int (*comparator)(const void*, const void*)
+);
+
+/**
+ * @brief Sets the validity check used by DEDUP_KEEP_VALID. Without one, DEDUP_KEEP_VALID keeps the first element
+ *
+ * @param[in,out] set       Pointer to the set
+ * @param[in]     validator Validity check
+ * @param[in]     context   Passed to the validator
+ */
+void hash_dedup_set_validator(HashDedupSet *set, DedupValidator validator, void *context);
+
+/**
+ * @brief Inserts an element, or solves the duplicate according to the policy of the set
+ *
+ * @param[in,out] set       Pointer to the set
+ * @param[in]     element   Pointer to the element, copied in the set
+ * @param[in]     crc       CRC of the element (e.g. crc32_compute of the frame). Ignored if not used
+ *
+ * @return DEDUP_INSERTED for a new element, DEDUP_REPLACED / DEDUP_DROPPED for a duplicate,
+ *         DEDUP_FAIL if the memory ran out
+ */
+DedupInsertResult hash_dedup_insert(HashDedupSet *set, const void *element, uint32_t crc);
+
+/**
+ * @brief Type definition for the filter of hash_dedup_retain
+ *
+ * @return true to keep the element in the set
+ */
+typedef bool (*DedupRetainFilter)(const void *element, void *context);
+
+/**
+ * @brief Removes the elements the filter doesn't keep, so a set fed forever stays bounded
+ *        (e.g. the timestamps older than the ones a reorder window can still accept)
+ *
+ *  The kept elements stay in first arrival order, the table is rebuilt with their slots
+ *
+ * @param[in,out] set       Pointer to the set
+ * @param[in]     keep      Filter called once per element
+ * @param[in]     context   Passed to the filter
+ *
+ * @return true on success, false if the memory ran out (the set is left as it was)
+ */
+bool hash_dedup_retain(HashDedupSet *set, DedupRetainFilter keep, void *context);
+
+/**
+ * @brief Frees the table but keeps the elements. No more insertions can be done after this
+ *
+ * @param[in,out] set   Pointer to the set
+ */
+void hash_dedup_release_table(HashDedupSet *set);
+
+/**
+ * @brief Frees the table and the elements
+ *
+ * @param[in,out] set   Pointer to the set. Safe to call twice
+ */
+void hash_dedup_free(HashDedupSet *set);
+
+#endif // HASH_DEDUP_H
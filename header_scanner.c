@@ -0,0 +1,208 @@
+/**
+ * @file header_scanner.c
+ * @brief Implementation file of the header_scanner header
+ *
+ *  Every vector implementation compares the block starting at i, i+1 and i+2 against the
+ *  three header bytes, and ANDs the results: a set lane k means a full header at i+k.
+ *  The tail that doesn't fill a vector is finished by the scalar loop.
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#include "header_scanner.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define HEADER_SCANNER_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define HEADER_SCANNER_NEON 1
+#include <arm_neon.h>
+#endif
+
+typedef size_t (*HeaderScanFunction)(const uint8_t *buffer, size_t buffer_size, size_t start, const BeaconHeader header);
+
+//////////////////////////////////////////
+
+static size_t scan_scalar(const uint8_t *buffer, size_t buffer_size, size_t start, const BeaconHeader header)
+{
+    if (buffer_size < 3) return buffer_size;
+
+    const uint8_t b0 = header.beacon_id.b[0];
+    const uint8_t b1 = header.beacon_id.b[1];
+    const uint8_t b2 = header.beacon_id.b[2];
+
+    for (size_t i = start; i + 3 <= buffer_size; ++i)
+    {
+        if (buffer[i] == b0 && buffer[i + 1] == b1 && buffer[i + 2] == b2) return i;
+    }
+    return buffer_size;
+}
+
+//////////////////////////////////////////
+
+#ifdef HEADER_SCANNER_X86
+
+__attribute__((target("sse2")))
+static size_t scan_sse2(const uint8_t *buffer, size_t buffer_size, size_t start, const BeaconHeader header)
+{
+    const __m128i b0 = _mm_set1_epi8((char)header.beacon_id.b[0]);
+    const __m128i b1 = _mm_set1_epi8((char)header.beacon_id.b[1]);
+    const __m128i b2 = _mm_set1_epi8((char)header.beacon_id.b[2]);
+
+    size_t i = start;
+    // the last load reads up to i + 2 + 15
+    while (i + 16 + 2 <= buffer_size)
+    {
+        __m128i v0 = _mm_loadu_si128((const __m128i*)(buffer + i));
+        __m128i v1 = _mm_loadu_si128((const __m128i*)(buffer + i + 1));
+        __m128i v2 = _mm_loadu_si128((const __m128i*)(buffer + i + 2));
+
+        __m128i match = _mm_and_si128(_mm_and_si128(_mm_cmpeq_epi8(v0, b0), _mm_cmpeq_epi8(v1, b1)),
+                                      _mm_cmpeq_epi8(v2, b2));
+        unsigned mask = (unsigned)_mm_movemask_epi8(match);
+        if (mask) return i + (size_t)__builtin_ctz(mask);
+        i += 16;
+    }
+    return scan_scalar(buffer, buffer_size, i, header);
+}
+
+//////////////////////////////////////////
+
+__attribute__((target("avx2")))
+static size_t scan_avx2(const uint8_t *buffer, size_t buffer_size, size_t start, const BeaconHeader header)
+{
+    const __m256i b0 = _mm256_set1_epi8((char)header.beacon_id.b[0]);
+    const __m256i b1 = _mm256_set1_epi8((char)header.beacon_id.b[1]);
+    const __m256i b2 = _mm256_set1_epi8((char)header.beacon_id.b[2]);
+
+    size_t i = start;
+    // the last load reads up to i + 2 + 31
+    while (i + 32 + 2 <= buffer_size)
+    {
+        __m256i v0 = _mm256_loadu_si256((const __m256i*)(buffer + i));
+        __m256i v1 = _mm256_loadu_si256((const __m256i*)(buffer + i + 1));
+        __m256i v2 = _mm256_loadu_si256((const __m256i*)(buffer + i + 2));
+
+        __m256i match = _mm256_and_si256(_mm256_and_si256(_mm256_cmpeq_epi8(v0, b0), _mm256_cmpeq_epi8(v1, b1)),
+                                         _mm256_cmpeq_epi8(v2, b2));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(match);
+        if (mask) return i + (size_t)__builtin_ctz(mask);
+        i += 32;
+    }
+    return scan_sse2(buffer, buffer_size, i, header);
+}
+
+#endif // HEADER_SCANNER_X86
+
+//////////////////////////////////////////
+
+#ifdef HEADER_SCANNER_NEON
+
+static size_t scan_neon(const uint8_t *buffer, size_t buffer_size, size_t start, const BeaconHeader header)
+{
+    const uint8x16_t b0 = vdupq_n_u8(header.beacon_id.b[0]);
+    const uint8x16_t b1 = vdupq_n_u8(header.beacon_id.b[1]);
+    const uint8x16_t b2 = vdupq_n_u8(header.beacon_id.b[2]);
+
+    size_t i = start;
+    while (i + 16 + 2 <= buffer_size)
+    {
+        uint8x16_t match = vandq_u8(vandq_u8(vceqq_u8(vld1q_u8(buffer + i), b0),
+                                             vceqq_u8(vld1q_u8(buffer + i + 1), b1)),
+                                    vceqq_u8(vld1q_u8(buffer + i + 2), b2));
+        // narrow every lane to 4 bits, there is no movemask in NEON
+        uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(match), 4)), 0);
+        if (mask) return i + (size_t)(__builtin_ctzll(mask) >> 2);
+        i += 16;
+    }
+    return scan_scalar(buffer, buffer_size, i, header);
+}
+
+#endif // HEADER_SCANNER_NEON
+
+//////////////////////////////////////////
+
+static HeaderScanFunction scan_function = NULL;        // resolved on first use
+static HeaderScanImplementation scan_implementation = HEADER_SCAN_SCALAR;
+
+/**
+ * @brief Internal helper, returns the function of an implementation or NULL if not supported
+ */
+static HeaderScanFunction implementation_function(HeaderScanImplementation implementation)
+{
+    switch (implementation)
+    {
+    case HEADER_SCAN_SCALAR:
+        return scan_scalar;
+#ifdef HEADER_SCANNER_X86
+    case HEADER_SCAN_SSE2:
+        return __builtin_cpu_supports("sse2") ? scan_sse2 : NULL;
+    case HEADER_SCAN_AVX2:
+        return __builtin_cpu_supports("avx2") ? scan_avx2 : NULL;
+#endif
+#ifdef HEADER_SCANNER_NEON
+    case HEADER_SCAN_NEON:
+        return scan_neon;
+#endif
+    default:
+        return NULL;
+    }
+}
+
+//////////////////////////////////////////
+
+bool header_scanner_select(HeaderScanImplementation implementation)
+{
+    if (implementation == HEADER_SCAN_AUTO)
+    {
+        static const HeaderScanImplementation preference[] =
+        {
+            HEADER_SCAN_AVX2, HEADER_SCAN_SSE2, HEADER_SCAN_NEON, HEADER_SCAN_SCALAR
+        };
+        for (size_t i = 0; i < sizeof preference / sizeof preference[0]; ++i)
+        {
+            if (implementation_function(preference[i])) return header_scanner_select(preference[i]);
+        }
+        return false;
+    }
+
+    HeaderScanFunction function = implementation_function(implementation);
+    if (!function) return false;
+
+    // every thread resolves to the same function, the stores only have to be atomic
+    __atomic_store_n(&scan_implementation, implementation, __ATOMIC_RELAXED);
+    __atomic_store_n(&scan_function, function, __ATOMIC_RELEASE);
+    return true;
+}
+
+//////////////////////////////////////////
+
+const char *header_scanner_name(void)
+{
+    if (!__atomic_load_n(&scan_function, __ATOMIC_ACQUIRE)) header_scanner_select(HEADER_SCAN_AUTO);
+
+    switch (__atomic_load_n(&scan_implementation, __ATOMIC_RELAXED))
+    {
+    case HEADER_SCAN_SSE2:  return "sse2";
+    case HEADER_SCAN_AVX2:  return "avx2";
+    case HEADER_SCAN_NEON:  return "neon";
+    default:                return "scalar";
+    }
+}
+
+//////////////////////////////////////////
+
+size_t find_beacon_header(const uint8_t *buffer, size_t buffer_size, const BeaconHeader header)
+{
+    if (!buffer) return buffer_size;
+
+    HeaderScanFunction function = __atomic_load_n(&scan_function, __ATOMIC_ACQUIRE);
+    if (!function)
+    {
+        header_scanner_select(HEADER_SCAN_AUTO);
+        function = __atomic_load_n(&scan_function, __ATOMIC_ACQUIRE);
+    }
+    return function(buffer, buffer_size, 0, header);
+}
@@ -0,0 +1,60 @@
+/**
+ * @file header_scanner.h
+ * @brief Header of the beacon header (sync word) search routine
+ *
+ *  Finds the next BeaconHeader match in a byte buffer. The compare is done 16 (SSE2),
+ *  32 (AVX2) or 16 (NEON) positions at a time, with a scalar fallback. The implementation
+ *  is picked at runtime from the CPU features, and can be forced for benchmarking.
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#ifndef HEADER_SCANNER_H_INCLUDED
+#define HEADER_SCANNER_H_INCLUDED
+
+#include "beacon_frame_schema.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+    @enum available implementations of the header search
+**/
+typedef enum
+{
+    HEADER_SCAN_AUTO,           // best implementation supported by the CPU
+    HEADER_SCAN_SCALAR,
+    HEADER_SCAN_SSE2,
+    HEADER_SCAN_AVX2,
+    HEADER_SCAN_NEON
+} HeaderScanImplementation;
+
+/**
+ * @brief Finds the first position of the header in the buffer
+ *
+ * @param[in] buffer        Pointer to the bytes to search
+ * @param[in] buffer_size   Number of bytes in the buffer
+ * @param[in] header        Header to search for
+ *
+ * @return Offset of the first byte of the header, or buffer_size if there is no complete match
+ */
+size_t find_beacon_header(const uint8_t *buffer, size_t buffer_size, const BeaconHeader header);
+
+/**
+ * @brief Forces the implementation used by find_beacon_header
+ *
+ * @param[in] implementation    Implementation to use, HEADER_SCAN_AUTO restores the runtime detection
+ *
+ * @return true if selected, false if the CPU (or the build) does not support it
+ */
+bool header_scanner_select(HeaderScanImplementation implementation);
+
+/**
+ * @brief Name of the implementation currently used, for logging
+ */
+const char *header_scanner_name(void);
+
+#endif // HEADER_SCANNER_H
@@ -0,0 +1,268 @@
+/**
+ * @file incremental_checkpoint.c
+ * @brief Implementation file of the incremental_checkpoint header
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#include "incremental_checkpoint.h"
+#include "extended_tools.h"
+#include "index_sidecar.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//////////////////////////////////////////
+
+bool incremental_checkpoint_path(const char *output_filename, char *out, size_t out_size)
+{
+    if (!output_filename || !out) return false;
+
+    int length = snprintf(out, out_size, "%s%s", output_filename, INCREMENTAL_CHECKPOINT_EXTENSION);
+    return length > 0 && (size_t)length < out_size;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, CRC-32 of the bytes before the offset, the ones a growing file is most likely rewritten in
+ */
+static uint32_t tail_fingerprint(const uint8_t *data, uint64_t offset)
+{
+    const uint64_t tail_size = offset < INCREMENTAL_CHECKPOINT_TAIL_SIZE ? offset : INCREMENTAL_CHECKPOINT_TAIL_SIZE;
+    return crc32_compute(data + (offset - tail_size), (size_t)tail_size);
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, allocates the copies of an output state
+ */
+static bool output_allocate(IncrementalOutput *output, size_t element_size, size_t window_capacity)
+{
+    output->element_size = element_size;
+    output->window_capacity = window_capacity;
+    output->last_emitted = (unsigned char*)malloc(element_size);
+    output->held = (unsigned char*)malloc(window_capacity * element_size);
+
+    if (output->last_emitted && output->held) return true;
+    incremental_output_free(output);
+    return false;
+}
+
+//////////////////////////////////////////
+
+bool incremental_output_capture(IncrementalOutput *output, const ReorderWindow *window)
+{
+    if (!output || !window) return false;
+
+    memset(output, 0, sizeof *output);
+    if (!output_allocate(output, window->element_size, window->capacity)) return false;
+
+    output->has_emitted = window->has_emitted;
+    memcpy(output->last_emitted, window->last_emitted, window->element_size);
+    return true;
+}
+
+//////////////////////////////////////////
+
+bool incremental_output_hold(IncrementalOutput *output, const void *element)
+{
+    if (!output || !element || !output->held || output->held_count == output->window_capacity) return false;
+
+    memcpy(output->held + output->held_count * output->element_size, element, output->element_size);
+    output->held_count++;
+    return true;
+}
+
+//////////////////////////////////////////
+
+bool incremental_output_restore(const IncrementalOutput *output, ReorderWindow *window)
+{
+    if (!output || !window) return false;
+    if (output->element_size != window->element_size || output->window_capacity != window->capacity) return false;
+
+    return reorder_window_restore(window, output->has_emitted ? output->last_emitted : NULL, output->held, output->held_count);
+}
+
+//////////////////////////////////////////
+
+void incremental_output_free(IncrementalOutput *output)
+{
+    if (!output) return;
+
+    free(output->last_emitted);
+    free(output->held);
+    output->last_emitted = NULL;
+    output->held = NULL;
+    output->held_count = 0;
+}
+
+//////////////////////////////////////////
+
+bool incremental_checkpoint_save
+(
+    const char *checkpoint_filename,
+    const MappedFrameFile *source,
+    uint64_t source_offset,
+    const BeaconHeader header,
+    const IncrementalOutput *outputs,
+    size_t output_count
+)
+{
+    if (!checkpoint_filename || !source || source_offset > source->size || (!outputs && output_count > 0)) return false;
+
+    size_t payload_size = 0;
+    for (size_t o = 0; o < output_count; ++o)
+    {
+        payload_size += sizeof(IncrementalCheckpointOutputHeader) + outputs[o].element_size * (outputs[o].held_count + 1);
+    }
+
+    unsigned char *payload = (unsigned char*)malloc(payload_size > 0 ? payload_size : 1);
+    if (!payload)
+    {
+        perror("malloc");
+        return false;
+    }
+
+    unsigned char *cursor = payload;
+    for (size_t o = 0; o < output_count; ++o)
+    {
+        const IncrementalOutput *output = &outputs[o];
+        IncrementalCheckpointOutputHeader output_header;
+
+        memset(&output_header, 0, sizeof output_header);
+        output_header.csv_size = output->csv_size;
+        output_header.tail_offset = output->tail_offset;
+        output_header.tail_rows = output->tail_rows;
+        output_header.element_size = (uint32_t)output->element_size;
+        output_header.window_capacity = (uint32_t)output->window_capacity;
+        output_header.held_count = (uint32_t)output->held_count;
+        output_header.has_emitted = output->has_emitted;
+
+        memcpy(cursor, &output_header, sizeof output_header);
+        cursor += sizeof output_header;
+        memcpy(cursor, output->last_emitted, output->element_size);
+        cursor += output->element_size;
+        memcpy(cursor, output->held, output->held_count * output->element_size);
+        cursor += output->held_count * output->element_size;
+    }
+
+    IncrementalCheckpointHeader checkpoint;
+    memset(&checkpoint, 0, sizeof checkpoint);
+    memcpy(checkpoint.magic, INCREMENTAL_CHECKPOINT_MAGIC, sizeof checkpoint.magic);
+    checkpoint.byte_order_mark = INCREMENTAL_CHECKPOINT_BYTE_ORDER_MARK;
+    checkpoint.output_count = (uint32_t)output_count;
+    checkpoint.source_offset = source_offset;
+    checkpoint.source_fingerprint = index_sidecar_fingerprint(source->data, source_offset);
+    checkpoint.source_size = source->size;
+    checkpoint.source_modified_time_ns = source->modified_time_ns;
+    checkpoint.tail_fingerprint = tail_fingerprint(source->data, source_offset);
+    checkpoint.outputs_crc = crc32_compute(payload, payload_size);
+    memcpy(checkpoint.beacon_id, header.beacon_id.b, BEACON_HEADER_SIZE);
+
+    bool ok = file_write_replacing(checkpoint_filename, &checkpoint, sizeof checkpoint, payload, payload_size);
+    if (!ok) fprintf(stderr, "Error: the checkpoint could not be saved at %s.\n", checkpoint_filename);
+
+    free(payload);
+    return ok;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, reads the states of the outputs from the payload of the checkpoint
+ */
+static bool parse_outputs(const unsigned char *payload, size_t payload_size, IncrementalOutput *outputs, size_t output_count)
+{
+    size_t position = 0;
+
+    for (size_t o = 0; o < output_count; ++o)
+    {
+        IncrementalCheckpointOutputHeader output_header;
+        IncrementalOutput *output = &outputs[o];
+
+        if (payload_size - position < sizeof output_header) return false;
+        memcpy(&output_header, payload + position, sizeof output_header);
+        position += sizeof output_header;
+
+        const uint64_t element_bytes = (uint64_t)output_header.element_size * ((uint64_t)output_header.held_count + 1);
+        if (output_header.element_size == 0 || output_header.window_capacity == 0 ||
+            output_header.held_count > output_header.window_capacity ||
+            output_header.tail_offset > output_header.csv_size || element_bytes > payload_size - position)
+        {
+            return false;
+        }
+
+        if (!output_allocate(output, output_header.element_size, output_header.window_capacity)) return false;
+
+        output->csv_size = output_header.csv_size;
+        output->tail_offset = output_header.tail_offset;
+        output->tail_rows = output_header.tail_rows;
+        output->held_count = output_header.held_count;
+        output->has_emitted = output_header.has_emitted != 0;
+
+        memcpy(output->last_emitted, payload + position, output->element_size);
+        position += output->element_size;
+        memcpy(output->held, payload + position, output->held_count * output->element_size);
+        position += output->held_count * output->element_size;
+    }
+    return position == payload_size;
+}
+
+//////////////////////////////////////////
+
+bool incremental_checkpoint_load
+(
+    const char *checkpoint_filename,
+    const MappedFrameFile *source,
+    const BeaconHeader header,
+    IncrementalOutput *outputs,
+    size_t output_count,
+    uint64_t *source_offset
+)
+{
+    if (!checkpoint_filename || !source || !outputs || !source_offset) return false;
+
+    FILE *file = fopen(checkpoint_filename, "rb");
+    if (!file) return false;
+
+    IncrementalCheckpointHeader checkpoint;
+    long file_size = -1;
+    bool ok = fread(&checkpoint, sizeof checkpoint, 1, file) == 1 &&
+              memcmp(checkpoint.magic, INCREMENTAL_CHECKPOINT_MAGIC, sizeof checkpoint.magic) == 0 &&
+              checkpoint.byte_order_mark == INCREMENTAL_CHECKPOINT_BYTE_ORDER_MARK &&
+              checkpoint.output_count == output_count &&
+              memcmp(checkpoint.beacon_id, header.beacon_id.b, BEACON_HEADER_SIZE) == 0 &&
+              checkpoint.source_offset <= source->size &&
+              (checkpoint.source_size != source->size || checkpoint.source_modified_time_ns == source->modified_time_ns) &&
+              index_sidecar_fingerprint(source->data, checkpoint.source_offset) == checkpoint.source_fingerprint &&
+              tail_fingerprint(source->data, checkpoint.source_offset) == checkpoint.tail_fingerprint &&
+              fseek(file, 0, SEEK_END) == 0 && (file_size = ftell(file)) >= (long)sizeof checkpoint &&
+              fseek(file, (long)sizeof checkpoint, SEEK_SET) == 0;
+
+    const size_t payload_size = ok ? (size_t)file_size - sizeof checkpoint : 0;
+    unsigned char *payload = ok ? (unsigned char*)malloc(payload_size > 0 ? payload_size : 1) : NULL;
+
+    ok = ok && payload &&
+         fread(payload, 1, payload_size, file) == payload_size &&
+         crc32_compute(payload, payload_size) == checkpoint.outputs_crc;
+    fclose(file);
+
+    for (size_t o = 0; o < output_count; ++o) memset(&outputs[o], 0, sizeof outputs[o]);
+
+    ok = ok && parse_outputs(payload, payload_size, outputs, output_count);
+    free(payload);
+
+    if (!ok)
+    {
+        for (size_t o = 0; o < output_count; ++o) incremental_output_free(&outputs[o]);
+        return false;
+    }
+
+    *source_offset = checkpoint.source_offset;
+    return true;
+}
@@ -0,0 +1,191 @@
+/**
+ * @file incremental_checkpoint.h
+ * @brief Header of the checkpoint of the incremental mode: where a run over a growing file stopped
+ *
+ *  A ground station file grows during a pass. The checkpoint records the bytes of the file already
+ *  decoded (and a fingerprint of them, see the note) and, for every CSV output,
+ *  the elements still held by its reorder window. They are written at the end of the run anyway, so
+ *  the CSV files are complete, and the offset where their rows start is kept: the next run restores
+ *  the windows, writes from that offset again, and only decodes the new bytes.
+ *
+ *  File layout (all the integers in the byte order of the writer host):
+ *      IncrementalCheckpointHeader                 INCREMENTAL_CHECKPOINT_HEADER_SIZE bytes
+ *      for every output:
+ *          IncrementalCheckpointOutputHeader       INCREMENTAL_CHECKPOINT_OUTPUT_HEADER_SIZE bytes
+ *          last emitted element                    element_size bytes
+ *          held elements                           held_count * element_size bytes
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ * @note The fingerprint reads a bounded amount of the source whatever its size: the sampled blocks of
+ *       index_sidecar_fingerprint and the last INCREMENTAL_CHECKPOINT_TAIL_SIZE bytes before the offset, where the
+ *       next frame starts. A source of the same size must also keep the modification time of the checkpoint
+ */
+
+#ifndef INCREMENTAL_CHECKPOINT_H_INCLUDED
+#define INCREMENTAL_CHECKPOINT_H_INCLUDED
+
+#include "beacon_frame_schema.h"
+#include "mapped_frame_reader.h"
+#include "reorder_window.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define INCREMENTAL_CHECKPOINT_EXTENSION ".ckpt"            // appended to the name of the first CSV output
+#define INCREMENTAL_CHECKPOINT_MAGIC "BRCKPV3"              // 7 chars + '\0', V2 fingerprinted all the bytes of the source
+#define INCREMENTAL_CHECKPOINT_BYTE_ORDER_MARK 0x01020304u
+#define INCREMENTAL_CHECKPOINT_HEADER_SIZE 64
+#define INCREMENTAL_CHECKPOINT_OUTPUT_HEADER_SIZE 40
+#define INCREMENTAL_CHECKPOINT_TAIL_SIZE (64u << 10)       // bytes before the offset in the tail fingerprint
+
+/**
+ * @struct IncrementalCheckpointHeader
+ * @brief  First bytes of the checkpoint
+ */
+typedef struct INCREMENTAL_CHECKPOINT_HEADER
+{
+    char        magic[8];                       // INCREMENTAL_CHECKPOINT_MAGIC
+    uint32_t    byte_order_mark;                // INCREMENTAL_CHECKPOINT_BYTE_ORDER_MARK
+    uint32_t    output_count;
+    uint64_t    source_offset;                  // bytes of the source done with, the next run starts here
+    uint32_t    source_fingerprint;             // index_sidecar_fingerprint of those bytes
+    uint32_t    outputs_crc;                    // CRC-32 of the rest of the file
+    uint8_t     beacon_id[BEACON_HEADER_SIZE];  // header searched
+    uint8_t     reserved_0[5];
+    uint64_t    source_size;                    // bytes of the source when the checkpoint was saved
+    int64_t     source_modified_time_ns;        // modified_time_ns of the source then
+    uint32_t    tail_fingerprint;               // CRC-32 of the INCREMENTAL_CHECKPOINT_TAIL_SIZE bytes before source_offset
+    uint8_t     reserved[4];
+} IncrementalCheckpointHeader;
+
+/**
+ * @struct IncrementalCheckpointOutputHeader
+ * @brief  State of one CSV output in the checkpoint
+ */
+typedef struct INCREMENTAL_CHECKPOINT_OUTPUT_HEADER
+{
+    uint64_t    csv_size;                       // bytes of the CSV file at the end of the run
+    uint64_t    tail_offset;                    // where the rows of the held elements start in it
+    uint64_t    tail_rows;                      // rows before tail_offset, without the header
+    uint32_t    element_size;
+    uint32_t    window_capacity;
+    uint32_t    held_count;
+    uint8_t     has_emitted;                    // the last emitted element is valid
+    uint8_t     reserved[3];
+} IncrementalCheckpointOutputHeader;
+
+_Static_assert(sizeof(IncrementalCheckpointHeader) == INCREMENTAL_CHECKPOINT_HEADER_SIZE,
+               "checkpoint header size is part of the format");
+_Static_assert(sizeof(IncrementalCheckpointOutputHeader) == INCREMENTAL_CHECKPOINT_OUTPUT_HEADER_SIZE,
+               "checkpoint output header size is part of the format");
+
+/**
+ * @struct IncrementalOutput
+ * @brief  State of one CSV output between two runs
+ */
+typedef struct INCREMENTAL_OUTPUT
+{
+    uint64_t        csv_size;                   // bytes of the CSV file
+    uint64_t        tail_offset;                // where the rows of the held elements start in the CSV file
+    uint64_t        tail_rows;                  // rows before tail_offset, without the header
+    size_t          element_size;
+    size_t          window_capacity;
+    bool            has_emitted;
+    unsigned char  *last_emitted;               // element_size bytes
+    unsigned char  *held;                       // held_count elements (room for window_capacity), sorted
+    size_t          held_count;
+} IncrementalOutput;
+
+/**
+ * @brief Builds the checkpoint name of a run, next to its first CSV output: two runs with their own
+ *        outputs don't share a checkpoint, even on the same source
+ *
+ * @param[in]  output_filename  Name of the first CSV file the run writes
+ * @param[out] out              That name and INCREMENTAL_CHECKPOINT_EXTENSION
+ * @param[in]  out_size         Size of out
+ *
+ * @return true on success, false if out is too small
+ */
+bool incremental_checkpoint_path(const char *output_filename, char *out, size_t out_size);
+
+/**
+ * @brief Starts the state of a window at the end of a run, before the elements it holds are emitted.
+ *        The CSV fields are set by the caller
+ *
+ * @param[out] output       State to fill, released with incremental_output_free
+ * @param[in]  window       Window of the output, its last emitted element is copied
+ *
+ * @return true on success, false if the memory ran out
+ */
+bool incremental_output_capture(IncrementalOutput *output, const ReorderWindow *window);
+
+/**
+ * @brief Adds an element emitted by the window after incremental_output_capture, see reorder_window_flush
+ *
+ *  The elements written at the end of the run are kept, instead of the window storage,
+ *  so the next run writes the same rows again, without the duplicates dropped on the way
+ *
+ * @return false if the window emitted more than its capacity
+ */
+bool incremental_output_hold(IncrementalOutput *output, const void *element);
+
+/**
+ * @brief Puts the elements of the state back in an empty window, see reorder_window_restore
+ *
+ * @return false if the window is not of the same element size and capacity
+ */
+bool incremental_output_restore(const IncrementalOutput *output, ReorderWindow *window);
+
+/**
+ * @brief Releases the copies of an output state
+ */
+void incremental_output_free(IncrementalOutput *output);
+
+/**
+ * @brief Saves a checkpoint (written to a temporary file, then renamed)
+ *
+ * @param[in] checkpoint_filename   Name of the checkpoint
+ * @param[in] source                Mapped source file
+ * @param[in] source_offset         Bytes of the source done with
+ * @param[in] header                Constant structure that holds the beacon header ID searched
+ * @param[in] outputs               State of every output
+ * @param[in] output_count          Number of outputs
+ *
+ * @return true on success, false on error (printed to stderr)
+ */
+bool incremental_checkpoint_save
+(
+    const char *checkpoint_filename,
+    const MappedFrameFile *source,
+    uint64_t source_offset,
+    const BeaconHeader header,
+    const IncrementalOutput *outputs,
+    size_t output_count
+);
+
+/**
+ * @brief Loads a checkpoint, if it belongs to the first bytes of the source and to the same outputs
+ *
+ * @param[in]  checkpoint_filename  Name of the checkpoint
+ * @param[in]  source               Mapped source file
+ * @param[in]  header               Constant structure that holds the beacon header ID to search for
+ * @param[out] outputs              State of every output, released with incremental_output_free on success
+ * @param[in]  output_count         Number of outputs expected
+ * @param[out] source_offset        Bytes of the source done with
+ *
+ * @return true on success, false if missing, unreadable, or of another file (nothing to release)
+ */
+bool incremental_checkpoint_load
+(
+    const char *checkpoint_filename,
+    const MappedFrameFile *source,
+    const BeaconHeader header,
+    IncrementalOutput *outputs,
+    size_t output_count,
+    uint64_t *source_offset
+);
+
+#endif // INCREMENTAL_CHECKPOINT_H
@@ -0,0 +1,266 @@
+/**
+ * @file index_sidecar.c
+ * @brief Implementation file of the index_sidecar header
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#include "index_sidecar.h"
+#include "extended_tools.h"
+#include "run_merge.h"
+
+#include <stdio.h>
+#include <string.h>
+
+//////////////////////////////////////////
+
+bool index_sidecar_path(const char *source_filename, char *out, size_t out_size)
+{
+    if (!source_filename || !out) return false;
+
+    int length = snprintf(out, out_size, "%s%s", source_filename, INDEX_SIDECAR_EXTENSION);
+    return length > 0 && (size_t)length < out_size;
+}
+
+//////////////////////////////////////////
+
+uint32_t index_sidecar_fingerprint(const uint8_t *data, uint64_t size)
+{
+    uint32_t crc = crc32_update(0, &size, sizeof size);
+
+    if (size <= (uint64_t)INDEX_SIDECAR_SAMPLE_COUNT * INDEX_SIDECAR_SAMPLE_SIZE) return crc32_update(crc, data, (size_t)size);
+
+    // evenly spaced blocks, the first one at the start and the last one ending at size.
+    // The frames between them are checked by the entry walk of the load
+    const uint64_t stride = (size - INDEX_SIDECAR_SAMPLE_SIZE) / (INDEX_SIDECAR_SAMPLE_COUNT - 1);
+    for (uint64_t k = 0; k < INDEX_SIDECAR_SAMPLE_COUNT; ++k)
+    {
+        uint64_t offset = k + 1 == INDEX_SIDECAR_SAMPLE_COUNT ? size - INDEX_SIDECAR_SAMPLE_SIZE : k * stride;
+        crc = crc32_update(crc, data + offset, INDEX_SIDECAR_SAMPLE_SIZE);
+    }
+    return crc;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, checks that the header is of this format, source bytes and index settings
+ */
+static bool header_matches
+(
+    const IndexSidecarHeader *sidecar,
+    const MappedFrameFile *source,
+    const BeaconHeader header,
+    DedupPolicy policy,
+    bool key_includes_crc
+)
+{
+    if (memcmp(sidecar->magic, INDEX_SIDECAR_MAGIC, sizeof sidecar->magic) != 0) return false;
+    if (sidecar->byte_order_mark != INDEX_SIDECAR_BYTE_ORDER_MARK) return false;
+    if (sidecar->entry_size != sizeof(FrameIndexEntry)) return false;
+    if (memcmp(sidecar->beacon_id, header.beacon_id.b, BEACON_HEADER_SIZE) != 0) return false;
+    if (sidecar->dedup_policy != (uint8_t)policy || sidecar->dedup_key_includes_crc != (uint8_t)key_includes_crc) return false;
+    if (sidecar->skip_wrong_frames != (uint8_t)source->skip_wrong_frames) return false;
+    if (sidecar->entry_count > 0 && sidecar->byte_order != FRAME_BYTE_ORDER_BIG_ENDIAN &&
+        sidecar->byte_order != FRAME_BYTE_ORDER_LITTLE_ENDIAN) return false;
+
+    // a smaller file is not the same one, a bigger one may have been appended to
+    if (sidecar->source_size > source->size) return false;
+    if (sidecar->entry_count > BEACON_FRAME_COUNT_ESTIMATE(sidecar->source_size)) return false;
+    // nothing was appended, so the same bytes are not written since
+    if (sidecar->source_size == source->size && sidecar->source_modified_time_ns != source->modified_time_ns) return false;
+
+    return index_sidecar_fingerprint(source->data, sidecar->source_size) == sidecar->source_fingerprint;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, the entries are sorted and each one points to a frame of the indexed bytes: the header
+ *        before it, its section IDs and its rtc_s are checked (one cache line per frame, nothing decoded)
+ */
+static bool entries_match_source
+(
+    const FrameIndexEntry *entries,
+    size_t count,
+    const uint8_t *source_data,
+    uint64_t source_size,
+    const BeaconHeader header,
+    FrameByteOrder byte_order
+)
+{
+    BeaconFrameView view;
+    view.swap = byte_order != HOST_BYTE_ORDER;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const uint64_t offset = entries[i].frame_offset;
+        if (offset < BEACON_HEADER_SIZE || offset + BEACON_FRAME_SIZE > source_size) return false;
+        if (i > 0 && entries[i].rtc_s < entries[i - 1].rtc_s) return false;
+
+        view.bytes = source_data + offset;
+        if (memcmp(view.bytes - BEACON_HEADER_SIZE, header.beacon_id.b, BEACON_HEADER_SIZE) != 0 ||
+            !beacon_frame_ids_match(view.bytes, byte_order) ||
+            beacon_frame_view_rtc_s(&view) != entries[i].rtc_s) return false;
+    }
+    return true;
+}
+
+//////////////////////////////////////////
+
+IndexSidecarState index_sidecar_load
+(
+    const char *sidecar_filename,
+    MappedFrameFile *source,
+    const BeaconHeader header,
+    DedupPolicy policy,
+    bool key_includes_crc,
+    DynamicArray *index,
+    uint64_t *indexed_size
+)
+{
+    if (!sidecar_filename || !source || !index || !indexed_size) return INDEX_SIDECAR_STALE;
+
+    FILE *file = fopen(sidecar_filename, "rb");
+    if (!file) return INDEX_SIDECAR_STALE;
+
+    IndexSidecarHeader sidecar;
+    if (fread(&sidecar, sizeof sidecar, 1, file) != 1 || !header_matches(&sidecar, source, header, policy, key_includes_crc))
+    {
+        fclose(file);
+        return INDEX_SIDECAR_STALE;
+    }
+
+    const size_t count = (size_t)sidecar.entry_count;
+    if (!dynamic_array_init(index, sizeof(FrameIndexEntry), count))
+    {
+        fclose(file);
+        return INDEX_SIDECAR_STALE;
+    }
+
+    bool ok = fread(index->data, sizeof(FrameIndexEntry), count, file) == count &&
+              crc32_compute(index->data, count * sizeof(FrameIndexEntry)) == sidecar.entries_crc &&
+              entries_match_source((const FrameIndexEntry*)index->data, count, source->data, sidecar.source_size,
+                                   header, (FrameByteOrder)sidecar.byte_order);
+    fclose(file);
+
+    if (!ok)
+    {
+        dynamic_array_free(index);
+        return INDEX_SIDECAR_STALE;
+    }
+
+    index->length = count;
+    *indexed_size = sidecar.source_size;
+    // the fields of the indexed frames are read in this byte order, the file is not scanned to detect it
+    if (count > 0) source->byte_order = (FrameByteOrder)sidecar.byte_order;
+    return sidecar.source_size == source->size ? INDEX_SIDECAR_VALID : INDEX_SIDECAR_APPENDED;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, bytes of the source done with: up to the header of a frame cut by the end of the
+ *        file (counted by the robust read), so the next --update-index reads that frame again once completed
+ */
+static uint64_t indexed_source_size(const MappedFrameFile *source)
+{
+    const FrameIntegrityStats *integrity = &source->integrity;
+    if (source->skip_wrong_frames && integrity->frames_truncated > 0 && integrity->truncated_header < source->size)
+    {
+        return integrity->truncated_header;
+    }
+    return source->size;
+}
+
+//////////////////////////////////////////
+
+bool index_sidecar_save
+(
+    const char *sidecar_filename,
+    const MappedFrameFile *source,
+    const BeaconHeader header,
+    DedupPolicy policy,
+    bool key_includes_crc,
+    const DynamicArray *index
+)
+{
+    if (!sidecar_filename || !source || !index || index->element_size != sizeof(FrameIndexEntry)) return false;
+
+    IndexSidecarHeader sidecar;
+    memset(&sidecar, 0, sizeof sidecar);
+    memcpy(sidecar.magic, INDEX_SIDECAR_MAGIC, sizeof sidecar.magic);
+    sidecar.byte_order_mark = INDEX_SIDECAR_BYTE_ORDER_MARK;
+    sidecar.entry_size = sizeof(FrameIndexEntry);
+    sidecar.entry_count = index->length;
+    sidecar.source_size = indexed_source_size(source);
+    sidecar.source_fingerprint = index_sidecar_fingerprint(source->data, sidecar.source_size);
+    sidecar.entries_crc = crc32_compute(index->data, index->length * sizeof(FrameIndexEntry));
+    memcpy(sidecar.beacon_id, header.beacon_id.b, BEACON_HEADER_SIZE);
+    sidecar.dedup_policy = (uint8_t)policy;
+    sidecar.dedup_key_includes_crc = (uint8_t)key_includes_crc;
+    sidecar.skip_wrong_frames = (uint8_t)source->skip_wrong_frames;
+    sidecar.byte_order = (uint8_t)source->byte_order;
+    sidecar.source_modified_time_ns = source->modified_time_ns;
+
+    bool ok = file_write_replacing(sidecar_filename, &sidecar, sizeof sidecar,
+                                   index->data, index->length * sizeof(FrameIndexEntry));
+    if (!ok) fprintf(stderr, "Error: the frame index could not be saved at %s.\n", sidecar_filename);
+    return ok;
+}
+
+//////////////////////////////////////////
+
+uint64_t index_sidecar_resume_offset(uint64_t indexed_size)
+{
+    // a header complete in the indexed bytes was already found, a partial one is in the last bytes
+    return indexed_size > BEACON_HEADER_SIZE - 1 ? indexed_size - (BEACON_HEADER_SIZE - 1) : 0;
+}
+
+//////////////////////////////////////////
+
+bool index_sidecar_can_merge(DedupPolicy policy, bool key_includes_crc)
+{
+    return !key_includes_crc && (policy == DEDUP_KEEP_FIRST || policy == DEDUP_KEEP_LAST);
+}
+
+//////////////////////////////////////////
+
+bool index_sidecar_merge(DynamicArray *index, const DynamicArray *appended, DedupPolicy policy, size_t *duplicates)
+{
+    if (!index || !appended || !index_sidecar_can_merge(policy, false)) return false;
+
+    // on equal rtc_s the merge keeps the element of the first run
+    SortedRun runs[2];
+    const DynamicArray *first = policy == DEDUP_KEEP_FIRST ? index : appended;
+    const DynamicArray *second = policy == DEDUP_KEEP_FIRST ? appended : index;
+
+    runs[0].data = first->data;
+    runs[0].length = first->length;
+    runs[1].data = second->data;
+    runs[1].length = second->length;
+
+    DynamicArray merged;
+    const size_t total = index->length + appended->length;
+
+    if (duplicates) *duplicates = 0;
+    if (appended->length == 0) return true;
+
+    if (!dynamic_array_init(&merged, sizeof(FrameIndexEntry), total)) return false;
+
+    size_t written = run_merge_deduplicate(runs, 2, sizeof(FrameIndexEntry), offsetof(FrameIndexEntry, rtc_s), merged.data);
+    if (written == (size_t)-1)
+    {
+        dynamic_array_free(&merged);
+        return false;
+    }
+
+    merged.length = written;
+    if (duplicates) *duplicates = total - written;
+
+    dynamic_array_free(index);
+    *index = merged;
+    return true;
+}
@@ -0,0 +1,181 @@
+/**
+ * @file index_sidecar.h
+ * @brief Header of the frame index sidecar: the sorted index of a .bin file, saved next to it
+ *
+ *  A later run loads the index instead of scanning the file again, so a time range query
+ *  (see frame_index_keep_range) only decodes the frames of the range from the mapped file.
+ *  The sidecar records how many bytes of the source it indexes and a fingerprint of them: a file
+ *  that was only appended to still matches on those bytes, and only the new bytes need to be indexed.
+ *  A last frame cut by the end of the file (skipped by the robust mode) is not in those bytes: it is
+ *  indexed with the appended ones once it is complete.
+ *  It also records the byte order of the frames, given back to the mapped file on load.
+ *
+ *  File layout (all the integers in the byte order of the writer host):
+ *      IndexSidecarHeader                          INDEX_SIDECAR_HEADER_SIZE bytes
+ *      FrameIndexEntry[entry_count]                sorted by rtc_s, one per rtc_s (and CRC with dedup_key_includes_crc)
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ * @note Checking a sidecar costs less than indexing the file again: the fingerprint is a CRC-32 of
+ *       INDEX_SIDECAR_SAMPLE_COUNT blocks spread over the indexed bytes (the first and the last ones included),
+ *       a file of the same size must have the same modification time, and the load walks the entries checking
+ *       the header, the section IDs and the rtc_s of each frame at its offset. A file edited in place so that
+ *       a frame moved is indexed again instead of being read at the wrong offsets
+ */
+
+#ifndef INDEX_SIDECAR_H_INCLUDED
+#define INDEX_SIDECAR_H_INCLUDED
+
+#include "beacon_frame_schema.h"
+#include "dynamic_array.h"
+#include "frame_index.h"
+#include "hash_dedup.h"
+#include "mapped_frame_reader.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define INDEX_SIDECAR_EXTENSION ".idx"                  // appended to the source file name
+#define INDEX_SIDECAR_MAGIC "BRIDXV4"                   // 7 chars + '\0', V3 didn't record the byte order and the time
+#define INDEX_SIDECAR_BYTE_ORDER_MARK 0x01020304u
+#define INDEX_SIDECAR_HEADER_SIZE 64
+#define INDEX_SIDECAR_SAMPLE_SIZE 4096                  // bytes of each block of the fingerprint
+#define INDEX_SIDECAR_SAMPLE_COUNT 64                   // blocks of the fingerprint, evenly spaced
+
+/**
+ * @struct IndexSidecarHeader
+ * @brief  First bytes of the sidecar
+ */
+typedef struct INDEX_SIDECAR_HEADER
+{
+    char        magic[8];                       // INDEX_SIDECAR_MAGIC
+    uint32_t    byte_order_mark;                // INDEX_SIDECAR_BYTE_ORDER_MARK
+    uint32_t    entry_size;                     // sizeof(FrameIndexEntry)
+    uint64_t    entry_count;
+    uint64_t    source_size;                    // bytes of the source indexed, a truncated last frame excluded
+    uint32_t    source_fingerprint;             // index_sidecar_fingerprint of those bytes
+    uint32_t    entries_crc;                    // CRC-32 of the entries
+    uint8_t     beacon_id[BEACON_HEADER_SIZE];  // header searched when indexing
+    uint8_t     dedup_policy;                   // DedupPolicy of the index
+    uint8_t     dedup_key_includes_crc;
+    uint8_t     skip_wrong_frames;              // the wrong frames were skipped (robust mode), not a failure
+    uint8_t     byte_order;                     // FrameByteOrder of the frames, FRAME_BYTE_ORDER_UNKNOWN without entries
+    uint8_t     reserved_0;
+    int64_t     source_modified_time_ns;        // modified_time_ns of the source when it was indexed
+    uint8_t     reserved[8];
+} IndexSidecarHeader;
+
+_Static_assert(sizeof(IndexSidecarHeader) == INDEX_SIDECAR_HEADER_SIZE, "sidecar header size is part of the format");
+_Static_assert(sizeof(FrameIndexEntry) == 16, "sidecar entry size is part of the format");
+
+/**
+    @enum what a sidecar holds for the current source file
+**/
+typedef enum
+{
+    INDEX_SIDECAR_VALID,            // the index of the whole file
+    INDEX_SIDECAR_APPENDED,         // the index of the first bytes, the file grew after it was saved
+    INDEX_SIDECAR_STALE             // missing, unreadable, or of another file or settings (the robust mode included): index again
+} IndexSidecarState;
+
+/**
+ * @brief Builds the sidecar name of a source file
+ *
+ * @param[in]  source_filename  Name of the .bin file
+ * @param[out] out              The source name and INDEX_SIDECAR_EXTENSION
+ * @param[in]  out_size         Size of out
+ *
+ * @return true on success, false if out is too small
+ */
+bool index_sidecar_path(const char *source_filename, char *out, size_t out_size);
+
+/**
+ * @brief Fingerprint of the first size bytes of a file, see the note of this header
+ *
+ * @param[in] data      First byte of the file
+ * @param[in] size      Bytes to fingerprint
+ *
+ * @return CRC-32 of the size and of the sampled blocks (of all the bytes under INDEX_SIDECAR_SAMPLE_COUNT blocks)
+ */
+uint32_t index_sidecar_fingerprint(const uint8_t *data, uint64_t size);
+
+/**
+ * @brief Loads a sidecar, if it belongs to the source and to the same index settings
+ *
+ * @param[in]  sidecar_filename     Name of the sidecar
+ * @param[in,out] source            Mapped source file, its skip_wrong_frames is one of the index settings: an index
+ *                                  that skipped wrong frames is not used by a run that has to fail on them.
+ *                                  Its byte_order is set to the one of the indexed frames when the state is not stale
+ * @param[in]  header               Constant structure that holds the beacon header ID to search for
+ * @param[in]  policy               Dedup policy of the index
+ * @param[in]  key_includes_crc     Dedup key setting of the index
+ * @param[out] index                Initialized by the function when the state is not INDEX_SIDECAR_STALE
+ * @param[out] indexed_size         Bytes of the source in the index
+ *
+ * @return State of the sidecar
+ */
+IndexSidecarState index_sidecar_load
+(
+    const char *sidecar_filename,
+    MappedFrameFile *source,
+    const BeaconHeader header,
+    DedupPolicy policy,
+    bool key_includes_crc,
+    DynamicArray *index,
+    uint64_t *indexed_size
+);
+
+/**
+ * @brief Saves the index of the whole source (written to a temporary file, then renamed)
+ *
+ * @param[in] sidecar_filename  Name of the sidecar
+ * @param[in] source            Mapped source file, all of it indexed, with the skip_wrong_frames, the byte order and
+ *                              the integrity counters of the indexing (the sidecar stops at a truncated last frame)
+ * @param[in] header            Constant structure that holds the beacon header ID searched
+ * @param[in] policy            Dedup policy of the index
+ * @param[in] key_includes_crc  Dedup key setting of the index
+ * @param[in] index             DynamicArray of FrameIndexEntry, sorted by rtc_s
+ *
+ * @return true on success, false on error (printed to stderr)
+ */
+bool index_sidecar_save
+(
+    const char *sidecar_filename,
+    const MappedFrameFile *source,
+    const BeaconHeader header,
+    DedupPolicy policy,
+    bool key_includes_crc,
+    const DynamicArray *index
+);
+
+/**
+ * @brief Offset to index the appended bytes from: a header may have started in the last indexed bytes
+ *
+ * @param[in] indexed_size      Bytes of the source in the index
+ */
+uint64_t index_sidecar_resume_offset(uint64_t indexed_size);
+
+/**
+ * @brief Whether the index of the appended bytes can be merged into the loaded one, see index_sidecar_merge
+ *
+ *  DEDUP_KEEP_VALID and a key with the CRC need all the frames of a rtc_s, the file is indexed again
+ */
+bool index_sidecar_can_merge(DedupPolicy policy, bool key_includes_crc);
+
+/**
+ * @brief Merges the sorted index of the appended bytes into the loaded one
+ *
+ *  A rtc_s in both keeps the older frame with DEDUP_KEEP_FIRST, the appended one with DEDUP_KEEP_LAST
+ *
+ * @param[in,out] index         Loaded index, replaced by the merged one
+ * @param[in]     appended      Sorted index of the appended bytes, without repeated rtc_s
+ * @param[in]     policy        DEDUP_KEEP_FIRST or DEDUP_KEEP_LAST
+ * @param[out]    duplicates    rtc_s found in both
+ *
+ * @return true on success, false if the memory ran out (index is left as it was)
+ */
+bool index_sidecar_merge(DynamicArray *index, const DynamicArray *appended, DedupPolicy policy, size_t *duplicates);
+
+#endif // INDEX_SIDECAR_H
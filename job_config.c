@@ -0,0 +1,383 @@
+/**
+ * @file job_config.c
+ * @brief Implementation file of the job_config header
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#include "job_config.h"
+#include "calibration_engine.h"
+#include "fast_format.h"
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @struct JobPathKey
+ * @brief  A key naming a file, and where it is kept in the job
+ */
+typedef struct JOB_PATH_KEY
+{
+    const char *key;
+    size_t      offset;                     // of the char[JOB_CONFIG_PATH_SIZE] member
+    bool        is_output;                  // placed in output-dir by job_config_finish
+} JobPathKey;
+
+static const JobPathKey path_keys[] =
+{
+    { "input",                      offsetof(JobConfig, input),                         false },
+    { "output-dir",                 offsetof(JobConfig, output_dir),                    false },
+    { "thermal-csv",                offsetof(JobConfig, thermal_csv),                   true },
+    { "thermal-columnar",           offsetof(JobConfig, thermal_columnar),              true },
+    { "thermal-aggregate",          offsetof(JobConfig, thermal_aggregate),             true },
+    { "sun-sensors-csv",            offsetof(JobConfig, sun_sensors_csv),               true },
+    { "sun-sensors-columnar",       offsetof(JobConfig, sun_sensors_columnar),          true },
+    { "sun-sensors-aggregate",      offsetof(JobConfig, sun_sensors_aggregate),         true },
+    { "calibrated-fields-csv",      offsetof(JobConfig, calibrated_fields_csv),         true },
+    { "calibrated-fields-columnar", offsetof(JobConfig, calibrated_fields_columnar),    true },
+};
+
+static const char *const value_keys[] =
+{
+    "mode", "threads", "outputs", "fields", "formats", "aggregate-window", "sun-vector-norm", "decimals",
+    "index-sidecar"
+};
+
+//////////////////////////////////////////
+
+void job_config_init(JobConfig *job)
+{
+    if (!job) return;
+
+    memset(job, 0, sizeof *job);
+    job->mode = JOB_MODE_MEMORY;
+    job->threads = 0;
+    job->outputs = JOB_OUTPUT_ALL;
+    job->fields = CALIBRATION_FIELD_MASK_ALL;
+    job->write_csv = true;
+    job->write_columnar = true;
+    job->write_aggregate = false;
+    job->aggregate_window_s = 60;
+    job->aggregate_norm = true;
+    job->decimals = 2;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, the path key of that name, NULL if it is not one
+ */
+static const JobPathKey* find_path_key(const char *key)
+{
+    for (size_t k = 0; k < sizeof path_keys / sizeof path_keys[0]; ++k)
+    {
+        if (strcmp(path_keys[k].key, key) == 0) return &path_keys[k];
+    }
+    return NULL;
+}
+
+//////////////////////////////////////////
+
+bool job_config_is_key(const char *key)
+{
+    if (!key) return false;
+    if (find_path_key(key)) return true;
+
+    for (size_t k = 0; k < sizeof value_keys / sizeof value_keys[0]; ++k)
+    {
+        if (strcmp(value_keys[k], key) == 0) return true;
+    }
+    return false;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, copies the item of a comma list starting at list, and returns where the next one starts
+ *
+ * @return NULL at the end of the list, or if the item doesn't fit in out
+ */
+static const char* next_list_item(const char *list, char *out, size_t out_size)
+{
+    if (*list == '\0') return NULL;
+
+    size_t length = strcspn(list, ",");
+    if (length >= out_size) return NULL;
+
+    memcpy(out, list, length);
+    out[length] = '\0';
+    return list[length] == ',' ? list + length + 1 : list + length;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, the bits of a comma list of names
+ *
+ * @return false if a name is not in the list of names
+ */
+static bool parse_name_list(const char *value, const char *const names[], const unsigned bits[], size_t name_count, unsigned *out)
+{
+    char item[64];
+    unsigned mask = 0;
+
+    for (const char *cursor = value; (cursor = next_list_item(cursor, item, sizeof item)) != NULL; )
+    {
+        size_t n = 0;
+        while (n < name_count && strcmp(names[n], item) != 0) ++n;
+        if (n == name_count) return false;
+        mask |= bits[n];
+    }
+    *out = mask;
+    return mask != 0;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, the mask of a comma list of calibrated field names
+ */
+static bool parse_field_list(const char *value, CalibrationFieldMask *out)
+{
+    if (strcmp(value, "all") == 0)
+    {
+        *out = CALIBRATION_FIELD_MASK_ALL;
+        return true;
+    }
+
+    char item[64];
+    CalibrationFieldMask mask = 0;
+
+    for (const char *cursor = value; (cursor = next_list_item(cursor, item, sizeof item)) != NULL; )
+    {
+        CalibrationFieldId id;
+        if (!calibration_field_find(item, &id))
+        {
+            fprintf(stderr, "Unknown calibrated field %s \n", item);
+            return false;
+        }
+        mask |= CALIBRATION_FIELD_BIT(id);
+    }
+    *out = mask;
+    return mask != 0;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, a whole text as an integer in [0, max]
+ */
+static bool parse_bounded_integer(const char *value, unsigned long max, unsigned long *out)
+{
+    char *end = NULL;
+
+    if (!isdigit((unsigned char)value[0])) return false;
+    unsigned long number = strtoul(value, &end, 10);
+    if (*end != '\0' || number > max) return false;
+
+    *out = number;
+    return true;
+}
+
+//////////////////////////////////////////
+
+bool job_config_set(JobConfig *job, const char *key, const char *value)
+{
+    if (!job || !key || !value) return false;
+
+    static const char *const output_names[] = { "thermal", "sun_sensors", "calibrated_fields", "all" };
+    static const unsigned output_bits[] = { JOB_OUTPUT_THERMAL, JOB_OUTPUT_SUN_SENSORS, JOB_OUTPUT_CALIBRATED_FIELDS, JOB_OUTPUT_ALL };
+    static const char *const format_names[] = { "csv", "columnar", "aggregate" };
+    static const unsigned format_bits[] = { 1u << 0, 1u << 1, 1u << 2 };
+
+    const JobPathKey *path_key = find_path_key(key);
+    unsigned bits = 0;
+    unsigned long number = 0;
+    bool ok = true;
+
+    if (path_key)
+    {
+        ok = strlen(value) < JOB_CONFIG_PATH_SIZE && (value[0] != '\0' || strcmp(key, "output-dir") == 0);
+        if (ok) strcpy((char*)job + path_key->offset, value);
+    }
+    else if (strcmp(key, "mode") == 0)
+    {
+        if (strcmp(value, "memory") == 0) job->mode = JOB_MODE_MEMORY;
+        else if (strcmp(value, "streaming") == 0) job->mode = JOB_MODE_STREAMING;
+        else if (strcmp(value, "pipelined") == 0) job->mode = JOB_MODE_PIPELINED;
+        else if (strcmp(value, "live") == 0) job->mode = JOB_MODE_LIVE;
+        else if (strcmp(value, "incremental") == 0) job->mode = JOB_MODE_INCREMENTAL;
+        else ok = false;
+    }
+    else if (strcmp(key, "threads") == 0)
+    {
+        ok = parse_bounded_integer(value, 1024, &number);
+        if (ok) job->threads = (size_t)number;
+    }
+    else if (strcmp(key, "outputs") == 0)
+    {
+        ok = parse_name_list(value, output_names, output_bits, 4, &bits);
+        if (ok) job->outputs = bits;
+    }
+    else if (strcmp(key, "fields") == 0)
+    {
+        ok = parse_field_list(value, &job->fields);
+    }
+    else if (strcmp(key, "formats") == 0)
+    {
+        ok = parse_name_list(value, format_names, format_bits, 3, &bits);
+        if (ok)
+        {
+            job->write_csv = (bits & format_bits[0]) != 0;
+            job->write_columnar = (bits & format_bits[1]) != 0;
+            job->write_aggregate = (bits & format_bits[2]) != 0;
+        }
+    }
+    else if (strcmp(key, "aggregate-window") == 0)
+    {
+        ok = parse_bounded_integer(value, JOB_CONFIG_MAX_AGGREGATE_WINDOW_S, &number) && number > 0;
+        if (ok) job->aggregate_window_s = (uint32_t)number;
+    }
+    else if (strcmp(key, "sun-vector-norm") == 0)
+    {
+        ok = strcmp(value, "yes") == 0 || strcmp(value, "no") == 0;
+        if (ok) job->aggregate_norm = strcmp(value, "yes") == 0;
+    }
+    else if (strcmp(key, "index-sidecar") == 0)
+    {
+        ok = strcmp(value, "yes") == 0 || strcmp(value, "no") == 0;
+        if (ok) job->index_sidecar = strcmp(value, "yes") == 0;
+    }
+    else if (strcmp(key, "decimals") == 0)
+    {
+        ok = parse_bounded_integer(value, FAST_FORMAT_MAX_PRECISION, &number);
+        if (ok) job->decimals = (int)number;
+    }
+    else
+    {
+        fprintf(stderr, "Unknown job setting %s \n", key);
+        return false;
+    }
+
+    if (!ok) fprintf(stderr, "Wrong value \"%s\" for the job setting %s \n", value, key);
+    return ok;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, removes the blanks at both ends of a text, in place
+ */
+static char* trim(char *text)
+{
+    while (isspace((unsigned char)*text)) ++text;
+
+    size_t length = strlen(text);
+    while (length > 0 && isspace((unsigned char)text[length - 1])) text[--length] = '\0';
+    return text;
+}
+
+//////////////////////////////////////////
+
+bool job_config_load(JobConfig *job, const char *filename)
+{
+    if (!job || !filename) return false;
+
+    FILE *file = fopen(filename, "r");
+    if (!file)
+    {
+        perror(filename);
+        return false;
+    }
+
+    char line[JOB_CONFIG_LINE_SIZE];
+    size_t line_number = 0;
+    bool ok = true;
+
+    while (ok && fgets(line, sizeof line, file))
+    {
+        ++line_number;
+        if (!strchr(line, '\n') && !feof(file))
+        {
+            fprintf(stderr, "%s:%zu: line too long \n", filename, line_number);
+            ok = false;
+            break;
+        }
+
+        char *comment = strchr(line, '#');
+        if (comment) *comment = '\0';
+
+        char *key = trim(line);
+        if (*key == '\0') continue;
+
+        char *equals = strchr(key, '=');
+        if (!equals)
+        {
+            fprintf(stderr, "%s:%zu: expected key = value \n", filename, line_number);
+            ok = false;
+            break;
+        }
+        *equals = '\0';
+
+        key = trim(key);
+        if (!job_config_set(job, key, trim(equals + 1)))
+        {
+            fprintf(stderr, "%s:%zu: wrong job setting \n", filename, line_number);
+            ok = false;
+        }
+    }
+
+    fclose(file);
+    return ok;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, whether a file name already has a directory
+ */
+static bool has_directory(const char *path)
+{
+    return strchr(path, '/') != NULL || strchr(path, '\\') != NULL || (isalpha((unsigned char)path[0]) && path[1] == ':');
+}
+
+//////////////////////////////////////////
+
+bool job_config_finish(JobConfig *job)
+{
+    if (!job) return false;
+
+    if (job->outputs == 0 || (!job->write_csv && !job->write_columnar && !job->write_aggregate))
+    {
+        fprintf(stderr, "The job has no output to write \n");
+        return false;
+    }
+    if (job->input[0] == '\0')
+    {
+        fprintf(stderr, "The job has no input \n");
+        return false;
+    }
+    if (job->output_dir[0] == '\0') return true;
+
+    const size_t dir_length = strlen(job->output_dir);
+    const bool has_separator = job->output_dir[dir_length - 1] == '/' || job->output_dir[dir_length - 1] == '\\';
+
+    for (size_t k = 0; k < sizeof path_keys / sizeof path_keys[0]; ++k)
+    {
+        char *path = (char*)job + path_keys[k].offset;
+        if (!path_keys[k].is_output || has_directory(path)) continue;
+
+        char joined[JOB_CONFIG_PATH_SIZE];
+        int length = snprintf(joined, sizeof joined, "%s%s%s", job->output_dir, has_separator ? "" : "/", path);
+        if (length < 0 || (size_t)length >= sizeof joined)
+        {
+            fprintf(stderr, "Output file name too long: %s \n", path);
+            return false;
+        }
+        strcpy(path, joined);
+    }
+    return true;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file job_config.h
+ * @brief Header of the job configuration: what a run reads, which outputs it writes and how, set at run time
+ *
+ *  Every setting is a key and a value, given on the command line ("--threads 4") or in a job file,
+ *  one "key = value" per line ('#' starts a comment). The same keys are valid in both:
+ *      input                       telemetry file, or the source of the live mode (see stream_source.h)
+ *      mode                        memory, streaming, pipelined (streaming with reader and writer threads),
+ *                                  live (a socket or a pipe) or incremental (a file that grows between runs)
+ *      threads                     decode threads, 0 for one per online processor
+ *      outputs                     comma list of thermal, sun_sensors, calibrated_fields, or all
+ *      fields                      comma list of calibration_table.h field names for calibrated_fields, or all
+ *      formats                     comma list of csv, columnar, aggregate (the window tables of window_aggregate.h,
+ *                                  for the thermal and sun sensor outputs)
+ *      aggregate-window            seconds of the aggregation windows, 1 to 2^31
+ *      sun-vector-norm             yes or no, the norm of the sun vector is aggregated too
+ *      decimals                    decimals of the CSV files, 0 to FAST_FORMAT_MAX_PRECISION
+ *      output-dir                  directory of the output files given without a directory
+ *      index-sidecar               yes or no, the in-memory mode saves the sorted frame index next to the input
+ *                                  and loads it on the next runs (see index_sidecar.h)
+ *      thermal-csv, thermal-columnar, thermal-aggregate, sun-sensors-csv, sun-sensors-columnar,
+ *      sun-sensors-aggregate, calibrated-fields-csv, calibrated-fields-columnar      name of each output file
+ *  A run decodes its input once for all the outputs selected. Two jobs with their own output names (or
+ *  output-dir) can run at the same time on the same host.
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ * @note The streaming and live modes only write the thermal and sun sensor CSV files and their aggregate tables,
+ *       the incremental mode only the CSV files
+ */
+
+#ifndef JOB_CONFIG_H_INCLUDED
+#define JOB_CONFIG_H_INCLUDED
+
+#include "calibration_table.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define JOB_CONFIG_PATH_SIZE FILENAME_MAX
+#define JOB_CONFIG_LINE_SIZE (JOB_CONFIG_PATH_SIZE + 64)
+#define JOB_CONFIG_MAX_AGGREGATE_WINDOW_S 0x80000000u
+
+/**
+    @enum how the frames go from the input to the outputs
+**/
+typedef enum
+{
+    JOB_MODE_MEMORY,                // mapped, indexed by rtc_s, sorted once for all the outputs
+    JOB_MODE_STREAMING,             // through the reorder windows, bounded memory
+    JOB_MODE_PIPELINED,             // streaming, with a reader thread and a writer thread per CSV file
+    JOB_MODE_LIVE,                  // streaming from a live source, the frames are written as they are received
+    JOB_MODE_INCREMENTAL            // streaming of the bytes appended since the last run, from its checkpoint
+} JobMode;
+
+/**
+    @enum outputs of a job, one bit each
+**/
+typedef enum
+{
+    JOB_OUTPUT_THERMAL = 1 << 0,
+    JOB_OUTPUT_SUN_SENSORS = 1 << 1,
+    JOB_OUTPUT_CALIBRATED_FIELDS = 1 << 2,
+    JOB_OUTPUT_ALL = JOB_OUTPUT_THERMAL | JOB_OUTPUT_SUN_SENSORS | JOB_OUTPUT_CALIBRATED_FIELDS
+} JobOutput;
+
+/**
+ * @struct JobConfig
+ * @brief  Settings of a run
+ */
+typedef struct JOB_CONFIG
+{
+    char                    input[JOB_CONFIG_PATH_SIZE];
+    JobMode                 mode;
+    size_t                  threads;
+    unsigned                outputs;                    // JobOutput bits
+    CalibrationFieldMask    fields;                     // of the calibrated_fields output
+    bool                    write_csv;
+    bool                    write_columnar;
+    bool                    write_aggregate;
+    uint32_t                aggregate_window_s;
+    bool                    aggregate_norm;             // of the sun vector
+    bool                    index_sidecar;
+    int                     decimals;
+    char                    output_dir[JOB_CONFIG_PATH_SIZE];
+    char                    thermal_csv[JOB_CONFIG_PATH_SIZE];
+    char                    thermal_columnar[JOB_CONFIG_PATH_SIZE];
+    char                    thermal_aggregate[JOB_CONFIG_PATH_SIZE];
+    char                    sun_sensors_csv[JOB_CONFIG_PATH_SIZE];
+    char                    sun_sensors_columnar[JOB_CONFIG_PATH_SIZE];
+    char                    sun_sensors_aggregate[JOB_CONFIG_PATH_SIZE];
+    char                    calibrated_fields_csv[JOB_CONFIG_PATH_SIZE];
+    char                    calibrated_fields_columnar[JOB_CONFIG_PATH_SIZE];
+} JobConfig;
+
+/**
+ * @brief Initializes a job: in-memory mode, one thread per processor, every output and field, the csv and
+ *        columnar formats, 60 s windows with the norm, 2 decimals, no index sidecar, and no file names (the caller sets its
+ *        defaults with job_config_set)
+ *
+ * @param[out] job      Job to initialize
+ */
+void job_config_init(JobConfig *job);
+
+/**
+ * @brief Whether a key is a setting of the job, see the list of this header
+ */
+bool job_config_is_key(const char *key);
+
+/**
+ * @brief Sets one setting of the job
+ *
+ * @param[in,out] job   Job to change
+ * @param[in]     key   One of the keys of this header
+ * @param[in]     value Its value as text
+ *
+ * @return true on success, false on an unknown key or a wrong value (printed to stderr)
+ */
+bool job_config_set(JobConfig *job, const char *key, const char *value);
+
+/**
+ * @brief Sets the settings of a job file, in file order
+ *
+ * @param[in,out] job       Job to change
+ * @param[in]     filename  Job file, "key = value" lines
+ *
+ * @return true on success, false if the file can't be read or a line is wrong (printed to stderr)
+ */
+bool job_config_load(JobConfig *job, const char *filename);
+
+/**
+ * @brief Checks the job once all the settings are given, and puts the output files in output-dir
+ *
+ * @param[in,out] job   Job to check, call it once
+ *
+ * @return true if the job can run, false otherwise (printed to stderr)
+ */
+bool job_config_finish(JobConfig *job);
+
+#endif // JOB_CONFIG_H
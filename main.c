@@ -9,228 +9,1967 @@
  * @author Federico Jose Diaz
  * @date 26/10/2025
  *
- * @note In this implementation, the read frames are loaded in memory
- *       to deduplicate, and sort via the column "rtc_s", as the frames could come out of order
+ * @note In this implementation, the file is loaded in memory and indexed by "rtc_s", as the frames
+ *       could come out of order. The index is sorted and deduplicated once, and gathered into the columns
+ *       of every subsystem, calibrated a block at a time
+ * @note With STREAMING_MODE the frames go through a bounded reorder window instead, and straight
+ *       to the CSV files, so the memory used doesn't grow with the size of the file
+ * @note The live mode does the same with a socket or a pipe, frames are written while the pass is received
+ * @note The incremental mode does the same with a file that grows between runs, from where the last run stopped
+ * @note The input, the outputs, their formats and the mode are the settings of a job (see job_config.h),
+ *       given on the command line or in a job file. The defines below are their defaults
  */
 
 #include "beacon_frame_schema.h"
+#include "mapped_frame_reader.h"
 #include "thermal_calibrated.h"
 #include "sun_sensors_calibrated.h"
 #include "csv_tool.h"
+#include "columnar_tool.h"
+#include "arena.h"
+#include "dynamic_array.h"
+#include "frame_index.h"
+#include "hash_dedup.h"
+#include "reorder_window.h"
+#include "telemetry_store.h"
+#include "calibration_engine.h"
+#include "parallel_decode.h"
+#include "batch_processor.h"
+#include "stream_parser.h"
+#include "stream_source.h"
+#include "pipeline_io.h"
+#include "index_sidecar.h"
+#include "incremental_checkpoint.h"
+#include "timestamp_sort.h"
+#include "pipeline_metrics.h"
+#include "job_config.h"
+#include "window_aggregate.h"
 
+#include <errno.h>
+#include <signal.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <string.h>
 
+// defaults of the job settings (see job_config.h), changed at run time by the command line options or a job file
 #define THERMAL_DATA_CSV_FILENAME "thermal_data.csv"
 #define SUN_SENSOR_DATA_CSV_FILENAME "sun_sensor_data.csv"
 #define SATELLITE_TELEMETRY_DATA_FILENAME "TITAraw_tlmy.bin"
 
+// columnar binary copies of the CSV files, full float precision (see columnar_reader.py), written when the
+// job asks for them ("--formats csv,columnar")
+// @note only in the in-memory mode, the columns need the amount of rows before writing
+#define WRITE_COLUMNAR_OUTPUT 0
+#define THERMAL_DATA_COLUMNAR_FILENAME "thermal_data.bcol"
+#define SUN_SENSOR_DATA_COLUMNAR_FILENAME "sun_sensor_data.bcol"
+
 #define CSV_DECIMAL_PRECISION 2
 
-int process_thermal_data(ThermalTelemetryCalibrated* thermal_telemetry_array, size_t *thermal_length);
-int process_sun_sensors_data(SunSensorsTelemetryCalibrated* sun_sensors_telemetry_array, size_t *sun_sensors_length);
+// min, mean, max and standard deviation of the thermal and sun sensor values per AGGREGATE_WINDOW_S of rtc_s,
+// computed while the rows are written (see window_aggregate.h), for the trend plots of long time ranges
+#define WRITE_AGGREGATE_OUTPUT 0
+#define AGGREGATE_WINDOW_S 60
+#define AGGREGATE_SUN_VECTOR_NORM 1
+#define THERMAL_DATA_AGGREGATE_FILENAME "thermal_aggregate.csv"
+#define SUN_SENSOR_DATA_AGGREGATE_FILENAME "sun_sensor_aggregate.csv"
+
+// every field of calibration_table.h in the selection, calibrated by the generic engine in one pass per frame,
+// written when the job asks for them ("--outputs all", or calibrated_fields in the list)
+// @note only in the in-memory mode, the other modes warn (a batch job with no other output is refused)
+#define WRITE_CALIBRATED_FIELDS_OUTPUT 0
+#define CALIBRATED_FIELDS_SELECTION CALIBRATION_FIELD_MASK_ALL
+#define CALIBRATED_FIELDS_CSV_FILENAME "calibrated_fields.csv"
+#define CALIBRATED_FIELDS_COLUMNAR_FILENAME "calibrated_fields.bcol"
+
+// 1 to process the file in constant memory. Frames arriving more than REORDER_WINDOW_FRAMES
+// positions out of order are dropped (and counted) in this mode
+#ifndef STREAMING_MODE
+#define STREAMING_MODE 0
+#endif
+#define REORDER_WINDOW_FRAMES 256
+// the streaming, live and incremental modes drop a repeated rtc_s as the frame arrives, before the windows
+// (see hash_dedup.h), so the first frame received is the one written. The set only needs the rtc_s the windows can
+// still take: the older ones are removed when it holds STREAMING_DEDUP_PRUNE_FRAMES of them
+#define STREAMING_DEDUP_PRUNE_FRAMES (16 * REORDER_WINDOW_FRAMES)
+
+// 1 to overlap the reads, the decoding and the writes of the two CSV files in STREAMING_MODE,
+// on four threads (see pipeline_io.h). The output is the same
+#ifndef PIPELINED_STREAMING
+#define PIPELINED_STREAMING 1
+#endif
+
+// "--live SOURCE" (the live mode, SOURCE as the input) reads a live feed instead (see stream_source.h),
+// through the same windows and CSV files.
+// A frame leaves its window when nothing was received for LIVE_IDLE_FLUSH_MS (the beacons are seconds
+// apart, so a live frame is written within that time), or when a frame LIVE_REORDER_DELAY_S newer
+// arrives in the same burst (e.g. a replay of the stored telemetry). The CSV files are written after every read
+#define LIVE_MODE_OPTION "--live"
+#define LIVE_REORDER_DELAY_S 900
+#define LIVE_IDLE_FLUSH_MS 200
+#define LIVE_READ_CHUNK_SIZE (64u << 10)
+
+// "--incremental" (the incremental mode) processes a file that grows between runs (e.g. rerun every few minutes
+// during a pass): only the bytes appended since the last run are decoded, through the same windows, and the rows
+// added to the CSV files. The state of the run is saved in a checkpoint next to the thermal CSV file, so jobs with
+// their own outputs keep their own checkpoint (see incremental_checkpoint.h).
+// A frame older than the ones the windows can still reorder is inserted in the rows already written,
+// only the CSV rows from its rtc_s on are rewritten
+#define INCREMENTAL_MODE_OPTION "--incremental"
+
+// which frame is kept when a rtc_s is repeated in the file by the in-memory mode: DEDUP_KEEP_FIRST or DEDUP_KEEP_LAST.
+// The streaming modes always keep the first one, the rows of the earlier frame may already be written
+#define FRAME_DEDUP_POLICY DEDUP_KEEP_FIRST
+// 1 to keep the frames with the same rtc_s but different content (CRC-32 of the frame bytes), in-memory mode only
+#define FRAME_DEDUP_KEY_INCLUDES_CRC 0
+
+// the frames have no CRC of their own and every frame indexed already passed the section ID check,
+// so there is nothing a validator could tell two frames of a rtc_s apart with
+_Static_assert(FRAME_DEDUP_POLICY != DEDUP_KEEP_VALID, "DEDUP_KEEP_VALID needs a validator, the frames have no CRC to check");
+
+// 1 to save the sorted frame index next to the input (see index_sidecar.h), loaded by the next runs.
+// The job setting index-sidecar changes it at run time
+#define FRAME_INDEX_SIDECAR 0
+
+// options of the in-memory mode, before the batch paths if any:
+//   --from RTC_S, --to RTC_S   only the frames of the time range, found in the index by binary search
+//   --update-index             with the index sidecar, also index the bytes appended to the input after its
+//                              sidecar was saved. Without it, those bytes are left out until the sidecar is rebuilt
+#define TIME_RANGE_FROM_OPTION "--from"
+#define TIME_RANGE_TO_OPTION "--to"
+#define UPDATE_INDEX_OPTION "--update-index"
+
+// "--robust", before the batch paths if any: a frame with a wrong section ID is skipped instead of stopping
+// the in-memory or the batch run, and the search goes on after its header. Nothing is printed per frame,
+// the wrong frames, the bytes skipped and the resyncs are reported once the file is indexed
+#define ROBUST_MODE_OPTION "--robust"
+
+// "--metrics", before the batch paths if any: the time of each stage, the bytes and frames read, the peak memory
+// and the integrity counters are printed at the end of a run of any mode as one line of JSON (see pipeline_metrics.h),
+// once per pass for the incremental mode. Without it the stages are not timed
+#define METRICS_OPTION "--metrics"
+
+// "--job FILE" and "--KEY VALUE" for every key of job_config.h, before the batch paths if any: the settings of
+// the run instead of the defaults above, e.g. "--outputs thermal --formats csv --output-dir pass_42".
+// They apply in command line order, so an option after a job file overrides it
+#define JOB_FILE_OPTION "--job"
+
+// threads for the indexing and the calibration, 0 for one per online processor, 1 for the serial path.
+// Files under PARALLEL_DECODE_MIN_CHUNK_SIZE bytes per thread use less threads
+#ifndef DECODE_THREAD_COUNT
+#define DECODE_THREAD_COUNT 0
+#endif
+
+/**
+ * @struct IndexOptions
+ * @brief  Command line options of the in-memory mode
+ */
+typedef struct INDEX_OPTIONS
+{
+    uint32_t    range_first_s;
+    uint32_t    range_last_s;               // included
+    bool        update_index;
+    bool        given;                      // at least one index option in the command line
+    bool        skip_wrong_frames;          // ROBUST_MODE_OPTION, also used by the batch mode
+    bool        print_metrics;              // METRICS_OPTION, also used by the batch and streaming modes
+} IndexOptions;
+
+// metrics of the run, disabled unless METRICS_OPTION is given
+static PipelineMetrics run_metrics;
+
+// settings of the run: the defaults above, then the options and the job files in command line order
+static JobConfig run_job;
 
-// @note Because this is a code::blocks project, I opted for not using console parameters
-// even that it's easy to configure, for simplicity, not used.
-int main()
+// values of the aggregate tables
+static const WindowAggregateColumn thermal_aggregate_columns[] =
 {
-    FILE *file = fopen(SATELLITE_TELEMETRY_DATA_FILENAME, "rb");
+    { "CPU_C",          offsetof(ThermalTelemetryCalibrated, CPU_C) },
+    { "mirror_cell_C",  offsetof(ThermalTelemetryCalibrated, mirror_cell_C) },
+};
+static const WindowAggregateColumn sun_sensors_aggregate_columns[] =
+{
+    { "sun_vector_x",   offsetof(SunSensorsTelemetryCalibrated, sun_vector_x) },
+    { "sun_vector_y",   offsetof(SunSensorsTelemetryCalibrated, sun_vector_y) },
+    { "sun_vector_z",   offsetof(SunSensorsTelemetryCalibrated, sun_vector_z) },
+};
 
-    if (!file)
-    {
-        perror("fopen");
-        return 1;
-    }
+void init_default_job(JobConfig *job);
+int parse_index_options(int argc, char *argv[], IndexOptions *options);
+int load_frame_index(MappedFrameFile *file, const char *filename, const BeaconHeader header, size_t decode_threads,
+                     bool update_index, DynamicArray *frame_index);
+int build_frame_index(MappedFrameFile *file, const BeaconHeader header, size_t decode_threads, DynamicArray *frame_index);
+void print_frame_integrity(const FrameIntegrityStats *integrity);
+void report_read_failure(const MappedFrameFile *file, const BeaconHeader header);
+void report_wrong_frame(const BeaconFrame *frame);
+int process_batch(char *const paths[], size_t path_count, const BeaconHeader header, bool skip_wrong_frames);
+int process_streaming_frames(FILE *file, const BeaconHeader header);
+int process_pipelined_frames(FILE *file, const BeaconHeader header);
+int process_live_frames(const char *source_specification, const BeaconHeader header);
+int process_incremental_frames(const char *filename, const BeaconHeader header);
+int process_calibrated_fields(MappedFrameFile *file, const DynamicArray *frame_index);
+int process_thermal_data(const ThermalTelemetryCalibrated* thermal_telemetry_array, size_t thermal_length);
+int process_sun_sensors_data(const SunSensorsTelemetryCalibrated* sun_sensors_telemetry_array, size_t sun_sensors_length);
 
+// @note Because this is a code::blocks project, without console parameters SATELLITE_TELEMETRY_DATA_FILENAME
+// is processed with the defaults above. The job settings (JOB_FILE_OPTION and the keys of job_config.h) change
+// the input, the outputs and the mode. Files or directories as parameters run the batch mode instead
+// (see batch_processor.h): all of them are merged into the same output files. LIVE_MODE_OPTION and a source
+// run the live mode, INCREMENTAL_MODE_OPTION the incremental mode, both with the other job settings
+int main(int argc, char *argv[])
+{
     // the header for each frame
     BeaconHeader header = { .beacon_id = { {0xFF,0xFF,0xF0} } };
 
-    // a struct to hold each frame read from the file
-    BeaconFrame frame;
-
-    ThermalTelemetryCalibrated *thermal_telemetry_array = NULL;
-    size_t thermal_length = 0;
-    size_t thermal_capacity = 0;
-
-    SunSensorsTelemetryCalibrated *sun_sensor_telemetry_array = NULL;
-    size_t sun_sensor_length = 0;
-    size_t sun_sensor_capacity = 0;
+    init_default_job(&run_job);
 
+    IndexOptions options;
+    int first_path = parse_index_options(argc, argv, &options);
+    if (first_path < 0 || !job_config_finish(&run_job)) return 1;
 
-    printf("[EXEC] file frame reading... \n");
-    ReadFileReturnType read_state = read_data_frame(file, header, &frame);
-    //@note I ended up reading both the thermal and sunsensor data.
-    //      Using the same architecture logic, I could maintain a somewhat cohesive structure
-    while (read_state == READ_OK)
+    if (run_job.mode == JOB_MODE_LIVE || run_job.mode == JOB_MODE_INCREMENTAL)
     {
-        /* THERMAL SECTION */
-        ThermalTelemetryCalibrated thermal_telemetry;
-        thermal_telemetry = thermal_to_calibrated(&frame.thermal, frame.platform.rtc_s);
+        const bool live = run_job.mode == JOB_MODE_LIVE;
+        const char *mode_name = live ? "live" : "incremental";
+        if (first_path < argc)
+        {
+            fprintf(stderr, "The %s mode reads one input, not the files or directories of the batch mode \n", mode_name);
+            return 1;
+        }
+        if (options.given) fprintf(stderr, "Warning: the index options are not used by the %s mode.\n", mode_name);
+        if (options.skip_wrong_frames) fprintf(stderr, "Warning: %s is not used by the %s mode.\n", ROBUST_MODE_OPTION, mode_name);
+        const unsigned streamed_outputs = JOB_OUTPUT_THERMAL | JOB_OUTPUT_SUN_SENSORS;
+        if ((run_job.outputs & streamed_outputs) != streamed_outputs || !run_job.write_csv)
+        {
+            fprintf(stderr, "Warning: the %s mode always writes the thermal and sun sensor CSV files.\n", mode_name);
+        }
+        // the rows of a checkpoint are written again by the next run, an aggregate window could not be
+        if (!live && run_job.write_aggregate)
+        {
+            fprintf(stderr, "Warning: the incremental mode doesn't write the aggregate tables.\n");
+            run_job.write_aggregate = false;
+        }
+        pipeline_metrics_init(&run_metrics, options.print_metrics, mode_name);
+        return live ? process_live_frames(run_job.input, header) : process_incremental_frames(run_job.input, header);
+    }
 
-        if (thermal_length == thermal_capacity)
+    if (first_path < argc)
+    {
+        if (options.given) fprintf(stderr, "Warning: the index options are not used by the batch mode.\n");
+        // the tasks keep the calibrated thermal and sun sensor rows of each file, not its frames
+        if (run_job.outputs & JOB_OUTPUT_CALIBRATED_FIELDS)
         {
-            // initialize with 128 capacity so we are not incrementing all the time
-            // if not enough space, increase capacity by adding 128
-            size_t new_capacity = thermal_capacity ? thermal_capacity + 128 : 128;
-            void *temp_ptr = realloc(thermal_telemetry_array, new_capacity * sizeof *thermal_telemetry_array);
-            if (!temp_ptr)
+            if (!(run_job.outputs & (JOB_OUTPUT_THERMAL | JOB_OUTPUT_SUN_SENSORS)))
             {
-                perror("realloc");
-                free(thermal_telemetry_array);
-                free(sun_sensor_telemetry_array);
-                fclose(file);
+                fprintf(stderr, "The batch mode doesn't write the calibrated fields, and no other output was asked for.\n");
                 return 1;
             }
-            thermal_telemetry_array = (ThermalTelemetryCalibrated*)temp_ptr;
-            thermal_capacity = new_capacity;
+            fprintf(stderr, "Warning: the batch mode doesn't write the calibrated fields.\n");
         }
-        thermal_telemetry_array[thermal_length++] = thermal_telemetry;
-        /* END THERMAL SECTION */
+        pipeline_metrics_init(&run_metrics, options.print_metrics, "batch");
+        return process_batch(argv + first_path, (size_t)(argc - first_path), header, options.skip_wrong_frames);
+    }
 
-        /* SUN VECTOR SECTION */
-        SunSensorsTelemetryCalibrated sun_sensor_telemetry;
-        sun_sensor_telemetry = sun_sensors_to_calibrated(&frame.aocs, frame.platform.rtc_s);
+    if (run_job.mode != JOB_MODE_MEMORY)
+    {
+        const bool pipelined = run_job.mode == JOB_MODE_PIPELINED;
+        pipeline_metrics_init(&run_metrics, options.print_metrics, pipelined ? "pipelined_streaming" : "streaming");
+        if (options.given) fprintf(stderr, "Warning: the index options are not used by the streaming mode.\n");
+        if (options.skip_wrong_frames) fprintf(stderr, "Warning: %s is not used by the streaming mode.\n", ROBUST_MODE_OPTION);
+        const unsigned streamed_outputs = JOB_OUTPUT_THERMAL | JOB_OUTPUT_SUN_SENSORS;
+        if ((run_job.outputs & streamed_outputs) != streamed_outputs || !run_job.write_csv)
+        {
+            fprintf(stderr, "Warning: the streaming mode always writes the thermal and sun sensor CSV files.\n");
+        }
 
-        if (sun_sensor_length == sun_sensor_capacity)
+        // plain stream reads, a mapping (or its fallback) could need the whole file in memory
+        FILE *stream = fopen(run_job.input, "rb");
+        if (!stream)
         {
-            // initialize with 128 capacity so we are not incrementing all the time
-            // if not enough space, increase capacity by adding 128
-            size_t new_capacity = sun_sensor_capacity ? sun_sensor_capacity + 128 : 128;
-            void *temp_ptr = realloc(sun_sensor_telemetry_array, new_capacity * sizeof * sun_sensor_telemetry_array);
-            if (!temp_ptr)
-            {
-                perror("realloc");
-                free(thermal_telemetry_array);
-                free(sun_sensor_telemetry_array);
-                fclose(file);
-                return 1;
-            }
-            sun_sensor_telemetry_array = (SunSensorsTelemetryCalibrated*)temp_ptr;
-            sun_sensor_capacity = new_capacity;
+            perror("fopen");
+            return 1;
         }
-        sun_sensor_telemetry_array[sun_sensor_length++] = sun_sensor_telemetry;
-        /* END SUN VECTOR SECTION */
+        int streaming_result = pipelined ? process_pipelined_frames(stream, header) : process_streaming_frames(stream, header);
+        fclose(stream);
+        if (streaming_result == 0) pipeline_metrics_print(&run_metrics, stdout);
+        return streaming_result;
+    }
+
+    MappedFrameFile file;
+
+    pipeline_metrics_init(&run_metrics, options.print_metrics, "memory");
+    if (!mapped_file_open(run_job.input, &file))
+    {
+        perror("mapped_file_open");
+        return 1;
+    }
+    file.skip_wrong_frames = options.skip_wrong_frames;
+    run_metrics.bytes_read = file.size;
+
+    // one (rtc_s, offset) entry per frame: the order is computed once, for all the subsystems
+    const size_t decode_threads = parallel_decode_thread_count(run_job.threads);
+    DynamicArray frame_index;
 
-        read_state = read_data_frame(file, header, &frame);
+    if (options.update_index && !run_job.index_sidecar)
+    {
+        fprintf(stderr, "Warning: %s is only used with the index sidecar (--index-sidecar yes).\n", UPDATE_INDEX_OPTION);
     }
 
-    if (read_state == READ_FAIL)
+    // the index only needs rtc_s, the frames are viewed in place (the section IDs are still checked)
+    int index_ok = load_frame_index(&file, run_job.input, header, decode_threads,
+                                    options.update_index, &frame_index);
+
+    if (!index_ok)
     {
-        fprintf(stderr, "Something went wrong with the file read: READ_FAIL \n");
-        free(thermal_telemetry_array);
-        free(sun_sensor_telemetry_array);
-        fclose(file);
+        mapped_file_close(&file);
         return 1;
     }
 
-    fclose(file);
+    // the index is sorted: the frames of the range are found without reading the others
+    const bool has_range = options.range_first_s > 0 || options.range_last_s < UINT32_MAX;
+    if (has_range)
+    {
+        frame_index_keep_range(&frame_index, options.range_first_s, options.range_last_s);
+        printf("[CHCK] frames in the time range [%lu, %lu]: %zu \n",
+               (unsigned long)options.range_first_s, (unsigned long)options.range_last_s, frame_index.length);
+    }
+
+    if (frame_index.length == 0)
+    {
+        fprintf(stderr, has_range ? "No frames in the time range \n" : "No frames in file \n");
+        dynamic_array_free(&frame_index);
+        mapped_file_close(&file);
+        return 1;
+    }
+
+    printf("[CHCK] frames post process: %zu \n", frame_index.length);
+    run_metrics.frames_unique = frame_index.length;
+
+    if (run_job.outputs & JOB_OUTPUT_CALIBRATED_FIELDS)
+    {
+        printf("[EXEC] calibrated fields processing... \n");
+        if (!process_calibrated_fields(&file, &frame_index))
+        {
+            fprintf(stderr, "ERROR: could not process the calibrated fields for some reason \n");
+        }
+    }
+
+    // the subsystem columns are only calibrated for their outputs
+    if (!(run_job.outputs & (JOB_OUTPUT_THERMAL | JOB_OUTPUT_SUN_SENSORS)))
+    {
+        dynamic_array_free(&frame_index);
+        mapped_file_close(&file);
+        pipeline_metrics_print(&run_metrics, stdout);
+        return 0;
+    }
+
+    // the columns and their array-of-structs views live in one arena, released at once on every path
+    Arena run_arena;
+    TelemetryStore telemetry;
 
-    if (thermal_length == 0 ||sun_sensor_length == 0)
+    arena_init(&run_arena, 0);
+    if (!telemetry_store_init_arena(&telemetry, frame_index.length, &run_arena))
     {
-        fprintf(stderr, "No frames in file \n");
-        free(thermal_telemetry_array);
-        free(sun_sensor_telemetry_array);
+        perror("telemetry_store_init");
+        arena_free(&run_arena);
+        dynamic_array_free(&frame_index);
+        mapped_file_close(&file);
         return 1;
     }
 
-    printf("[CHCK] thermal data packets: %d \n",thermal_length);
-    printf("[CHCK] SUN data packets: %d \n",sun_sensor_length);
+    printf("[EXEC] frame calibration... \n");
+    double stage_start = pipeline_metrics_stage_begin(&run_metrics);
+    bool load_ok = telemetry_store_load_parallel(&telemetry, &file, &frame_index, decode_threads);
+    pipeline_metrics_stage_end(&run_metrics, "telemetry.calibrate", stage_start, frame_index.length,
+                               frame_index.length * (uint64_t)BEACON_FRAME_SIZE);
 
-    printf("[EXEC] thermal data processing... \n");
-    if(!process_thermal_data(thermal_telemetry_array, &thermal_length))
+    dynamic_array_free(&frame_index);
+    mapped_file_close(&file);
+
+    if (!load_ok)
     {
-        fprintf(stderr, "ERROR: could not process the thermal data for some reason \n");
+        fprintf(stderr, "Something went wrong with the frame extraction \n");
+        arena_free(&run_arena);
+        return 1;
     }
-    printf("[EXEC] sun sensor data processing... \n");
-    if(!process_sun_sensors_data(sun_sensor_telemetry_array, &sun_sensor_length))
+
+    printf("[CHCK] thermal data packets: %zu \n", telemetry.thermal.length);
+    printf("[CHCK] SUN data packets: %zu \n", telemetry.sun_sensors.length);
+
+    // array-of-structs views of the columns, for the CSV and columnar writers
+    ThermalTelemetryCalibrated *thermal_array =
+        (ThermalTelemetryCalibrated*)arena_alloc(&run_arena, (telemetry.thermal.length + 1) * sizeof(ThermalTelemetryCalibrated));
+    SunSensorsTelemetryCalibrated *sun_sensors_array =
+        (SunSensorsTelemetryCalibrated*)arena_alloc(&run_arena, (telemetry.sun_sensors.length + 1) * sizeof(SunSensorsTelemetryCalibrated));
+    if (!thermal_array || !sun_sensors_array)
     {
-        fprintf(stderr, "ERROR: could not process the sun sensor data for some reason \n");
+        perror("arena_alloc");
+        arena_free(&run_arena);
+        return 1;
     }
 
-    printf("[CHCK] thermal data packets post process: %d \n",thermal_length);
-    printf("[CHCK] SUN data packets post process: %d \n",sun_sensor_length);
+    stage_start = pipeline_metrics_stage_begin(&run_metrics);
+    size_t thermal_length = thermal_columns_to_array(&telemetry.thermal, 0, telemetry.thermal.length, thermal_array);
+    size_t sun_sensors_length = sun_sensors_columns_to_array(&telemetry.sun_sensors, 0, telemetry.sun_sensors.length, sun_sensors_array);
+    pipeline_metrics_stage_end(&run_metrics, "telemetry.columns_to_rows", stage_start, thermal_length + sun_sensors_length,
+                               thermal_length * sizeof *thermal_array + sun_sensors_length * sizeof *sun_sensors_array);
+
+    if (run_job.outputs & JOB_OUTPUT_THERMAL)
+    {
+        printf("[EXEC] thermal data processing... \n");
+        if(!process_thermal_data(thermal_array, thermal_length))
+        {
+            fprintf(stderr, "ERROR: could not process the thermal data for some reason \n");
+        }
+    }
+    if (run_job.outputs & JOB_OUTPUT_SUN_SENSORS)
+    {
+        printf("[EXEC] sun sensor data processing... \n");
+        if(!process_sun_sensors_data(sun_sensors_array, sun_sensors_length))
+        {
+            fprintf(stderr, "ERROR: could not process the sun sensor data for some reason \n");
+        }
+    }
 
-    free(thermal_telemetry_array);
-    free(sun_sensor_telemetry_array);
+    arena_free(&run_arena);
+    pipeline_metrics_print(&run_metrics, stdout);
     return 0;
 }
 
+/**
+ * @brief Internal helper, size of a file in bytes, -1 if it can't be opened
+ */
+static long file_size_of(const char *filename)
+{
+    FILE *file = fopen(filename, "rb");
+    if (!file) return -1;
+
+    long end = fseek(file, 0, SEEK_END) == 0 ? ftell(file) : -1;
+    fclose(file);
+    return end;
+}
 
-int process_thermal_data(ThermalTelemetryCalibrated* thermal_telemetry_array, size_t *thermal_length)
+/**
+ * @brief Internal helper, ends the metrics stage of an output file, its bytes are the size of the file
+ */
+static void end_output_stage(const char *stage, double start_seconds, size_t rows, const char *filename)
 {
-    //PROCESS THERMAL VALUES (NOT NEEDED BUT ALREADY DONE)
-    // sort by timestamp using qsort
-    qsort(thermal_telemetry_array, *thermal_length, sizeof *thermal_telemetry_array, thermal_timestamp_comparator);
+    if (!run_metrics.enabled) return;
+
+    long size = file_size_of(filename);
+    pipeline_metrics_stage_end(&run_metrics, stage, start_seconds, rows, size > 0 ? (uint64_t)size : 0);
+}
+
+/**
+ * @brief Internal helper, opens the aggregate table of the thermal data
+ */
+static bool thermal_aggregator_open(WindowAggregator *aggregator)
+{
+    printf("[EXEC] generating %u s aggregates of thermal data at: ./%s\n", run_job.aggregate_window_s, run_job.thermal_aggregate);
+    return window_aggregator_open(aggregator, run_job.thermal_aggregate, run_job.aggregate_window_s,
+                                  offsetof(ThermalTelemetryCalibrated, thermal_telemetry_timestamp), thermal_aggregate_columns,
+                                  sizeof thermal_aggregate_columns / sizeof thermal_aggregate_columns[0], NULL,
+                                  run_job.decimals) == 1;
+}
+
+/**
+ * @brief Internal helper, opens the aggregate table of the sun sensor data, with the norm of the vector if selected
+ */
+static bool sun_sensors_aggregator_open(WindowAggregator *aggregator)
+{
+    printf("[EXEC] generating %u s aggregates of sun_vector data at: ./%s\n", run_job.aggregate_window_s, run_job.sun_sensors_aggregate);
+    return window_aggregator_open(aggregator, run_job.sun_sensors_aggregate, run_job.aggregate_window_s,
+                                  offsetof(SunSensorsTelemetryCalibrated, sun_sensors_telemetry_timestamp), sun_sensors_aggregate_columns,
+                                  sizeof sun_sensors_aggregate_columns / sizeof sun_sensors_aggregate_columns[0],
+                                  run_job.aggregate_norm ? "sun_vector_norm" : NULL, run_job.decimals) == 1;
+}
+
+/**
+ * @brief Internal helper, writes the last window of an aggregate table and closes it
+ *
+ * @param[in] write_ok      false if adding a row already failed, the file is closed anyway
+ *
+ * @return true if the table was written
+ */
+static bool close_aggregate_table(WindowAggregator *aggregator, bool write_ok, const char *filename)
+{
+    const size_t rows_added = aggregator->rows_added;
+    if (window_aggregator_close(aggregator) != 1 || !write_ok)
+    {
+        fprintf(stderr, "Aggregate table generation failed.\n");
+        return false;
+    }
+
+    printf("[CHCK] rows aggregated: %zu in %zu windows \n", rows_added, aggregator->writer.rows_written);
+    printf("[SAVE] Data file saved at: ./%s\n", filename);
+    return true;
+}
+
+/**
+ * @brief Internal helper, reads a rtc_s value of an option
+ */
+static bool parse_rtc_s(const char *text, uint32_t *rtc_s)
+{
+    char *end = NULL;
+    errno = 0;
+    unsigned long long value = strtoull(text, &end, 10);
+
+    if (errno != 0 || end == text || *end != '\0' || text[0] == '-' || value > UINT32_MAX) return false;
+    *rtc_s = (uint32_t)value;
+    return true;
+}
 
-    //Update the new array size with duplicates removed
-    *thermal_length = array_duplicate_removal(thermal_telemetry_array, *thermal_length, sizeof *thermal_telemetry_array, thermal_timestamp_comparator);
+void init_default_job(JobConfig *job)
+{
+    job_config_init(job);
+    job->mode = !STREAMING_MODE ? JOB_MODE_MEMORY : PIPELINED_STREAMING ? JOB_MODE_PIPELINED : JOB_MODE_STREAMING;
+    job->threads = DECODE_THREAD_COUNT;
+    job->outputs = JOB_OUTPUT_THERMAL | JOB_OUTPUT_SUN_SENSORS | (WRITE_CALIBRATED_FIELDS_OUTPUT ? JOB_OUTPUT_CALIBRATED_FIELDS : 0);
+    job->fields = CALIBRATED_FIELDS_SELECTION;
+    job->write_columnar = WRITE_COLUMNAR_OUTPUT;
+    job->write_aggregate = WRITE_AGGREGATE_OUTPUT;
+    job->aggregate_window_s = AGGREGATE_WINDOW_S;
+    job->aggregate_norm = AGGREGATE_SUN_VECTOR_NORM;
+    job->index_sidecar = FRAME_INDEX_SIDECAR;
+    job->decimals = CSV_DECIMAL_PRECISION;
 
-    printf("[EXEC] generating CSV for thermal data at: ./%s\n",THERMAL_DATA_CSV_FILENAME);
+    strcpy(job->input, SATELLITE_TELEMETRY_DATA_FILENAME);
+    strcpy(job->thermal_csv, THERMAL_DATA_CSV_FILENAME);
+    strcpy(job->thermal_columnar, THERMAL_DATA_COLUMNAR_FILENAME);
+    strcpy(job->thermal_aggregate, THERMAL_DATA_AGGREGATE_FILENAME);
+    strcpy(job->sun_sensors_csv, SUN_SENSOR_DATA_CSV_FILENAME);
+    strcpy(job->sun_sensors_columnar, SUN_SENSOR_DATA_COLUMNAR_FILENAME);
+    strcpy(job->sun_sensors_aggregate, SUN_SENSOR_DATA_AGGREGATE_FILENAME);
+    strcpy(job->calibrated_fields_csv, CALIBRATED_FIELDS_CSV_FILENAME);
+    strcpy(job->calibrated_fields_columnar, CALIBRATED_FIELDS_COLUMNAR_FILENAME);
+}
 
-    int csv_file_status = write_array_to_csv(
-        THERMAL_DATA_CSV_FILENAME,
-        thermal_telemetry_array,                // Generic pointer to the data array
-        *thermal_length,                         // Number of elements
-        sizeof(ThermalTelemetryCalibrated),     // Size of a single element
-        thermal_calibrated_to_csv_line,         // The callback formatter function
-        CSV_DECIMAL_PRECISION,                  // Decimal precision on print
-        "rtc_s",                                // First column name
-        "CPU_C",                                // Remaining column names
-        "mirror_cell_C",
-        NULL                                    // NULL to terminate the list of column names
-    );
+int parse_index_options(int argc, char *argv[], IndexOptions *options)
+{
+    options->range_first_s = 0;
+    options->range_last_s = UINT32_MAX;
+    options->update_index = false;
+    options->given = false;
+    options->skip_wrong_frames = false;
+    options->print_metrics = false;
 
-    if (csv_file_status != 1)
+    int arg = 1;
+    while (arg < argc && strncmp(argv[arg], "--", 2) == 0)
     {
-        fprintf(stderr, "CSV generation failed.\n");
+        const char *option = argv[arg];
+        uint32_t *range_bound = NULL;
+
+        const bool job_file = strcmp(option, JOB_FILE_OPTION) == 0;
+        if (job_file || job_config_is_key(option + 2))
+        {
+            if (arg + 1 >= argc)
+            {
+                fprintf(stderr, "Option %s needs a value \n", option);
+                return -1;
+            }
+            if (job_file ? !job_config_load(&run_job, argv[arg + 1]) : !job_config_set(&run_job, option + 2, argv[arg + 1]))
+            {
+                return -1;
+            }
+            arg += 2;
+            continue;
+        }
+
+        // shorthands of the mode settings, kept from before the job settings
+        if (strcmp(option, LIVE_MODE_OPTION) == 0)
+        {
+            if (arg + 1 >= argc)
+            {
+                fprintf(stderr, "Option %s needs a source \n", option);
+                return -1;
+            }
+            if (!job_config_set(&run_job, "mode", "live") || !job_config_set(&run_job, "input", argv[arg + 1])) return -1;
+            arg += 2;
+            continue;
+        }
+        if (strcmp(option, INCREMENTAL_MODE_OPTION) == 0)
+        {
+            job_config_set(&run_job, "mode", "incremental");
+            ++arg;
+            continue;
+        }
+
+        if (strcmp(option, ROBUST_MODE_OPTION) == 0 || strcmp(option, METRICS_OPTION) == 0)
+        {
+            if (strcmp(option, ROBUST_MODE_OPTION) == 0) options->skip_wrong_frames = true;
+            else options->print_metrics = true;
+            ++arg;
+            continue;
+        }
+
+        if (strcmp(option, UPDATE_INDEX_OPTION) == 0) options->update_index = true;
+        else if (strcmp(option, TIME_RANGE_FROM_OPTION) == 0) range_bound = &options->range_first_s;
+        else if (strcmp(option, TIME_RANGE_TO_OPTION) == 0) range_bound = &options->range_last_s;
+        else
+        {
+            fprintf(stderr, "Unknown option %s \n", option);
+            return -1;
+        }
+
+        if (range_bound && (arg + 1 >= argc || !parse_rtc_s(argv[arg + 1], range_bound)))
+        {
+            fprintf(stderr, "Option %s needs a rtc_s value \n", option);
+            return -1;
+        }
+
+        options->given = true;
+        arg += range_bound ? 2 : 1;
+    }
+    return arg;
+}
+
+int load_frame_index(MappedFrameFile *file, const char *filename, const BeaconHeader header, size_t decode_threads,
+                     bool update_index, DynamicArray *frame_index)
+{
+    char sidecar_filename[FILENAME_MAX];
+
+    if (!run_job.index_sidecar || !index_sidecar_path(filename, sidecar_filename, sizeof sidecar_filename))
+    {
+        printf("[EXEC] file frame indexing (up to %zu threads)... \n", decode_threads);
+        return build_frame_index(file, header, decode_threads, frame_index);
+    }
+
+    uint64_t indexed_size = 0;
+    double stage_start = pipeline_metrics_stage_begin(&run_metrics);
+    IndexSidecarState state = index_sidecar_load(sidecar_filename, file, header, FRAME_DEDUP_POLICY,
+                                                 FRAME_DEDUP_KEY_INCLUDES_CRC, frame_index, &indexed_size);
+    if (state != INDEX_SIDECAR_STALE)
+    {
+        pipeline_metrics_stage_end(&run_metrics, "index.sidecar_load", stage_start, frame_index->length,
+                                   frame_index->length * sizeof(FrameIndexEntry));
+    }
+
+    if (state == INDEX_SIDECAR_VALID || (state == INDEX_SIDECAR_APPENDED && !update_index))
+    {
+        printf("[CHCK] frame index loaded from ./%s: %zu unique frames \n", sidecar_filename, frame_index->length);
+        run_metrics.frames_read = frame_index->length;
+        if (state == INDEX_SIDECAR_APPENDED)
+        {
+            printf("[CHCK] %llu bytes appended after the index are not read (see %s) \n",
+                   (unsigned long long)(file->size - indexed_size), UPDATE_INDEX_OPTION);
+        }
+        return 1;
+    }
+
+    if (state == INDEX_SIDECAR_APPENDED && index_sidecar_can_merge(FRAME_DEDUP_POLICY, FRAME_DEDUP_KEY_INCLUDES_CRC))
+    {
+        // only the new bytes are read, and their sorted index merged into the loaded one
+        DynamicArray appended;
+        size_t repeated = 0;
+
+        run_metrics.frames_read = frame_index->length;
+
+        printf("[EXEC] indexing the %llu bytes appended after ./%s (up to %zu threads)... \n",
+               (unsigned long long)(file->size - indexed_size), sidecar_filename, decode_threads);
+
+        file->position = (size_t)index_sidecar_resume_offset(indexed_size);
+        int appended_ok = build_frame_index(file, header, decode_threads, &appended);
+        file->position = 0;
+
+        if (!appended_ok)
+        {
+            dynamic_array_free(frame_index);
+            return 0;
+        }
+
+        bool merge_ok = index_sidecar_merge(frame_index, &appended, FRAME_DEDUP_POLICY, &repeated);
+        dynamic_array_free(&appended);
+        if (!merge_ok)
+        {
+            perror("index_sidecar_merge");
+            dynamic_array_free(frame_index);
+            return 0;
+        }
+
+        printf("[CHCK] rtc_s both in the index and in the appended bytes: %zu \n", repeated);
+        printf("[CHCK] unique frames indexed: %zu \n", frame_index->length);
+    }
+    else
+    {
+        // a policy that needs every repeated frame can't be merged, the whole file is indexed again
+        if (state == INDEX_SIDECAR_APPENDED) dynamic_array_free(frame_index);
+
+        printf("[EXEC] file frame indexing (up to %zu threads)... \n", decode_threads);
+        if (!build_frame_index(file, header, decode_threads, frame_index)) return 0;
+    }
+
+    stage_start = pipeline_metrics_stage_begin(&run_metrics);
+    if (index_sidecar_save(sidecar_filename, file, header, FRAME_DEDUP_POLICY, FRAME_DEDUP_KEY_INCLUDES_CRC, frame_index))
+    {
+        printf("[SAVE] Frame index saved at: ./%s\n", sidecar_filename);
+        pipeline_metrics_stage_end(&run_metrics, "index.sidecar_save", stage_start, frame_index->length,
+                                   frame_index->length * sizeof(FrameIndexEntry));
     }
-    printf("[SAVE] Data file saved at: ./%s\n", THERMAL_DATA_CSV_FILENAME);
     return 1;
 }
 
-int process_sun_sensors_data(SunSensorsTelemetryCalibrated* sun_sensors_telemetry_array, size_t *sun_sensors_length)
+int build_frame_index(MappedFrameFile *file, const BeaconHeader header, size_t decode_threads, DynamicArray *frame_index)
 {
-    //PROCESS SUNSENSOR VALUES
-    // sort by timestamp using qsort
-    qsort(
-          sun_sensors_telemetry_array,
-          *sun_sensors_length,
-          sizeof * sun_sensors_telemetry_array,
-          sun_sensors_timestamp_comparator
-          );
-
-    //Update the new array size with duplicates removed
-    *sun_sensors_length = array_duplicate_removal
-                                    (
-                                    sun_sensors_telemetry_array,
-                                    *sun_sensors_length,
-                                    sizeof *sun_sensors_telemetry_array,
-                                    sun_sensors_timestamp_comparator
-                                    );
-
-    printf("[EXEC] generating CSV for sun_vector data at: ./%s\n",SUN_SENSOR_DATA_CSV_FILENAME);
-
-    int csv_file_status = write_array_to_csv(
-        SUN_SENSOR_DATA_CSV_FILENAME,
-        sun_sensors_telemetry_array,                // Generic pointer to the data array
-        *sun_sensors_length,                         // Number of elements
-        sizeof(SunSensorsTelemetryCalibrated),      // Size of a single element
-        sun_sensors_calibrated_to_csv_line,         // The callback formatter function
-        CSV_DECIMAL_PRECISION,                      // Decimal precision on print
-        "rtc_s",                                    // First column name
-        "sun_vector_x",
-        "sun_vector_y",
-        "sun_vector_z",
-        NULL                                    // NULL to terminate the list of column names
-    );
-
-    if (csv_file_status != 1)
+    const uint64_t bytes_to_read = file->size - file->position;
+    double stage_start = pipeline_metrics_stage_begin(&run_metrics);
+
+    // keeping the first frame of each rtc_s is what a stable sort does: each thread sorts its part of the
+    // file, and the sorted runs are merged dropping the repeated rtc_s on the way
+    if (FRAME_DEDUP_POLICY == DEDUP_KEEP_FIRST && !FRAME_DEDUP_KEY_INCLUDES_CRC)
     {
-        fprintf(stderr, "CSV generation failed.\n");
+        size_t duplicates_dropped = 0;
+
+        if (!dynamic_array_init(frame_index, sizeof(FrameIndexEntry), 0))
+        {
+            perror("dynamic_array_init");
+            return 0;
+        }
+        if (frame_index_build_sorted_parallel(file, header, frame_index, decode_threads, &duplicates_dropped) == READ_FAIL)
+        {
+            report_read_failure(file, header);
+            dynamic_array_free(frame_index);
+            return 0;
+        }
+
+        // sorted and deduplicated in the same pass as the read
+        pipeline_metrics_stage_end(&run_metrics, "index.read_sort_dedupe", stage_start,
+                                   frame_index->length + duplicates_dropped, bytes_to_read);
+        run_metrics.frames_read += frame_index->length + duplicates_dropped;
+        run_metrics.integrity = file->integrity;
+
+        print_frame_integrity(&file->integrity);
+        printf("[CHCK] duplicated frames: %zu dropped, 0 replaced \n", duplicates_dropped);
+        printf("[CHCK] unique frames indexed: %zu \n", frame_index->length);
+        return 1;
+    }
+
+    // the other policies need every duplicate: they are removed while the file is read, so only the unique frames get sorted
+    HashDedupSet frame_set;
+
+    if (!hash_dedup_init(&frame_set, sizeof(FrameIndexEntry), offsetof(FrameIndexEntry, rtc_s),
+                         BEACON_FRAME_COUNT_ESTIMATE(file->size), FRAME_DEDUP_POLICY, FRAME_DEDUP_KEY_INCLUDES_CRC, NULL))
+    {
+        perror("hash_dedup_init");
+        return 0;
+    }
+
+    if (frame_index_build_parallel(file, header, &frame_set, decode_threads) == READ_FAIL)
+    {
+        report_read_failure(file, header);
+        hash_dedup_free(&frame_set);
+        return 0;
+    }
+
+    const size_t frames_found = frame_set.elements.length + frame_set.duplicates_dropped + frame_set.duplicates_replaced;
+    pipeline_metrics_stage_end(&run_metrics, "index.read_dedupe", stage_start, frames_found, bytes_to_read);
+    run_metrics.frames_read += frames_found;
+    run_metrics.integrity = file->integrity;
+
+    print_frame_integrity(&file->integrity);
+    printf("[CHCK] duplicated frames: %zu dropped, %zu replaced \n",
+           frame_set.duplicates_dropped, frame_set.duplicates_replaced);
+
+    // only the elements are needed from here
+    hash_dedup_release_table(&frame_set);
+    *frame_index = frame_set.elements;
+
+    printf("[CHCK] unique frames indexed: %zu \n", frame_index->length);
+    printf("[EXEC] frame index sorting... \n");
+    stage_start = pipeline_metrics_stage_begin(&run_metrics);
+    // the set already solved the duplicates: with FRAME_DEDUP_KEY_INCLUDES_CRC, the frames of a rtc_s with
+    // different content stay, one row each
+    frame_index_sort_stable(frame_index);
+    pipeline_metrics_stage_end(&run_metrics, "index.sort", stage_start, frame_index->length,
+                               frame_index->length * sizeof(FrameIndexEntry));
+    return 1;
+}
+
+void print_frame_integrity(const FrameIntegrityStats *integrity)
+{
+    const FrameIntegrityStats nothing_skipped = { 0 };
+    if (memcmp(integrity, &nothing_skipped, sizeof nothing_skipped) == 0) return;
+
+    printf("[CHCK] wrong frames skipped: %zu, truncated: %zu, bytes skipped: %zu, resyncs: %zu \n",
+           integrity->frames_wrong, integrity->frames_truncated, integrity->bytes_skipped, integrity->resyncs);
+}
+
+// the decoder prints nothing, the read that stops on a frame reports it once
+void report_read_failure(const MappedFrameFile *file, const BeaconHeader header)
+{
+    const size_t frame_header = file->position - BEACON_HEADER_SIZE;
+    BeaconFrame frame;
+
+    switch (mapped_file_read_failure(file, header))
+    {
+        case READ_FAILURE_WRONG_FRAME:
+            decode_beacon_frame_sections(file->data + file->position, file->byte_order, FRAME_SECTION_NONE, &frame);
+            report_wrong_frame(&frame);
+            fprintf(stderr, "The frame at byte %zu stopped the read (%s skips the wrong frames) \n", frame_header,
+                    ROBUST_MODE_OPTION);
+            break;
+        case READ_FAILURE_TRUNCATED_FRAME:
+            fprintf(stderr, "The last frame is truncated, at byte %zu (%s reads the frames before it) \n", frame_header,
+                    ROBUST_MODE_OPTION);
+            break;
+        case READ_FAILURE_OUT_OF_MEMORY:
+            fprintf(stderr, "Something went wrong with the file read: not enough memory \n");
+            break;
+    }
+}
+
+void report_wrong_frame(const BeaconFrame *frame)
+{
+    char description[96];
+    if (describe_wrong_section_id(frame, description, sizeof description)) fprintf(stderr, "%s \n", description);
+}
+
+int process_batch(char *const paths[], size_t path_count, const BeaconHeader header, bool skip_wrong_frames)
+{
+    DynamicArray filenames;
+
+    if (!dynamic_array_init(&filenames, sizeof(char*), path_count))
+    {
+        perror("dynamic_array_init");
+        return 1;
+    }
+    if (!batch_collect_inputs(paths, path_count, &filenames))
+    {
+        batch_free_filenames(&filenames);
+        return 1;
+    }
+    if (filenames.length == 0)
+    {
+        fprintf(stderr, "No input files: no %s file in the paths given \n", BATCH_INPUT_EXTENSION);
+        batch_free_filenames(&filenames);
+        return 1;
+    }
+
+    const size_t decode_threads = parallel_decode_thread_count(run_job.threads);
+    BatchResult batch;
+
+    printf("[EXEC] batch processing of %zu files (%zu threads)... \n", filenames.length, decode_threads);
+    double stage_start = pipeline_metrics_stage_begin(&run_metrics);
+    bool batch_ok = batch_process(&filenames, header, decode_threads, skip_wrong_frames, &batch);
+    batch_free_filenames(&filenames);
+
+    if (!batch_ok)
+    {
+        fprintf(stderr, "Something went wrong with the batch processing \n");
+        return 1;
+    }
+
+    printf("[CHCK] files processed: %zu, failed: %zu, tasks stolen: %zu \n",
+           batch.files_processed, batch.files_failed, batch.tasks_stolen);
+    // frames_indexed sums the unique frames of each file, before the dedup between files
+    printf("[CHCK] frames indexed per file: %zu (duplicated frames: %zu in the files, %zu between files) \n",
+           batch.frames_indexed, batch.duplicates_in_files, batch.duplicates_between_files);
+    print_frame_integrity(&batch.integrity);
+    printf("[CHCK] frames post process: %zu \n", batch.thermal_length);
+
+    // the files are indexed, calibrated and merged by the same tasks
+    pipeline_metrics_stage_end(&run_metrics, "batch.read_calibrate_merge", stage_start,
+                               batch.frames_indexed + batch.duplicates_in_files, batch.bytes_read);
+    run_metrics.bytes_read = batch.bytes_read;
+    run_metrics.frames_read = batch.frames_indexed + batch.duplicates_in_files;
+    run_metrics.frames_unique = batch.thermal_length;
+    run_metrics.integrity = batch.integrity;
+
+    // the outputs of a previous run are kept
+    if (batch.thermal_length == 0)
+    {
+        fprintf(stderr, "No frames decoded, the outputs are not written \n");
+        batch_result_free(&batch);
+        pipeline_metrics_print(&run_metrics, stdout);
+        return 1;
+    }
+
+    bool outputs_ok = true;
+    if (run_job.outputs & JOB_OUTPUT_THERMAL)
+    {
+        printf("[EXEC] thermal data processing... \n");
+        if(!process_thermal_data(batch.thermal, batch.thermal_length))
+        {
+            fprintf(stderr, "ERROR: could not process the thermal data for some reason \n");
+            outputs_ok = false;
+        }
+    }
+    if (run_job.outputs & JOB_OUTPUT_SUN_SENSORS)
+    {
+        printf("[EXEC] sun sensor data processing... \n");
+        if(!process_sun_sensors_data(batch.sun_sensors, batch.sun_sensors_length))
+        {
+            fprintf(stderr, "ERROR: could not process the sun sensor data for some reason \n");
+            outputs_ok = false;
+        }
+    }
+
+    batch_result_free(&batch);
+    pipeline_metrics_print(&run_metrics, stdout);
+
+    // the outputs have the frames of the other files, but the run is not complete
+    if (batch.files_failed > 0)
+    {
+        fprintf(stderr, "%zu of the files were skipped (see above) \n", batch.files_failed);
+        return 1;
+    }
+    return outputs_ok ? 0 : 1;
+}
+
+/**
+ * @struct CalibratedRowsContext
+ * @brief  Context of the frame index walk of process_calibrated_fields
+ */
+typedef struct CALIBRATED_ROWS_CONTEXT
+{
+    const CalibrationEngine    *engine;
+    DynamicArray               *rows;               // reserved for the whole index
+} CalibratedRowsContext;
+
+/**
+ * @brief callback of the frame index walk, calibrates the fields of the engine straight into the next row
+ */
+static bool extract_calibrated_row(const BeaconFrameView *view, void *context)
+{
+    CalibratedRowsContext *rows_context = (CalibratedRowsContext*)context;
+    DynamicArray *rows = rows_context->rows;
+
+    if (rows->length == rows->capacity) return false;
+
+    CalibratedRow *row = (CalibratedRow*)((unsigned char*)rows->data + rows->length * rows->element_size);
+    calibration_engine_calibrate_view(rows_context->engine, view, row);
+    rows->length++;
+    return true;
+}
+
+/**
+ * @brief callback of the reorder windows, writes the element leaving the window to its CSV file
+ */
+static bool emit_csv_row(const void *element, void *context)
+{
+    return csv_writer_write((CsvWriter*)context, element) >= 0;
+}
+
+/**
+ * @struct AggregatingSink
+ * @brief  Context of emit_aggregated_row: the CSV sink of a window, and its aggregate table
+ */
+typedef struct AGGREGATING_SINK
+{
+    ReorderWindowEmit   emit;
+    void               *context;
+    WindowAggregator   *aggregator;
+} AggregatingSink;
+
+/**
+ * @brief callback of the reorder windows with the aggregate tables, the element goes to its CSV sink and its window
+ */
+static bool emit_aggregated_row(const void *element, void *context)
+{
+    AggregatingSink *sink = (AggregatingSink*)context;
+    return sink->emit(element, sink->context) && window_aggregator_add(sink->aggregator, element) == 1;
+}
+
+/**
+ * @struct StreamingOutput
+ * @brief  Reorder windows and CSV files of the streaming and live modes
+ */
+typedef struct STREAMING_OUTPUT
+{
+    ReorderWindow   thermal_window;
+    ReorderWindow   sun_sensor_window;
+    HashDedupSet    frame_set;              // uint32_t rtc_s received, a repeated one doesn't enter the windows
+    size_t          frame_set_prune_at;     // length of the set that starts the next pruning
+    CsvWriter       thermal_writer;
+    CsvWriter       sun_sensor_writer;
+    ReorderWindowEmit emit;                 // emit_csv_row, or emit_async_csv_row in the pipelined mode
+    void           *thermal_sink;           // context of emit for each window
+    void           *sun_sensor_sink;
+
+    bool            aggregate;              // the rows leaving the windows are aggregated too
+    WindowAggregator thermal_aggregator;
+    WindowAggregator sun_sensor_aggregator;
+    AggregatingSink thermal_tap;            // sinks of emit_aggregated_row
+    AggregatingSink sun_sensor_tap;
+} StreamingOutput;
+
+/**
+ * @brief Internal helper, sets where the elements leaving the windows go, through the aggregate tables if open
+ */
+static void streaming_output_route(StreamingOutput *output, ReorderWindowEmit emit, void *thermal_sink, void *sun_sensor_sink)
+{
+    if (!output->aggregate)
+    {
+        output->emit = emit;
+        output->thermal_sink = thermal_sink;
+        output->sun_sensor_sink = sun_sensor_sink;
+        return;
+    }
+
+    output->thermal_tap = (AggregatingSink){ emit, thermal_sink, &output->thermal_aggregator };
+    output->sun_sensor_tap = (AggregatingSink){ emit, sun_sensor_sink, &output->sun_sensor_aggregator };
+    output->emit = emit_aggregated_row;
+    output->thermal_sink = &output->thermal_tap;
+    output->sun_sensor_sink = &output->sun_sensor_tap;
+}
+
+/**
+ * @brief Internal helper, releases the reorder windows and the set of the received rtc_s
+ */
+static void streaming_output_free_windows(StreamingOutput *output)
+{
+    reorder_window_free(&output->thermal_window);
+    reorder_window_free(&output->sun_sensor_window);
+    hash_dedup_free(&output->frame_set);
+}
+
+/**
+ * @brief Internal helper, creates the reorder windows of the output, the CSV files are not opened
+ */
+static bool streaming_output_init_windows(StreamingOutput *output)
+{
+    memset(output, 0, sizeof *output);
+
+    bool windows_ready = reorder_window_init(&output->thermal_window, sizeof(ThermalTelemetryCalibrated),
+                                               REORDER_WINDOW_FRAMES, thermal_timestamp_comparator);
+    windows_ready = reorder_window_init(&output->sun_sensor_window, sizeof(SunSensorsTelemetryCalibrated),
+                                        REORDER_WINDOW_FRAMES, sun_sensors_timestamp_comparator) && windows_ready;
+    windows_ready = windows_ready && hash_dedup_init(&output->frame_set, sizeof(uint32_t), 0, STREAMING_DEDUP_PRUNE_FRAMES,
+                                                     DEDUP_KEEP_FIRST, false, NULL);
+    if (!windows_ready)
+    {
+        perror("reorder_window_init");
+        streaming_output_free_windows(output);
+        return false;
+    }
+    output->frame_set_prune_at = STREAMING_DEDUP_PRUNE_FRAMES;
+
+    streaming_output_route(output, emit_csv_row, &output->thermal_writer, &output->sun_sensor_writer);
+    return true;
+}
+
+/**
+ * @brief Creates the reorder windows and opens the CSV files
+ *
+ * @return true on success, false on error (nothing is left open)
+ */
+static bool streaming_output_open(StreamingOutput *output)
+{
+    if (!streaming_output_init_windows(output)) return false;
+
+    printf("[EXEC] generating CSV for thermal data at: ./%s\n", run_job.thermal_csv);
+    printf("[EXEC] generating CSV for sun_vector data at: ./%s\n", run_job.sun_sensors_csv);
+
+    if (csv_writer_open(&output->thermal_writer, run_job.thermal_csv, thermal_calibrated_to_csv_line,
+                        run_job.decimals, "rtc_s", "CPU_C", "mirror_cell_C", NULL) != 1 ||
+        csv_writer_open(&output->sun_sensor_writer, run_job.sun_sensors_csv, sun_sensors_calibrated_to_csv_line,
+                        run_job.decimals, "rtc_s", "sun_vector_x", "sun_vector_y", "sun_vector_z", NULL) != 1)
+    {
+        fprintf(stderr, "CSV generation failed.\n");
+        if (output->thermal_writer.file) csv_writer_close(&output->thermal_writer);
+        streaming_output_free_windows(output);
+        return false;
+    }
+
+    if (run_job.write_aggregate)
+    {
+        bool thermal_opened = thermal_aggregator_open(&output->thermal_aggregator);
+        if (!thermal_opened || !sun_sensors_aggregator_open(&output->sun_sensor_aggregator))
+        {
+            fprintf(stderr, "Aggregate table generation failed.\n");
+            if (thermal_opened) window_aggregator_close(&output->thermal_aggregator);
+            csv_writer_close(&output->thermal_writer);
+            csv_writer_close(&output->sun_sensor_writer);
+            streaming_output_free_windows(output);
+            return false;
+        }
+        output->aggregate = true;
+        streaming_output_route(output, emit_csv_row, &output->thermal_writer, &output->sun_sensor_writer);
+    }
+    return true;
+}
+
+/**
+ * @brief callback of hash_dedup_retain, keeps the rtc_s not older than the last one that left the windows
+ */
+static bool keep_timestamp_from(const void *element, void *context)
+{
+    uint32_t rtc_s;
+    memcpy(&rtc_s, element, sizeof rtc_s);
+    return rtc_s >= *(const uint32_t*)context;
+}
+
+/**
+ * @brief Internal helper, removes from the set the rtc_s the windows can't take anymore (late, see reorder_window_push)
+ */
+static void streaming_output_prune_set(StreamingOutput *output)
+{
+    const ReorderWindow *window = &output->thermal_window;
+
+    if (window->has_emitted)
+    {
+        uint32_t oldest_s;
+        memcpy(&oldest_s, window->last_emitted + offsetof(ThermalTelemetryCalibrated, thermal_telemetry_timestamp), sizeof oldest_s);
+        hash_dedup_retain(&output->frame_set, keep_timestamp_from, &oldest_s);
+    }
+
+    // still half full, the windows hold more rtc_s than expected: the next pruning waits for as many again
+    if (output->frame_set.elements.length > output->frame_set_prune_at / 2) output->frame_set_prune_at *= 2;
+}
+
+/**
+ * @brief Internal helper, adds to the set the rtc_s of the elements restored in the windows, and of the last one emitted
+ */
+static void streaming_output_seed_set(StreamingOutput *output)
+{
+    const ReorderWindow *window = &output->thermal_window;
+    const size_t timestamp_offset = offsetof(ThermalTelemetryCalibrated, thermal_telemetry_timestamp);
+    uint32_t rtc_s;
+
+    for (size_t i = 0; i < window->length; ++i)
+    {
+        memcpy(&rtc_s, window->elements + i * window->element_size + timestamp_offset, sizeof rtc_s);
+        hash_dedup_insert(&output->frame_set, &rtc_s, 0);
+    }
+    if (window->has_emitted)
+    {
+        memcpy(&rtc_s, window->last_emitted + timestamp_offset, sizeof rtc_s);
+        hash_dedup_insert(&output->frame_set, &rtc_s, 0);
+    }
+}
+
+/**
+ * @brief Calibrates a frame into the reorder windows, the elements leaving them are written
+ *
+ * @return false if a CSV write failed
+ */
+static bool streaming_output_push(StreamingOutput *output, const BeaconFrame *frame)
+{
+    // a repeated rtc_s stops here. If the set can't grow, the windows still drop the duplicates they hold together
+    const uint32_t rtc_s = frame->platform.rtc_s;
+    if (hash_dedup_insert(&output->frame_set, &rtc_s, 0) == DEDUP_DROPPED) return true;
+    if (output->frame_set.elements.length >= output->frame_set_prune_at) streaming_output_prune_set(output);
+
+    ThermalTelemetryCalibrated thermal_telemetry = thermal_to_calibrated(&frame->thermal, frame->platform.rtc_s);
+    SunSensorsTelemetryCalibrated sun_sensor_telemetry = sun_sensors_to_calibrated(&frame->aocs, frame->platform.rtc_s);
+
+    return reorder_window_push(&output->thermal_window, &thermal_telemetry, output->emit, output->thermal_sink) &&
+           reorder_window_push(&output->sun_sensor_window, &sun_sensor_telemetry, output->emit, output->sun_sensor_sink);
+}
+
+/**
+ * @brief Emits whatever is left in the windows, already in order
+ *
+ * @return false if a CSV write failed
+ */
+static bool streaming_output_flush_windows(StreamingOutput *output)
+{
+    return reorder_window_flush(&output->thermal_window, output->emit, output->thermal_sink) &&
+           reorder_window_flush(&output->sun_sensor_window, output->emit, output->sun_sensor_sink);
+}
+
+/**
+ * @brief Writes whatever is left in the windows (already in order), and closes the files
+ *
+ * @param[in] write_ok      false if a write already failed, the counters are still printed
+ *
+ * @return true if every element was written and the files closed
+ */
+static bool streaming_output_close(StreamingOutput *output, bool write_ok)
+{
+    write_ok = write_ok && streaming_output_flush_windows(output);
+
+    if (!write_ok) fprintf(stderr, "CSV generation failed.\n");
+
+    // a frame dropped by the set is a duplicate of both windows
+    const size_t duplicates_received = output->frame_set.duplicates_dropped;
+    printf("[CHCK] thermal data packets written: %zu (duplicates %zu, late %zu) \n", output->thermal_writer.rows_written,
+           duplicates_received + output->thermal_window.duplicates_dropped, output->thermal_window.late_dropped);
+    printf("[CHCK] SUN data packets written: %zu (duplicates %zu, late %zu) \n", output->sun_sensor_writer.rows_written,
+           duplicates_received + output->sun_sensor_window.duplicates_dropped, output->sun_sensor_window.late_dropped);
+
+    if (csv_writer_close(&output->thermal_writer) != 1) write_ok = false;
+    if (csv_writer_close(&output->sun_sensor_writer) != 1) write_ok = false;
+
+    if (output->aggregate)
+    {
+        write_ok = close_aggregate_table(&output->thermal_aggregator, write_ok, run_job.thermal_aggregate) && write_ok;
+        write_ok = close_aggregate_table(&output->sun_sensor_aggregator, write_ok, run_job.sun_sensors_aggregate) && write_ok;
+    }
+
+    streaming_output_free_windows(output);
+    return write_ok;
+}
+
+/**
+ * @brief Ends the metrics stage of a streaming run: the frames are read, calibrated, reordered and written together
+ */
+static void end_streaming_stage(double start_seconds, FILE *file, size_t frames_read, const StreamingOutput *output)
+{
+    if (!run_metrics.enabled) return;
+
+    long bytes_read = ftell(file);
+    run_metrics.bytes_read = bytes_read > 0 ? (uint64_t)bytes_read : 0;
+    run_metrics.frames_read = frames_read;
+    run_metrics.frames_unique = output->thermal_writer.rows_written;
+    pipeline_metrics_stage_end(&run_metrics, "stream.read_calibrate_write", start_seconds, frames_read, run_metrics.bytes_read);
+}
+
+int process_streaming_frames(FILE *file, const BeaconHeader header)
+{
+    StreamingOutput output;
+    int result = 1;
+
+    if (!streaming_output_open(&output)) return 1;
+
+    printf("[EXEC] streaming file frame reading... \n");
+
+    // only the sections read by the thermal and sun sensor calibrations are decoded
+    const FrameSectionMask streaming_sections = THERMAL_FRAME_SECTIONS | SUN_SENSORS_FRAME_SECTIONS;
+    BeaconFrame frame;
+    size_t frames_read = 0;
+    bool write_ok = true;
+    ReadFileReturnType read_state;
+    double stage_start = pipeline_metrics_stage_begin(&run_metrics);
+
+    while (write_ok && (read_state = read_data_frame_sections(file, header, streaming_sections, &frame)) == READ_OK)
+    {
+        write_ok = streaming_output_push(&output, &frame);
+        frames_read++;
+    }
+
+    if (write_ok && read_state == READ_FAIL)
+    {
+        // a short read leaves the frame as it was, only a wrong one is decoded
+        if (feof(file)) fprintf(stderr, "The last frame of the file is truncated \n");
+        else report_wrong_frame(&frame);
+        fprintf(stderr, "Something went wrong with the file read: READ_FAIL \n");
+        result = 0;
+    }
+
+    printf("[CHCK] frames read: %zu \n", frames_read);
+
+    if (!streaming_output_close(&output, write_ok)) result = 0;
+    end_streaming_stage(stage_start, file, frames_read, &output);
+    if (result)
+    {
+        printf("[SAVE] Data file saved at: ./%s\n", run_job.thermal_csv);
+        printf("[SAVE] Data file saved at: ./%s\n", run_job.sun_sensors_csv);
+    }
+    return result ? 0 : 1;
+}
+
+/**
+ * @brief callback of the reorder windows in the pipelined mode, the line is written by the writer thread
+ */
+static bool emit_async_csv_row(const void *element, void *context)
+{
+    return async_csv_writer_write((AsyncCsvWriter*)context, element) >= 0;
+}
+
+/**
+ * @brief callback of the stream parser in the pipelined mode
+ */
+static bool push_streaming_frame(const BeaconFrame *frame, void *context)
+{
+    return streaming_output_push((StreamingOutput*)context, frame);
+}
+
+int process_pipelined_frames(FILE *file, const BeaconHeader header)
+{
+    StreamingOutput output;
+    BlockReader reader;
+    AsyncCsvWriter thermal_async_writer;
+    AsyncCsvWriter sun_sensor_async_writer;
+
+    if (!streaming_output_open(&output)) return 1;
+
+    bool thermal_started = async_csv_writer_start(&thermal_async_writer, &output.thermal_writer);
+    bool sun_sensor_started = thermal_started && async_csv_writer_start(&sun_sensor_async_writer, &output.sun_sensor_writer);
+    if (!sun_sensor_started || !block_reader_start(&reader, file))
+    {
+        fprintf(stderr, "The pipeline threads could not be started.\n");
+        if (sun_sensor_started) async_csv_writer_finish(&sun_sensor_async_writer);
+        if (thermal_started) async_csv_writer_finish(&thermal_async_writer);
+        streaming_output_close(&output, false);
+        return 1;
+    }
+
+    // the lines leaving the windows are formatted here, and written by the writer threads
+    streaming_output_route(&output, emit_async_csv_row, &thermal_async_writer, &sun_sensor_async_writer);
+
+    printf("[EXEC] pipelined file frame reading (reader, decoder and 2 writer threads)... \n");
+
+    // only the sections read by the thermal and sun sensor calibrations are decoded. The first wrong
+    // frame ends the file, as in process_streaming_frames
+    StreamParser parser;
+    stream_parser_init(&parser, header, THERMAL_FRAME_SECTIONS | SUN_SENSORS_FRAME_SECTIONS);
+    parser.stop_at_wrong_frame = true;
+
+    bool write_ok = true;
+    const PipelineBuffer *block;
+    double stage_start = pipeline_metrics_stage_begin(&run_metrics);
+
+    while (write_ok && parser.frames_failed == 0 && (block = block_reader_next(&reader)) != NULL)
+    {
+        if (!stream_parser_feed(&parser, block->data, block->length, push_streaming_frame, &output))
+        {
+            write_ok = parser.frames_failed > 0;
+        }
+    }
+
+    bool read_ok = block_reader_stop(&reader);
+
+    write_ok = write_ok && streaming_output_flush_windows(&output);
+    write_ok = async_csv_writer_finish(&thermal_async_writer) && write_ok;
+    write_ok = async_csv_writer_finish(&sun_sensor_async_writer) && write_ok;
+
+    streaming_output_route(&output, emit_csv_row, &output.thermal_writer, &output.sun_sensor_writer);
+
+    // a header without its whole frame at the end of the file is a failed read too
+    int result = 1;
+    if (write_ok && (!read_ok || parser.frames_failed > 0 || parser.pending_length >= BEACON_HEADER_SIZE))
+    {
+        if (parser.frames_failed > 0) report_wrong_frame(&parser.wrong_frame);
+        else if (read_ok) fprintf(stderr, "The last frame of the file is truncated \n");
+        fprintf(stderr, "Something went wrong with the file read: READ_FAIL \n");
+        result = 0;
+    }
+
+    printf("[CHCK] frames read: %zu \n", parser.frames_decoded);
+
+    if (!streaming_output_close(&output, write_ok)) result = 0;
+    end_streaming_stage(stage_start, file, parser.frames_decoded, &output);
+    if (result)
+    {
+        printf("[SAVE] Data file saved at: ./%s\n", run_job.thermal_csv);
+        printf("[SAVE] Data file saved at: ./%s\n", run_job.sun_sensors_csv);
+    }
+    return result ? 0 : 1;
+}
+
+// set by SIGINT, the live mode stops at the next read and still writes what is in the windows
+static volatile sig_atomic_t live_stop_requested = 0;
+
+static void request_live_stop(int signal_number)
+{
+    (void)signal_number;
+    live_stop_requested = 1;
+}
+
+/**
+ * @brief callback of the stream parser, a frame makes the ones LIVE_REORDER_DELAY_S older leave the windows
+ */
+static bool push_live_frame(const BeaconFrame *frame, void *context)
+{
+    StreamingOutput *output = (StreamingOutput*)context;
+
+    if (!streaming_output_push(output, frame)) return false;
+    if (frame->platform.rtc_s < LIVE_REORDER_DELAY_S) return true;
+
+    const uint32_t bound = frame->platform.rtc_s - LIVE_REORDER_DELAY_S;
+    ThermalTelemetryCalibrated thermal_bound = { .thermal_telemetry_timestamp = bound };
+    SunSensorsTelemetryCalibrated sun_sensor_bound = { .sun_sensors_telemetry_timestamp = bound };
+
+    return reorder_window_emit_before(&output->thermal_window, &thermal_bound, output->emit, output->thermal_sink) &&
+           reorder_window_emit_before(&output->sun_sensor_window, &sun_sensor_bound, output->emit, output->sun_sensor_sink);
+}
+
+int process_live_frames(const char *source_specification, const BeaconHeader header)
+{
+    StreamSource source;
+    StreamingOutput output;
+    uint8_t *chunk = (uint8_t*)malloc(LIVE_READ_CHUNK_SIZE);
+
+    if (!chunk)
+    {
+        perror("malloc");
+        return 1;
+    }
+    if (!stream_source_open(source_specification, &source))
+    {
+        free(chunk);
+        return 1;
+    }
+    if (!streaming_output_open(&output))
+    {
+        stream_source_close(&source);
+        free(chunk);
+        return 1;
+    }
+
+    printf("[EXEC] live frame reading from %s (Ctrl+C to stop)... \n", source_specification);
+    fflush(stdout);
+    signal(SIGINT, request_live_stop);
+
+    // only the sections read by the thermal and sun sensor calibrations are decoded
+    StreamParser parser;
+    stream_parser_init(&parser, header, THERMAL_FRAME_SECTIONS | SUN_SENSORS_FRAME_SECTIONS);
+
+    bool write_ok = true;
+    StreamReadResult read_state = STREAM_READ_IDLE;
+
+    while (write_ok && !live_stop_requested)
+    {
+        size_t received;
+        read_state = stream_source_read(&source, chunk, LIVE_READ_CHUNK_SIZE, LIVE_IDLE_FLUSH_MS, &received);
+
+        // the time waiting for the feed is not a stage, only what is done with each read
+        double stage_start = pipeline_metrics_stage_begin(&run_metrics);
+        if (read_state == STREAM_READ_DATA)
+        {
+            const size_t frames_before = parser.frames_decoded;
+            write_ok = stream_parser_feed(&parser, chunk, received, push_live_frame, &output);
+            pipeline_metrics_stage_end(&run_metrics, "live.read_dedupe_write", stage_start,
+                                       parser.frames_decoded - frames_before, received);
+            stage_start = pipeline_metrics_stage_begin(&run_metrics);
+        }
+        else if (read_state == STREAM_READ_IDLE)
+        {
+            // a quiet feed (e.g. between two passes) doesn't keep the last frames waiting for newer ones
+            write_ok = streaming_output_flush_windows(&output);
+        }
+        else
+        {
+            break;
+        }
+
+        // the rows leave the process once per read, not once per pass
+        write_ok = write_ok &&
+                   csv_writer_flush(&output.thermal_writer) == 1 &&
+                   csv_writer_flush(&output.sun_sensor_writer) == 1;
+        pipeline_metrics_stage_end(&run_metrics, "live.csv_flush", stage_start, 0, 0);
+    }
+
+    signal(SIGINT, SIG_DFL);
+    stream_source_close(&source);
+    free(chunk);
+
+    int result = 1;
+    if (write_ok && read_state == STREAM_READ_ERROR)
+    {
+        perror("stream_source_read");
+        result = 0;
+    }
+
+    printf("[CHCK] bytes received: %zu \n", parser.bytes_received);
+    printf("[CHCK] frames read: %zu (wrong %zu, incomplete at the end %s) \n",
+           parser.frames_decoded, parser.frames_failed, parser.pending_length >= BEACON_HEADER_SIZE ? "yes" : "no");
+
+    if (!streaming_output_close(&output, write_ok)) result = 0;
+    run_metrics.bytes_read = parser.bytes_received;
+    run_metrics.frames_read = parser.frames_decoded;
+    run_metrics.frames_unique = output.thermal_writer.rows_written;
+    run_metrics.integrity.frames_wrong = parser.frames_failed;
+    if (result)
+    {
+        printf("[SAVE] Data file saved at: ./%s\n", run_job.thermal_csv);
+        printf("[SAVE] Data file saved at: ./%s\n", run_job.sun_sensors_csv);
+    }
+    pipeline_metrics_print(&run_metrics, stdout);
+    return result ? 0 : 1;
+}
+
+/**
+ * @brief Continues the CSV files of a checkpoint: the windows get back the elements they held,
+ *        and the CSV files are written again from the first row of those elements
+ *
+ * @return true on success, false on error (nothing is left open)
+ */
+static bool streaming_output_resume(StreamingOutput *output, const IncrementalOutput *thermal_state,
+                                    const IncrementalOutput *sun_sensor_state)
+{
+    if (!streaming_output_init_windows(output)) return false;
+
+    if (!incremental_output_restore(thermal_state, &output->thermal_window) ||
+        !incremental_output_restore(sun_sensor_state, &output->sun_sensor_window))
+    {
+        fprintf(stderr, "The checkpoint doesn't fit the reorder windows.\n");
+        streaming_output_free_windows(output);
+        return false;
+    }
+    streaming_output_seed_set(output);
+
+    printf("[EXEC] appending to the CSV for thermal data at: ./%s\n", run_job.thermal_csv);
+    printf("[EXEC] appending to the CSV for sun_vector data at: ./%s\n", run_job.sun_sensors_csv);
+
+    if (csv_writer_reopen(&output->thermal_writer, run_job.thermal_csv, thermal_calibrated_to_csv_line,
+                          run_job.decimals, (long)thermal_state->tail_offset, (size_t)thermal_state->tail_rows) != 1 ||
+        csv_writer_reopen(&output->sun_sensor_writer, run_job.sun_sensors_csv, sun_sensors_calibrated_to_csv_line,
+                          run_job.decimals, (long)sun_sensor_state->tail_offset, (size_t)sun_sensor_state->tail_rows) != 1)
+    {
+        fprintf(stderr, "CSV generation failed.\n");
+        if (output->thermal_writer.file) csv_writer_close(&output->thermal_writer);
+        streaming_output_free_windows(output);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @struct HeldRowsSink
+ * @brief  Context of emit_held_row
+ */
+typedef struct HELD_ROWS_SINK
+{
+    CsvWriter          *writer;
+    IncrementalOutput  *state;
+} HeldRowsSink;
+
+/**
+ * @brief callback of the reorder windows at the end of an incremental run, the rows are kept for the checkpoint
+ */
+static bool emit_held_row(const void *element, void *context)
+{
+    HeldRowsSink *sink = (HeldRowsSink*)context;
+    return csv_writer_write(sink->writer, element) >= 0 && incremental_output_hold(sink->state, element);
+}
+
+/**
+ * @brief callback of the reorder windows in the incremental mode, keeps the late elements to insert them after the run
+ */
+static bool collect_late_row(const void *element, void *context)
+{
+    return dynamic_array_push((DynamicArray*)context, element);
+}
+
+/**
+ * @brief Internal helper, inserts the late elements in a closed CSV file of the incremental mode
+ *
+ * @param[in,out] state     tail_offset and tail_rows are moved after the inserted rows
+ *
+ * @return false on error
+ */
+static bool insert_late_rows(const char *filename, DynamicArray *late, size_t key_offset, CsvLineFormatter formatter,
+                             IncrementalOutput *state, size_t *rows_inserted)
+{
+    long bytes_inserted = 0;
+    size_t length = late->length;
+
+    *rows_inserted = 0;
+    if (length == 0) return true;
+
+    // the rows already written are sorted and unique, the late ones have to be too
+    if (!timestamp_sort_deduplicate(late->data, &length, late->element_size, key_offset)) return false;
+
+    if (csv_insert_sorted_rows(filename, late->data, length, late->element_size, key_offset, formatter,
+                               run_job.decimals, rows_inserted, &bytes_inserted) != 1)
+    {
+        return false;
+    }
+
+    // every late element is older than the ones held by the window, so the held rows only moved
+    state->tail_offset += (uint64_t)bytes_inserted;
+    state->tail_rows += *rows_inserted;
+    return true;
+}
+
+int process_incremental_frames(const char *filename, const BeaconHeader header)
+{
+    char checkpoint_filename[FILENAME_MAX];
+    MappedFrameFile file;
+
+    if (!incremental_checkpoint_path(run_job.thermal_csv, checkpoint_filename, sizeof checkpoint_filename))
+    {
+        fprintf(stderr, "File name too long: %s \n", run_job.thermal_csv);
+        return 1;
+    }
+    if (!mapped_file_open(filename, &file))
+    {
+        perror("mapped_file_open");
+        return 1;
+    }
+
+    IncrementalOutput states[2];
+    uint64_t resume_offset = 0;
+    double stage_start = pipeline_metrics_stage_begin(&run_metrics);
+    bool resumed = incremental_checkpoint_load(checkpoint_filename, &file, header, states, 2, &resume_offset);
+
+    // a CSV file written by another run (or edited) since the checkpoint can't be continued
+    if (resumed && (file_size_of(run_job.thermal_csv) != (long)states[0].csv_size ||
+                    file_size_of(run_job.sun_sensors_csv) != (long)states[1].csv_size))
+    {
+        printf("[CHCK] the CSV files changed after the checkpoint \n");
+        incremental_output_free(&states[0]);
+        incremental_output_free(&states[1]);
+        resumed = false;
+    }
+
+    if (resumed && resume_offset == file.size)
+    {
+        printf("[CHCK] no bytes appended to ./%s after the checkpoint \n", filename);
+        pipeline_metrics_stage_end(&run_metrics, "incremental.checkpoint_load", stage_start, 0, 0);
+        incremental_output_free(&states[0]);
+        incremental_output_free(&states[1]);
+        mapped_file_close(&file);
+        pipeline_metrics_print(&run_metrics, stdout);
+        return 0;
+    }
+
+    if (resumed)
+    {
+        printf("[CHCK] checkpoint loaded from ./%s: %llu bytes already read \n",
+               checkpoint_filename, (unsigned long long)resume_offset);
+    }
+    else
+    {
+        printf("[CHCK] no checkpoint of ./%s to continue, it is read from the start \n", filename);
+        resume_offset = 0;
+    }
+
+    StreamingOutput output;
+    bool output_open = resumed ? streaming_output_resume(&output, &states[0], &states[1]) : streaming_output_open(&output);
+    // the rows of the held elements were cut from the CSV files, they are written again but not new
+    const size_t thermal_rows_before = (output_open ? output.thermal_writer.rows_written : 0) +
+                                       (resumed ? states[0].held_count : 0);
+    pipeline_metrics_stage_end(&run_metrics, "incremental.checkpoint_load", stage_start, 0, 0);
+
+    if (resumed)
+    {
+        incremental_output_free(&states[0]);
+        incremental_output_free(&states[1]);
+    }
+
+    DynamicArray thermal_late;
+    DynamicArray sun_sensor_late;
+    bool late_ready = dynamic_array_init(&thermal_late, sizeof(ThermalTelemetryCalibrated), 0);
+    late_ready = dynamic_array_init(&sun_sensor_late, sizeof(SunSensorsTelemetryCalibrated), 0) && late_ready;
+
+    if (!output_open || !late_ready)
+    {
+        if (!late_ready) perror("dynamic_array_init");
+        if (output_open) streaming_output_close(&output, false);
+        dynamic_array_free(&thermal_late);
+        dynamic_array_free(&sun_sensor_late);
+        mapped_file_close(&file);
+        return 1;
+    }
+
+    output.thermal_window.late = collect_late_row;
+    output.thermal_window.late_context = &thermal_late;
+    output.sun_sensor_window.late = collect_late_row;
+    output.sun_sensor_window.late_context = &sun_sensor_late;
+
+    printf("[EXEC] incremental file frame reading, %llu new bytes... \n",
+           (unsigned long long)(file.size - resume_offset));
+
+    // the new bytes are decoded in place. A frame not complete yet at the end of the file is left for the
+    // next run, the first wrong frame ends the file as in process_streaming_frames
+    StreamParser parser;
+    stream_parser_init(&parser, header, THERMAL_FRAME_SECTIONS | SUN_SENSORS_FRAME_SECTIONS);
+    parser.stop_at_wrong_frame = true;
+
+    // decoded, deduplicated by the set and written by the windows in the same pass, as in the streaming mode
+    stage_start = pipeline_metrics_stage_begin(&run_metrics);
+    bool write_ok = stream_parser_feed(&parser, file.data + resume_offset, file.size - (size_t)resume_offset,
+                                       push_streaming_frame, &output) || parser.frames_failed > 0;
+    pipeline_metrics_stage_end(&run_metrics, "incremental.read_dedupe_append", stage_start, parser.frames_decoded,
+                               file.size - resume_offset);
+    run_metrics.bytes_read = file.size - resume_offset;
+    run_metrics.frames_read = parser.frames_decoded;
+
+    // the elements still in the windows are written too, and saved to be written again by the next run
+    stage_start = pipeline_metrics_stage_begin(&run_metrics);
+    IncrementalOutput next_states[2];
+    long thermal_tail = csv_writer_tell(&output.thermal_writer);
+    long sun_sensor_tail = csv_writer_tell(&output.sun_sensor_writer);
+    bool captured = incremental_output_capture(&next_states[0], &output.thermal_window);
+    captured = incremental_output_capture(&next_states[1], &output.sun_sensor_window) && captured;
+
+    HeldRowsSink thermal_sink = { &output.thermal_writer, &next_states[0] };
+    HeldRowsSink sun_sensor_sink = { &output.sun_sensor_writer, &next_states[1] };
+    captured = captured && write_ok &&
+               reorder_window_flush(&output.thermal_window, emit_held_row, &thermal_sink) &&
+               reorder_window_flush(&output.sun_sensor_window, emit_held_row, &sun_sensor_sink);
+
+    next_states[0].tail_offset = (uint64_t)thermal_tail;
+    next_states[0].tail_rows = output.thermal_writer.rows_written - next_states[0].held_count;
+    next_states[1].tail_offset = (uint64_t)sun_sensor_tail;
+    next_states[1].tail_rows = output.sun_sensor_writer.rows_written - next_states[1].held_count;
+
+    int result = 1;
+    if (write_ok && parser.frames_failed > 0)
+    {
+        report_wrong_frame(&parser.wrong_frame);
+        fprintf(stderr, "Something went wrong with the file read: READ_FAIL \n");
+        result = 0;
+    }
+
+    printf("[CHCK] frames read: %zu \n", parser.frames_decoded);
+
+    if (!streaming_output_close(&output, write_ok && captured && thermal_tail >= 0 && sun_sensor_tail >= 0)) result = 0;
+    const size_t thermal_rows_appended = output.thermal_writer.rows_written - thermal_rows_before;
+    pipeline_metrics_stage_end(&run_metrics, "incremental.csv_flush", stage_start, next_states[0].held_count, 0);
+
+    size_t thermal_inserted = 0;
+    size_t sun_sensor_inserted = 0;
+    stage_start = pipeline_metrics_stage_begin(&run_metrics);
+    if (result &&
+        (!insert_late_rows(run_job.thermal_csv, &thermal_late, offsetof(ThermalTelemetryCalibrated, thermal_telemetry_timestamp),
+                           thermal_calibrated_to_csv_line, &next_states[0], &thermal_inserted) ||
+         !insert_late_rows(run_job.sun_sensors_csv, &sun_sensor_late,
+                           offsetof(SunSensorsTelemetryCalibrated, sun_sensors_telemetry_timestamp),
+                           sun_sensors_calibrated_to_csv_line, &next_states[1], &sun_sensor_inserted)))
+    {
+        fprintf(stderr, "The late rows could not be inserted in the CSV files.\n");
+        result = 0;
+    }
+    if (result && thermal_late.length + sun_sensor_late.length > 0)
+    {
+        pipeline_metrics_stage_end(&run_metrics, "incremental.late_insert", stage_start,
+                                   thermal_inserted + sun_sensor_inserted, 0);
+        printf("[CHCK] late rows inserted in the CSV files: thermal %zu, SUN %zu \n", thermal_inserted, sun_sensor_inserted);
+    }
+    run_metrics.frames_unique = thermal_rows_appended + thermal_inserted;
+
+    dynamic_array_free(&thermal_late);
+    dynamic_array_free(&sun_sensor_late);
+
+    // the bytes of a header or frame not complete yet are read again by the next run
+    long thermal_size = file_size_of(run_job.thermal_csv);
+    long sun_sensor_size = file_size_of(run_job.sun_sensors_csv);
+    next_states[0].csv_size = (uint64_t)thermal_size;
+    next_states[1].csv_size = (uint64_t)sun_sensor_size;
+
+    stage_start = pipeline_metrics_stage_begin(&run_metrics);
+    if (result && thermal_size >= 0 && sun_sensor_size >= 0 &&
+        incremental_checkpoint_save(checkpoint_filename, &file, file.size - parser.pending_length, header, next_states, 2))
+    {
+        pipeline_metrics_stage_end(&run_metrics, "incremental.checkpoint_save", stage_start, 0, 0);
+        printf("[SAVE] Checkpoint saved at: ./%s\n", checkpoint_filename);
+    }
+    else
+    {
+        // the CSV files don't match the old checkpoint anymore, the next run starts again
+        remove(checkpoint_filename);
+        result = 0;
+    }
+
+    incremental_output_free(&next_states[0]);
+    incremental_output_free(&next_states[1]);
+    mapped_file_close(&file);
+
+    if (result)
+    {
+        printf("[SAVE] Data file saved at: ./%s\n", run_job.thermal_csv);
+        printf("[SAVE] Data file saved at: ./%s\n", run_job.sun_sensors_csv);
+    }
+    pipeline_metrics_print(&run_metrics, stdout);
+    return result ? 0 : 1;
+}
+
+int process_calibrated_fields(MappedFrameFile *file, const DynamicArray *frame_index)
+{
+    CalibrationEngine engine;
+    DynamicArray rows;
+
+    if (!calibration_engine_init(&engine, run_job.fields))
+    {
+        fprintf(stderr, "Wrong calibrated fields selection.\n");
+        return 0;
+    }
+    if (!dynamic_array_init(&rows, engine.row_size, frame_index->length))
+    {
+        perror("dynamic_array_init");
+        return 0;
+    }
+
+    // only the selected fields are read, in place in the mapped file
+    CalibratedRowsContext context = { &engine, &rows };
+    double stage_start = pipeline_metrics_stage_begin(&run_metrics);
+    bool walk_ok = frame_index_walk(file, frame_index, extract_calibrated_row, &context);
+    pipeline_metrics_stage_end(&run_metrics, "calibrated_fields.calibrate", stage_start, rows.length,
+                               rows.length * (uint64_t)BEACON_FRAME_SIZE);
+
+    if (!walk_ok)
+    {
+        fprintf(stderr, "Something went wrong with the frame extraction \n");
+        dynamic_array_free(&rows);
+        return 0;
+    }
+    printf("[CHCK] calibrated fields: %zu, rows: %zu \n", engine.field_count, rows.length);
+
+    if (run_job.write_csv)
+    {
+        printf("[EXEC] generating CSV for the calibrated fields at: ./%s\n", run_job.calibrated_fields_csv);
+        stage_start = pipeline_metrics_stage_begin(&run_metrics);
+        if (calibration_engine_write_csv(&engine, run_job.calibrated_fields_csv, &rows) != 1)
+        {
+            fprintf(stderr, "CSV generation failed.\n");
+        }
+        else
+        {
+            end_output_stage("calibrated_fields.csv_write", stage_start, rows.length, run_job.calibrated_fields_csv);
+            printf("[SAVE] Data file saved at: ./%s\n", run_job.calibrated_fields_csv);
+        }
+    }
+
+    if (run_job.write_columnar)
+    {
+        stage_start = pipeline_metrics_stage_begin(&run_metrics);
+        if (calibration_engine_write_columnar(&engine, run_job.calibrated_fields_columnar, &rows) != 1)
+        {
+            fprintf(stderr, "Columnar file generation failed.\n");
+        }
+        else
+        {
+            end_output_stage("calibrated_fields.columnar_write", stage_start, rows.length, run_job.calibrated_fields_columnar);
+            printf("[SAVE] Data file saved at: ./%s\n", run_job.calibrated_fields_columnar);
+        }
+    }
+
+    dynamic_array_free(&rows);
+    return 1;
+}
+
+int process_thermal_data(const ThermalTelemetryCalibrated* thermal_telemetry_array, size_t thermal_length)
+{
+    //PROCESS THERMAL VALUES (NOT NEEDED BUT ALREADY DONE)
+    // the values come sorted and without duplicates from the telemetry store
+    double stage_start = 0.0;
+    if (run_job.write_csv)
+    {
+        printf("[EXEC] generating CSV for thermal data at: ./%s\n",run_job.thermal_csv);
+
+        stage_start = pipeline_metrics_stage_begin(&run_metrics);
+        int csv_file_status = write_array_to_csv_batch(
+            run_job.thermal_csv,
+            thermal_telemetry_array,                // Generic pointer to the data array
+            thermal_length,                         // Number of elements
+            sizeof(ThermalTelemetryCalibrated),     // Size of a single element
+            thermal_calibrated_to_csv_batch,        // The callback batch formatter function
+            run_job.decimals,                       // Decimal precision on print
+            "rtc_s",                                // First column name
+            "CPU_C",                                // Remaining column names
+            "mirror_cell_C",
+            NULL                                    // NULL to terminate the list of column names
+        );
+
+        if (csv_file_status != 1)
+        {
+            fprintf(stderr, "CSV generation failed.\n");
+        }
+        end_output_stage("thermal.csv_write", stage_start, thermal_length, run_job.thermal_csv);
+        printf("[SAVE] Data file saved at: ./%s\n", run_job.thermal_csv);
+    }
+
+    if (run_job.write_columnar)
+    {
+        static const ColumnarColumn thermal_columns[] =
+        {
+            { "rtc_s",          COLUMNAR_UINT32,  offsetof(ThermalTelemetryCalibrated, thermal_telemetry_timestamp) },
+            { "CPU_C",          COLUMNAR_FLOAT32, offsetof(ThermalTelemetryCalibrated, CPU_C) },
+            { "mirror_cell_C",  COLUMNAR_FLOAT32, offsetof(ThermalTelemetryCalibrated, mirror_cell_C) },
+        };
+
+        stage_start = pipeline_metrics_stage_begin(&run_metrics);
+        if (write_array_to_columnar(run_job.thermal_columnar, thermal_telemetry_array, thermal_length,
+                                    sizeof(ThermalTelemetryCalibrated), thermal_columns,
+                                    sizeof thermal_columns / sizeof thermal_columns[0]) != 1)
+        {
+            fprintf(stderr, "Columnar file generation failed.\n");
+        }
+        else
+        {
+            end_output_stage("thermal.columnar_write", stage_start, thermal_length, run_job.thermal_columnar);
+            printf("[SAVE] Data file saved at: ./%s\n", run_job.thermal_columnar);
+        }
+    }
+
+    if (run_job.write_aggregate)
+    {
+        WindowAggregator aggregator;
+
+        stage_start = pipeline_metrics_stage_begin(&run_metrics);
+        if (!thermal_aggregator_open(&aggregator))
+        {
+            fprintf(stderr, "Aggregate table generation failed.\n");
+        }
+        else
+        {
+            bool added = window_aggregator_add_array(&aggregator, thermal_telemetry_array, thermal_length, sizeof(ThermalTelemetryCalibrated)) == 1;
+            if (close_aggregate_table(&aggregator, added, run_job.thermal_aggregate))
+            {
+                end_output_stage("thermal.aggregate_write", stage_start, thermal_length, run_job.thermal_aggregate);
+            }
+        }
+    }
+    return 1;
+}
+
+int process_sun_sensors_data(const SunSensorsTelemetryCalibrated* sun_sensors_telemetry_array, size_t sun_sensors_length)
+{
+    //PROCESS SUNSENSOR VALUES
+    // the values come sorted and without duplicates from the telemetry store
+    double stage_start = 0.0;
+    if (run_job.write_csv)
+    {
+        printf("[EXEC] generating CSV for sun_vector data at: ./%s\n",run_job.sun_sensors_csv);
+
+        stage_start = pipeline_metrics_stage_begin(&run_metrics);
+        int csv_file_status = write_array_to_csv_batch(
+            run_job.sun_sensors_csv,
+            sun_sensors_telemetry_array,                // Generic pointer to the data array
+            sun_sensors_length,                         // Number of elements
+            sizeof(SunSensorsTelemetryCalibrated),      // Size of a single element
+            sun_sensors_calibrated_to_csv_batch,        // The callback batch formatter function
+            run_job.decimals,                           // Decimal precision on print
+            "rtc_s",                                    // First column name
+            "sun_vector_x",
+            "sun_vector_y",
+            "sun_vector_z",
+            NULL                                    // NULL to terminate the list of column names
+        );
+
+        if (csv_file_status != 1)
+        {
+            fprintf(stderr, "CSV generation failed.\n");
+        }
+        end_output_stage("sun_sensors.csv_write", stage_start, sun_sensors_length, run_job.sun_sensors_csv);
+        printf("[SAVE] Data file saved at: ./%s\n", run_job.sun_sensors_csv);
+    }
+
+    if (run_job.write_columnar)
+    {
+        static const ColumnarColumn sun_sensors_columns[] =
+        {
+            { "rtc_s",          COLUMNAR_UINT32,  offsetof(SunSensorsTelemetryCalibrated, sun_sensors_telemetry_timestamp) },
+            { "sun_vector_x",   COLUMNAR_FLOAT32, offsetof(SunSensorsTelemetryCalibrated, sun_vector_x) },
+            { "sun_vector_y",   COLUMNAR_FLOAT32, offsetof(SunSensorsTelemetryCalibrated, sun_vector_y) },
+            { "sun_vector_z",   COLUMNAR_FLOAT32, offsetof(SunSensorsTelemetryCalibrated, sun_vector_z) },
+        };
+
+        stage_start = pipeline_metrics_stage_begin(&run_metrics);
+        if (write_array_to_columnar(run_job.sun_sensors_columnar, sun_sensors_telemetry_array, sun_sensors_length,
+                                    sizeof(SunSensorsTelemetryCalibrated), sun_sensors_columns,
+                                    sizeof sun_sensors_columns / sizeof sun_sensors_columns[0]) != 1)
+        {
+            fprintf(stderr, "Columnar file generation failed.\n");
+        }
+        else
+        {
+            end_output_stage("sun_sensors.columnar_write", stage_start, sun_sensors_length, run_job.sun_sensors_columnar);
+            printf("[SAVE] Data file saved at: ./%s\n", run_job.sun_sensors_columnar);
+        }
+    }
+
+    if (run_job.write_aggregate)
+    {
+        WindowAggregator aggregator;
+
+        stage_start = pipeline_metrics_stage_begin(&run_metrics);
+        if (!sun_sensors_aggregator_open(&aggregator))
+        {
+            fprintf(stderr, "Aggregate table generation failed.\n");
+        }
+        else
+        {
+            bool added = window_aggregator_add_array(&aggregator, sun_sensors_telemetry_array, sun_sensors_length, sizeof(SunSensorsTelemetryCalibrated)) == 1;
+            if (close_aggregate_table(&aggregator, added, run_job.sun_sensors_aggregate))
+            {
+                end_output_stage("sun_sensors.aggregate_write", stage_start, sun_sensors_length, run_job.sun_sensors_aggregate);
+            }
+        }
     }
-    printf("[SAVE] Data file saved at: ./%s\n", SUN_SENSOR_DATA_CSV_FILENAME);
     return 1;
 }
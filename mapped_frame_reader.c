@@ -0,0 +1,248 @@
+/**
+ * @file mapped_frame_reader.c
+ * @brief Implementation file of the mapped_frame_reader header
+ *
+ *  Uses mmap on POSIX systems and CreateFileMapping on windows. If the mapping fails
+ *  (e.g. the file is a pipe), the file is read in MAPPED_FILE_READ_BLOCK_SIZE blocks into the heap
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#include "mapped_frame_reader.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, loads the whole file in the heap reading large blocks
+ */
+static bool load_file_blocks(const char *filename, MappedFrameFile *out)
+{
+    FILE *file = fopen(filename, "rb");
+    if (!file) return false;
+
+    uint8_t *buffer = NULL;
+    size_t length = 0;
+    size_t capacity = 0;
+
+    for (;;)
+    {
+        if (capacity - length < MAPPED_FILE_READ_BLOCK_SIZE)
+        {
+            size_t new_capacity = capacity ? capacity * 2 : MAPPED_FILE_READ_BLOCK_SIZE;
+            void *temp_ptr = realloc(buffer, new_capacity);
+            if (!temp_ptr)
+            {
+                free(buffer);
+                fclose(file);
+                return false;
+            }
+            buffer = (uint8_t*)temp_ptr;
+            capacity = new_capacity;
+        }
+
+        size_t read_bytes = fread(buffer + length, 1, MAPPED_FILE_READ_BLOCK_SIZE, file);
+        length += read_bytes;
+        if (read_bytes < MAPPED_FILE_READ_BLOCK_SIZE) break;
+    }
+
+    if (ferror(file))
+    {
+        free(buffer);
+        fclose(file);
+        return false;
+    }
+    fclose(file);
+
+    out->data = buffer;
+    out->size = length;
+    out->is_mapped = false;
+    return true;
+}
+
+//////////////////////////////////////////
+
+bool mapped_file_open(const char *filename, MappedFrameFile *out)
+{
+    if (!filename || !out) return false;
+
+    memset(out, 0, sizeof *out);
+    out->decode_sections = FRAME_SECTIONS_ALL;
+
+#ifdef _WIN32
+    HANDLE file_handle = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL,
+                                     OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file_handle != INVALID_HANDLE_VALUE)
+    {
+        LARGE_INTEGER file_size;
+        FILETIME write_time;
+        if (GetFileTime(file_handle, NULL, NULL, &write_time))
+        {
+            // 100 ns intervals since 1601-01-01
+            uint64_t intervals = ((uint64_t)write_time.dwHighDateTime << 32) | write_time.dwLowDateTime;
+            out->modified_time_ns = ((int64_t)intervals - 116444736000000000) * 100;
+        }
+        if (GetFileSizeEx(file_handle, &file_size) && file_size.QuadPart == 0)
+        {
+            // empty files can't be mapped, but they are valid files without frames
+            CloseHandle(file_handle);
+            return true;
+        }
+
+        HANDLE mapping_handle = CreateFileMappingA(file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping_handle)
+        {
+            const void *view = MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+            if (view)
+            {
+                out->data = (const uint8_t*)view;
+                out->size = (size_t)file_size.QuadPart;
+                out->is_mapped = true;
+                out->file_handle = file_handle;
+                out->mapping_handle = mapping_handle;
+                return true;
+            }
+            CloseHandle(mapping_handle);
+        }
+        CloseHandle(file_handle);
+    }
+#else
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) == 0 && S_ISREG(file_stat.st_mode))
+    {
+#ifdef __APPLE__
+        out->modified_time_ns = (int64_t)file_stat.st_mtimespec.tv_sec * 1000000000 + file_stat.st_mtimespec.tv_nsec;
+#else
+        out->modified_time_ns = (int64_t)file_stat.st_mtim.tv_sec * 1000000000 + file_stat.st_mtim.tv_nsec;
+#endif
+        if (file_stat.st_size == 0)
+        {
+            // empty files can't be mapped, but they are valid files without frames
+            close(fd);
+            return true;
+        }
+
+        void *view = mmap(NULL, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view != MAP_FAILED)
+        {
+            // the frames are decoded front to back, let the kernel read ahead aggressively
+            madvise(view, (size_t)file_stat.st_size, MADV_SEQUENTIAL);
+            close(fd);
+            out->data = (const uint8_t*)view;
+            out->size = (size_t)file_stat.st_size;
+            out->is_mapped = true;
+            return true;
+        }
+    }
+    close(fd);
+#endif
+
+    // mapping not possible, fallback to block reads
+    return load_file_blocks(filename, out);
+}
+
+//////////////////////////////////////////
+
+bool mapped_file_from_buffer(const uint8_t *data, size_t size, MappedFrameFile *out)
+{
+    if (!out || (!data && size > 0)) return false;
+
+    memset(out, 0, sizeof *out);
+    out->decode_sections = FRAME_SECTIONS_ALL;
+    out->data = data;
+    out->size = size;
+    out->is_borrowed = true;
+    return true;
+}
+
+//////////////////////////////////////////
+
+void mapped_file_close(MappedFrameFile *file)
+{
+    if (!file) return;
+
+    if (file->is_mapped)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(file->data);
+        CloseHandle(file->mapping_handle);
+        CloseHandle(file->file_handle);
+#else
+        munmap((void*)file->data, file->size);
+#endif
+    }
+    else if (!file->is_borrowed)
+    {
+        free((void*)file->data);
+    }
+    memset(file, 0, sizeof *file);
+}
+
+//////////////////////////////////////////
+
+ReadFileReturnType read_mapped_data_frame
+(
+    MappedFrameFile *file,
+    const BeaconHeader header,
+    BeaconFrame *out
+)
+{
+    if (!file || !out) return READ_FAIL;
+    return read_data_frame_from_buffer_sections(file->data, file->size, &file->position, &file->byte_order, header,
+                                                file->decode_sections, out);
+}
+
+//////////////////////////////////////////
+
+ReadFileReturnType read_mapped_frame_view
+(
+    MappedFrameFile *file,
+    const BeaconHeader header,
+    BeaconFrameView *out
+)
+{
+    if (!file || !out) return READ_FAIL;
+    if (file->skip_wrong_frames)
+    {
+        return read_frame_view_from_buffer_robust(file->data, file->size, &file->position, &file->byte_order, header,
+                                                  &file->integrity, out);
+    }
+    return read_frame_view_from_buffer(file->data, file->size, &file->position, &file->byte_order, header, out);
+}
+
+//////////////////////////////////////////
+
+ReadFailureCause mapped_file_read_failure(const MappedFrameFile *file, const BeaconHeader header)
+{
+    if (!file || file->position < BEACON_HEADER_SIZE || file->position > file->size) return READ_FAILURE_OUT_OF_MEMORY;
+    if (memcmp(file->data + file->position - BEACON_HEADER_SIZE, header.beacon_id.b, BEACON_HEADER_SIZE) != 0)
+    {
+        return READ_FAILURE_OUT_OF_MEMORY;
+    }
+    if (file->size - file->position < BEACON_FRAME_SIZE) return READ_FAILURE_TRUNCATED_FRAME;
+
+    const uint8_t *frame_bytes = file->data + file->position;
+    if (detect_frame_byte_order(frame_bytes) == FRAME_BYTE_ORDER_UNKNOWN ||
+        !beacon_frame_ids_match(frame_bytes, file->byte_order))
+    {
+        return READ_FAILURE_WRONG_FRAME;
+    }
+    return READ_FAILURE_OUT_OF_MEMORY;
+}
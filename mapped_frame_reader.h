@@ -0,0 +1,139 @@
+/**
+ * @file mapped_frame_reader.h
+ * @brief Header of the memory mapped frame reader
+ *
+ *  Maps a whole telemetry file in memory (or loads it in large blocks when mapping is not available)
+ *  and decodes the frames straight from that byte span, instead of one stdio call per field.
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#ifndef MAPPED_FRAME_READER_H_INCLUDED
+#define MAPPED_FRAME_READER_H_INCLUDED
+
+#include "beacon_frame_schema.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// block size used to load the file when it can't be memory mapped
+#define MAPPED_FILE_READ_BLOCK_SIZE (1u << 20)
+
+/**
+    @enum why a read of the frames of a MappedFrameFile returned READ_FAIL, see mapped_file_read_failure
+**/
+typedef enum
+{
+    READ_FAILURE_OUT_OF_MEMORY,             // the position is not right after a header
+    READ_FAILURE_WRONG_FRAME,               // a frame with a wrong section ID after the header before the position
+    READ_FAILURE_TRUNCATED_FRAME            // less than a frame after that header, the end of the file cuts it
+} ReadFailureCause;
+
+/**
+ * @struct MappedFrameFile
+ * @brief  Holds a telemetry file mapped in memory, and the current read position
+ */
+typedef struct MAPPED_FRAME_FILE
+{
+    const uint8_t  *data;                   // start of the file bytes
+    size_t          size;                   // size of the file in bytes
+    int64_t         modified_time_ns;       // last write of the file in nanoseconds since 1970-01-01, 0 if unknown (buffers)
+    size_t          position;               // offset of the next byte to read
+    FrameByteOrder  byte_order;             // detected from the first valid frame of the file
+    FrameSectionMask decode_sections;       // sections decoded by read_mapped_data_frame, FRAME_SECTIONS_ALL on open
+    bool            skip_wrong_frames;      // the view reads and the chunks skip the wrong frames, false on open
+    FrameIntegrityStats integrity;          // what was skipped with skip_wrong_frames
+    bool            is_mapped;              // true if data is a mapping, false if it was loaded in the heap
+    bool            is_borrowed;            // true if data belongs to the caller (mapped_file_from_buffer)
+#ifdef _WIN32
+    void           *file_handle;
+    void           *mapping_handle;
+#endif
+} MappedFrameFile;
+
+/**
+ * @brief Opens and maps a telemetry file in memory
+ *
+ * @param[in]   filename    Path of the file to open
+ * @param[out]  out         Pointer to the structure to initialize
+ *
+ * @return true on success, false on error (errno is kept for perror)
+ */
+bool mapped_file_open(const char *filename, MappedFrameFile *out);
+
+/**
+ * @brief Reads the frames of bytes already in memory (e.g. received by the caller), without copying them
+ *
+ * @param[in]   data        Start of the bytes, kept by the caller until mapped_file_close
+ * @param[in]   size        Number of bytes
+ * @param[out]  out         Pointer to the structure to initialize
+ *
+ * @return true on success, false on invalid arguments
+ */
+bool mapped_file_from_buffer(const uint8_t *data, size_t size, MappedFrameFile *out);
+
+/**
+ * @brief Releases the mapping (or the loaded buffer) of the file
+ *
+ * @param[in,out] file   Pointer to the structure to release. Safe to call twice
+ */
+void mapped_file_close(MappedFrameFile *file);
+
+/**
+ * @brief Searchs for the header in the mapped file and then reads a data frame element
+ *
+ *  Drop-in replacement of read_data_frame for a MappedFrameFile. Returns the same
+ *  BeaconFrame values and ReadFileReturnType states. The byte order is detected once per file.
+ *  Only the sections in file->decode_sections are decoded (see decode_beacon_frame_sections).
+ *
+ * @param[in,out]   file        Mapped file, its position is moved past the frame read
+ * @param[in]       header      Constant structure that holds the beacon header ID to search for
+ * @param[out]      out         Pointer to the return structure holding the frame values
+ *
+ * @return Read file return state
+ */
+ReadFileReturnType read_mapped_data_frame
+(
+    MappedFrameFile *file,
+    const BeaconHeader header,
+    BeaconFrame *out
+);
+
+/**
+ * @brief Same as read_mapped_data_frame, but the frame is viewed in the mapping instead of decoded
+ *
+ *  The section IDs are checked as by read_mapped_data_frame, no field is read (see BeaconFrameView).
+ *  With file->skip_wrong_frames, the wrong frames are skipped and counted in file->integrity instead
+ *  (see read_frame_view_from_buffer_robust), so the read only ends at READ_EOF.
+ *
+ * @param[in,out]   file        Mapped file, its position is moved past the frame read
+ * @param[in]       header      Constant structure that holds the beacon header ID to search for
+ * @param[out]      out         View of the frame, valid until mapped_file_close
+ *
+ * @return Read file return state
+ */
+ReadFileReturnType read_mapped_frame_view
+(
+    MappedFrameFile *file,
+    const BeaconHeader header,
+    BeaconFrameView *out
+);
+
+/**
+ * @brief Tells why the frames of a file could not be read, from the position left by the failed read
+ *
+ *  The reads and the index builds leave the position right after the header of a wrong or truncated frame.
+ *  Anywhere else, the memory ran out (a failure of the memory may also leave it there, and is then
+ *  reported as the frame found)
+ *
+ * @param[in]   file        Mapped file, after a read or an index build returned READ_FAIL
+ * @param[in]   header      Constant structure that holds the beacon header ID searched
+ *
+ * @return The cause of the failure. The header of the frame starts at position - BEACON_HEADER_SIZE
+ */
+ReadFailureCause mapped_file_read_failure(const MappedFrameFile *file, const BeaconHeader header);
+
+#endif // MAPPED_FRAME_READER_H
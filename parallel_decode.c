@@ -0,0 +1,555 @@
+/**
+ * @file parallel_decode.c
+ * @brief Implementation file of the parallel_decode header
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#include "parallel_decode.h"
+#include "extended_tools.h"
+#include "header_scanner.h"
+#include "run_merge.h"
+#include "timestamp_sort.h"
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+_Static_assert(PARALLEL_DECODE_MAX_THREADS <= RUN_MERGE_MAX_RUNS, "every chunk is a run of the merge");
+
+/**
+ * @struct DecodeChunk
+ * @brief  Byte range of the file decoded by one worker, and its thread-local index
+ */
+struct DECODE_CHUNK
+{
+    const MappedFrameFile  *file;
+    BeaconHeader            header;
+    size_t                  start;              // the chunk has the frames whose header starts in [start, end)
+    size_t                  end;
+    DynamicArray            entries;            // FrameIndexEntry, in file order
+    size_t                  chain_end;          // offset after the last frame decoded
+    bool                    failed;             // the frame at fail_header was truncated or wrong
+    size_t                  fail_header;
+    bool                    out_of_memory;
+    bool                    with_crc;           // frame_crc of the entries, 0 if not needed
+    size_t                  taken;              // first entry on the serial chain, set by the stitching
+    size_t                  read_entries;       // entries taken, before the sort removes the duplicates
+    bool                    sorted;
+};
+
+/**
+ * @struct CalibrationChunk
+ * @brief  Range of the index calibrated by one worker
+ */
+typedef struct CALIBRATION_CHUNK
+{
+    TelemetryStore         *store;
+    const MappedFrameFile  *file;
+    const DynamicArray     *index;
+    size_t                  first;
+    size_t                  count;
+    bool                    ok;
+} CalibrationChunk;
+
+//////////////////////////////////////////
+
+size_t parallel_decode_thread_count(size_t requested)
+{
+    if (requested == 0)
+    {
+#ifdef _WIN32
+        SYSTEM_INFO system_info;
+        GetSystemInfo(&system_info);
+        requested = system_info.dwNumberOfProcessors;
+#else
+        long processors = sysconf(_SC_NPROCESSORS_ONLN);
+        requested = processors > 0 ? (size_t)processors : 1;
+#endif
+    }
+    if (requested < 1) requested = 1;
+    if (requested > PARALLEL_DECODE_MAX_THREADS) requested = PARALLEL_DECODE_MAX_THREADS;
+    return requested;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, decodes the frames whose header starts in [from, chunk->end), the same way
+ *        frame_index_build_deduplicated reads them: each search starts at the end of the previous frame
+ */
+static void scan_chunk(DecodeChunk *chunk, size_t from)
+{
+    const MappedFrameFile *file = chunk->file;
+    // a header starting before end can finish up to BEACON_HEADER_SIZE - 1 bytes after it
+    const size_t search_limit = chunk->end + BEACON_HEADER_SIZE - 1 < file->size ? chunk->end + BEACON_HEADER_SIZE - 1 : file->size;
+
+    BeaconFrameView view;
+    size_t position = from;
+
+    chunk->entries.length = 0;
+    chunk->chain_end = from;
+    chunk->failed = false;
+
+    while (position < search_limit)
+    {
+        size_t found = position + find_beacon_header(file->data + position, search_limit - position, chunk->header);
+        if (found >= search_limit) return;
+
+        FrameIndexEntry entry;
+        entry.frame_offset = found + BEACON_HEADER_SIZE;
+
+        // skipped as the serial read does, the stitching counts them (see count_chain_integrity)
+        if (file->skip_wrong_frames)
+        {
+            if (file->size - entry.frame_offset < BEACON_FRAME_SIZE) return;
+            if (!beacon_frame_ids_match(file->data + entry.frame_offset, file->byte_order))
+            {
+                position = entry.frame_offset;
+                continue;
+            }
+        }
+
+        // a header inside a frame of the previous chunk usually has no IDs at all: only the failures on the
+        // serial chain stop the read (see frame_chunks_stitch)
+        if (file->size - entry.frame_offset < BEACON_FRAME_SIZE ||
+            detect_frame_byte_order(file->data + entry.frame_offset) == FRAME_BYTE_ORDER_UNKNOWN ||
+            !beacon_frame_view_init(file->data + entry.frame_offset, file->byte_order, &view))
+        {
+            chunk->failed = true;
+            chunk->fail_header = found;
+            return;
+        }
+
+        entry.rtc_s = beacon_frame_view_rtc_s(&view);
+        entry.frame_crc = chunk->with_crc ? crc32_compute(file->data + entry.frame_offset, BEACON_FRAME_SIZE) : 0;
+
+        if (!dynamic_array_push(&chunk->entries, &entry))
+        {
+            chunk->out_of_memory = true;
+            return;
+        }
+
+        position = entry.frame_offset + BEACON_FRAME_SIZE;
+        chunk->chain_end = position;
+    }
+}
+
+//////////////////////////////////////////
+
+static void* decode_chunk_worker(void *argument)
+{
+    DecodeChunk *chunk = (DecodeChunk*)argument;
+    scan_chunk(chunk, chunk->start);
+    return NULL;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, first entry of the chunk on the serial chain, which continues searching at chain
+ *
+ * @return the entry index, chunk->entries.length if the chunk adds no frame, SIZE_MAX if the chunk must be scanned again
+ */
+static size_t find_chain_start(const DecodeChunk *chunk, size_t chain)
+{
+    // a previous frame ending before the chunk: the worker and the serial scan both find the first header
+    if (chain <= chunk->start) return 0;
+
+    // every header of the chunk is inside the frames already taken
+    if (chain >= chunk->end) return chunk->entries.length;
+
+    const MappedFrameFile *file = chunk->file;
+    const size_t search_limit = chunk->end + BEACON_HEADER_SIZE - 1 < file->size ? chunk->end + BEACON_HEADER_SIZE - 1 : file->size;
+    size_t next_header = chain + find_beacon_header(file->data + chain, search_limit - chain, chunk->header);
+    if (next_header >= search_limit) return chunk->entries.length;
+
+    // from a common frame on, the worker and the serial scan read the same frames
+    const FrameIndexEntry *entries = (const FrameIndexEntry*)chunk->entries.data;
+    for (size_t i = 0; i < chunk->entries.length && entries[i].frame_offset <= next_header + BEACON_HEADER_SIZE; ++i)
+    {
+        if (entries[i].frame_offset == next_header + BEACON_HEADER_SIZE) return i;
+    }
+    return SIZE_MAX;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, adds what the serial read skips around the frames of the chain to file->integrity.
+ *        The chain has the same frames as the serial read, so only the bytes between them are searched again
+ */
+static void count_chain_integrity(FrameChunkSet *set, size_t chain_start)
+{
+    MappedFrameFile *file = set->file;
+    const BeaconHeader header = set->chunks[0].header;
+    BeaconFrameView view;
+    size_t previous_end = chain_start;
+
+    for (size_t k = 0; k < set->chunk_count; ++k)
+    {
+        const DecodeChunk *chunk = &set->chunks[k];
+        const FrameIndexEntry *entries = (const FrameIndexEntry*)chunk->entries.data;
+
+        for (size_t i = chunk->taken; i < chunk->entries.length; ++i)
+        {
+            // the robust read stops at this same frame, after the wrong ones in between
+            size_t position = previous_end;
+            if (entries[i].frame_offset - BEACON_HEADER_SIZE != previous_end)
+            {
+                read_frame_view_from_buffer_robust(file->data, file->size, &position, &file->byte_order, header,
+                                                   &file->integrity, &view);
+            }
+            previous_end = entries[i].frame_offset + BEACON_FRAME_SIZE;
+        }
+    }
+
+    // the bytes after the last frame
+    size_t position = previous_end;
+    read_frame_view_from_buffer_robust(file->data, file->size, &position, &file->byte_order, header, &file->integrity, &view);
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, runs the worker once per item, the first one on the calling thread.
+ *        An item without its thread runs on the calling thread too
+ */
+static void run_on_threads(void* (*worker)(void*), void *items, size_t item_size, size_t count)
+{
+    pthread_t threads[PARALLEL_DECODE_MAX_THREADS];
+    bool started[PARALLEL_DECODE_MAX_THREADS];
+    unsigned char *item_bytes = (unsigned char*)items;
+
+    for (size_t k = 1; k < count; ++k)
+    {
+        started[k] = pthread_create(&threads[k], NULL, worker, item_bytes + k * item_size) == 0;
+    }
+    worker(item_bytes);
+    for (size_t k = 1; k < count; ++k)
+    {
+        if (started[k]) pthread_join(threads[k], NULL);
+        else worker(item_bytes + k * item_size);
+    }
+}
+
+//////////////////////////////////////////
+
+bool frame_chunks_init
+(
+    FrameChunkSet *set,
+    MappedFrameFile *file,
+    const BeaconHeader header,
+    size_t chunk_count,
+    bool with_crc
+)
+{
+    if (!set || !file) return false;
+    memset(set, 0, sizeof *set);
+
+    const size_t remaining = file->position < file->size ? file->size - file->position : 0;
+    if (chunk_count > PARALLEL_DECODE_MAX_THREADS) chunk_count = PARALLEL_DECODE_MAX_THREADS;
+    if (chunk_count > remaining / PARALLEL_DECODE_MIN_CHUNK_SIZE) chunk_count = remaining / PARALLEL_DECODE_MIN_CHUNK_SIZE;
+    if (chunk_count < 1) chunk_count = 1;
+
+    // the chunks need the byte order of the file before they start. If the first frame doesn't give it,
+    // it fails on the first chunk, as it does in the serial read. Skipping the wrong frames, the serial
+    // read takes it from the first valid one
+    size_t search = file->position;
+    while (file->byte_order == FRAME_BYTE_ORDER_UNKNOWN && search < file->size)
+    {
+        size_t first_header = search + find_beacon_header(file->data + search, file->size - search, header);
+        if (first_header >= file->size || file->size - first_header < BEACON_HEADER_SIZE + BEACON_FRAME_SIZE) break;
+
+        file->byte_order = detect_frame_byte_order(file->data + first_header + BEACON_HEADER_SIZE);
+        if (file->byte_order == FRAME_BYTE_ORDER_UNKNOWN && !file->skip_wrong_frames) file->byte_order = FRAME_BYTE_ORDER_BIG_ENDIAN;
+        search = first_header + BEACON_HEADER_SIZE;
+    }
+
+    set->chunks = (DecodeChunk*)calloc(chunk_count, sizeof *set->chunks);
+    if (!set->chunks) return false;
+    set->file = file;
+    set->chunk_count = chunk_count;
+
+    for (size_t k = 0; k < chunk_count; ++k)
+    {
+        DecodeChunk *chunk = &set->chunks[k];
+
+        chunk->file = file;
+        chunk->header = header;
+        chunk->with_crc = with_crc;
+        chunk->start = file->position + remaining / chunk_count * k;
+        chunk->end = k + 1 == chunk_count ? file->position + remaining : file->position + remaining / chunk_count * (k + 1);
+        if (!dynamic_array_init(&chunk->entries, sizeof(FrameIndexEntry), BEACON_FRAME_COUNT_ESTIMATE(chunk->end - chunk->start) + 1))
+        {
+            frame_chunks_free(set);
+            return false;
+        }
+    }
+    return true;
+}
+
+//////////////////////////////////////////
+
+void frame_chunks_decode(FrameChunkSet *set, size_t chunk)
+{
+    if (!set || chunk >= set->chunk_count) return;
+    scan_chunk(&set->chunks[chunk], set->chunks[chunk].start);
+}
+
+//////////////////////////////////////////
+
+ReadFileReturnType frame_chunks_stitch(FrameChunkSet *set)
+{
+    if (!set || !set->chunks) return READ_FAIL;
+
+    MappedFrameFile *file = set->file;
+
+    // stitch the chunks in file order, following the position where the serial scan would search next
+    const size_t chain_start = file->position;
+    size_t chain = chain_start;
+
+    for (size_t k = 0; k < set->chunk_count; ++k)
+    {
+        DecodeChunk *chunk = &set->chunks[k];
+        size_t first_entry = find_chain_start(chunk, chain);
+
+        if (first_entry == SIZE_MAX)
+        {
+            // the worker synchronized on a header inside a frame of the previous chunk
+            scan_chunk(chunk, chain);
+            first_entry = 0;
+        }
+        if (chunk->out_of_memory) return READ_FAIL;
+
+        chunk->taken = first_entry;
+        if (first_entry < chunk->entries.length) chain = chunk->chain_end;
+
+        if (chunk->failed && (first_entry < chunk->entries.length || chunk->fail_header >= chain))
+        {
+            // like the serial read, the position is left right after the header of the failed frame
+            // (see mapped_file_read_failure)
+            file->position = chunk->fail_header + BEACON_HEADER_SIZE;
+            return READ_FAIL;
+        }
+    }
+
+    // the chunks skipped the wrong frames quietly, they are counted once the chain is known
+    if (file->skip_wrong_frames) count_chain_integrity(set, chain_start);
+
+    file->position = file->size;
+    return READ_EOF;
+}
+
+//////////////////////////////////////////
+
+static void* sort_chunk_worker(void *argument)
+{
+    DecodeChunk *chunk = (DecodeChunk*)argument;
+    FrameIndexEntry *entries = (FrameIndexEntry*)chunk->entries.data + chunk->taken;
+    size_t length = chunk->entries.length - chunk->taken;
+
+    chunk->read_entries = length;
+    chunk->sorted = timestamp_sort_deduplicate(entries, &length, sizeof(FrameIndexEntry), offsetof(FrameIndexEntry, rtc_s));
+    chunk->entries.length = chunk->taken + length;
+    return NULL;
+}
+
+//////////////////////////////////////////
+
+ReadFileReturnType frame_chunks_merge_sorted
+(
+    FrameChunkSet *set,
+    DynamicArray *index,
+    size_t thread_count,
+    size_t *duplicates_dropped
+)
+{
+    if (!set || !set->chunks || !index || index->element_size != sizeof(FrameIndexEntry) || index->length != 0) return READ_FAIL;
+
+    // each chunk sorts its own run (nearly sorted already, only a few frames out of order)
+    if (thread_count > 1) run_on_threads(sort_chunk_worker, set->chunks, sizeof *set->chunks, set->chunk_count);
+    else for (size_t k = 0; k < set->chunk_count; ++k) sort_chunk_worker(&set->chunks[k]);
+
+    SortedRun runs[PARALLEL_DECODE_MAX_THREADS];
+    size_t read_entries = 0;
+    size_t total = 0;
+    bool sorted = true;
+
+    for (size_t k = 0; k < set->chunk_count; ++k)
+    {
+        const DecodeChunk *chunk = &set->chunks[k];
+
+        sorted = sorted && chunk->sorted;
+        runs[k].data = (const FrameIndexEntry*)chunk->entries.data + chunk->taken;
+        runs[k].length = chunk->entries.length - chunk->taken;
+        total += runs[k].length;
+        read_entries += chunk->read_entries;
+    }
+    if (!sorted || !dynamic_array_reserve(index, total + 1)) return READ_FAIL;
+
+    // the runs are in file order, so the merge keeps the first frame of each rtc_s, as frame_index_sort
+    size_t merged = run_merge_deduplicate_parallel(runs, set->chunk_count, sizeof(FrameIndexEntry),
+                                                   offsetof(FrameIndexEntry, rtc_s), index->data, thread_count);
+    if (merged == (size_t)-1) return READ_FAIL;
+
+    index->length = merged;
+    if (duplicates_dropped) *duplicates_dropped = read_entries - merged;
+    return READ_EOF;
+}
+
+//////////////////////////////////////////
+
+void frame_chunks_free(FrameChunkSet *set)
+{
+    if (!set) return;
+
+    for (size_t k = 0; set->chunks && k < set->chunk_count; ++k) dynamic_array_free(&set->chunks[k].entries);
+    free(set->chunks);
+    memset(set, 0, sizeof *set);
+}
+
+//////////////////////////////////////////
+
+ReadFileReturnType frame_index_build_parallel
+(
+    MappedFrameFile *file,
+    const BeaconHeader header,
+    HashDedupSet *set,
+    size_t thread_count
+)
+{
+    if (!file || !set || set->elements.element_size != sizeof(FrameIndexEntry)) return READ_FAIL;
+
+    FrameChunkSet chunk_set;
+    size_t chunk_count = parallel_decode_thread_count(thread_count);
+
+    if (chunk_count <= 1) return frame_index_build_deduplicated(file, header, set);
+    if (!frame_chunks_init(&chunk_set, file, header, chunk_count, true)) return READ_FAIL;
+    if (chunk_set.chunk_count <= 1)
+    {
+        frame_chunks_free(&chunk_set);
+        return frame_index_build_deduplicated(file, header, set);
+    }
+
+    run_on_threads(decode_chunk_worker, chunk_set.chunks, sizeof *chunk_set.chunks, chunk_set.chunk_count);
+    ReadFileReturnType result = frame_chunks_stitch(&chunk_set);
+
+    // the set sees the entries in file order, as with the serial build
+    for (size_t k = 0; result != READ_FAIL && k < chunk_set.chunk_count; ++k)
+    {
+        const DecodeChunk *chunk = &chunk_set.chunks[k];
+        const FrameIndexEntry *entries = (const FrameIndexEntry*)chunk->entries.data;
+
+        for (size_t i = chunk->taken; i < chunk->entries.length; ++i)
+        {
+            if (hash_dedup_insert(set, &entries[i], entries[i].frame_crc) == DEDUP_FAIL)
+            {
+                result = READ_FAIL;
+                break;
+            }
+        }
+    }
+
+    frame_chunks_free(&chunk_set);
+    return result;
+}
+
+//////////////////////////////////////////
+
+ReadFileReturnType frame_index_build_sorted_parallel
+(
+    MappedFrameFile *file,
+    const BeaconHeader header,
+    DynamicArray *index,
+    size_t thread_count,
+    size_t *duplicates_dropped
+)
+{
+    if (!file || !index || index->element_size != sizeof(FrameIndexEntry) || index->length != 0) return READ_FAIL;
+
+    FrameChunkSet chunk_set;
+    size_t chunk_count = parallel_decode_thread_count(thread_count);
+
+    if (chunk_count <= 1 || !frame_chunks_init(&chunk_set, file, header, chunk_count, false) || chunk_set.chunk_count <= 1)
+    {
+        if (chunk_count > 1) frame_chunks_free(&chunk_set);
+
+        ReadFileReturnType serial_result = frame_index_build(file, header, index);
+        size_t read_entries = index->length;
+
+        if (serial_result != READ_FAIL) frame_index_sort(index);
+        if (duplicates_dropped) *duplicates_dropped = read_entries - index->length;
+        return serial_result;
+    }
+
+    run_on_threads(decode_chunk_worker, chunk_set.chunks, sizeof *chunk_set.chunks, chunk_set.chunk_count);
+
+    ReadFileReturnType result = frame_chunks_stitch(&chunk_set);
+    if (result != READ_FAIL) result = frame_chunks_merge_sorted(&chunk_set, index, thread_count, duplicates_dropped);
+
+    frame_chunks_free(&chunk_set);
+    return result;
+}
+
+//////////////////////////////////////////
+
+static void* calibration_chunk_worker(void *argument)
+{
+    CalibrationChunk *chunk = (CalibrationChunk*)argument;
+    chunk->ok = telemetry_store_fill_rows(chunk->store, chunk->file, chunk->index, chunk->first, chunk->count);
+    return NULL;
+}
+
+//////////////////////////////////////////
+
+bool telemetry_store_load_parallel
+(
+    TelemetryStore *store,
+    const MappedFrameFile *file,
+    const DynamicArray *index,
+    size_t thread_count
+)
+{
+    if (!store || !file || !index) return false;
+
+    size_t chunk_count = parallel_decode_thread_count(thread_count);
+    if (chunk_count > index->length / PARALLEL_DECODE_MIN_CHUNK_ENTRIES) chunk_count = index->length / PARALLEL_DECODE_MIN_CHUNK_ENTRIES;
+    if (chunk_count <= 1) return telemetry_store_load(store, file, index);
+
+    CalibrationChunk chunks[PARALLEL_DECODE_MAX_THREADS];
+
+    // whole kernel blocks per chunk
+    size_t blocks = (index->length + TELEMETRY_STORE_BLOCK - 1) / TELEMETRY_STORE_BLOCK;
+    for (size_t k = 0; k < chunk_count; ++k)
+    {
+        size_t first = blocks * k / chunk_count * TELEMETRY_STORE_BLOCK;
+        size_t last = k + 1 == chunk_count ? index->length : blocks * (k + 1) / chunk_count * TELEMETRY_STORE_BLOCK;
+
+        chunks[k].store = store;
+        chunks[k].file = file;
+        chunks[k].index = index;
+        chunks[k].first = first;
+        chunks[k].count = last - first;
+        chunks[k].ok = false;
+    }
+
+    run_on_threads(calibration_chunk_worker, chunks, sizeof *chunks, chunk_count);
+
+    bool ok = true;
+    for (size_t k = 0; k < chunk_count; ++k) ok = ok && chunks[k].ok;
+
+    if (!ok) return false;
+    store->thermal.length += index->length;
+    store->sun_sensors.length += index->length;
+    return true;
+}
@@ -0,0 +1,191 @@
+/**
+ * @file parallel_decode.h
+ * @brief Header of the multi-threaded decoding of a mapped telemetry file
+ *
+ *  The frames are self-synchronizing on the beacon ID, so the file is split into one byte range per
+ *  thread: each worker resyncs at its first header, and decodes (and checksums) the frames whose header
+ *  starts inside its range into a thread-local index. A frame straddling the end of a range belongs to
+ *  the range where its header starts.
+ *
+ *  A worker can't know if its first header is a real one or three bytes inside the previous frame, so
+ *  the chunks are stitched in file order: a chunk is only taken from the first of its frames the serial
+ *  scan would have found, and scanned again serially if the serial scan doesn't meet any of them.
+ *  The entries reach the deduplication set in file order, so the result is exactly the serial one.
+ *
+ *  frame_index_build_sorted_parallel skips the set: each chunk sorts its own entries (the frames are
+ *  nearly in order inside a chunk), and the runs are merged with the duplicates removed in the same
+ *  pass (see run_merge.h), which gives the index of frame_index_build + frame_index_sort.
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#ifndef PARALLEL_DECODE_H_INCLUDED
+#define PARALLEL_DECODE_H_INCLUDED
+
+#include "beacon_frame_schema.h"
+#include "dynamic_array.h"
+#include "frame_index.h"
+#include "hash_dedup.h"
+#include "mapped_frame_reader.h"
+#include "telemetry_store.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define PARALLEL_DECODE_MAX_THREADS 64
+#define PARALLEL_DECODE_MIN_CHUNK_SIZE (1u << 20)       // bytes per thread, smaller files use less threads
+#define PARALLEL_DECODE_MIN_CHUNK_ENTRIES (1u << 14)    // index entries per thread for the calibration
+
+typedef struct DECODE_CHUNK DecodeChunk;
+
+/**
+ * @struct FrameChunkSet
+ * @brief  The rest of a mapped file, split in chunks that can be decoded on any thread (e.g. the tasks of a pool)
+ *
+ *  frame_chunks_init, then frame_chunks_decode once per chunk, in any order and on any threads,
+ *  then frame_chunks_stitch and frame_chunks_merge_sorted on one thread, when all of them are done.
+ */
+typedef struct FRAME_CHUNK_SET
+{
+    MappedFrameFile    *file;
+    DecodeChunk        *chunks;
+    size_t              chunk_count;
+} FrameChunkSet;
+
+/**
+ * @brief Number of threads to use
+ *
+ * @param[in] requested     Number of threads, 0 for one per online processor
+ *
+ * @return requested (or the processor count), limited to 1..PARALLEL_DECODE_MAX_THREADS
+ */
+size_t parallel_decode_thread_count(size_t requested);
+
+/**
+ * @brief Splits the rest of the file in chunks, and finds the byte order of the file if it is not known yet
+ *
+ * @param[out]    set           Chunk set to initialize
+ * @param[in,out] file          Mapped file, split from its current position
+ * @param[in]     header        Constant structure that holds the beacon header ID to search for
+ * @param[in]     chunk_count   Wanted number of chunks, limited so every chunk has PARALLEL_DECODE_MIN_CHUNK_SIZE bytes
+ *                              (and to PARALLEL_DECODE_MAX_THREADS). See set->chunk_count for the result
+ * @param[in]     with_crc      true to compute the frame_crc of the entries (for a HashDedupSet), 0 otherwise
+ *
+ * @return true on success, false if the memory ran out (nothing is left allocated)
+ */
+bool frame_chunks_init
+(
+    FrameChunkSet *set,
+    MappedFrameFile *file,
+    const BeaconHeader header,
+    size_t chunk_count,
+    bool with_crc
+);
+
+/**
+ * @brief Decodes the frames whose header starts in the chunk. Different chunks can be decoded at the same time
+ *
+ * @param[in,out] set       Initialized chunk set
+ * @param[in]     chunk     Chunk to decode, less than set->chunk_count
+ */
+void frame_chunks_decode(FrameChunkSet *set, size_t chunk);
+
+/**
+ * @brief Keeps the frames of every chunk the serial scan reads, once all the chunks are decoded
+ *
+ * @param[in,out] set       Chunk set, decoded
+ *
+ * @return READ_EOF, or READ_FAIL on a wrong frame or if the memory ran out (the position of the file is left
+ *         after the header of the wrong frame, as read_mapped_frame_view does). With file->skip_wrong_frames,
+ *         the wrong frames are skipped and counted in file->integrity, as the serial read does
+ */
+ReadFileReturnType frame_chunks_stitch(FrameChunkSet *set);
+
+/**
+ * @brief Sorts each chunk and merges them into the index, without the duplicated rtc_s, once stitched
+ *
+ * @param[in,out] set                   Chunk set, stitched
+ * @param[out]    index                 Initialized and empty DynamicArray of FrameIndexEntry
+ * @param[in]     thread_count          Threads for the sort and the merge, 1 to do them on the calling thread
+ * @param[out]    duplicates_dropped    Optional, number of frames removed for a repeated rtc_s
+ *
+ * @return READ_EOF on success, READ_FAIL if the memory ran out
+ */
+ReadFileReturnType frame_chunks_merge_sorted
+(
+    FrameChunkSet *set,
+    DynamicArray *index,
+    size_t thread_count,
+    size_t *duplicates_dropped
+);
+
+/**
+ * @brief Releases the chunks
+ *
+ * @param[in,out] set   Chunk set. Safe to call twice
+ */
+void frame_chunks_free(FrameChunkSet *set);
+
+/**
+ * @brief Multi-threaded frame_index_build_deduplicated, with the same result
+ *
+ * @param[in,out] file          Mapped file, read from its current position
+ * @param[in]     header        Constant structure that holds the beacon header ID to search for
+ * @param[in,out] set           Set initialized for FrameIndexEntry keyed on rtc_s. Its elements are the index
+ * @param[in]     thread_count  Number of threads (see parallel_decode_thread_count), 1 runs the serial build
+ *
+ * @return READ_EOF when the whole file was indexed, READ_FAIL on a wrong frame or if the memory ran out
+ */
+ReadFileReturnType frame_index_build_parallel
+(
+    MappedFrameFile *file,
+    const BeaconHeader header,
+    HashDedupSet *set,
+    size_t thread_count
+);
+
+/**
+ * @brief Multi-threaded frame_index_build followed by frame_index_sort, with the same result
+ *
+ *  Equivalent to frame_index_build_parallel with a DEDUP_KEEP_FIRST set keyed only on rtc_s, and
+ *  frame_index_sort. The entries have no frame_crc (0).
+ *
+ * @param[in,out] file                  Mapped file, read from its current position
+ * @param[in]     header                Constant structure that holds the beacon header ID to search for
+ * @param[out]    index                 Initialized and empty DynamicArray of FrameIndexEntry, sorted by rtc_s
+ *                                      and without duplicates on success
+ * @param[in]     thread_count          Number of threads (see parallel_decode_thread_count), 1 runs the serial build
+ * @param[out]    duplicates_dropped    Optional, number of frames removed for a repeated rtc_s
+ *
+ * @return READ_EOF when the whole file was indexed, READ_FAIL on a wrong frame or if the memory ran out
+ */
+ReadFileReturnType frame_index_build_sorted_parallel
+(
+    MappedFrameFile *file,
+    const BeaconHeader header,
+    DynamicArray *index,
+    size_t thread_count,
+    size_t *duplicates_dropped
+);
+
+/**
+ * @brief Multi-threaded telemetry_store_load, each thread calibrates a range of the index
+ *
+ * @param[in,out] store         Initialized store, with capacity for the whole index
+ * @param[in]     file          Mapped file the index was built from
+ * @param[in]     index         DynamicArray of FrameIndexEntry
+ * @param[in]     thread_count  Number of threads (see parallel_decode_thread_count), 1 runs telemetry_store_load
+ *
+ * @return true on success, false if the store is too small or a frame is out of the file
+ */
+bool telemetry_store_load_parallel
+(
+    TelemetryStore *store,
+    const MappedFrameFile *file,
+    const DynamicArray *index,
+    size_t thread_count
+);
+
+#endif // PARALLEL_DECODE_H
@@ -0,0 +1,305 @@
+/**
+ * @file pipeline_io.c
+ * @brief Implementation file of the pipeline_io header
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#include "pipeline_io.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sched.h>
+#include <time.h>
+#endif
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, waits a bit longer on every failed attempt: spin, then yield, then sleep
+ */
+static void wait_backoff(unsigned *attempts)
+{
+    unsigned attempt = (*attempts)++;
+
+    if (attempt < PIPELINE_WAIT_SPINS) return;
+#ifdef _WIN32
+    if (attempt < PIPELINE_WAIT_SPINS + PIPELINE_WAIT_YIELDS) SwitchToThread();
+    else Sleep(1);
+#else
+    if (attempt < PIPELINE_WAIT_SPINS + PIPELINE_WAIT_YIELDS)
+    {
+        sched_yield();
+    }
+    else
+    {
+        struct timespec pause = { 0, PIPELINE_WAIT_SLEEP_US * 1000L };
+        nanosleep(&pause, NULL);
+    }
+#endif
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, pops an item, waiting for it. Gives up if stopping becomes true
+ *
+ * @param[in] stopping      NULL to wait until an item comes
+ */
+static bool ring_pop_wait(SpscRing *ring, void **item, atomic_bool *stopping)
+{
+    unsigned attempts = 0;
+
+    while (!spsc_ring_try_pop(ring, item))
+    {
+        if (stopping && atomic_load_explicit(stopping, memory_order_relaxed)) return false;
+        wait_backoff(&attempts);
+    }
+    return true;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, pushes an item to a ring with room for every buffer (and the NULL one)
+ */
+static void ring_push_wait(SpscRing *ring, void *item)
+{
+    unsigned attempts = 0;
+    while (!spsc_ring_try_push(ring, item)) wait_backoff(&attempts);
+}
+
+//////////////////////////////////////////
+
+static void buffers_free(PipelineBuffer *buffers, size_t count, SpscRing *filled, SpscRing *empty)
+{
+    for (size_t b = 0; b < count; ++b)
+    {
+        free(buffers[b].data);
+        buffers[b].data = NULL;
+    }
+    spsc_ring_free(filled);
+    spsc_ring_free(empty);
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, allocates the buffers and the two rings going around them
+ *
+ * @param[in] count     Buffers, a power of two. The filled ring has room for all of them and the NULL one
+ */
+static bool buffers_init(PipelineBuffer *buffers, size_t count, size_t buffer_size, SpscRing *filled, SpscRing *empty)
+{
+    memset(buffers, 0, count * sizeof *buffers);
+
+    if (!spsc_ring_init(filled, 2 * count)) return false;
+    if (!spsc_ring_init(empty, count))
+    {
+        spsc_ring_free(filled);
+        return false;
+    }
+
+    bool ok = true;
+    for (size_t b = 0; ok && b < count; ++b)
+    {
+        buffers[b].data = (unsigned char*)malloc(buffer_size);
+        ok = buffers[b].data != NULL && spsc_ring_try_push(empty, &buffers[b]);
+    }
+
+    if (!ok) buffers_free(buffers, count, filled, empty);
+    return ok;
+}
+
+//////////////////////////////////////////
+
+static void* block_reader_main(void *argument)
+{
+    BlockReader *reader = (BlockReader*)argument;
+    void *item;
+
+    while (ring_pop_wait(&reader->empty, &item, &reader->stopping))
+    {
+        PipelineBuffer *block = (PipelineBuffer*)item;
+        block->length = fread(block->data, 1, PIPELINE_BLOCK_SIZE, reader->file);
+
+        if (block->length == 0)
+        {
+            reader->read_error = ferror(reader->file) != 0;
+            break;
+        }
+        ring_push_wait(&reader->filled, block);
+    }
+
+    // the release of the push makes read_error visible with the end of the file
+    ring_push_wait(&reader->filled, NULL);
+    return NULL;
+}
+
+//////////////////////////////////////////
+
+bool block_reader_start(BlockReader *reader, FILE *file)
+{
+    if (!reader || !file) return false;
+    memset(reader, 0, sizeof *reader);
+
+    reader->file = file;
+    atomic_init(&reader->stopping, false);
+
+    if (!buffers_init(reader->blocks, PIPELINE_INPUT_BLOCKS, PIPELINE_BLOCK_SIZE, &reader->filled, &reader->empty)) return false;
+
+    if (pthread_create(&reader->thread, NULL, block_reader_main, reader) != 0)
+    {
+        buffers_free(reader->blocks, PIPELINE_INPUT_BLOCKS, &reader->filled, &reader->empty);
+        return false;
+    }
+    return true;
+}
+
+//////////////////////////////////////////
+
+const PipelineBuffer *block_reader_next(BlockReader *reader)
+{
+    if (!reader || reader->finished) return NULL;
+
+    if (reader->current)
+    {
+        ring_push_wait(&reader->empty, reader->current);
+        reader->current = NULL;
+    }
+
+    void *item;
+    ring_pop_wait(&reader->filled, &item, NULL);
+
+    reader->current = (PipelineBuffer*)item;
+    reader->finished = reader->current == NULL;
+    return reader->current;
+}
+
+//////////////////////////////////////////
+
+bool block_reader_stop(BlockReader *reader)
+{
+    if (!reader) return false;
+
+    atomic_store_explicit(&reader->stopping, true, memory_order_relaxed);
+    pthread_join(reader->thread, NULL);
+
+    bool ok = !reader->read_error;
+    buffers_free(reader->blocks, PIPELINE_INPUT_BLOCKS, &reader->filled, &reader->empty);
+    reader->current = NULL;
+    return ok;
+}
+
+//////////////////////////////////////////
+
+static void* async_csv_writer_main(void *argument)
+{
+    AsyncCsvWriter *async_writer = (AsyncCsvWriter*)argument;
+    void *item;
+
+    // after a failure the buffers still go back, so the caller never waits for one
+    while (ring_pop_wait(&async_writer->filled, &item, NULL) && item)
+    {
+        PipelineBuffer *buffer = (PipelineBuffer*)item;
+
+        if (!atomic_load_explicit(&async_writer->failed, memory_order_relaxed) &&
+            csv_writer_write_text(async_writer->writer, (const char*)buffer->data, buffer->length, buffer->rows) != 1)
+        {
+            atomic_store_explicit(&async_writer->failed, true, memory_order_relaxed);
+        }
+        ring_push_wait(&async_writer->empty, buffer);
+    }
+    return NULL;
+}
+
+//////////////////////////////////////////
+
+bool async_csv_writer_start(AsyncCsvWriter *async_writer, CsvWriter *writer)
+{
+    if (!async_writer || !writer || !writer->file || !writer->formatter) return false;
+    memset(async_writer, 0, sizeof *async_writer);
+
+    async_writer->writer = writer;
+    atomic_init(&async_writer->failed, false);
+
+    if (!buffers_init(async_writer->buffers, PIPELINE_OUTPUT_BUFFERS, PIPELINE_OUTPUT_BUFFER_SIZE,
+                      &async_writer->filled, &async_writer->empty))
+    {
+        return false;
+    }
+
+    if (pthread_create(&async_writer->thread, NULL, async_csv_writer_main, async_writer) != 0)
+    {
+        buffers_free(async_writer->buffers, PIPELINE_OUTPUT_BUFFERS, &async_writer->filled, &async_writer->empty);
+        return false;
+    }
+    return true;
+}
+
+//////////////////////////////////////////
+
+int async_csv_writer_write(AsyncCsvWriter *async_writer, const void *element_ptr)
+{
+    if (!async_writer || !element_ptr) return -1;
+    if (atomic_load_explicit(&async_writer->failed, memory_order_relaxed)) return -1;
+
+    PipelineBuffer *buffer = async_writer->current;
+
+    // room for a whole line and its '\n', so the formatter can write in place
+    if (buffer && PIPELINE_OUTPUT_BUFFER_SIZE - buffer->length < MAX_LINE_BUFFER + 1)
+    {
+        ring_push_wait(&async_writer->filled, buffer);
+        buffer = NULL;
+    }
+    if (!buffer)
+    {
+        void *item;
+        ring_pop_wait(&async_writer->empty, &item, NULL);
+
+        buffer = (PipelineBuffer*)item;
+        buffer->length = 0;
+        buffer->rows = 0;
+    }
+    async_writer->current = buffer;
+
+    const CsvWriter *writer = async_writer->writer;
+    char *line = (char*)buffer->data + buffer->length;
+    int len = writer->formatter(element_ptr, line, MAX_LINE_BUFFER, writer->precision);
+
+    if (len < 0)
+    {
+        fprintf(stderr, "Warning: Formatting failed for an element. Skipping.\n");
+        return 0;
+    }
+
+    line[len] = '\n';
+    buffer->length += (size_t)len + 1;
+    buffer->rows++;
+    return 1;
+}
+
+//////////////////////////////////////////
+
+bool async_csv_writer_finish(AsyncCsvWriter *async_writer)
+{
+    if (!async_writer) return false;
+
+    if (async_writer->current)
+    {
+        ring_push_wait(&async_writer->filled, async_writer->current);
+        async_writer->current = NULL;
+    }
+    ring_push_wait(&async_writer->filled, NULL);
+    pthread_join(async_writer->thread, NULL);
+
+    bool ok = !atomic_load_explicit(&async_writer->failed, memory_order_relaxed);
+    buffers_free(async_writer->buffers, PIPELINE_OUTPUT_BUFFERS, &async_writer->filled, &async_writer->empty);
+    return ok;
+}
@@ -0,0 +1,137 @@
+/**
+ * @file pipeline_io.h
+ * @brief Header of the threads overlapping the reads and the CSV writes with the decoding
+ *
+ *  A BlockReader thread reads the next blocks of the input while the current one is decoded, and an
+ *  AsyncCsvWriter thread per CSV file writes the lines already formatted while the next ones are.
+ *  Each stage hands its buffers to the next one through an SpscRing, and gets them back through a
+ *  second one, so a fixed set of buffers goes around and nothing is allocated after the start.
+ *
+ *      reader thread --blocks--> decoder (caller) --lines--> writer thread, one per file
+ *
+ *  A stage with nothing to do retries a few times, then yields the CPU, then sleeps PIPELINE_WAIT_SLEEP_US
+ *  between retries, so a stage waiting for the disk doesn't keep a core busy.
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#ifndef PIPELINE_IO_H_INCLUDED
+#define PIPELINE_IO_H_INCLUDED
+
+#include "csv_tool.h"
+#include "spsc_ring.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#define PIPELINE_BLOCK_SIZE (1u << 20)              // bytes per input read
+#define PIPELINE_INPUT_BLOCKS 4                     // blocks read ahead, power of two
+#define PIPELINE_OUTPUT_BUFFER_SIZE (1u << 18)      // CSV lines handed to the writer at once
+#define PIPELINE_OUTPUT_BUFFERS 4                   // per file, power of two
+
+#define PIPELINE_WAIT_SPINS 64
+#define PIPELINE_WAIT_YIELDS 256
+#define PIPELINE_WAIT_SLEEP_US 50
+
+/**
+ * @struct PipelineBuffer
+ * @brief  A block of input bytes, or of CSV lines
+ */
+typedef struct PIPELINE_BUFFER
+{
+    unsigned char  *data;
+    size_t          length;                 // bytes used
+    size_t          rows;                   // CSV lines in data, unused for the input
+} PipelineBuffer;
+
+/**
+ * @struct BlockReader
+ * @brief  Read ahead thread of a file
+ */
+typedef struct BLOCK_READER
+{
+    FILE               *file;
+    PipelineBuffer      blocks[PIPELINE_INPUT_BLOCKS];
+    SpscRing            filled;             // thread -> caller, NULL after the last block
+    SpscRing            empty;              // caller -> thread
+    PipelineBuffer     *current;            // block held by the caller
+    pthread_t           thread;
+    atomic_bool         stopping;
+    bool                read_error;         // written by the thread before the NULL block
+    bool                finished;           // the caller got the NULL block
+} BlockReader;
+
+/**
+ * @struct AsyncCsvWriter
+ * @brief  Writer thread of an open CsvWriter
+ */
+typedef struct ASYNC_CSV_WRITER
+{
+    CsvWriter          *writer;             // only used by the thread, but for its formatter
+    PipelineBuffer      buffers[PIPELINE_OUTPUT_BUFFERS];
+    SpscRing            filled;             // caller -> thread, NULL after the last buffer
+    SpscRing            empty;              // thread -> caller
+    PipelineBuffer     *current;            // buffer filled by the caller
+    pthread_t           thread;
+    atomic_bool         failed;             // a write failed, the next lines are dropped
+} AsyncCsvWriter;
+
+/**
+ * @brief Starts reading the file ahead
+ *
+ * @param[out] reader       Pointer to the reader to initialize
+ * @param[in]  file         Open file, read only by the thread until block_reader_stop
+ *
+ * @return true on success, false if the memory ran out or the thread could not be started
+ */
+bool block_reader_start(BlockReader *reader, FILE *file);
+
+/**
+ * @brief Waits for the next block. The previous one goes back to the thread
+ *
+ * @param[in,out] reader    Pointer to the reader
+ *
+ * @return The next block, valid until the next call, or NULL at the end of the file
+ */
+const PipelineBuffer *block_reader_next(BlockReader *reader);
+
+/**
+ * @brief Stops the thread, even before the end of the file, and releases the reader
+ *
+ * @return true if every read succeeded, false on read error
+ */
+bool block_reader_stop(BlockReader *reader);
+
+/**
+ * @brief Starts the writer thread of a CSV file
+ *
+ * @param[out] async_writer Pointer to the writer to initialize
+ * @param[in]  writer       Open writer with a formatter, written only by the thread until async_csv_writer_finish
+ *
+ * @return true on success, false if the memory ran out or the thread could not be started
+ */
+bool async_csv_writer_start(AsyncCsvWriter *async_writer, CsvWriter *writer);
+
+/**
+ * @brief Formats an element as a CSV line, written later by the thread
+ *
+ * @param[in,out] async_writer  Pointer to a started writer
+ * @param[in]     element_ptr   A void* pointer to the element to write
+ *
+ * @return int 1 on success, 0 if the element could not be formatted (skipped), -1 if a write already failed.
+ */
+int async_csv_writer_write(AsyncCsvWriter *async_writer, const void *element_ptr);
+
+/**
+ * @brief Hands over the last lines, waits until they are written and stops the thread. The CsvWriter stays open
+ *
+ * @return true if every line was written, false on write error
+ */
+bool async_csv_writer_finish(AsyncCsvWriter *async_writer);
+
+#endif // PIPELINE_IO_H
@@ -0,0 +1,147 @@
+/**
+ * @file pipeline_metrics.c
+ * @brief Implementation file of the pipeline_metrics header
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#include "pipeline_metrics.h"
+
+#include <string.h>
+
+#ifdef _WIN32
+#define PSAPI_VERSION 2                         // GetProcessMemoryInfo from kernel32, no psapi library to link
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <time.h>
+#endif
+
+//////////////////////////////////////////
+
+double pipeline_metrics_now_seconds(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+#endif
+}
+
+//////////////////////////////////////////
+
+void pipeline_metrics_init(PipelineMetrics *metrics, bool enabled, const char *mode)
+{
+    if (!metrics) return;
+
+    memset(metrics, 0, sizeof *metrics);
+    metrics->enabled = enabled;
+    metrics->mode = mode;
+    if (enabled) metrics->start_seconds = pipeline_metrics_now_seconds();
+}
+
+//////////////////////////////////////////
+
+double pipeline_metrics_stage_begin(const PipelineMetrics *metrics)
+{
+    return metrics && metrics->enabled ? pipeline_metrics_now_seconds() : 0.0;
+}
+
+//////////////////////////////////////////
+
+void pipeline_metrics_stage_end(PipelineMetrics *metrics, const char *name, double start_seconds, uint64_t frames, uint64_t bytes)
+{
+    if (!metrics || !metrics->enabled || !name) return;
+
+    const double elapsed = pipeline_metrics_now_seconds() - start_seconds;
+
+    PipelineStageMetrics *stage = NULL;
+    for (size_t s = 0; s < metrics->stage_count && !stage; ++s)
+    {
+        if (strncmp(metrics->stages[s].name, name, PIPELINE_METRICS_STAGE_NAME_SIZE - 1) == 0) stage = &metrics->stages[s];
+    }
+    if (!stage)
+    {
+        if (metrics->stage_count == PIPELINE_METRICS_MAX_STAGES) return;
+
+        stage = &metrics->stages[metrics->stage_count++];
+        strncpy(stage->name, name, PIPELINE_METRICS_STAGE_NAME_SIZE - 1);
+        stage->name[PIPELINE_METRICS_STAGE_NAME_SIZE - 1] = '\0';
+    }
+
+    stage->seconds += elapsed;
+    stage->frames += frames;
+    stage->bytes += bytes;
+}
+
+//////////////////////////////////////////
+
+uint64_t pipeline_metrics_peak_memory(void)
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof counters)) return 0;
+    return (uint64_t)counters.PeakWorkingSetSize;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return (uint64_t)usage.ru_maxrss;           // bytes
+#else
+    return (uint64_t)usage.ru_maxrss * 1024u;   // kilobytes
+#endif
+#endif
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, a rate that is 0 instead of infinite for a stage too short for the clock
+ */
+static double rate_per_second(double amount, double seconds)
+{
+    return seconds > 0.0 ? amount / seconds : 0.0;
+}
+
+//////////////////////////////////////////
+
+void pipeline_metrics_print(const PipelineMetrics *metrics, FILE *out)
+{
+    if (!metrics || !metrics->enabled || !out) return;
+
+    const double seconds = pipeline_metrics_now_seconds() - metrics->start_seconds;
+
+    // the names are literals of the callers, nothing to escape
+    fprintf(out, PIPELINE_METRICS_LINE_PREFIX "{\"mode\":\"%s\",\"seconds\":%.6f,\"bytes_read\":%llu,\"frames_read\":%llu,"
+            "\"frames_unique\":%llu,\"frames_per_s\":%.1f,\"mb_per_s\":%.3f,\"peak_memory_bytes\":%llu,"
+            "\"frames_wrong\":%zu,\"frames_truncated\":%zu,\"bytes_skipped\":%zu,\"resyncs\":%zu,\"stages\":[",
+            metrics->mode ? metrics->mode : "",
+            seconds,
+            (unsigned long long)metrics->bytes_read,
+            (unsigned long long)metrics->frames_read,
+            (unsigned long long)metrics->frames_unique,
+            rate_per_second((double)metrics->frames_read, seconds),
+            rate_per_second((double)metrics->bytes_read, seconds) * 1e-6,
+            (unsigned long long)pipeline_metrics_peak_memory(),
+            metrics->integrity.frames_wrong, metrics->integrity.frames_truncated,
+            metrics->integrity.bytes_skipped, metrics->integrity.resyncs);
+
+    for (size_t s = 0; s < metrics->stage_count; ++s)
+    {
+        const PipelineStageMetrics *stage = &metrics->stages[s];
+        fprintf(out, "%s{\"name\":\"%s\",\"seconds\":%.6f,\"frames\":%llu,\"bytes\":%llu,\"frames_per_s\":%.1f,\"mb_per_s\":%.3f}",
+                s > 0 ? "," : "", stage->name, stage->seconds,
+                (unsigned long long)stage->frames, (unsigned long long)stage->bytes,
+                rate_per_second((double)stage->frames, stage->seconds),
+                rate_per_second((double)stage->bytes, stage->seconds) * 1e-6);
+    }
+    fprintf(out, "]}\n");
+}
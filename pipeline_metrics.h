@@ -0,0 +1,109 @@
+/**
+ * @file pipeline_metrics.h
+ * @brief Header of the run metrics: time spent by each stage of a pass, throughput, peak memory and integrity
+ *
+ *  A stage is timed with the monotonic clock, between pipeline_metrics_stage_begin and pipeline_metrics_stage_end,
+ *  and named "subsystem.stage" (e.g. "thermal.csv_write"). A disabled metrics structure doesn't read the clock,
+ *  so the calls can stay in the hot paths. At the end of the run, pipeline_metrics_print writes them as one
+ *  line of JSON, to be collected per pass without a profiler:
+ *
+ *      [STAT] {"mode":"memory","seconds":0.012,"bytes_read":7571,...,"stages":[{"name":"index.read_sort_dedupe",...}]}
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#ifndef PIPELINE_METRICS_H_INCLUDED
+#define PIPELINE_METRICS_H_INCLUDED
+
+#include "beacon_frame_schema.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define PIPELINE_METRICS_MAX_STAGES 32
+#define PIPELINE_METRICS_STAGE_NAME_SIZE 48
+#define PIPELINE_METRICS_LINE_PREFIX "[STAT] "
+
+/**
+ * @struct PipelineStageMetrics
+ * @brief  Totals of one stage, a stage ended several times adds up
+ */
+typedef struct PIPELINE_STAGE_METRICS
+{
+    char        name[PIPELINE_METRICS_STAGE_NAME_SIZE];
+    double      seconds;
+    uint64_t    frames;                     // frames (or rows) that went through the stage
+    uint64_t    bytes;                      // bytes read or written by the stage
+} PipelineStageMetrics;
+
+/**
+ * @struct PipelineMetrics
+ * @brief  Metrics of one run
+ */
+typedef struct PIPELINE_METRICS
+{
+    bool                    enabled;
+    const char             *mode;                   // "memory", "batch", "streaming"...
+    double                  start_seconds;          // monotonic clock at pipeline_metrics_init
+    uint64_t                bytes_read;             // input bytes
+    uint64_t                frames_read;            // valid frames found, duplicates included (or the frames of a loaded index)
+    uint64_t                frames_unique;          // frames left after the deduplication
+    FrameIntegrityStats     integrity;              // wrong frames skipped and resyncs
+    PipelineStageMetrics    stages[PIPELINE_METRICS_MAX_STAGES];
+    size_t                  stage_count;            // in the order they were first ended
+} PipelineMetrics;
+
+/**
+ * @brief Monotonic clock
+ *
+ * @return seconds since an arbitrary point, only differences are meaningful
+ */
+double pipeline_metrics_now_seconds(void);
+
+/**
+ * @brief Starts the metrics of a run
+ *
+ * @param[out] metrics  Metrics to initialize
+ * @param[in]  enabled  false to make every other call do nothing
+ * @param[in]  mode     Name of the run mode, a string literal
+ */
+void pipeline_metrics_init(PipelineMetrics *metrics, bool enabled, const char *mode);
+
+/**
+ * @brief Start time of a stage
+ *
+ * @return the monotonic clock, or 0 if the metrics are disabled
+ */
+double pipeline_metrics_stage_begin(const PipelineMetrics *metrics);
+
+/**
+ * @brief Ends a stage, its time and counters are added to the stage of that name
+ *
+ * @param[in,out] metrics        Metrics of the run
+ * @param[in]     name           "subsystem.stage", truncated to PIPELINE_METRICS_STAGE_NAME_SIZE - 1 chars
+ * @param[in]     start_seconds  Returned by pipeline_metrics_stage_begin
+ * @param[in]     frames         Frames (or rows) processed
+ * @param[in]     bytes          Bytes read or written
+ */
+void pipeline_metrics_stage_end(PipelineMetrics *metrics, const char *name, double start_seconds, uint64_t frames, uint64_t bytes);
+
+/**
+ * @brief Peak resident memory of the process
+ *
+ * @return bytes, 0 if the system doesn't tell
+ */
+uint64_t pipeline_metrics_peak_memory(void);
+
+/**
+ * @brief Writes the metrics as one PIPELINE_METRICS_LINE_PREFIX line of JSON. Nothing if they are disabled
+ *
+ * @param[in] metrics   Metrics of the run
+ * @param[in] out       Stream to write to (e.g. stdout)
+ */
+void pipeline_metrics_print(const PipelineMetrics *metrics, FILE *out);
+
+#endif // PIPELINE_METRICS_H
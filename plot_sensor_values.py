@@ -5,6 +5,8 @@ import sys
 from datetime import datetime, timezone
 import matplotlib.pyplot as plt
 
+from columnar_reader import is_columnar_file, read_columnar
+
 
 def read_sun_sensors_csv(path):
     rows = []
@@ -22,17 +24,23 @@ def read_sun_sensors_csv(path):
             except (ValueError, IndexError):
                 continue
     rows.sort(key=lambda x: x[0])
-    return rows
-
-
-def plot_sun_sensors(rows, out_png=None, show=False):
-    if not rows:
-        print("No valid rows to plot", file=sys.stderr)
-        return 1
     ts = [t for t, _, _, _ in rows]
     sun_vector_x = [c for _, c, _, _ in rows]
     sun_vector_y = [c for _, _, c, _ in rows]
     sun_vector_z = [c for _, _, _, c in rows]
+    return ts, sun_vector_x, sun_vector_y, sun_vector_z
+
+
+def read_sun_sensors_columnar(path):
+    # already sorted by the writer, and memory mapped: no parsing
+    columns = read_columnar(path)
+    return columns["rtc_s"], columns["sun_vector_x"], columns["sun_vector_y"], columns["sun_vector_z"]
+
+
+def plot_sun_sensors(ts, sun_vector_x, sun_vector_y, sun_vector_z, out_png=None, show=False):
+    if len(ts) == 0:
+        print("No valid rows to plot", file=sys.stderr)
+        return 1
 
     plt.figure(figsize=(10, 5))
     plt.plot(ts, sun_vector_x, label="sun_vector_x")
@@ -54,14 +62,17 @@ def plot_sun_sensors(rows, out_png=None, show=False):
 
 
 def main():
-    ap = argparse.ArgumentParser(description="Plot sun vector CSV: rtc_s;sun_vector_x;sun_vector_y;sun_vector_z")
-    ap.add_argument("csv", help="input CSV path")
+    ap = argparse.ArgumentParser(description="Plot sun vector CSV: rtc_s;sun_vector_x;sun_vector_y;sun_vector_z (or its .bcol columnar file)")
+    ap.add_argument("csv", help="input CSV or .bcol path")
     ap.add_argument("-o", "--out", help="output PNG path (if omitted, shows the plot)")
     ap.add_argument("--show", action="store_true", help="show an interactive window")
     args = ap.parse_args()
 
-    rows = read_sun_sensors_csv(args.csv)
-    sys.exit(plot_sun_sensors(rows, args.out, args.show))
+    if is_columnar_file(args.csv):
+        columns = read_sun_sensors_columnar(args.csv)
+    else:
+        columns = read_sun_sensors_csv(args.csv)
+    sys.exit(plot_sun_sensors(*columns, args.out, args.show))
 
 
 if __name__ == "__main__":
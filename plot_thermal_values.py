@@ -5,6 +5,8 @@ import sys
 from datetime import datetime, timezone
 import matplotlib.pyplot as plt
 
+from columnar_reader import is_columnar_file, read_columnar
+
 
 def read_thermal_csv(path):
     rows = []
@@ -21,16 +23,22 @@ def read_thermal_csv(path):
             except (ValueError, IndexError):
                 continue
     rows.sort(key=lambda x: x[0])
-    return rows
+    ts = [t for t, _, _ in rows]
+    cpu = [c for _, c, _ in rows]
+    mir = [m for _, _, m in rows]
+    return ts, cpu, mir
+
 
+def read_thermal_columnar(path):
+    # already sorted by the writer, and memory mapped: no parsing
+    columns = read_columnar(path)
+    return columns["rtc_s"], columns["CPU_C"], columns["mirror_cell_C"]
 
-def plot_thermal(rows, out_png=None, show=False):
-    if not rows:
+
+def plot_thermal(ts, cpu, mir, out_png=None, show=False):
+    if len(ts) == 0:
         print("No valid rows to plot", file=sys.stderr)
         return 1
-    ts = [t for t, _, _ in rows]
-    cpu = [c for _, c, _ in rows]
-    mir = [m for _, _, m in rows]
 
     plt.figure(figsize=(10, 5))
     plt.plot(ts, cpu, label="CPU_C")
@@ -51,14 +59,17 @@ def plot_thermal(rows, out_png=None, show=False):
 
 
 def main():
-    ap = argparse.ArgumentParser(description="Plot thermal CSV: rtc_s;CPU_C;mirror_cell_C")
-    ap.add_argument("csv", help="input CSV path")
+    ap = argparse.ArgumentParser(description="Plot thermal CSV: rtc_s;CPU_C;mirror_cell_C (or its .bcol columnar file)")
+    ap.add_argument("csv", help="input CSV or .bcol path")
     ap.add_argument("-o", "--out", help="output PNG path (if omitted, shows the plot)")
     ap.add_argument("--show", action="store_true", help="show an interactive window")
     args = ap.parse_args()
 
-    rows = read_thermal_csv(args.csv)
-    sys.exit(plot_thermal(rows, args.out, args.show))
+    if is_columnar_file(args.csv):
+        ts, cpu, mir = read_thermal_columnar(args.csv)
+    else:
+        ts, cpu, mir = read_thermal_csv(args.csv)
+    sys.exit(plot_thermal(ts, cpu, mir, args.out, args.show))
 
 
 if __name__ == "__main__":
@@ -0,0 +1,231 @@
+/**
+ * @file reorder_window.c
+ * @brief Implementation file of the reorder_window header
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#include "reorder_window.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define HEAP_ELEMENT(window, index) ((window)->elements + (index) * (window)->element_size)
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, swaps two heap elements using the extra slot at the end of the storage
+ */
+static void heap_swap(ReorderWindow *window, size_t a, size_t b)
+{
+    unsigned char *temp = HEAP_ELEMENT(window, window->capacity);
+    memcpy(temp, HEAP_ELEMENT(window, a), window->element_size);
+    memcpy(HEAP_ELEMENT(window, a), HEAP_ELEMENT(window, b), window->element_size);
+    memcpy(HEAP_ELEMENT(window, b), temp, window->element_size);
+}
+
+//////////////////////////////////////////
+
+static void heap_sift_up(ReorderWindow *window, size_t index)
+{
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / 2;
+        if (window->comparator(HEAP_ELEMENT(window, index), HEAP_ELEMENT(window, parent)) >= 0) break;
+        heap_swap(window, index, parent);
+        index = parent;
+    }
+}
+
+//////////////////////////////////////////
+
+static void heap_sift_down(ReorderWindow *window, size_t index)
+{
+    for (;;)
+    {
+        size_t smallest = index;
+        size_t left = 2 * index + 1;
+        size_t right = left + 1;
+
+        if (left < window->length &&
+            window->comparator(HEAP_ELEMENT(window, left), HEAP_ELEMENT(window, smallest)) < 0)
+        {
+            smallest = left;
+        }
+        if (right < window->length &&
+            window->comparator(HEAP_ELEMENT(window, right), HEAP_ELEMENT(window, smallest)) < 0)
+        {
+            smallest = right;
+        }
+        if (smallest == index) return;
+
+        heap_swap(window, index, smallest);
+        index = smallest;
+    }
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, emits an element unless it is a duplicate of the last emitted one
+ */
+static bool emit_element(ReorderWindow *window, const void *element, ReorderWindowEmit emit, void *context)
+{
+    if (window->has_emitted && window->comparator(element, window->last_emitted) == 0)
+    {
+        window->duplicates_dropped++;
+        return true;
+    }
+
+    if (!emit(element, context)) return false;
+
+    memcpy(window->last_emitted, element, window->element_size);
+    window->has_emitted = true;
+    window->emitted_count++;
+    return true;
+}
+
+//////////////////////////////////////////
+
+bool reorder_window_init
+(
+    ReorderWindow *window,
+    size_t element_size,
+    size_t capacity,
+    int (*comparator)(const void*, const void*)
+)
+{
+    if (!window || element_size == 0 || capacity == 0 || !comparator) return false;
+
+    memset(window, 0, sizeof *window);
+
+    // capacity elements, the swap slot, and the last emitted copy
+    window->elements = (unsigned char*)malloc((capacity + 2) * element_size);
+    if (!window->elements) return false;
+
+    window->last_emitted = window->elements + (capacity + 1) * element_size;
+    window->element_size = element_size;
+    window->capacity = capacity;
+    window->comparator = comparator;
+    return true;
+}
+
+//////////////////////////////////////////
+
+void reorder_window_free(ReorderWindow *window)
+{
+    if (!window) return;
+    free(window->elements);
+    memset(window, 0, sizeof *window);
+}
+
+//////////////////////////////////////////
+
+bool reorder_window_push(ReorderWindow *window, const void *element, ReorderWindowEmit emit, void *context)
+{
+    if (!window || !element || !emit) return false;
+
+    if (window->has_emitted)
+    {
+        int order = window->comparator(element, window->last_emitted);
+        if (order == 0)
+        {
+            window->duplicates_dropped++;
+            return true;
+        }
+        if (order < 0)
+        {
+            // too late, the window was not big enough for this one
+            if (window->late) return window->late(element, window->late_context);
+            window->late_dropped++;
+            return true;
+        }
+    }
+
+    if (window->length < window->capacity)
+    {
+        memcpy(HEAP_ELEMENT(window, window->length), element, window->element_size);
+        window->length++;
+        heap_sift_up(window, window->length - 1);
+        return true;
+    }
+
+    // full window: if the new element is the smallest one it leaves right away,
+    // otherwise the top leaves and the new element takes its place
+    if (window->comparator(element, HEAP_ELEMENT(window, 0)) <= 0)
+    {
+        return emit_element(window, element, emit, context);
+    }
+
+    if (!emit_element(window, HEAP_ELEMENT(window, 0), emit, context)) return false;
+
+    memcpy(HEAP_ELEMENT(window, 0), element, window->element_size);
+    heap_sift_down(window, 0);
+    return true;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, emits the top of the heap and removes it
+ */
+static bool heap_pop_emit(ReorderWindow *window, ReorderWindowEmit emit, void *context)
+{
+    if (!emit_element(window, HEAP_ELEMENT(window, 0), emit, context)) return false;
+
+    window->length--;
+    if (window->length > 0)
+    {
+        memcpy(HEAP_ELEMENT(window, 0), HEAP_ELEMENT(window, window->length), window->element_size);
+        heap_sift_down(window, 0);
+    }
+    return true;
+}
+
+//////////////////////////////////////////
+
+bool reorder_window_flush(ReorderWindow *window, ReorderWindowEmit emit, void *context)
+{
+    if (!window || !emit) return false;
+
+    while (window->length > 0)
+    {
+        if (!heap_pop_emit(window, emit, context)) return false;
+    }
+    return true;
+}
+
+//////////////////////////////////////////
+
+bool reorder_window_emit_before(ReorderWindow *window, const void *bound, ReorderWindowEmit emit, void *context)
+{
+    if (!window || !bound || !emit) return false;
+
+    while (window->length > 0 && window->comparator(HEAP_ELEMENT(window, 0), bound) < 0)
+    {
+        if (!heap_pop_emit(window, emit, context)) return false;
+    }
+    return true;
+}
+
+//////////////////////////////////////////
+
+bool reorder_window_restore(ReorderWindow *window, const void *last_emitted, const void *elements, size_t length)
+{
+    if (!window || window->length > 0 || length > window->capacity || (!elements && length > 0)) return false;
+
+    window->has_emitted = last_emitted != NULL;
+    if (last_emitted) memcpy(window->last_emitted, last_emitted, window->element_size);
+
+    const unsigned char *element = (const unsigned char*)elements;
+    for (size_t i = 0; i < length; ++i)
+    {
+        memcpy(HEAP_ELEMENT(window, i), element + i * window->element_size, window->element_size);
+        window->length++;
+        heap_sift_up(window, i);
+    }
+    return true;
+}
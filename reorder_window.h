@@ -0,0 +1,126 @@
+/**
+ * @file reorder_window.h
+ * @brief Header of a bounded reorder window for streaming processing
+ *
+ *  Holds up to "capacity" elements in a min-heap ordered with a qsort style comparator.
+ *  When the window is full, pushing a new element makes the smallest one leave the window
+ *  through the emit callback, so elements come out sorted as long as they arrive at most
+ *  "capacity" positions out of order. Duplicates (comparator returns 0 against the last
+ *  emitted element) are dropped on the fly.
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#ifndef REORDER_WINDOW_H_INCLUDED
+#define REORDER_WINDOW_H_INCLUDED
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief Type definition for the callback that receives the elements leaving the window, in order
+ *
+ * @param[in] element      Pointer to the element leaving the window
+ * @param[in] context      Pointer given by the user of the window (e.g. a CsvWriter)
+ *
+ * @return true on success, false to report an error back to the caller of the window
+ */
+typedef bool (*ReorderWindowEmit)(const void *element, void *context);
+
+/**
+ * @struct ReorderWindow
+ * @brief  min-heap of elements and the state of the last emitted one
+ */
+typedef struct REORDER_WINDOW
+{
+    unsigned char  *elements;                               // heap storage, capacity elements + 1 swap slot
+    unsigned char  *last_emitted;                           // copy of the last element that left the window
+    size_t          element_size;
+    size_t          capacity;
+    size_t          length;
+    bool            has_emitted;
+    int           (*comparator)(const void*, const void*);
+    ReorderWindowEmit late;                                 // NULL on init: the late elements are dropped
+    void           *late_context;                           // passed to late
+
+    size_t          emitted_count;                          // elements emitted
+    size_t          duplicates_dropped;                     // equal to the last emitted element
+    size_t          late_dropped;                           // arrived after a bigger element was already emitted,
+                                                            // and no late callback to give them to
+} ReorderWindow;
+
+/**
+ * @brief Initializes a window
+ *
+ * @param[out] window           Pointer to the window to initialize
+ * @param[in]  element_size     Size of one element in bytes
+ * @param[in]  capacity         Maximum number of elements held, the maximum out of order distance supported
+ * @param[in]  comparator       int (*)(const void*, const void*), same signature as qsort
+ *
+ * @return true on success, false if the memory could not be allocated
+ */
+bool reorder_window_init
+(
+    ReorderWindow *window,
+    size_t element_size,
+    size_t capacity,
+    int (*comparator)(const void*, const void*)
+);
+
+/**
+ * @brief Releases the memory of the window
+ */
+void reorder_window_free(ReorderWindow *window);
+
+/**
+ * @brief Adds an element. If the window is full, the smallest element is emitted first
+ *
+ *  Elements smaller than the last emitted one can't be placed in order anymore: they go to the late
+ *  callback of the window when set (e.g. to insert them later in the rows already written), or are dropped
+ *
+ * @param[in,out]   window      Pointer to the window
+ * @param[in]       element     Pointer to the element to copy in the window
+ * @param[in]       emit        Callback for the element leaving the window
+ * @param[in]       context     Passed to the callback
+ *
+ * @return false if the emit (or late) callback failed
+ */
+bool reorder_window_push(ReorderWindow *window, const void *element, ReorderWindowEmit emit, void *context);
+
+/**
+ * @brief Emits all the elements left in the window, in order
+ *
+ * @return false if the emit callback failed
+ */
+bool reorder_window_flush(ReorderWindow *window, ReorderWindowEmit emit, void *context);
+
+/**
+ * @brief Emits, in order, the elements smaller than bound, without waiting for the window to fill
+ *
+ *  Bounds the time an element stays in the window (e.g. bound = newest timestamp minus the delay allowed),
+ *  an element arriving later than that is dropped as late
+ *
+ * @param[in,out]   window      Pointer to the window
+ * @param[in]       bound       Pointer to an element compared with the comparator of the window
+ * @param[in]       emit        Callback for the elements leaving the window
+ * @param[in]       context     Passed to the callback
+ *
+ * @return false if the emit callback failed
+ */
+bool reorder_window_emit_before(ReorderWindow *window, const void *bound, ReorderWindowEmit emit, void *context);
+
+/**
+ * @brief Sets the contents of an empty window, e.g. saved by a previous run of the same stream
+ *
+ * @param[in,out]   window          Pointer to an initialized window
+ * @param[in]       last_emitted    Copy of the last element emitted before, NULL if none
+ * @param[in]       elements        Elements held by the window, in any order
+ * @param[in]       length          Number of elements, up to the capacity of the window
+ *
+ * @return false on invalid arguments
+ */
+bool reorder_window_restore(ReorderWindow *window, const void *last_emitted, const void *elements, size_t length);
+
+#endif // REORDER_WINDOW_H
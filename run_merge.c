@@ -0,0 +1,251 @@
+/**
+ * @file run_merge.c
+ * @brief Implementation file of the run_merge header
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#include "run_merge.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RUN_MERGE_EXHAUSTED UINT64_MAX
+
+/**
+ * @struct MergePart
+ * @brief  Timestamp range of the merge done by one thread
+ */
+typedef struct MERGE_PART
+{
+    SortedRun       runs[RUN_MERGE_MAX_RUNS];   // the part of each run inside the range
+    size_t          run_count;
+    size_t          element_size;
+    size_t          key_offset;
+    unsigned char  *out;
+    size_t          written;
+} MergePart;
+
+//////////////////////////////////////////
+
+static inline uint32_t element_key(const SortedRun *run, size_t i, size_t element_size, size_t key_offset)
+{
+    uint32_t key;
+    memcpy(&key, (const unsigned char*)run->data + i * element_size + key_offset, sizeof key);
+    return key;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, tree key of the head of a run: the timestamp, then the run for the ties
+ */
+static inline uint64_t head_key(const SortedRun *run, size_t run_index, size_t position, size_t element_size, size_t key_offset)
+{
+    if (position >= run->length) return RUN_MERGE_EXHAUSTED;
+    return ((uint64_t)element_key(run, position, element_size, key_offset) << 32) | run_index;
+}
+
+//////////////////////////////////////////
+
+size_t run_merge_deduplicate(const SortedRun *runs, size_t run_count, size_t element_size, size_t key_offset, void *out)
+{
+    if (!runs || run_count > RUN_MERGE_MAX_RUNS || element_size == 0 || key_offset + sizeof(uint32_t) > element_size) return (size_t)-1;
+    if (run_count == 0) return 0;
+    if (!out) return (size_t)-1;
+
+    uint64_t heads[RUN_MERGE_MAX_RUNS];
+    size_t positions[RUN_MERGE_MAX_RUNS];
+    size_t loser[RUN_MERGE_MAX_RUNS];           // loser[0] is the winner of the whole tree
+    size_t winner[2 * RUN_MERGE_MAX_RUNS];      // only to build the tree, the leaves are run_count.. 2 * run_count - 1
+
+    for (size_t r = 0; r < run_count; ++r)
+    {
+        positions[r] = 0;
+        heads[r] = head_key(&runs[r], r, 0, element_size, key_offset);
+        winner[run_count + r] = r;
+    }
+    for (size_t node = run_count - 1; node >= 1; --node)
+    {
+        size_t left = winner[2 * node];
+        size_t right = winner[2 * node + 1];
+        bool left_wins = heads[left] < heads[right];
+
+        winner[node] = left_wins ? left : right;
+        loser[node] = left_wins ? right : left;
+    }
+    loser[0] = winner[1];
+
+    unsigned char *output = (unsigned char*)out;
+    size_t written = 0;
+    bool has_last = false;
+    uint32_t last_key = 0;
+
+    while (heads[loser[0]] != RUN_MERGE_EXHAUSTED)
+    {
+        const size_t run = loser[0];
+        const uint32_t key = (uint32_t)(heads[run] >> 32);
+
+        // the duplicates of a timestamp come out one after another, the first one is kept
+        if (!has_last || key != last_key)
+        {
+            memcpy(output + written * element_size,
+                   (const unsigned char*)runs[run].data + positions[run] * element_size, element_size);
+            written++;
+            last_key = key;
+            has_last = true;
+        }
+
+        heads[run] = head_key(&runs[run], run, ++positions[run], element_size, key_offset);
+
+        // replay the matches from the leaf of the run up to the root
+        size_t current = run;
+        for (size_t node = (run_count + run) / 2; node >= 1; node /= 2)
+        {
+            if (heads[loser[node]] < heads[current])
+            {
+                size_t swap = loser[node];
+                loser[node] = current;
+                current = swap;
+            }
+        }
+        loser[0] = current;
+    }
+    return written;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, number of elements of the run with a timestamp lower than key
+ */
+static size_t lower_bound(const SortedRun *run, uint64_t key, size_t element_size, size_t key_offset)
+{
+    size_t low = 0;
+    size_t high = run->length;
+
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+        if (element_key(run, middle, element_size, key_offset) < key) low = middle + 1;
+        else high = middle;
+    }
+    return low;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, lowest timestamp with at least rank elements of all the runs below it
+ */
+static uint64_t split_key(const SortedRun *runs, size_t run_count, size_t rank, size_t element_size, size_t key_offset)
+{
+    uint64_t low = 0;
+    uint64_t high = (uint64_t)UINT32_MAX + 1;
+
+    while (low < high)
+    {
+        uint64_t middle = low + (high - low) / 2;
+        size_t below = 0;
+        for (size_t r = 0; r < run_count; ++r) below += lower_bound(&runs[r], middle, element_size, key_offset);
+
+        if (below >= rank) high = middle;
+        else low = middle + 1;
+    }
+    return low;
+}
+
+//////////////////////////////////////////
+
+static void* merge_part_worker(void *argument)
+{
+    MergePart *part = (MergePart*)argument;
+    part->written = run_merge_deduplicate(part->runs, part->run_count, part->element_size, part->key_offset, part->out);
+    return NULL;
+}
+
+//////////////////////////////////////////
+
+size_t run_merge_deduplicate_parallel
+(
+    const SortedRun *runs,
+    size_t run_count,
+    size_t element_size,
+    size_t key_offset,
+    void *out,
+    size_t thread_count
+)
+{
+    if (!runs || run_count > RUN_MERGE_MAX_RUNS || element_size == 0 || key_offset + sizeof(uint32_t) > element_size) return (size_t)-1;
+
+    size_t total = 0;
+    for (size_t r = 0; r < run_count; ++r) total += runs[r].length;
+
+    size_t part_count = thread_count < RUN_MERGE_MAX_THREADS ? thread_count : RUN_MERGE_MAX_THREADS;
+    if (part_count > total / RUN_MERGE_MIN_THREAD_ELEMENTS) part_count = total / RUN_MERGE_MIN_THREAD_ELEMENTS;
+    if (part_count <= 1) return run_merge_deduplicate(runs, run_count, element_size, key_offset, out);
+
+    MergePart *parts = (MergePart*)calloc(part_count, sizeof *parts);
+    pthread_t threads[RUN_MERGE_MAX_THREADS];
+    bool started[RUN_MERGE_MAX_THREADS];
+    if (!parts) return (size_t)-1;
+
+    // the part p has the timestamps in [split p, split p + 1), written where its first element would be without duplicates
+    size_t begin[RUN_MERGE_MAX_RUNS] = { 0 };
+    size_t part_offset = 0;
+
+    for (size_t p = 0; p < part_count; ++p)
+    {
+        size_t end[RUN_MERGE_MAX_RUNS];
+        size_t part_length = 0;
+
+        if (p + 1 == part_count)
+        {
+            for (size_t r = 0; r < run_count; ++r) end[r] = runs[r].length;
+        }
+        else
+        {
+            uint64_t split = split_key(runs, run_count, total / part_count * (p + 1), element_size, key_offset);
+            for (size_t r = 0; r < run_count; ++r) end[r] = lower_bound(&runs[r], split, element_size, key_offset);
+        }
+
+        for (size_t r = 0; r < run_count; ++r)
+        {
+            parts[p].runs[r].data = (const unsigned char*)runs[r].data + begin[r] * element_size;
+            parts[p].runs[r].length = end[r] - begin[r];
+            part_length += end[r] - begin[r];
+            begin[r] = end[r];
+        }
+        parts[p].run_count = run_count;
+        parts[p].element_size = element_size;
+        parts[p].key_offset = key_offset;
+        parts[p].out = (unsigned char*)out + part_offset * element_size;
+        part_offset += part_length;
+    }
+
+    for (size_t p = 1; p < part_count; ++p)
+    {
+        started[p] = pthread_create(&threads[p], NULL, merge_part_worker, &parts[p]) == 0;
+    }
+    merge_part_worker(&parts[0]);
+    for (size_t p = 1; p < part_count; ++p)
+    {
+        if (started[p]) pthread_join(threads[p], NULL);
+        else merge_part_worker(&parts[p]);
+    }
+
+    // close the gaps left by the duplicates, only the parts after the first duplicate move
+    size_t written = 0;
+    for (size_t p = 0; p < part_count; ++p)
+    {
+        unsigned char *destination = (unsigned char*)out + written * element_size;
+        if (destination != parts[p].out) memmove(destination, parts[p].out, parts[p].written * element_size);
+        written += parts[p].written;
+    }
+
+    free(parts);
+    return written;
+}
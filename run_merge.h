@@ -0,0 +1,76 @@
+/**
+ * @file run_merge.h
+ * @brief Header of a k-way merge of sorted runs, with fused deduplication
+ *
+ *  Merges arrays of structs already sorted by a uint32_t timestamp inside them (e.g. the per-thread
+ *  runs of parallel_decode) with a loser tree: log2(k) comparisons per element, on (timestamp, run)
+ *  keys cached next to the tree, so the elements are only read once, when they are copied out.
+ *  Equal timestamps come out in run order and only the first one is copied, so with the runs in
+ *  file order the first element of each group of duplicates is kept, as with timestamp_sort_deduplicate.
+ *
+ *  The parallel merge splits the timestamp range in one part per thread, with the same number of
+ *  elements each. A group of duplicates never crosses a split, so every thread merges and deduplicates
+ *  its part independently, straight into the output.
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#ifndef RUN_MERGE_H_INCLUDED
+#define RUN_MERGE_H_INCLUDED
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define RUN_MERGE_MAX_RUNS 64
+#define RUN_MERGE_MAX_THREADS 64
+#define RUN_MERGE_MIN_THREAD_ELEMENTS (1u << 15)    // elements per thread, smaller merges use less threads
+
+/**
+ * @struct SortedRun
+ * @brief  An array sorted by its uint32_t timestamp
+ */
+typedef struct SORTED_RUN
+{
+    const void *data;
+    size_t      length;
+} SortedRun;
+
+/**
+ * @brief Merges the runs into out, and removes the duplicated timestamps
+ *
+ * @param[in]  runs             Runs to merge, in priority order for the duplicates
+ * @param[in]  run_count        Number of runs, up to RUN_MERGE_MAX_RUNS
+ * @param[in]  element_size     Size of one element in bytes
+ * @param[in]  key_offset       Offset of the uint32_t timestamp inside the element (use offsetof)
+ * @param[out] out              Room for the sum of the run lengths. Must not overlap the runs
+ *
+ * @return the number of elements written, (size_t)-1 on invalid arguments
+ */
+size_t run_merge_deduplicate(const SortedRun *runs, size_t run_count, size_t element_size, size_t key_offset, void *out);
+
+/**
+ * @brief Same as run_merge_deduplicate, on several threads
+ *
+ * @param[in]  runs             Runs to merge, in priority order for the duplicates
+ * @param[in]  run_count        Number of runs, up to RUN_MERGE_MAX_RUNS
+ * @param[in]  element_size     Size of one element in bytes
+ * @param[in]  key_offset       Offset of the uint32_t timestamp inside the element (use offsetof)
+ * @param[out] out              Room for the sum of the run lengths. Must not overlap the runs
+ * @param[in]  thread_count     Maximum number of threads, 1 runs run_merge_deduplicate
+ *
+ * @return the number of elements written, (size_t)-1 on invalid arguments or if the memory ran out
+ */
+size_t run_merge_deduplicate_parallel
+(
+    const SortedRun *runs,
+    size_t run_count,
+    size_t element_size,
+    size_t key_offset,
+    void *out,
+    size_t thread_count
+);
+
+#endif // RUN_MERGE_H
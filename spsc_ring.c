@@ -0,0 +1,66 @@
+/**
+ * @file spsc_ring.c
+ * @brief Implementation file of the spsc_ring header
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#include "spsc_ring.h"
+
+#include <stdlib.h>
+
+//////////////////////////////////////////
+
+bool spsc_ring_init(SpscRing *ring, size_t capacity)
+{
+    if (!ring || capacity == 0 || (capacity & (capacity - 1)) != 0) return false;
+
+    ring->slots = (void**)malloc(capacity * sizeof *ring->slots);
+    if (!ring->slots) return false;
+
+    ring->mask = capacity - 1;
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    return true;
+}
+
+//////////////////////////////////////////
+
+void spsc_ring_free(SpscRing *ring)
+{
+    if (!ring) return;
+    free(ring->slots);
+    ring->slots = NULL;
+}
+
+//////////////////////////////////////////
+
+bool spsc_ring_try_push(SpscRing *ring, void *item)
+{
+    // only this thread writes tail, the consumer's head is needed to know the room left
+    const size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    const size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+
+    if (tail - head > ring->mask) return false;
+
+    ring->slots[tail & ring->mask] = item;
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+//////////////////////////////////////////
+
+bool spsc_ring_try_pop(SpscRing *ring, void **item)
+{
+    // the acquire load of tail makes the slot written before it visible
+    const size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    const size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+
+    if (head == tail) return false;
+
+    *item = ring->slots[head & ring->mask];
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+    return true;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file spsc_ring.h
+ * @brief Header of a lock-free single producer, single consumer ring of pointers
+ *
+ *  One thread pushes and one thread pops, without locks: each side only writes its own index,
+ *  with release stores the other side reads with acquire loads. The two indexes are on different
+ *  cache lines, so the producer and the consumer don't invalidate each other's line on every item.
+ *  The ring never waits, the callers retry (see pipeline_io.c).
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#ifndef SPSC_RING_H_INCLUDED
+#define SPSC_RING_H_INCLUDED
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define SPSC_RING_CACHE_LINE 64
+
+/**
+ * @struct SpscRing
+ * @brief  Slots and the indexes of both sides. The indexes only grow, the slot is index & mask
+ */
+typedef struct SPSC_RING
+{
+    _Alignas(SPSC_RING_CACHE_LINE) atomic_size_t head;     // next slot to pop, written by the consumer
+    _Alignas(SPSC_RING_CACHE_LINE) atomic_size_t tail;     // next slot to push, written by the producer
+    _Alignas(SPSC_RING_CACHE_LINE) void **slots;
+    size_t                                      mask;
+} SpscRing;
+
+/**
+ * @brief Initializes an empty ring
+ *
+ * @param[out] ring         Pointer to the ring to initialize
+ * @param[in]  capacity     Number of slots, a power of two
+ *
+ * @return true on success, false on invalid capacity or if the memory could not be allocated
+ */
+bool spsc_ring_init(SpscRing *ring, size_t capacity);
+
+/**
+ * @brief Releases the slots of the ring (not the items)
+ */
+void spsc_ring_free(SpscRing *ring);
+
+/**
+ * @brief Adds an item, producer side
+ *
+ * @param[in,out] ring      Pointer to the ring
+ * @param[in]     item      Pointer to queue, NULL is a valid item
+ *
+ * @return true on success, false if the ring is full
+ */
+bool spsc_ring_try_push(SpscRing *ring, void *item);
+
+/**
+ * @brief Takes the oldest item, consumer side
+ *
+ * @param[in,out] ring      Pointer to the ring
+ * @param[out]    item      The item taken
+ *
+ * @return true on success, false if the ring is empty
+ */
+bool spsc_ring_try_pop(SpscRing *ring, void **item);
+
+#endif // SPSC_RING_H
@@ -0,0 +1,147 @@
+/**
+ * @file stream_parser.c
+ * @brief Implementation file of the stream_parser header
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#include "stream_parser.h"
+
+#include <string.h>
+
+//////////////////////////////////////////
+
+void stream_parser_init(StreamParser *parser, const BeaconHeader header, FrameSectionMask sections)
+{
+    if (!parser) return;
+
+    memset(parser, 0, sizeof *parser);
+    parser->header = header;
+    parser->sections = sections;
+    parser->byte_order = FRAME_BYTE_ORDER_UNKNOWN;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, decodes every complete frame of the buffer
+ *
+ * @param[out] consumed     Bytes done with. The rest (a partial header or frame) is needed by the next feed
+ *
+ * @return false if the handler failed, or at a wrong frame with stop_at_wrong_frame
+ */
+static bool parse_frames
+(
+    StreamParser *parser,
+    const uint8_t *buffer,
+    size_t size,
+    size_t *consumed,
+    StreamFrameHandler handler,
+    void *context
+)
+{
+    size_t position = 0;
+
+    for (;;)
+    {
+        const size_t start = position;
+        BeaconFrame frame;
+        ReadFileReturnType state = read_data_frame_from_buffer_sections(buffer, size, &position, &parser->byte_order,
+                                                                        parser->header, parser->sections, &frame);
+        if (state == READ_OK)
+        {
+            parser->frames_decoded++;
+            if (!handler(&frame, context))
+            {
+                *consumed = position;
+                return false;
+            }
+            continue;
+        }
+
+        if (state == READ_EOF)
+        {
+            // no header left, but the last bytes could be the start of the next one
+            size_t tail = size > BEACON_HEADER_SIZE - 1 ? size - (BEACON_HEADER_SIZE - 1) : 0;
+            *consumed = tail > start ? tail : start;
+            return true;
+        }
+
+        // READ_FAIL leaves the position right after the header: a frame still arriving, or a wrong one
+        if (size - position < BEACON_FRAME_SIZE)
+        {
+            *consumed = position - BEACON_HEADER_SIZE;
+            return true;
+        }
+        parser->frames_failed++;
+        parser->wrong_frame = frame;
+        if (parser->stop_at_wrong_frame)
+        {
+            *consumed = position;
+            return false;
+        }
+    }
+}
+
+//////////////////////////////////////////
+
+bool stream_parser_feed
+(
+    StreamParser *parser,
+    const uint8_t *bytes,
+    size_t length,
+    StreamFrameHandler handler,
+    void *context
+)
+{
+    if (!parser || (!bytes && length > 0) || !handler) return false;
+    parser->bytes_received += length;
+
+    while (length > 0)
+    {
+        size_t consumed;
+
+        if (parser->pending_length == 0)
+        {
+            // the frames of the chunk are decoded in place, only the partial one at the end is kept
+            if (!parse_frames(parser, bytes, length, &consumed, handler, context)) return false;
+
+            parser->pending_length = length - consumed;
+            memcpy(parser->pending, bytes + consumed, parser->pending_length);
+            return true;
+        }
+
+        // complete the pending header or frame with the first bytes of the chunk
+        size_t room = STREAM_PARSER_PENDING_SIZE - parser->pending_length;
+        size_t appended = length < room ? length : room;
+
+        memcpy(parser->pending + parser->pending_length, bytes, appended);
+        parser->pending_length += appended;
+        bytes += appended;
+        length -= appended;
+
+        if (!parse_frames(parser, parser->pending, parser->pending_length, &consumed, handler, context))
+        {
+            parser->pending_length = 0;
+            return false;
+        }
+
+        // the rest is shorter than a header plus a frame, so it only spans the old pending bytes
+        // when the whole chunk was appended. Otherwise it is parsed again from the chunk, in place
+        size_t rest = parser->pending_length - consumed;
+        if (rest <= appended)
+        {
+            bytes -= rest;
+            length += rest;
+            parser->pending_length = 0;
+        }
+        else
+        {
+            memmove(parser->pending, parser->pending + consumed, rest);
+            parser->pending_length = rest;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,90 @@
+/**
+ * @file stream_parser.h
+ * @brief Header of the incremental frame parser for live feeds
+ *
+ *  The parser is fed the bytes as they arrive (a pipe read, a TCP segment, a UDP datagram), in chunks
+ *  of any size, and calls the handler for every frame completed by the chunk. A header or a frame split
+ *  between two chunks is kept in the parser until the next call, so it never blocks waiting for bytes.
+ *  The frames inside a chunk are decoded in place, only the bytes around the chunk boundaries are copied.
+ *
+ *  Unlike the file readers, a frame with a wrong section ID doesn't stop the feed: it is counted,
+ *  and the search for the next header goes on right after the header of the wrong frame
+ *  (unless stop_at_wrong_frame is set, to behave like read_data_frame).
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#ifndef STREAM_PARSER_H_INCLUDED
+#define STREAM_PARSER_H_INCLUDED
+
+#include "beacon_frame_schema.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// a partial header and frame, plus the bytes of the next chunk appended to complete it
+#define STREAM_PARSER_PENDING_SIZE (2 * (BEACON_HEADER_SIZE + BEACON_FRAME_SIZE))
+
+/**
+ * @brief Type definition for the callback that receives the decoded frames, in arrival order
+ *
+ * @param[in] frame        Pointer to the decoded frame, only valid during the call
+ * @param[in] context      Pointer given to stream_parser_feed
+ *
+ * @return true on success, false to stop the feed
+ */
+typedef bool (*StreamFrameHandler)(const BeaconFrame *frame, void *context);
+
+/**
+ * @struct StreamParser
+ * @brief  Bytes carried between two feeds, and the feed counters
+ */
+typedef struct STREAM_PARSER
+{
+    BeaconHeader        header;
+    FrameSectionMask    sections;                   // see decode_beacon_frame_sections
+    FrameByteOrder      byte_order;                 // detected from the first frame with valid IDs
+    uint8_t             pending[STREAM_PARSER_PENDING_SIZE];
+    size_t              pending_length;             // bytes of a header or frame not complete yet
+    bool                stop_at_wrong_frame;        // false on init
+
+    size_t              bytes_received;
+    size_t              frames_decoded;
+    size_t              frames_failed;              // wrong section IDs, skipped
+    BeaconFrame         wrong_frame;                // section IDs of the last one, see describe_wrong_section_id
+} StreamParser;
+
+/**
+ * @brief Initializes a parser
+ *
+ * @param[out] parser       Pointer to the parser to initialize
+ * @param[in]  header       Constant structure that holds the beacon header ID to search for
+ * @param[in]  sections     FrameSection bits of the sections to decode
+ */
+void stream_parser_init(StreamParser *parser, const BeaconHeader header, FrameSectionMask sections);
+
+/**
+ * @brief Parses the next bytes of the feed
+ *
+ * @param[in,out] parser    Pointer to the parser
+ * @param[in]     bytes     The bytes received, following the ones of the previous call
+ * @param[in]     length    Number of bytes, can be 0
+ * @param[in]     handler   Callback for every frame completed
+ * @param[in]     context   Passed to the callback
+ *
+ * @return false if the handler failed or, with stop_at_wrong_frame, at a wrong frame (the rest of the bytes
+ *         are not parsed), or on invalid arguments
+ */
+bool stream_parser_feed
+(
+    StreamParser *parser,
+    const uint8_t *bytes,
+    size_t length,
+    StreamFrameHandler handler,
+    void *context
+);
+
+#endif // STREAM_PARSER_H
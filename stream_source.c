@@ -0,0 +1,263 @@
+/**
+ * @file stream_source.c
+ * @brief Implementation file of the stream_source header
+ *
+ *  Uses POSIX sockets and poll, and winsock with select on windows
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#include "stream_source.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <fcntl.h>
+#include <io.h>
+#include <limits.h>
+#pragma comment(lib, "ws2_32")
+#define INVALID_HANDLE ((uintptr_t)INVALID_SOCKET)
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+#define INVALID_HANDLE (-1)
+#endif
+
+#define STREAM_SOURCE_MAX_HOST 256
+
+//////////////////////////////////////////
+
+static void close_socket(uintptr_t handle)
+{
+#ifdef _WIN32
+    closesocket((SOCKET)handle);
+#else
+    close((int)handle);
+#endif
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, a socket connected (TCP) or bound (UDP) to one of the addresses of host:port
+ *
+ * @param[in] host      NULL for every local interface (UDP)
+ */
+static bool open_socket(const char *host, const char *port, int socket_type, uintptr_t *handle)
+{
+#ifdef _WIN32
+    WSADATA wsa_data;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa_data) != 0)
+    {
+        fprintf(stderr, "Error: winsock could not be started.\n");
+        return false;
+    }
+#endif
+
+    struct addrinfo hints;
+    struct addrinfo *addresses = NULL;
+
+    memset(&hints, 0, sizeof hints);
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = socket_type;
+    hints.ai_flags = host ? 0 : AI_PASSIVE;
+
+    int error = getaddrinfo(host, port, &hints, &addresses);
+    if (error != 0)
+    {
+        fprintf(stderr, "Error: can't resolve %s:%s (%s).\n", host ? host : "*", port, gai_strerror(error));
+#ifdef _WIN32
+        WSACleanup();
+#endif
+        return false;
+    }
+
+    bool ok = false;
+    for (struct addrinfo *address = addresses; address && !ok; address = address->ai_next)
+    {
+        uintptr_t candidate = (uintptr_t)socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if (candidate == (uintptr_t)INVALID_HANDLE) continue;
+
+        if (socket_type == SOCK_STREAM) ok = connect(candidate, address->ai_addr, address->ai_addrlen) == 0;
+        else ok = bind(candidate, address->ai_addr, address->ai_addrlen) == 0;
+
+        if (ok) *handle = candidate;
+        else close_socket(candidate);
+    }
+    freeaddrinfo(addresses);
+
+    if (!ok)
+    {
+        fprintf(stderr, "Error: can't %s %s:%s.\n", socket_type == SOCK_STREAM ? "connect to" : "bind", host ? host : "*", port);
+#ifdef _WIN32
+        WSACleanup();
+#endif
+    }
+    return ok;
+}
+
+//////////////////////////////////////////
+
+bool stream_source_open(const char *specification, StreamSource *source)
+{
+    if (!specification || !source) return false;
+    memset(source, 0, sizeof *source);
+
+    if (strcmp(specification, "-") == 0)
+    {
+        source->type = STREAM_SOURCE_STDIN;
+#ifdef _WIN32
+        _setmode(0, _O_BINARY);
+#endif
+        source->handle = 0;
+        return true;
+    }
+
+    if (strncmp(specification, "tcp:", 4) == 0)
+    {
+        // the port is after the last ':', the host is everything before it
+        const char *address = specification + 4;
+        const char *separator = strrchr(address, ':');
+        char host[STREAM_SOURCE_MAX_HOST];
+
+        if (!separator || separator == address || (size_t)(separator - address) >= sizeof host || separator[1] == '\0')
+        {
+            fprintf(stderr, "Error: wrong TCP source %s, expected tcp:HOST:PORT.\n", specification);
+            return false;
+        }
+        memcpy(host, address, (size_t)(separator - address));
+        host[separator - address] = '\0';
+
+        uintptr_t handle;
+        if (!open_socket(host, separator + 1, SOCK_STREAM, &handle)) return false;
+
+        source->type = STREAM_SOURCE_TCP;
+        source->handle = handle;
+        return true;
+    }
+
+    if (strncmp(specification, "udp:", 4) == 0)
+    {
+        if (specification[4] == '\0')
+        {
+            fprintf(stderr, "Error: wrong UDP source %s, expected udp:PORT.\n", specification);
+            return false;
+        }
+
+        uintptr_t handle;
+        if (!open_socket(NULL, specification + 4, SOCK_DGRAM, &handle)) return false;
+
+        source->type = STREAM_SOURCE_UDP;
+        source->handle = handle;
+        return true;
+    }
+
+#ifdef _WIN32
+    int descriptor = _open(specification, _O_RDONLY | _O_BINARY);
+#else
+    int descriptor = open(specification, O_RDONLY);
+#endif
+    if (descriptor < 0)
+    {
+        perror("open");
+        return false;
+    }
+    source->type = STREAM_SOURCE_FILE;
+    source->handle = descriptor;
+    return true;
+}
+
+//////////////////////////////////////////
+
+StreamReadResult stream_source_read(StreamSource *source, uint8_t *buffer, size_t size, int timeout_ms, size_t *received)
+{
+    if (!source || !buffer || size == 0 || !received) return STREAM_READ_ERROR;
+    *received = 0;
+
+    const bool is_socket = source->type == STREAM_SOURCE_TCP || source->type == STREAM_SOURCE_UDP;
+    long count;
+
+#ifdef _WIN32
+    if (is_socket)
+    {
+        fd_set readable;
+        FD_ZERO(&readable);
+        FD_SET((SOCKET)source->handle, &readable);
+
+        struct timeval timeout = { timeout_ms / 1000, (timeout_ms % 1000) * 1000 };
+        int ready = select(0, &readable, NULL, NULL, timeout_ms < 0 ? NULL : &timeout);
+        if (ready == 0) return STREAM_READ_IDLE;
+        if (ready == SOCKET_ERROR) return STREAM_READ_ERROR;
+
+        int length = size > INT_MAX ? INT_MAX : (int)size;
+        count = recv((SOCKET)source->handle, (char*)buffer, length, 0);
+        if (count == SOCKET_ERROR)
+        {
+            // a truncated datagram still fills the whole buffer
+            if (WSAGetLastError() != WSAEMSGSIZE) return STREAM_READ_ERROR;
+            count = length;
+        }
+    }
+    else
+    {
+        // no timeout for the console and the pipes, the read blocks
+        unsigned length = size > INT_MAX ? INT_MAX : (unsigned)size;
+        count = _read((int)source->handle, buffer, length);
+        if (count < 0) return STREAM_READ_ERROR;
+    }
+#else
+    struct pollfd descriptor = { .fd = source->handle, .events = POLLIN };
+    int ready = poll(&descriptor, 1, timeout_ms);
+    if (ready == 0 || (ready < 0 && errno == EINTR)) return STREAM_READ_IDLE;
+    if (ready < 0) return STREAM_READ_ERROR;
+
+    ssize_t length = is_socket ? recv(source->handle, buffer, size, 0) : read(source->handle, buffer, size);
+    if (length < 0) return errno == EINTR || errno == EAGAIN ? STREAM_READ_IDLE : STREAM_READ_ERROR;
+    count = (long)length;
+#endif
+
+    // an empty datagram is not the end of the feed
+    if (count == 0) return source->type == STREAM_SOURCE_UDP ? STREAM_READ_IDLE : STREAM_READ_END;
+
+    *received = (size_t)count;
+    return STREAM_READ_DATA;
+}
+
+//////////////////////////////////////////
+
+void stream_source_close(StreamSource *source)
+{
+    if (!source) return;
+
+    switch (source->type)
+    {
+        case STREAM_SOURCE_TCP:
+        case STREAM_SOURCE_UDP:
+            close_socket((uintptr_t)source->handle);
+#ifdef _WIN32
+            WSACleanup();
+#endif
+            break;
+        case STREAM_SOURCE_FILE:
+#ifdef _WIN32
+            _close((int)source->handle);
+#else
+            close(source->handle);
+#endif
+            break;
+        case STREAM_SOURCE_STDIN:
+            break;
+    }
+    source->handle = INVALID_HANDLE;
+}
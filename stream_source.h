@@ -0,0 +1,92 @@
+/**
+ * @file stream_source.h
+ * @brief Header of the live feed sources: stdin, a named pipe, a TCP connection or UDP datagrams
+ *
+ *  The reads return as soon as some bytes arrived, with whatever was received (a datagram, a TCP
+ *  segment, a pipe write), so the frames can be parsed while the pass is still being received
+ *  (see stream_parser.h). A read with nothing received for timeout_ms returns STREAM_READ_IDLE.
+ *
+ *  Source specifications:
+ *      "-"             the standard input
+ *      "tcp:HOST:PORT" connects to the feed server
+ *      "udp:PORT"      receives the datagrams sent to PORT, on every interface
+ *      anything else   a file, or a named pipe written by the receiver
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ * @note On windows, the standard input and the pipes don't support the timeout, their reads block
+ */
+
+#ifndef STREAM_SOURCE_H_INCLUDED
+#define STREAM_SOURCE_H_INCLUDED
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+    @enum kind of source
+**/
+typedef enum
+{
+    STREAM_SOURCE_STDIN,
+    STREAM_SOURCE_FILE,
+    STREAM_SOURCE_TCP,
+    STREAM_SOURCE_UDP
+} StreamSourceType;
+
+/**
+    @enum result of a read
+**/
+typedef enum
+{
+    STREAM_READ_DATA,
+    STREAM_READ_IDLE,           // nothing received before the timeout (or interrupted by a signal)
+    STREAM_READ_END,            // end of file, or connection closed by the server
+    STREAM_READ_ERROR
+} StreamReadResult;
+
+/**
+ * @struct StreamSource
+ * @brief  Holds an open source
+ */
+typedef struct STREAM_SOURCE
+{
+    StreamSourceType    type;
+#ifdef _WIN32
+    uintptr_t           handle;     // SOCKET, or a C runtime file descriptor
+#else
+    int                 handle;     // file descriptor
+#endif
+} StreamSource;
+
+/**
+ * @brief Opens a source from its specification (see the description of this file)
+ *
+ * @param[in]   specification   "-", "tcp:HOST:PORT", "udp:PORT" or a path
+ * @param[out]  source          Pointer to the structure to initialize
+ *
+ * @return true on success, false on error (printed to stderr)
+ */
+bool stream_source_open(const char *specification, StreamSource *source);
+
+/**
+ * @brief Waits for bytes and reads what was received, up to size bytes
+ *
+ * @param[in,out] source        Pointer to an open source
+ * @param[out]    buffer        Where to copy the bytes
+ * @param[in]     size          Size of the buffer. A bigger UDP datagram is truncated
+ * @param[in]     timeout_ms    Maximum wait, negative to wait forever
+ * @param[out]    received      Number of bytes copied, 0 unless STREAM_READ_DATA
+ *
+ * @return Read result
+ */
+StreamReadResult stream_source_read(StreamSource *source, uint8_t *buffer, size_t size, int timeout_ms, size_t *received);
+
+/**
+ * @brief Closes the source (the standard input is left open)
+ */
+void stream_source_close(StreamSource *source);
+
+#endif // STREAM_SOURCE_H
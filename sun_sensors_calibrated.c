@@ -9,10 +9,14 @@
 
 #include "sun_sensors_calibrated.h"
 #include "extended_tools.h"
+#include "fast_format.h"
+#include "csv_tool.h"
 
 #include <stdbool.h>
 #include <stdio.h>
 
+#define SUN_SENSORS_BATCH_LANES 8     // int16_t values per block of the batch kernel, one SSE2 register
+
 //////////////////////////////////////////
 
 SunSensorsTelemetryCalibrated
@@ -28,15 +32,6 @@ sun_sensors_to_calibrated(
     int16_t sun_vector_z    = aocs_schema_value->sunvectorZ;
     uint32_t ts             = timestamp;
 
-    // swap bytes if file is big endian
-    if (IS_BIG_ENDIAN)
-    {
-        sun_vector_x       = byte16_swap(sun_vector_x);
-        sun_vector_y       = byte16_swap(sun_vector_y);
-        sun_vector_z       = byte16_swap(sun_vector_z);
-        ts                 = byte32_swap(ts);
-    }
-
     out.sun_vector_x = SUN_SENSORS_PHYSICAL_VALUE(sun_vector_x);
     out.sun_vector_y = SUN_SENSORS_PHYSICAL_VALUE(sun_vector_y);
     out.sun_vector_z = SUN_SENSORS_PHYSICAL_VALUE(sun_vector_z);
@@ -47,6 +42,42 @@ sun_sensors_to_calibrated(
 
 //////////////////////////////////////////
 
+void sun_sensors_calibrate_batch(const int16_t *restrict raw, size_t count, bool swap, float *restrict out)
+{
+    size_t i = 0;
+
+    // fixed width inner loops, vectorized even at -O2 since they need no scalar epilogue
+    if (swap)
+    {
+        for (; i + SUN_SENSORS_BATCH_LANES <= count; i += SUN_SENSORS_BATCH_LANES)
+        {
+            for (size_t lane = 0; lane < SUN_SENSORS_BATCH_LANES; ++lane)
+            {
+                int16_t value = (int16_t)__builtin_bswap16((uint16_t)raw[i + lane]);
+                out[i + lane] = SUN_SENSORS_PHYSICAL_VALUE(value);
+            }
+        }
+    }
+    else
+    {
+        for (; i + SUN_SENSORS_BATCH_LANES <= count; i += SUN_SENSORS_BATCH_LANES)
+        {
+            for (size_t lane = 0; lane < SUN_SENSORS_BATCH_LANES; ++lane)
+            {
+                out[i + lane] = SUN_SENSORS_PHYSICAL_VALUE(raw[i + lane]);
+            }
+        }
+    }
+
+    for (; i < count; ++i)
+    {
+        int16_t value = swap ? (int16_t)__builtin_bswap16((uint16_t)raw[i]) : raw[i];
+        out[i] = SUN_SENSORS_PHYSICAL_VALUE(value);
+    }
+}
+
+//////////////////////////////////////////
+
 void sun_sensors_calibrated_print(const SunSensorsTelemetryCalibrated* sun_sensors_calibrated_values)
 {
     if (!sun_sensors_calibrated_values) return;
@@ -72,21 +103,90 @@ int sun_sensors_calibrated_to_csv_line(
     if (precision < 0) precision = 0;
     if (precision > 9) precision = 9;
 
-    int written = snprintf(
-                    buffer,
-                    buffer_size,
-                    "%u;%.*f;%.*f;%.*f",
-                    sun_sensors_calibrated_values->sun_sensors_telemetry_timestamp,
-                    precision, sun_sensors_calibrated_values->sun_vector_x,
-                    precision, sun_sensors_calibrated_values->sun_vector_y,
-                    precision, sun_sensors_calibrated_values->sun_vector_z);
-
-    if (written < 0 || (size_t)written >= buffer_size) {
+    // "%u;%.*f;..." with the fast formatters, checked once against the worst case line length
+    if (buffer_size < FAST_FORMAT_UINT32_MAX_CHARS + 3 * (1 + FAST_FORMAT_FIXED_MAX_CHARS) + 1)
+    {
         // @note the defined buffer might be too small
         return -1;
     }
 
-    return written;
+    size_t written = format_uint32(buffer, sun_sensors_calibrated_values->sun_sensors_telemetry_timestamp);
+    buffer[written++] = SEPARATOR[0];
+    written += format_fixed_float(buffer + written, sun_sensors_calibrated_values->sun_vector_x, precision);
+    buffer[written++] = SEPARATOR[0];
+    written += format_fixed_float(buffer + written, sun_sensors_calibrated_values->sun_vector_y, precision);
+    buffer[written++] = SEPARATOR[0];
+    written += format_fixed_float(buffer + written, sun_sensors_calibrated_values->sun_vector_z, precision);
+    buffer[written] = '\0';
+
+    return (int)written;
+}
+
+//////////////////////////////////////////
+
+size_t sun_sensors_calibrated_to_csv_batch(
+    const void* array_ptr,
+    size_t count,
+    char* buffer,
+    size_t buffer_size,
+    int precision,
+    size_t* bytes_written
+)
+{
+    const SunSensorsTelemetryCalibrated* values = (const SunSensorsTelemetryCalibrated*)array_ptr;
+    const size_t max_line_size = FAST_FORMAT_UINT32_MAX_CHARS + 3 * (1 + FAST_FORMAT_FIXED_MAX_CHARS) + 1;
+
+    size_t row = 0;
+    size_t length = 0;
+
+    if (!values || !buffer || !bytes_written)
+    {
+        if (bytes_written) *bytes_written = 0;
+        return 0;
+    }
+
+    float columns[3][FAST_FORMAT_BLOCK_SIZE];
+    uint64_t scaled[3][FAST_FORMAT_BLOCK_SIZE];
+
+    while (row < count && buffer_size - length >= max_line_size)
+    {
+        size_t block_rows = count - row;
+        if (block_rows > FAST_FORMAT_BLOCK_SIZE) block_rows = FAST_FORMAT_BLOCK_SIZE;
+        if (block_rows > (buffer_size - length) / max_line_size) block_rows = (buffer_size - length) / max_line_size;
+
+        // one contiguous column per field, so the scaling runs over plain float arrays
+        for (size_t i = 0; i < block_rows; ++i)
+        {
+            columns[0][i] = values[row + i].sun_vector_x;
+            columns[1][i] = values[row + i].sun_vector_y;
+            columns[2][i] = values[row + i].sun_vector_z;
+        }
+
+        bool fast = true;
+        for (size_t column = 0; column < 3; ++column)
+        {
+            fast = scale_floats_to_fixed(columns[column], block_rows, precision, scaled[column]) && fast;
+        }
+
+        for (size_t i = 0; i < block_rows; ++i)
+        {
+            length += format_uint32(buffer + length, values[row + i].sun_sensors_telemetry_timestamp);
+            buffer[length++] = SEPARATOR[0];
+            length += fast ? format_scaled_fixed(buffer + length, scaled[0][i], float_sign_bit(columns[0][i]), precision)
+                           : format_fixed_float(buffer + length, columns[0][i], precision);
+            buffer[length++] = SEPARATOR[0];
+            length += fast ? format_scaled_fixed(buffer + length, scaled[1][i], float_sign_bit(columns[1][i]), precision)
+                           : format_fixed_float(buffer + length, columns[1][i], precision);
+            buffer[length++] = SEPARATOR[0];
+            length += fast ? format_scaled_fixed(buffer + length, scaled[2][i], float_sign_bit(columns[2][i]), precision)
+                           : format_fixed_float(buffer + length, columns[2][i], precision);
+            buffer[length++] = '\n';
+        }
+        row += block_rows;
+    }
+
+    *bytes_written = length;
+    return row;
 }
 
 //////////////////////////////////////////
@@ -25,6 +25,9 @@
 //conversion value for sun sensors
 #define SUN_SENSORS_PHYSICAL_VALUE(value) ((float)(value) / 16384.0f)
 
+// sections of the frame read by sun_sensors_to_calibrated, for the decoder (see decode_beacon_frame_sections)
+#define SUN_SENSORS_FRAME_SECTIONS FRAME_SECTION_AOCS
+
 /**
  * @struct SunSensorsTelemetryCalibrated
  * @brief  Holds sun sensor vector calibrated values obtained from the stream.
@@ -43,7 +46,7 @@ typedef struct SUN_SENSORS_CALIBRATED
  * @brief Convert sun sensors schema values to calibrated vector coordinates and adds a timestamp.
  *
  * Converts (x,y,z) raw fields (int16_t) into float values, using conversion defined in documentation.
- * If the file encoding was big-endian, performs byte-swaps before scaling.
+ * The schema values are already in host byte order, as decoded by decode_beacon_frame.
  *
  * @param[in] aocs_schema_value     Pointer to schema read from the frame.
  * @param[in] timestamp             Platform timestamp as read from PLATFORM section in schema.
@@ -57,6 +60,20 @@ sun_sensors_to_calibrated(
                     uint32_t timestamp
                     );
 
+/**
+ * @brief Batch calibration kernel: converts count raw int16_t sun vector coordinates into vector coordinates with SUN_SENSORS_PHYSICAL_VALUE
+ *
+ *  Same values as sun_sensors_to_calibrated, for a whole column at once (see telemetry_store.h).
+ *  Written as fixed width blocks of plain loops, one per byte order, so the compiler vectorizes
+ *  the swap, the int16_t to float conversion and the scale (8 values per block).
+ *
+ * @param[in]  raw      Raw values, as gathered from the frames
+ * @param[in]  count    Number of values
+ * @param[in]  swap     true if the raw values are not in host byte order (e.g. straight from the file)
+ * @param[out] out      count calibrated values
+ */
+void sun_sensors_calibrate_batch(const int16_t *restrict raw, size_t count, bool swap, float *restrict out);
+
 
 /**
  * @brief print sun sensors calibrated values to console
@@ -86,6 +103,31 @@ int sun_sensors_calibrated_to_csv_line
     int precision
 );
 
+/**
+ * @brief print an array of SunSensorsTelemetryCalibrated values to CSV lines, same text as sun_sensors_calibrated_to_csv_line plus '\n'
+ *
+ *  Implements the structure of the CsvBatchFormatter void pointer function for CSV printing.
+ *  The floats are scaled in blocks of FAST_FORMAT_BLOCK_SIZE rows, in a loop the compiler can vectorize
+ *
+ * @param[in]   array_ptr           Pointer to the first struct that holds the calibrated values
+ * @param[in]   count               number of structs available
+ * @param[out]  buffer              Pointer to the char buffer to write
+ * @param[in]   buffer_size         size of the buffer
+ * @param[in]   precision           precision on printing decimals
+ * @param[out]  bytes_written       size written to buffer
+ *
+ * @return number of lines written
+ */
+size_t sun_sensors_calibrated_to_csv_batch
+(
+    const void* array_ptr,
+    size_t count,
+    char* buffer,
+    size_t buffer_size,
+    int precision,
+    size_t* bytes_written
+);
+
 /**
  * @brief SunSensorsTelemetryCalibrated comparator via timestamps
  *
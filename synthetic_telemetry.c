@@ -0,0 +1,227 @@
+/**
+ * @file synthetic_telemetry.c
+ * @brief Implementation file of the synthetic_telemetry header
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#include "synthetic_telemetry.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const uint16_t section_ids[] = { PLATFORM_ID, MEMORY_ID, CDH_ID, POWER_ID, THERMAL_ID, AOCS_ID, PAYLOAD_ID };
+static const size_t section_offsets[] =
+{
+    OFFSET_PLATFORM_TELEMETRY_ID, OFFSET_MEMORY_TELEMETRY_ID, OFFSET_CDH_ID, OFFSET_POWER_TELEMETRY_ID,
+    OFFSET_THERMAL_TELEMETRY_ID, OFFSET_AOCS_TELEMETRY_ID, OFFSET_PAYLOAD_TELEMETRY_ID
+};
+
+//////////////////////////////////////////
+
+void synthetic_telemetry_default_options(SyntheticTelemetryOptions *options, uint64_t frame_count)
+{
+    if (!options) return;
+
+    options->frame_count = frame_count;
+    options->out_of_order_rate = 0.0;
+    options->duplicate_rate = 0.0;
+    options->corruption_rate = 0.0;
+    options->max_gap_bytes = 64;
+    options->byte_order = FRAME_BYTE_ORDER_BIG_ENDIAN;
+    options->seed = 0x9E3779B97F4A7C15ull;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, xorshift generator
+ */
+static uint32_t next_random(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return (uint32_t)(*state >> 32);
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, true with the given probability
+ */
+static bool random_chance(uint64_t *state, double rate)
+{
+    return (double)next_random(state) < rate * 4294967296.0;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, stores a value of size bytes in the byte order of the file
+ */
+static void store_value(uint8_t *bytes, uint32_t value, size_t size, FrameByteOrder byte_order)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        size_t shift = byte_order == FRAME_BYTE_ORDER_BIG_ENDIAN ? (size - 1 - i) * 8 : i * 8;
+        bytes[i] = (uint8_t)(value >> shift);
+    }
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, a frame with random fields, the section IDs and the timestamp
+ */
+static void build_frame(uint8_t *frame, uint32_t rtc_s, FrameByteOrder byte_order, uint64_t *state)
+{
+    for (size_t i = 0; i < BEACON_FRAME_SIZE; ++i) frame[i] = (uint8_t)next_random(state);
+    for (size_t s = 0; s < sizeof section_ids / sizeof section_ids[0]; ++s)
+    {
+        store_value(frame + section_offsets[s], section_ids[s], sizeof(uint16_t), byte_order);
+    }
+    store_value(frame + OFFSET_RTC_S, rtc_s, sizeof(uint32_t), byte_order);
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, writes the noise before a frame, the header and the frame
+ *
+ * @return true on success, false on a write error
+ */
+static bool write_frame
+(
+    FILE *file,
+    const BeaconHeader header,
+    const uint8_t *frame,
+    size_t max_gap_bytes,
+    uint64_t *state,
+    SyntheticTelemetryStats *stats
+)
+{
+    uint8_t noise[256];
+    size_t gap = max_gap_bytes > 0 ? next_random(state) % (max_gap_bytes + 1) : 0;
+
+    while (gap > 0)
+    {
+        size_t length = gap < sizeof noise ? gap : sizeof noise;
+        for (size_t i = 0; i < length; ++i)
+        {
+            uint8_t byte = (uint8_t)next_random(state);
+            noise[i] = byte == 0xFF ? 0x00 : byte;
+        }
+        if (fwrite(noise, 1, length, file) != length) return false;
+        stats->bytes_written += length;
+        gap -= length;
+    }
+
+    if (fwrite(header.beacon_id.b, 1, BEACON_HEADER_SIZE, file) != BEACON_HEADER_SIZE) return false;
+    if (fwrite(frame, 1, BEACON_FRAME_SIZE, file) != BEACON_FRAME_SIZE) return false;
+
+    stats->bytes_written += BEACON_HEADER_SIZE + BEACON_FRAME_SIZE;
+    stats->frames_written++;
+    return true;
+}
+
+//////////////////////////////////////////
+
+bool synthetic_telemetry_write
+(
+    const char *filename,
+    const BeaconHeader header,
+    const SyntheticTelemetryOptions *options,
+    SyntheticTelemetryStats *stats
+)
+{
+    if (!filename || !options) return false;
+    if (options->byte_order != FRAME_BYTE_ORDER_BIG_ENDIAN && options->byte_order != FRAME_BYTE_ORDER_LITTLE_ENDIAN) return false;
+    if (!(options->out_of_order_rate >= 0.0 && options->out_of_order_rate <= 1.0) ||
+        !(options->duplicate_rate >= 0.0 && options->duplicate_rate <= 1.0) ||
+        !(options->corruption_rate >= 0.0 && options->corruption_rate <= 1.0))
+    {
+        fprintf(stderr, "Error: the rates of the synthetic telemetry must be between 0 and 1.\n");
+        return false;
+    }
+    if (options->frame_count > (UINT32_MAX - SYNTHETIC_TELEMETRY_FIRST_RTC_S) / SYNTHETIC_TELEMETRY_MAX_RTC_STEP)
+    {
+        fprintf(stderr, "Error: too many synthetic frames for 32 bit timestamps.\n");
+        return false;
+    }
+
+    FILE *file = fopen(filename, "wb");
+    if (!file)
+    {
+        perror("fopen");
+        return false;
+    }
+    setvbuf(file, NULL, _IOFBF, SYNTHETIC_TELEMETRY_WRITE_BUFFER_SIZE);
+
+    SyntheticTelemetryStats written;
+    memset(&written, 0, sizeof written);
+
+    uint64_t state = options->seed ? options->seed : 1;
+    uint32_t rtc_s = SYNTHETIC_TELEMETRY_FIRST_RTC_S;
+    uint32_t block[SYNTHETIC_TELEMETRY_REORDER_DISTANCE];
+    uint8_t frame[BEACON_FRAME_SIZE];
+    bool ok = true;
+
+    for (uint64_t first = 0; ok && first < options->frame_count; first += SYNTHETIC_TELEMETRY_REORDER_DISTANCE)
+    {
+        uint64_t remaining = options->frame_count - first;
+        size_t length = remaining < SYNTHETIC_TELEMETRY_REORDER_DISTANCE ? (size_t)remaining : SYNTHETIC_TELEMETRY_REORDER_DISTANCE;
+
+        for (size_t i = 0; i < length; ++i)
+        {
+            rtc_s += 1 + next_random(&state) % SYNTHETIC_TELEMETRY_MAX_RTC_STEP;
+            block[i] = rtc_s;
+        }
+
+        // swaps inside the block keep every frame near its place, as the ground station merge does
+        for (size_t i = 0; length > 1 && i < length; ++i)
+        {
+            if (!random_chance(&state, options->out_of_order_rate)) continue;
+
+            size_t j = (i + 1 + next_random(&state) % (length - 1)) % length;
+            uint32_t temp = block[i];
+            block[i] = block[j];
+            block[j] = temp;
+            written.frames_out_of_order += 2;
+        }
+
+        for (size_t i = 0; ok && i < length; ++i)
+        {
+            build_frame(frame, block[i], options->byte_order, &state);
+
+            if (random_chance(&state, options->corruption_rate))
+            {
+                size_t s = next_random(&state) % (sizeof section_offsets / sizeof section_offsets[0]);
+                frame[section_offsets[s] + next_random(&state) % 2] ^= (uint8_t)(1 + next_random(&state) % 255);
+                written.frames_corrupted++;
+                ok = write_frame(file, header, frame, options->max_gap_bytes, &state, &written);
+                continue;
+            }
+
+            ok = write_frame(file, header, frame, options->max_gap_bytes, &state, &written);
+            if (ok && random_chance(&state, options->duplicate_rate))
+            {
+                ok = write_frame(file, header, frame, options->max_gap_bytes, &state, &written);
+                written.frames_duplicated++;
+            }
+        }
+    }
+
+    if (fclose(file) != 0) ok = false;
+    if (!ok)
+    {
+        fprintf(stderr, "Error: the synthetic telemetry could not be written to %s.\n", filename);
+        return false;
+    }
+
+    if (stats) *stats = written;
+    return true;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file synthetic_telemetry.h
+ * @brief Header of the synthetic telemetry generator: beacon files of any size, for the benchmarks
+ *
+ *  Every frame has valid section IDs, an increasing rtc_s and random values in the other fields.
+ *  The defects of a real pass are added at the given rates, each one decided per frame:
+ *      out of order    the frame swaps places with another one at most SYNTHETIC_TELEMETRY_REORDER_DISTANCE away
+ *      duplicate       the frame is written twice in a row, same bytes
+ *      corruption      one byte of a section ID is damaged, the decoder rejects the frame
+ *  Random bytes are written between the frames, without 0xFF so they never hold a header.
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#ifndef SYNTHETIC_TELEMETRY_H_INCLUDED
+#define SYNTHETIC_TELEMETRY_H_INCLUDED
+
+#include "beacon_frame_schema.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define SYNTHETIC_TELEMETRY_REORDER_DISTANCE 64         // frames are only swapped inside blocks of this many
+#define SYNTHETIC_TELEMETRY_FIRST_RTC_S 1542716400u     // first timestamp, as in the sample file
+#define SYNTHETIC_TELEMETRY_MAX_RTC_STEP 4              // seconds between two frames, 1 to this value
+#define SYNTHETIC_TELEMETRY_WRITE_BUFFER_SIZE (1u << 20)
+
+/**
+ * @struct SyntheticTelemetryOptions
+ * @brief  What to generate, see synthetic_telemetry_default_options
+ */
+typedef struct SYNTHETIC_TELEMETRY_OPTIONS
+{
+    uint64_t        frame_count;            // frames generated, without the duplicates
+    double          out_of_order_rate;      // 0 to 1, fraction of the frames swapped
+    double          duplicate_rate;         // 0 to 1, fraction of the frames written twice
+    double          corruption_rate;        // 0 to 1, fraction of the frames with a damaged section ID
+    size_t          max_gap_bytes;          // random bytes between two frames, 0 to this value
+    FrameByteOrder  byte_order;             // of the IDs and the fields
+    uint64_t        seed;                   // same seed and options, same file
+} SyntheticTelemetryOptions;
+
+/**
+ * @struct SyntheticTelemetryStats
+ * @brief  What was written, to check the results of a benchmark run over the file
+ */
+typedef struct SYNTHETIC_TELEMETRY_STATS
+{
+    uint64_t    frames_written;             // headers written, duplicates and corrupted frames included
+    uint64_t    frames_out_of_order;        // frames that swapped places
+    uint64_t    frames_duplicated;          // extra copies written
+    uint64_t    frames_corrupted;
+    uint64_t    bytes_written;
+} SyntheticTelemetryStats;
+
+/**
+ * @brief Options of a clean file: in order, no duplicates, no corruption, up to 64 bytes between frames
+ *
+ * @param[out] options      Options to fill
+ * @param[in]  frame_count  Frames to generate
+ */
+void synthetic_telemetry_default_options(SyntheticTelemetryOptions *options, uint64_t frame_count);
+
+/**
+ * @brief Writes a synthetic telemetry file
+ *
+ * @param[in]  filename     The name of the file to create or overwrite
+ * @param[in]  header       Constant structure that holds the beacon header ID written before every frame
+ * @param[in]  options      What to generate
+ * @param[out] stats        What was written, may be NULL
+ *
+ * @return true on success, false on a wrong option or a write error (printed to stderr)
+ */
+bool synthetic_telemetry_write
+(
+    const char *filename,
+    const BeaconHeader header,
+    const SyntheticTelemetryOptions *options,
+    SyntheticTelemetryStats *stats
+);
+
+#endif // SYNTHETIC_TELEMETRY_H
@@ -0,0 +1,213 @@
+/**
+ * @file telemetry_store.c
+ * @brief Implementation file of the telemetry_store header
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#include "telemetry_store.h"
+#include "beacon_frame_schema.h"
+#include "frame_index.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+//////////////////////////////////////////
+
+bool telemetry_store_init(TelemetryStore *store, size_t capacity)
+{
+    return telemetry_store_init_arena(store, capacity, NULL);
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, allocates a column in the arena of the store, or with malloc
+ */
+static void* column_alloc(const TelemetryStore *store, size_t size)
+{
+    return store->arena ? arena_alloc(store->arena, size) : malloc(size);
+}
+
+//////////////////////////////////////////
+
+bool telemetry_store_init_arena(TelemetryStore *store, size_t capacity, Arena *arena)
+{
+    if (!store) return false;
+    memset(store, 0, sizeof *store);
+    store->arena = arena;
+
+    // malloc(0) may return NULL, which would look like a failure
+    size_t rows = capacity > 0 ? capacity : 1;
+
+    store->thermal.timestamp        = (uint32_t*)column_alloc(store, rows * sizeof(uint32_t));
+    store->thermal.CPU_C            = (float*)column_alloc(store, rows * sizeof(float));
+    store->thermal.mirror_cell_C    = (float*)column_alloc(store, rows * sizeof(float));
+    store->sun_sensors.timestamp    = (uint32_t*)column_alloc(store, rows * sizeof(uint32_t));
+    store->sun_sensors.sun_vector_x = (float*)column_alloc(store, rows * sizeof(float));
+    store->sun_sensors.sun_vector_y = (float*)column_alloc(store, rows * sizeof(float));
+    store->sun_sensors.sun_vector_z = (float*)column_alloc(store, rows * sizeof(float));
+
+    if (!store->thermal.timestamp || !store->thermal.CPU_C || !store->thermal.mirror_cell_C ||
+        !store->sun_sensors.timestamp || !store->sun_sensors.sun_vector_x ||
+        !store->sun_sensors.sun_vector_y || !store->sun_sensors.sun_vector_z)
+    {
+        telemetry_store_free(store);
+        return false;
+    }
+
+    store->thermal.capacity = capacity;
+    store->sun_sensors.capacity = capacity;
+    return true;
+}
+
+//////////////////////////////////////////
+
+bool telemetry_store_fill_rows
+(
+    TelemetryStore *store,
+    const MappedFrameFile *file,
+    const DynamicArray *index,
+    size_t first,
+    size_t count
+)
+{
+    if (!store || !file || !index || first > index->length || count > index->length - first) return false;
+    if (store->thermal.capacity - store->thermal.length < first + count ||
+        store->sun_sensors.capacity - store->sun_sensors.length < first + count)
+    {
+        return false;
+    }
+
+    // the gathered values keep the byte order of the file, the kernels swap them if needed
+    const bool swap = file->byte_order != HOST_BYTE_ORDER;
+    int16_t raw[TELEMETRY_STORE_BLOCK];
+
+    ThermalTelemetryColumns *thermal = &store->thermal;
+    SunSensorsTelemetryColumns *sun_sensors = &store->sun_sensors;
+
+    for (size_t block = 0; block < count; block += TELEMETRY_STORE_BLOCK)
+    {
+        size_t block_count = count - block;
+        if (block_count > TELEMETRY_STORE_BLOCK) block_count = TELEMETRY_STORE_BLOCK;
+
+        const size_t entry = first + block;
+        const size_t thermal_row = thermal->length + entry;
+        const size_t sun_sensors_row = sun_sensors->length + entry;
+
+        /* THERMAL SECTION */
+        if (!frame_index_gather_timestamps(index, entry, block_count, thermal->timestamp + thermal_row)) return false;
+
+        if (!frame_index_gather_raw16(file, index, entry, block_count, OFFSET_CPU_C, raw)) return false;
+        thermal_calibrate_batch(raw, block_count, swap, thermal->CPU_C + thermal_row);
+
+        if (!frame_index_gather_raw16(file, index, entry, block_count, OFFSET_MIRROR_CELL_C, raw)) return false;
+        thermal_calibrate_batch(raw, block_count, swap, thermal->mirror_cell_C + thermal_row);
+        /* END THERMAL SECTION */
+
+        /* SUN VECTOR SECTION */
+        memcpy(sun_sensors->timestamp + sun_sensors_row, thermal->timestamp + thermal_row, block_count * sizeof(uint32_t));
+
+        if (!frame_index_gather_raw16(file, index, entry, block_count, OFFSET_SUNVECTOR_X, raw)) return false;
+        sun_sensors_calibrate_batch(raw, block_count, swap, sun_sensors->sun_vector_x + sun_sensors_row);
+
+        if (!frame_index_gather_raw16(file, index, entry, block_count, OFFSET_SUNVECTOR_Y, raw)) return false;
+        sun_sensors_calibrate_batch(raw, block_count, swap, sun_sensors->sun_vector_y + sun_sensors_row);
+
+        if (!frame_index_gather_raw16(file, index, entry, block_count, OFFSET_SUNVECTOR_Z, raw)) return false;
+        sun_sensors_calibrate_batch(raw, block_count, swap, sun_sensors->sun_vector_z + sun_sensors_row);
+        /* END SUN VECTOR SECTION */
+    }
+    return true;
+}
+
+//////////////////////////////////////////
+
+bool telemetry_store_load(TelemetryStore *store, const MappedFrameFile *file, const DynamicArray *index)
+{
+    if (!store || !index) return false;
+    if (!telemetry_store_fill_rows(store, file, index, 0, index->length)) return false;
+
+    store->thermal.length += index->length;
+    store->sun_sensors.length += index->length;
+    return true;
+}
+
+//////////////////////////////////////////
+
+ThermalTelemetryCalibrated thermal_columns_get(const ThermalTelemetryColumns *columns, size_t i)
+{
+    ThermalTelemetryCalibrated out;
+
+    out.thermal_telemetry_timestamp = columns->timestamp[i];
+    out.CPU_C = columns->CPU_C[i];
+    out.mirror_cell_C = columns->mirror_cell_C[i];
+
+    return out;
+}
+
+//////////////////////////////////////////
+
+SunSensorsTelemetryCalibrated sun_sensors_columns_get(const SunSensorsTelemetryColumns *columns, size_t i)
+{
+    SunSensorsTelemetryCalibrated out;
+
+    out.sun_sensors_telemetry_timestamp = columns->timestamp[i];
+    out.sun_vector_x = columns->sun_vector_x[i];
+    out.sun_vector_y = columns->sun_vector_y[i];
+    out.sun_vector_z = columns->sun_vector_z[i];
+
+    return out;
+}
+
+//////////////////////////////////////////
+
+size_t thermal_columns_to_array(const ThermalTelemetryColumns *columns, size_t first, size_t count,
+                                ThermalTelemetryCalibrated *out)
+{
+    if (!columns || !out || first >= columns->length) return 0;
+    if (count > columns->length - first) count = columns->length - first;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        out[i] = thermal_columns_get(columns, first + i);
+    }
+    return count;
+}
+
+//////////////////////////////////////////
+
+size_t sun_sensors_columns_to_array(const SunSensorsTelemetryColumns *columns, size_t first, size_t count,
+                                    SunSensorsTelemetryCalibrated *out)
+{
+    if (!columns || !out || first >= columns->length) return 0;
+    if (count > columns->length - first) count = columns->length - first;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        out[i] = sun_sensors_columns_get(columns, first + i);
+    }
+    return count;
+}
+
+//////////////////////////////////////////
+
+void telemetry_store_free(TelemetryStore *store)
+{
+    if (!store) return;
+
+    if (!store->arena)
+    {
+        free(store->thermal.timestamp);
+        free(store->thermal.CPU_C);
+        free(store->thermal.mirror_cell_C);
+        free(store->sun_sensors.timestamp);
+        free(store->sun_sensors.sun_vector_x);
+        free(store->sun_sensors.sun_vector_y);
+        free(store->sun_sensors.sun_vector_z);
+    }
+
+    memset(store, 0, sizeof *store);
+}
@@ -0,0 +1,164 @@
+/**
+ * @file telemetry_store.h
+ * @brief Header of the structure-of-arrays store of the calibrated telemetry
+ *
+ *  Each calibrated field is a contiguous column (timestamp, CPU_C, mirror_cell_C, sun_vector_x/y/z),
+ *  filled from the frame index in blocks of TELEMETRY_STORE_BLOCK frames: the raw int16_t fields
+ *  are gathered as they are in the file, and swapped and scaled a whole column at a time by the
+ *  batch kernels (thermal_calibrate_batch, sun_sensors_calibrate_batch).
+ *  The array-of-structs types are still available per element or per range, for the print and
+ *  CSV helpers.
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#ifndef TELEMETRY_STORE_H_INCLUDED
+#define TELEMETRY_STORE_H_INCLUDED
+
+#include "arena.h"
+#include "dynamic_array.h"
+#include "mapped_frame_reader.h"
+#include "thermal_calibrated.h"
+#include "sun_sensors_calibrated.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define TELEMETRY_STORE_BLOCK 1024          // frames gathered per call of the batch kernels
+
+/**
+ * @struct ThermalTelemetryColumns
+ * @brief  Calibrated thermal values, one column per field of ThermalTelemetryCalibrated
+ */
+typedef struct THERMAL_TELEMETRY_COLUMNS
+{
+    uint32_t   *timestamp;
+    float      *CPU_C;
+    float      *mirror_cell_C;
+    size_t      length;
+    size_t      capacity;
+} ThermalTelemetryColumns;
+
+/**
+ * @struct SunSensorsTelemetryColumns
+ * @brief  Calibrated sun vectors, one column per field of SunSensorsTelemetryCalibrated
+ */
+typedef struct SUN_SENSORS_TELEMETRY_COLUMNS
+{
+    uint32_t   *timestamp;
+    float      *sun_vector_x;
+    float      *sun_vector_y;
+    float      *sun_vector_z;
+    size_t      length;
+    size_t      capacity;
+} SunSensorsTelemetryColumns;
+
+/**
+ * @struct TelemetryStore
+ * @brief  The columns of every calibrated subsystem, one row per frame of the index
+ */
+typedef struct TELEMETRY_STORE
+{
+    ThermalTelemetryColumns     thermal;
+    SunSensorsTelemetryColumns  sun_sensors;
+    Arena                      *arena;          // owner of the columns, NULL: malloc'ed
+} TelemetryStore;
+
+/**
+ * @brief Initializes the store, allocating capacity rows for every column
+ *
+ * @param[out] store        Pointer to the store to initialize
+ * @param[in]  capacity     Rows to allocate, e.g. the length of the frame index
+ *
+ * @return true on success, false if the memory could not be allocated (nothing is left allocated)
+ */
+bool telemetry_store_init(TelemetryStore *store, size_t capacity);
+
+/**
+ * @brief Same as telemetry_store_init, with the columns allocated in an arena (released with it)
+ *
+ * @param[in] arena         Arena that owns the columns, NULL for telemetry_store_init
+ */
+bool telemetry_store_init_arena(TelemetryStore *store, size_t capacity, Arena *arena);
+
+/**
+ * @brief Appends one calibrated row per entry of the index, in index order
+ *
+ * @param[in,out] store     Initialized store, with capacity for the whole index
+ * @param[in]     file      Mapped file the index was built from
+ * @param[in]     index     DynamicArray of FrameIndexEntry, usually sorted and deduplicated
+ *
+ * @return true on success, false if the store is too small or a frame is out of the file
+ */
+bool telemetry_store_load(TelemetryStore *store, const MappedFrameFile *file, const DynamicArray *index);
+
+/**
+ * @brief Calibrates the entries [first, first + count) of the index into the rows length + first... of the store
+ *
+ *  The lengths are not changed, so disjoint ranges can be filled at the same time by different threads
+ *  (see telemetry_store_load_parallel). telemetry_store_load is this call for the whole index.
+ *
+ * @param[in,out] store     Initialized store, with capacity for the whole index
+ * @param[in]     file      Mapped file the index was built from
+ * @param[in]     index     DynamicArray of FrameIndexEntry
+ * @param[in]     first     First entry of the index
+ * @param[in]     count     Number of entries
+ *
+ * @return true on success, false on a wrong range, if the store is too small or a frame is out of the file
+ */
+bool telemetry_store_fill_rows
+(
+    TelemetryStore *store,
+    const MappedFrameFile *file,
+    const DynamicArray *index,
+    size_t first,
+    size_t count
+);
+
+/**
+ * @brief Array-of-structs view of the row i of the thermal columns
+ */
+ThermalTelemetryCalibrated thermal_columns_get(const ThermalTelemetryColumns *columns, size_t i);
+
+/**
+ * @brief Array-of-structs view of the row i of the sun sensor columns
+ */
+SunSensorsTelemetryCalibrated sun_sensors_columns_get(const SunSensorsTelemetryColumns *columns, size_t i);
+
+/**
+ * @brief Copies the rows [first, first + count) of the thermal columns into an array of structs
+ *
+ * @param[in]  columns      Thermal columns
+ * @param[in]  first        First row to copy
+ * @param[in]  count        Number of rows to copy
+ * @param[out] out          count elements
+ *
+ * @return the number of rows copied, less than count if the range goes past the length
+ */
+size_t thermal_columns_to_array(const ThermalTelemetryColumns *columns, size_t first, size_t count,
+                                ThermalTelemetryCalibrated *out);
+
+/**
+ * @brief Copies the rows [first, first + count) of the sun sensor columns into an array of structs
+ *
+ * @param[in]  columns      Sun sensor columns
+ * @param[in]  first        First row to copy
+ * @param[in]  count        Number of rows to copy
+ * @param[out] out          count elements
+ *
+ * @return the number of rows copied, less than count if the range goes past the length
+ */
+size_t sun_sensors_columns_to_array(const SunSensorsTelemetryColumns *columns, size_t first, size_t count,
+                                    SunSensorsTelemetryCalibrated *out);
+
+/**
+ * @brief Releases all the columns of the store (left to its arena, if any)
+ *
+ * @param[in,out] store     Pointer to the store to release. Safe to call twice
+ */
+void telemetry_store_free(TelemetryStore *store);
+
+#endif // TELEMETRY_STORE_H
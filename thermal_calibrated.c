@@ -9,10 +9,14 @@
 
 #include "thermal_calibrated.h"
 #include "extended_tools.h"
+#include "fast_format.h"
+#include "csv_tool.h"
 
 #include <stdbool.h>
 #include <stdio.h>
 
+#define THERMAL_BATCH_LANES 8     // int16_t values per block of the batch kernel, one SSE2 register
+
 //////////////////////////////////////////
 
 ThermalTelemetryCalibrated
@@ -28,14 +32,6 @@ thermal_to_calibrated
     int16_t mirror_T = thermal_schema_value->mirror_cell_C;
     uint32_t ts        = timestamp;
 
-    // swap bytes if file is big endian
-    if (IS_BIG_ENDIAN)
-    {
-        cpu_T       = byte16_swap(cpu_T);
-        mirror_T    = byte16_swap(mirror_T);
-        ts          = byte32_swap(ts);
-    }
-
     out.thermal_telemetry_timestamp = ts;
     out.CPU_C         = TEMP_C_PHYSICAL_VALUE(cpu_T);
     out.mirror_cell_C = TEMP_C_PHYSICAL_VALUE(mirror_T);
@@ -45,6 +41,42 @@ thermal_to_calibrated
 
 //////////////////////////////////////////
 
+void thermal_calibrate_batch(const int16_t *restrict raw, size_t count, bool swap, float *restrict out)
+{
+    size_t i = 0;
+
+    // fixed width inner loops, vectorized even at -O2 since they need no scalar epilogue
+    if (swap)
+    {
+        for (; i + THERMAL_BATCH_LANES <= count; i += THERMAL_BATCH_LANES)
+        {
+            for (size_t lane = 0; lane < THERMAL_BATCH_LANES; ++lane)
+            {
+                int16_t value = (int16_t)__builtin_bswap16((uint16_t)raw[i + lane]);
+                out[i + lane] = TEMP_C_PHYSICAL_VALUE(value);
+            }
+        }
+    }
+    else
+    {
+        for (; i + THERMAL_BATCH_LANES <= count; i += THERMAL_BATCH_LANES)
+        {
+            for (size_t lane = 0; lane < THERMAL_BATCH_LANES; ++lane)
+            {
+                out[i + lane] = TEMP_C_PHYSICAL_VALUE(raw[i + lane]);
+            }
+        }
+    }
+
+    for (; i < count; ++i)
+    {
+        int16_t value = swap ? (int16_t)__builtin_bswap16((uint16_t)raw[i]) : raw[i];
+        out[i] = TEMP_C_PHYSICAL_VALUE(value);
+    }
+}
+
+//////////////////////////////////////////
+
 void thermal_calibrated_print(const ThermalTelemetryCalibrated* thermal)
 {
     if (!thermal) return;
@@ -70,20 +102,84 @@ int thermal_calibrated_to_csv_line(
     if (precision < 0) precision = 0;
     if (precision > 9) precision = 9;
 
-    int written = snprintf(
-                    buffer,
-                    buffer_size,
-                    "%u;%.*f;%.*f",
-                    thermal_data_calibrated_values->thermal_telemetry_timestamp,
-                    precision, thermal_data_calibrated_values->CPU_C,
-                    precision, thermal_data_calibrated_values->mirror_cell_C);
-
-    if (written < 0 || (size_t)written >= buffer_size) {
+    // "%u;%.*f;..." with the fast formatters, checked once against the worst case line length
+    if (buffer_size < FAST_FORMAT_UINT32_MAX_CHARS + 2 * (1 + FAST_FORMAT_FIXED_MAX_CHARS) + 1)
+    {
         // @note the defined buffer might be too small
         return -1;
     }
 
-    return written;
+    size_t written = format_uint32(buffer, thermal_data_calibrated_values->thermal_telemetry_timestamp);
+    buffer[written++] = SEPARATOR[0];
+    written += format_fixed_float(buffer + written, thermal_data_calibrated_values->CPU_C, precision);
+    buffer[written++] = SEPARATOR[0];
+    written += format_fixed_float(buffer + written, thermal_data_calibrated_values->mirror_cell_C, precision);
+    buffer[written] = '\0';
+
+    return (int)written;
+}
+
+//////////////////////////////////////////
+
+size_t thermal_calibrated_to_csv_batch(
+    const void* array_ptr,
+    size_t count,
+    char* buffer,
+    size_t buffer_size,
+    int precision,
+    size_t* bytes_written
+)
+{
+    const ThermalTelemetryCalibrated* values = (const ThermalTelemetryCalibrated*)array_ptr;
+    const size_t max_line_size = FAST_FORMAT_UINT32_MAX_CHARS + 2 * (1 + FAST_FORMAT_FIXED_MAX_CHARS) + 1;
+
+    size_t row = 0;
+    size_t length = 0;
+
+    if (!values || !buffer || !bytes_written)
+    {
+        if (bytes_written) *bytes_written = 0;
+        return 0;
+    }
+
+    float columns[2][FAST_FORMAT_BLOCK_SIZE];
+    uint64_t scaled[2][FAST_FORMAT_BLOCK_SIZE];
+
+    while (row < count && buffer_size - length >= max_line_size)
+    {
+        size_t block_rows = count - row;
+        if (block_rows > FAST_FORMAT_BLOCK_SIZE) block_rows = FAST_FORMAT_BLOCK_SIZE;
+        if (block_rows > (buffer_size - length) / max_line_size) block_rows = (buffer_size - length) / max_line_size;
+
+        // one contiguous column per field, so the scaling runs over plain float arrays
+        for (size_t i = 0; i < block_rows; ++i)
+        {
+            columns[0][i] = values[row + i].CPU_C;
+            columns[1][i] = values[row + i].mirror_cell_C;
+        }
+
+        bool fast = true;
+        for (size_t column = 0; column < 2; ++column)
+        {
+            fast = scale_floats_to_fixed(columns[column], block_rows, precision, scaled[column]) && fast;
+        }
+
+        for (size_t i = 0; i < block_rows; ++i)
+        {
+            length += format_uint32(buffer + length, values[row + i].thermal_telemetry_timestamp);
+            buffer[length++] = SEPARATOR[0];
+            length += fast ? format_scaled_fixed(buffer + length, scaled[0][i], float_sign_bit(columns[0][i]), precision)
+                           : format_fixed_float(buffer + length, columns[0][i], precision);
+            buffer[length++] = SEPARATOR[0];
+            length += fast ? format_scaled_fixed(buffer + length, scaled[1][i], float_sign_bit(columns[1][i]), precision)
+                           : format_fixed_float(buffer + length, columns[1][i], precision);
+            buffer[length++] = '\n';
+        }
+        row += block_rows;
+    }
+
+    *bytes_written = length;
+    return row;
 }
 
 //////////////////////////////////////////
@@ -25,6 +25,9 @@
 //conversion value for temperature
 #define TEMP_C_PHYSICAL_VALUE(value) ((float)(value) * 0.01f)
 
+// sections of the frame read by thermal_to_calibrated, for the decoder (see decode_beacon_frame_sections)
+#define THERMAL_FRAME_SECTIONS FRAME_SECTION_THERMAL
+
 /**
  * @struct ThermalTelemetryCalibrated
  * @brief  Holds thermal calibrated values obtained from the stream.
@@ -42,7 +45,7 @@ typedef struct THERMAL_PHYSICAL
  * @brief Convert thermal schema values to calibrated [C] and adds a timestamp.
  *
  * Converts T raw fields (int16_t) into [C] (float) using conversion defined in documentation.
- * If the file encoding was big-endian, performs byte-swaps before scaling.
+ * The schema values are already in host byte order, as decoded by decode_beacon_frame.
  *
  * @param[in] thermal_schema_value  Pointer to schema read from the frame.
  * @param[in] timestamp             Platform timestamp as read from PLATFORM section in schema.
@@ -56,6 +59,20 @@ thermal_to_calibrated(
                     uint32_t timestamp
                     );
 
+/**
+ * @brief Batch calibration kernel: converts count raw int16_t temperatures into [C] with TEMP_C_PHYSICAL_VALUE
+ *
+ *  Same values as thermal_to_calibrated, for a whole column at once (see telemetry_store.h).
+ *  Written as fixed width blocks of plain loops, one per byte order, so the compiler vectorizes
+ *  the swap, the int16_t to float conversion and the scale (8 values per block).
+ *
+ * @param[in]  raw      Raw values, as gathered from the frames
+ * @param[in]  count    Number of values
+ * @param[in]  swap     true if the raw values are not in host byte order (e.g. straight from the file)
+ * @param[out] out      count calibrated values
+ */
+void thermal_calibrate_batch(const int16_t *restrict raw, size_t count, bool swap, float *restrict out);
+
 
 /**
  * @brief print thermal calibrated values to console
@@ -83,6 +100,31 @@ int thermal_calibrated_to_csv_line
     int decimals
 );
 
+/**
+ * @brief print an array of ThermalTelemetryCalibrated values to CSV lines, same text as thermal_calibrated_to_csv_line plus '\n'
+ *
+ *  Implements the structure of the CsvBatchFormatter void pointer function for CSV printing.
+ *  The floats are scaled in blocks of FAST_FORMAT_BLOCK_SIZE rows, in a loop the compiler can vectorize
+ *
+ * @param[in]   array_ptr           Pointer to the first struct that holds the calibrated values
+ * @param[in]   count               number of structs available
+ * @param[out]  buffer              Pointer to the char buffer to write
+ * @param[in]   buffer_size         size of the buffer
+ * @param[in]   precision           precision on printing decimals
+ * @param[out]  bytes_written       size written to buffer
+ *
+ * @return number of lines written
+ */
+size_t thermal_calibrated_to_csv_batch
+(
+    const void* array_ptr,
+    size_t count,
+    char* buffer,
+    size_t buffer_size,
+    int precision,
+    size_t* bytes_written
+);
+
 /**
  * @brief ThermalTelemetryCalibrated comparator via timestamps
  *
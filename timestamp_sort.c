@@ -0,0 +1,250 @@
+/**
+ * @file timestamp_sort.c
+ * @brief Implementation file of the timestamp_sort header
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#include "timestamp_sort.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define RADIX_BUCKETS (1u << TIMESTAMP_SORT_RADIX_BITS)
+#define RADIX_MAX_PASSES ((32 + TIMESTAMP_SORT_RADIX_BITS - 1) / TIMESTAMP_SORT_RADIX_BITS)
+
+// above one descent every NEARLY_SORTED_RATIO elements, the input is not considered nearly sorted
+#define NEARLY_SORTED_RATIO 16
+
+//////////////////////////////////////////
+
+static inline uint32_t element_key(const unsigned char *array, size_t index, size_t element_size, size_t key_offset)
+{
+    uint32_t key;
+    memcpy(&key, array + index * element_size + key_offset, sizeof key);
+    return key;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, removes duplicates of a sorted array keeping the first one. Returns the new length
+ */
+static size_t deduplicate_sorted(unsigned char *array, size_t n, size_t element_size, size_t key_offset)
+{
+    if (n == 0) return 0;
+
+    size_t keep_index = 1;
+    uint32_t last_key = element_key(array, 0, element_size, key_offset);
+
+    for (size_t i = 1; i < n; ++i)
+    {
+        uint32_t key = element_key(array, i, element_size, key_offset);
+        if (key == last_key) continue;
+
+        if (keep_index != i) memcpy(array + keep_index * element_size, array + i * element_size, element_size);
+        keep_index++;
+        last_key = key;
+    }
+    return keep_index;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, stable insertion sort that stops when more than budget elements would be moved.
+ *        The array is always left as a valid permutation of the input
+ *
+ * @return true if the array got sorted within the budget
+ */
+static bool insertion_sort_bounded
+(
+    unsigned char *array, size_t n, size_t element_size, size_t key_offset,
+    size_t budget, unsigned char *temp
+)
+{
+    size_t moved = 0;
+
+    for (size_t i = 1; i < n; ++i)
+    {
+        uint32_t key = element_key(array, i, element_size, key_offset);
+
+        size_t j = i;
+        while (j > 0 && element_key(array, j - 1, element_size, key_offset) > key) --j;
+        if (j == i) continue;
+
+        moved += i - j;
+        if (moved > budget) return false;
+
+        memcpy(temp, array + i * element_size, element_size);
+        memmove(array + (j + 1) * element_size, array + j * element_size, (i - j) * element_size);
+        memcpy(array + j * element_size, temp, element_size);
+    }
+    return true;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, radix sort of (key - min_key, index) pairs and gather of the elements,
+ *        only the unique ones if deduplicate
+ */
+static bool radix_sort_deduplicate
+(
+    unsigned char *array, size_t *length, size_t element_size, size_t key_offset,
+    uint32_t min_key, uint32_t max_key, bool deduplicate
+)
+{
+    const size_t n = *length;
+
+    uint64_t *pairs = (uint64_t*)malloc(n * sizeof *pairs);
+    uint64_t *scratch = (uint64_t*)malloc(n * sizeof *scratch);
+    unsigned char *gathered = (unsigned char*)malloc(n * element_size);
+    size_t (*counts)[RADIX_BUCKETS] = calloc(RADIX_MAX_PASSES, sizeof *counts);
+
+    if (!pairs || !scratch || !gathered || !counts)
+    {
+        free(pairs);
+        free(scratch);
+        free(gathered);
+        free(counts);
+        return false;
+    }
+
+    // only the digits needed by the range of timestamps are sorted
+    const uint32_t range = max_key - min_key;
+    const unsigned key_bits = range ? 32u - (unsigned)__builtin_clz(range) : 0u;
+    const unsigned passes = (key_bits + TIMESTAMP_SORT_RADIX_BITS - 1) / TIMESTAMP_SORT_RADIX_BITS;
+
+    // the key goes in the high half, so the pair sorts by key and then by original position.
+    // The histograms of every pass are built in the same read
+    for (size_t i = 0; i < n; ++i)
+    {
+        uint32_t relative_key = element_key(array, i, element_size, key_offset) - min_key;
+        pairs[i] = ((uint64_t)relative_key << 32) | (uint64_t)i;
+        for (unsigned pass = 0; pass < passes; ++pass)
+        {
+            counts[pass][(relative_key >> (pass * TIMESTAMP_SORT_RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+        }
+    }
+
+    for (unsigned pass = 0; pass < passes; ++pass)
+    {
+        const unsigned shift = 32 + pass * TIMESTAMP_SORT_RADIX_BITS;
+        size_t *pass_counts = counts[pass];
+
+        // all the keys share this digit, nothing to move
+        if (pass_counts[(pairs[0] >> shift) & (RADIX_BUCKETS - 1)] == n) continue;
+
+        size_t offset = 0;
+        for (size_t bucket = 0; bucket < RADIX_BUCKETS; ++bucket)
+        {
+            size_t count = pass_counts[bucket];
+            pass_counts[bucket] = offset;
+            offset += count;
+        }
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            scratch[pass_counts[(pairs[i] >> shift) & (RADIX_BUCKETS - 1)]++] = pairs[i];
+        }
+
+        uint64_t *swap_ptr = pairs;
+        pairs = scratch;
+        scratch = swap_ptr;
+    }
+
+    // gather the elements in order, skipping the repeated keys: each element is moved once
+    size_t unique = 0;
+    uint32_t last_key = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        uint32_t relative_key = (uint32_t)(pairs[i] >> 32);
+        if (deduplicate && unique > 0 && relative_key == last_key) continue;
+
+        memcpy(gathered + unique * element_size, array + (size_t)(pairs[i] & 0xFFFFFFFFu) * element_size, element_size);
+        unique++;
+        last_key = relative_key;
+    }
+    memcpy(array, gathered, unique * element_size);
+    *length = unique;
+
+    free(pairs);
+    free(scratch);
+    free(gathered);
+    free(counts);
+    return true;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, body of timestamp_sort_deduplicate and timestamp_sort_stable
+ */
+static bool sort_by_timestamp(void *array, size_t *length, size_t element_size, size_t key_offset, bool deduplicate)
+{
+    if (!array || !length || element_size == 0 || key_offset + sizeof(uint32_t) > element_size) return false;
+
+    unsigned char *p = (unsigned char*)array;
+    const size_t n = *length;
+    if (n < 2) return true;
+
+    // the radix pairs keep the index in 32 bits
+    if (n > UINT32_MAX) return false;
+
+    // one read to learn the range of the keys and how far from sorted the array is
+    uint32_t min_key = element_key(p, 0, element_size, key_offset);
+    uint32_t max_key = min_key;
+    uint32_t previous_key = min_key;
+    size_t descents = 0;
+
+    for (size_t i = 1; i < n; ++i)
+    {
+        uint32_t key = element_key(p, i, element_size, key_offset);
+        if (key < previous_key) descents++;
+        if (key < min_key) min_key = key;
+        if (key > max_key) max_key = key;
+        previous_key = key;
+    }
+
+    if (descents == 0)
+    {
+        if (deduplicate) *length = deduplicate_sorted(p, n, element_size, key_offset);
+        return true;
+    }
+
+    if (n < TIMESTAMP_SORT_SMALL_ARRAY || descents <= n / NEARLY_SORTED_RATIO)
+    {
+        unsigned char *temp = (unsigned char*)malloc(element_size);
+        if (!temp) return false;
+
+        size_t budget = n < TIMESTAMP_SORT_SMALL_ARRAY ? SIZE_MAX : n * TIMESTAMP_SORT_INSERTION_BUDGET;
+        bool sorted = insertion_sort_bounded(p, n, element_size, key_offset, budget, temp);
+        free(temp);
+
+        if (sorted)
+        {
+            if (deduplicate) *length = deduplicate_sorted(p, n, element_size, key_offset);
+            return true;
+        }
+        // too many moves, the radix sort takes it from here (the insertion sort kept it stable)
+    }
+
+    return radix_sort_deduplicate(p, length, element_size, key_offset, min_key, max_key, deduplicate);
+}
+
+//////////////////////////////////////////
+
+bool timestamp_sort_deduplicate(void *array, size_t *length, size_t element_size, size_t key_offset)
+{
+    return sort_by_timestamp(array, length, element_size, key_offset, true);
+}
+
+//////////////////////////////////////////
+
+bool timestamp_sort_stable(void *array, size_t length, size_t element_size, size_t key_offset)
+{
+    return sort_by_timestamp(array, &length, element_size, key_offset, false);
+}
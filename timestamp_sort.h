@@ -0,0 +1,57 @@
+/**
+ * @file timestamp_sort.h
+ * @brief Header of a sort specialized in uint32_t timestamp keys, with fused deduplication
+ *
+ *  Replaces qsort + array_duplicate_removal for arrays of structs holding a uint32_t timestamp
+ *  (e.g. rtc_s). No comparator calls: the key is read at key_offset inside each element.
+ *      - already sorted input: only the deduplication pass
+ *      - nearly sorted input: insertion sort, while the moved elements stay under a budget
+ *      - otherwise: LSD radix sort on (timestamp - min) over (key, index) pairs, only for
+ *        the digits the timestamp range needs, and a final gather pass that moves every
+ *        element once and drops the duplicates
+ *  The sort is stable, so the first element of each group of duplicates (in array order) is kept.
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#ifndef TIMESTAMP_SORT_H_INCLUDED
+#define TIMESTAMP_SORT_H_INCLUDED
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define TIMESTAMP_SORT_RADIX_BITS 11            // 2048 buckets per pass, 3 passes at most for 32 bit keys
+#define TIMESTAMP_SORT_INSERTION_BUDGET 8       // insertion sort gives up after moving 8 * n elements
+#define TIMESTAMP_SORT_SMALL_ARRAY 32           // below this, insertion sort without budget
+
+/**
+ * @brief Sorts an array by the uint32_t timestamp of its elements, and removes the duplicated timestamps
+ *
+ * @param[in,out] array         Pointer to the array
+ * @param[in,out] length        Number of elements, updated with the new logical length.
+ *                              Tail elements are not physically removed
+ * @param[in]     element_size  Size of one element in bytes
+ * @param[in]     key_offset    Offset of the uint32_t timestamp inside the element (use offsetof)
+ *
+ * @return true on success, false on invalid arguments or if the temporary memory could not be allocated
+ *         (the array is still a permutation of the input, but not sorted)
+ */
+bool timestamp_sort_deduplicate(void *array, size_t *length, size_t element_size, size_t key_offset);
+
+/**
+ * @brief Same sort, keeping the elements with a repeated timestamp (in array order), e.g. already deduplicated on a wider key
+ *
+ * @param[in,out] array         Pointer to the array
+ * @param[in]     length        Number of elements
+ * @param[in]     element_size  Size of one element in bytes
+ * @param[in]     key_offset    Offset of the uint32_t timestamp inside the element (use offsetof)
+ *
+ * @return true on success, false on invalid arguments or if the temporary memory could not be allocated
+ *         (the array is still a permutation of the input, but not sorted)
+ */
+bool timestamp_sort_stable(void *array, size_t length, size_t element_size, size_t key_offset);
+
+#endif // TIMESTAMP_SORT_H
@@ -0,0 +1,197 @@
+/**
+ * @file window_aggregate.c
+ * @brief Implementation file of the window_aggregate header
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#include "window_aggregate.h"
+#include "fast_format.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+static const char *const stat_suffixes[] = { "_min", "_mean", "_max", "_std" };
+
+#define STATS_PER_VALUE (sizeof stat_suffixes / sizeof stat_suffixes[0])
+
+//////////////////////////////////////////
+
+void welford_stats_reset(WelfordStats *stats)
+{
+    memset(stats, 0, sizeof *stats);
+}
+
+//////////////////////////////////////////
+
+void welford_stats_add(WelfordStats *stats, float value)
+{
+    if (stats->count == 0 || value < stats->min) stats->min = value;
+    if (stats->count == 0 || value > stats->max) stats->max = value;
+
+    stats->count++;
+    const double delta = (double)value - stats->mean;
+    stats->mean += delta / (double)stats->count;
+    stats->m2 += delta * ((double)value - stats->mean);
+}
+
+//////////////////////////////////////////
+
+double welford_stats_std(const WelfordStats *stats)
+{
+    return stats->count > 1 ? sqrt(stats->m2 / (double)(stats->count - 1)) : 0.0;
+}
+
+//////////////////////////////////////////
+
+int window_aggregator_open
+(
+    WindowAggregator *aggregator,
+    const char *filename,
+    uint32_t window_s,
+    size_t timestamp_offset,
+    const WindowAggregateColumn *columns,
+    size_t column_count,
+    const char *norm_name,
+    int precision
+)
+{
+    const size_t value_count = column_count + (norm_name ? 1 : 0);
+
+    if (!aggregator || !filename || window_s == 0 || !columns || column_count == 0 || value_count > WINDOW_AGGREGATE_MAX_VALUES)
+    {
+        fprintf(stderr, "Error: Invalid argument(s) passed to window_aggregator_open.\n");
+        return -1;
+    }
+
+    memset(aggregator, 0, sizeof *aggregator);
+    aggregator->columns = columns;
+    aggregator->column_count = column_count;
+    aggregator->timestamp_offset = timestamp_offset;
+    aggregator->window_s = window_s;
+    aggregator->with_norm = norm_name != NULL;
+
+    // "window_start_s", "rows", then the statistics of every value
+    char names[WINDOW_AGGREGATE_MAX_VALUES * STATS_PER_VALUE][WINDOW_AGGREGATE_MAX_NAME];
+    const char *header[2 + WINDOW_AGGREGATE_MAX_VALUES * STATS_PER_VALUE] = { "window_start_s", "rows" };
+    size_t header_count = 2;
+
+    for (size_t v = 0; v < value_count; ++v)
+    {
+        const char *value_name = v < column_count ? columns[v].name : norm_name;
+        for (size_t s = 0; s < STATS_PER_VALUE; ++s)
+        {
+            char *name = names[header_count - 2];
+            int length = snprintf(name, WINDOW_AGGREGATE_MAX_NAME, "%s%s", value_name, stat_suffixes[s]);
+            if (length < 0 || length >= WINDOW_AGGREGATE_MAX_NAME)
+            {
+                fprintf(stderr, "Error: aggregated column name too long: %s.\n", value_name);
+                return -1;
+            }
+            header[header_count++] = name;
+        }
+    }
+
+    return csv_writer_open_columns(&aggregator->writer, filename, precision, header, header_count);
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, writes the current window as a row of the table
+ */
+static int write_window(WindowAggregator *aggregator)
+{
+    const size_t value_count = aggregator->column_count + (aggregator->with_norm ? 1 : 0);
+    const int precision = aggregator->writer.precision;
+    char line[WINDOW_AGGREGATE_LINE_SIZE];
+    size_t length = 0;
+
+    length += format_uint32(line + length, aggregator->window_start_s);
+    line[length++] = SEPARATOR[0];
+    length += (size_t)snprintf(line + length, sizeof line - length, "%llu", (unsigned long long)aggregator->stats[0].count);
+
+    for (size_t v = 0; v < value_count; ++v)
+    {
+        const WelfordStats *stats = &aggregator->stats[v];
+        const float values[STATS_PER_VALUE] = { stats->min, (float)stats->mean, stats->max, (float)welford_stats_std(stats) };
+
+        for (size_t s = 0; s < STATS_PER_VALUE; ++s)
+        {
+            line[length++] = SEPARATOR[0];
+            length += format_fixed_float(line + length, values[s], precision);
+        }
+    }
+    line[length++] = '\n';
+
+    return csv_writer_write_text(&aggregator->writer, line, length, 1);
+}
+
+//////////////////////////////////////////
+
+int window_aggregator_add(WindowAggregator *aggregator, const void *row)
+{
+    if (!aggregator || !aggregator->writer.file || !row) return -1;
+
+    const unsigned char *bytes = (const unsigned char*)row;
+    uint32_t rtc_s;
+    memcpy(&rtc_s, bytes + aggregator->timestamp_offset, sizeof rtc_s);
+
+    const uint32_t window_start_s = rtc_s - rtc_s % aggregator->window_s;
+
+    if (aggregator->has_window && window_start_s < aggregator->window_start_s)
+    {
+        aggregator->rows_out_of_order++;
+    }
+    else if (!aggregator->has_window || window_start_s > aggregator->window_start_s)
+    {
+        if (aggregator->has_window && write_window(aggregator) < 0) return -1;
+
+        for (size_t v = 0; v < WINDOW_AGGREGATE_MAX_VALUES; ++v) welford_stats_reset(&aggregator->stats[v]);
+        aggregator->window_start_s = window_start_s;
+        aggregator->has_window = true;
+    }
+
+    double squares = 0.0;
+    for (size_t c = 0; c < aggregator->column_count; ++c)
+    {
+        float value;
+        memcpy(&value, bytes + aggregator->columns[c].offset, sizeof value);
+        welford_stats_add(&aggregator->stats[c], value);
+        squares += (double)value * (double)value;
+    }
+    if (aggregator->with_norm) welford_stats_add(&aggregator->stats[aggregator->column_count], (float)sqrt(squares));
+
+    aggregator->rows_added++;
+    return 1;
+}
+
+//////////////////////////////////////////
+
+int window_aggregator_add_array(WindowAggregator *aggregator, const void *rows, size_t row_count, size_t row_size)
+{
+    if (!rows && row_count > 0) return -1;
+
+    const unsigned char *row = (const unsigned char*)rows;
+    for (size_t r = 0; r < row_count; ++r, row += row_size)
+    {
+        if (window_aggregator_add(aggregator, row) < 0) return -1;
+    }
+    return 1;
+}
+
+//////////////////////////////////////////
+
+int window_aggregator_close(WindowAggregator *aggregator)
+{
+    if (!aggregator || !aggregator->writer.file) return -1;
+
+    int status = aggregator->has_window ? write_window(aggregator) : 1;
+    if (csv_writer_close(&aggregator->writer) != 1) status = -1;
+
+    aggregator->has_window = false;
+    return status;
+}
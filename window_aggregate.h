@@ -0,0 +1,144 @@
+/**
+ * @file window_aggregate.h
+ * @brief Header of the time window aggregation: min, mean, max and standard deviation of the calibrated
+ *        values per fixed window of rtc_s, written as a compact CSV table while the rows are exported
+ *
+ *  Rows are added in rtc_s order, as they leave the index or the reorder windows. A window covers
+ *  [k * window_s, (k + 1) * window_s) and is written when the first row of a later window arrives, so
+ *  only the statistics of the current window are kept (constant memory, one pass). The mean and the
+ *  variance use Welford's update, stable for long windows of close values. Windows without rows are
+ *  not written. The table has one row per window:
+ *
+ *      window_start_s;rows;CPU_C_min;CPU_C_mean;CPU_C_max;CPU_C_std;...
+ *
+ *  e.g. window_s = 60 for per-minute trends, or the orbital period for per-orbit ones
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#ifndef WINDOW_AGGREGATE_H_INCLUDED
+#define WINDOW_AGGREGATE_H_INCLUDED
+
+#include "csv_tool.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define WINDOW_AGGREGATE_MAX_VALUES 8           // columns of a row, plus the norm
+#define WINDOW_AGGREGATE_MAX_NAME 48            // including the '\0' and the "_mean" suffix
+#define WINDOW_AGGREGATE_LINE_SIZE 2048         // a table row, every value at FAST_FORMAT_FIXED_MAX_CHARS
+
+/**
+ * @struct WelfordStats
+ * @brief  Running statistics of one value
+ */
+typedef struct WELFORD_STATS
+{
+    uint64_t    count;
+    double      mean;
+    double      m2;                         // sum of the squared differences to the mean
+    float       min;
+    float       max;
+} WelfordStats;
+
+/**
+ * @struct WindowAggregateColumn
+ * @brief  A float member of the rows to aggregate
+ */
+typedef struct WINDOW_AGGREGATE_COLUMN
+{
+    const char *name;
+    size_t      offset;
+} WindowAggregateColumn;
+
+/**
+ * @struct WindowAggregator
+ * @brief  Statistics of the current window and the CSV file of the closed ones
+ */
+typedef struct WINDOW_AGGREGATOR
+{
+    CsvWriter                       writer;
+    const WindowAggregateColumn    *columns;
+    size_t                          column_count;
+    size_t                          timestamp_offset;           // of the uint32_t rtc_s member of the rows
+    uint32_t                        window_s;
+    bool                            with_norm;                  // the euclidean norm of the columns is one more value
+    bool                            has_window;                 // a row was added to the current window
+    uint32_t                        window_start_s;
+    WelfordStats                    stats[WINDOW_AGGREGATE_MAX_VALUES];
+
+    size_t                          rows_added;
+    size_t                          rows_out_of_order;          // older than the current window, added to it
+} WindowAggregator;
+
+/**
+ * @brief Starts the statistics of a value
+ */
+void welford_stats_reset(WelfordStats *stats);
+
+/**
+ * @brief Adds a value to the statistics
+ */
+void welford_stats_add(WelfordStats *stats, float value);
+
+/**
+ * @brief Sample standard deviation of the values added
+ *
+ * @return 0 with less than two values
+ */
+double welford_stats_std(const WelfordStats *stats);
+
+/**
+ * @brief Opens the CSV table of an aggregation and writes its header row
+ *
+ * @param[out] aggregator         Aggregator to initialize
+ * @param[in]  filename           The name of the file to create or overwrite
+ * @param[in]  window_s           Length of the windows in seconds, at least 1
+ * @param[in]  timestamp_offset   offsetof the uint32_t rtc_s member of the rows
+ * @param[in]  columns            Float members of the rows, kept by the aggregator
+ * @param[in]  column_count       Number of columns, at least 1
+ * @param[in]  norm_name          Name of the norm of the columns (e.g. "sun_vector_norm"), NULL for none
+ * @param[in]  precision          Decimals of the table
+ *
+ * @return int 1 on success, -1 on error
+ */
+int window_aggregator_open
+(
+    WindowAggregator *aggregator,
+    const char *filename,
+    uint32_t window_s,
+    size_t timestamp_offset,
+    const WindowAggregateColumn *columns,
+    size_t column_count,
+    const char *norm_name,
+    int precision
+);
+
+/**
+ * @brief Adds a row to its window, the previous window is written if the row starts a new one
+ *
+ * @param[in,out] aggregator    Open aggregator
+ * @param[in]     row           Row with the members of the aggregator
+ *
+ * @return int 1 on success, -1 on write error
+ */
+int window_aggregator_add(WindowAggregator *aggregator, const void *row);
+
+/**
+ * @brief Adds an array of rows, in order
+ *
+ * @return int 1 on success, -1 on write error
+ */
+int window_aggregator_add_array(WindowAggregator *aggregator, const void *rows, size_t row_count, size_t row_size);
+
+/**
+ * @brief Writes the current window and closes the file
+ *
+ * @return int 1 on success, -1 on write error (the file is closed anyway)
+ */
+int window_aggregator_close(WindowAggregator *aggregator);
+
+#endif // WINDOW_AGGREGATE_H
@@ -0,0 +1,235 @@
+/**
+ * @file work_pool.c
+ * @brief Implementation file of the work_pool header
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#include "work_pool.h"
+#include "arena.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// the worker running on this thread, NULL outside the pools
+static _Thread_local WorkDeque *current_deque = NULL;
+
+//////////////////////////////////////////
+
+static bool deque_push(WorkDeque *deque, WorkItem item)
+{
+    bool ok = true;
+    pthread_mutex_lock(&deque->lock);
+
+    if (deque->tail == deque->capacity)
+    {
+        if (deque->head > 0)
+        {
+            // the thieves left room at the front
+            memmove(deque->items, deque->items + deque->head, (deque->tail - deque->head) * sizeof *deque->items);
+            deque->tail -= deque->head;
+            deque->head = 0;
+        }
+        else
+        {
+            size_t capacity = deque->capacity ? deque->capacity * 2 : WORK_POOL_INITIAL_DEQUE_CAPACITY;
+            WorkItem *items = (WorkItem*)realloc(deque->items, capacity * sizeof *items);
+
+            if (items)
+            {
+                deque->items = items;
+                deque->capacity = capacity;
+            }
+            else
+            {
+                ok = false;
+            }
+        }
+    }
+    if (ok) deque->items[deque->tail++] = item;
+
+    pthread_mutex_unlock(&deque->lock);
+    return ok;
+}
+
+//////////////////////////////////////////
+
+/**
+ * @brief Internal helper, takes the newest task (owner) or the oldest one (thief) of the deque
+ */
+static bool deque_take(WorkDeque *deque, bool newest, WorkItem *item)
+{
+    bool found = false;
+    pthread_mutex_lock(&deque->lock);
+
+    if (deque->head < deque->tail)
+    {
+        *item = newest ? deque->items[--deque->tail] : deque->items[deque->head++];
+        if (deque->head == deque->tail) deque->head = deque->tail = 0;
+        found = true;
+    }
+
+    pthread_mutex_unlock(&deque->lock);
+    return found;
+}
+
+//////////////////////////////////////////
+
+static void* worker_main(void *argument)
+{
+    WorkDeque *own = (WorkDeque*)argument;
+    WorkPool *pool = own->pool;
+
+    current_deque = own;
+
+    for (;;)
+    {
+        WorkItem item;
+        bool stolen = false;
+        bool found = deque_take(own, true, &item);
+
+        for (size_t i = 1; !found && i < pool->thread_count; ++i)
+        {
+            found = stolen = deque_take(&pool->deques[(own->worker + i) % pool->thread_count], false, &item);
+        }
+
+        if (found)
+        {
+            pthread_mutex_lock(&pool->lock);
+            pool->queued--;
+            if (stolen) pool->tasks_stolen++;
+            pthread_mutex_unlock(&pool->lock);
+
+            item.task(item.argument);
+
+            pthread_mutex_lock(&pool->lock);
+            if (--pool->pending == 0) pthread_cond_broadcast(&pool->all_done);
+            pthread_mutex_unlock(&pool->lock);
+            continue;
+        }
+
+        // a task counted in queued is already in a deque: look again instead of sleeping
+        pthread_mutex_lock(&pool->lock);
+        while (pool->queued == 0 && !pool->stopping) pthread_cond_wait(&pool->work_available, &pool->lock);
+        bool stop = pool->stopping && pool->queued == 0;
+        pthread_mutex_unlock(&pool->lock);
+
+        if (stop) break;
+    }
+
+    // the tasks may have used the arena of the worker (see arena.h)
+    arena_thread_local_free();
+
+    current_deque = NULL;
+    return NULL;
+}
+
+//////////////////////////////////////////
+
+bool work_pool_init(WorkPool *pool, size_t thread_count)
+{
+    if (!pool || thread_count < 1 || thread_count > WORK_POOL_MAX_THREADS) return false;
+    memset(pool, 0, sizeof *pool);
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_available, NULL);
+    pthread_cond_init(&pool->all_done, NULL);
+
+    for (size_t k = 0; k < thread_count; ++k)
+    {
+        pool->deques[k].pool = pool;
+        pool->deques[k].worker = k;
+        pthread_mutex_init(&pool->deques[k].lock, NULL);
+    }
+
+    // the workers look at thread_count, set before any of them starts
+    pool->thread_count = thread_count;
+
+    for (size_t k = 0; k < thread_count; ++k)
+    {
+        if (pthread_create(&pool->threads[k], NULL, worker_main, &pool->deques[k]) != 0)
+        {
+            pthread_mutex_lock(&pool->lock);
+            pool->stopping = true;
+            pthread_cond_broadcast(&pool->work_available);
+            pthread_mutex_unlock(&pool->lock);
+
+            for (size_t started = 0; started < k; ++started) pthread_join(pool->threads[started], NULL);
+            for (size_t d = 0; d < thread_count; ++d) pthread_mutex_destroy(&pool->deques[d].lock);
+            pthread_cond_destroy(&pool->all_done);
+            pthread_cond_destroy(&pool->work_available);
+            pthread_mutex_destroy(&pool->lock);
+            return false;
+        }
+    }
+    return true;
+}
+
+//////////////////////////////////////////
+
+bool work_pool_submit(WorkPool *pool, WorkTask task, void *argument)
+{
+    if (!pool || !task) return false;
+
+    WorkItem item = { task, argument };
+    WorkDeque *deque = current_deque && current_deque->pool == pool ? current_deque : NULL;
+
+    // counted as pending first, so work_pool_wait can't return before the task is done
+    pthread_mutex_lock(&pool->lock);
+    pool->pending++;
+    if (!deque) deque = &pool->deques[pool->next_deque++ % pool->thread_count];
+    pthread_mutex_unlock(&pool->lock);
+
+    bool ok = deque_push(deque, item);
+
+    pthread_mutex_lock(&pool->lock);
+    if (ok)
+    {
+        pool->queued++;
+        pthread_cond_signal(&pool->work_available);
+    }
+    else if (--pool->pending == 0)
+    {
+        pthread_cond_broadcast(&pool->all_done);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return ok;
+}
+
+//////////////////////////////////////////
+
+void work_pool_wait(WorkPool *pool)
+{
+    if (!pool) return;
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->pending > 0) pthread_cond_wait(&pool->all_done, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+//////////////////////////////////////////
+
+void work_pool_free(WorkPool *pool)
+{
+    if (!pool || pool->thread_count == 0) return;
+
+    work_pool_wait(pool);
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = true;
+    pthread_cond_broadcast(&pool->work_available);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (size_t k = 0; k < pool->thread_count; ++k)
+    {
+        pthread_join(pool->threads[k], NULL);
+        pthread_mutex_destroy(&pool->deques[k].lock);
+        free(pool->deques[k].items);
+    }
+    pthread_cond_destroy(&pool->all_done);
+    pthread_cond_destroy(&pool->work_available);
+    pthread_mutex_destroy(&pool->lock);
+    pool->thread_count = 0;
+}
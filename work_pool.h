@@ -0,0 +1,112 @@
+/**
+ * @file work_pool.h
+ * @brief Header of a work-stealing thread pool
+ *
+ *  Every worker has its own deque of tasks. A task submitted from a worker (e.g. the chunks of a big
+ *  file, submitted by the task of that file) goes to the worker's own deque, and the worker takes
+ *  its newest task first, while its data is still in cache. A worker without tasks steals the oldest
+ *  task of another one, so a few long tasks never leave the other workers idle while tasks are queued.
+ *  A task submitted from outside the pool goes to the deques in turn.
+ *
+ * @author Federico Jose Diaz
+ * @date 14/10/2026
+ *
+ */
+
+#ifndef WORK_POOL_H_INCLUDED
+#define WORK_POOL_H_INCLUDED
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define WORK_POOL_MAX_THREADS 64
+#define WORK_POOL_INITIAL_DEQUE_CAPACITY 64
+
+/**
+ * @brief Type definition of a task
+ *
+ * @param[in] argument      Pointer given on submission
+ */
+typedef void (*WorkTask)(void *argument);
+
+/**
+ * @struct WorkItem
+ * @brief  A submitted task and its argument
+ */
+typedef struct WORK_ITEM
+{
+    WorkTask    task;
+    void       *argument;
+} WorkItem;
+
+/**
+ * @struct WorkDeque
+ * @brief  Tasks of one worker: the owner pushes and takes at the tail, the thieves take at the head
+ */
+typedef struct WORK_DEQUE
+{
+    struct WORK_POOL   *pool;               // owner of the deque, for its worker thread
+    size_t              worker;             // index of the worker owning the deque
+    WorkItem           *items;
+    size_t              head;
+    size_t              tail;
+    size_t              capacity;
+    pthread_mutex_t     lock;
+} WorkDeque;
+
+/**
+ * @struct WorkPool
+ * @brief  Pool state
+ */
+typedef struct WORK_POOL
+{
+    WorkDeque           deques[WORK_POOL_MAX_THREADS];
+    pthread_t           threads[WORK_POOL_MAX_THREADS];
+    size_t              thread_count;
+    size_t              next_deque;         // deque of the next task submitted from outside the pool
+    pthread_mutex_t     lock;               // queued, pending, stopping and next_deque
+    pthread_cond_t      work_available;
+    pthread_cond_t      all_done;
+    size_t              queued;             // tasks in the deques
+    size_t              pending;            // tasks submitted and not finished yet
+    bool                stopping;
+    size_t              tasks_stolen;
+} WorkPool;
+
+/**
+ * @brief Starts the workers
+ *
+ * @param[out] pool             Pointer to the pool to initialize
+ * @param[in]  thread_count     Number of workers, 1..WORK_POOL_MAX_THREADS
+ *
+ * @return true on success, false on invalid arguments or if the threads could not be started (nothing is left running)
+ */
+bool work_pool_init(WorkPool *pool, size_t thread_count);
+
+/**
+ * @brief Queues a task. Can be called from a task
+ *
+ * @param[in,out] pool      Pointer to the pool
+ * @param[in]     task      Task to run
+ * @param[in]     argument  Passed to the task
+ *
+ * @return true on success, false if the memory ran out (the task is not queued)
+ */
+bool work_pool_submit(WorkPool *pool, WorkTask task, void *argument);
+
+/**
+ * @brief Waits until every submitted task, and the tasks they submitted, are finished
+ *
+ * @param[in,out] pool      Pointer to the pool. Not to be called from a task
+ */
+void work_pool_wait(WorkPool *pool);
+
+/**
+ * @brief Waits for the tasks, stops the workers and releases the pool
+ *
+ * @param[in,out] pool      Pointer to the pool
+ */
+void work_pool_free(WorkPool *pool);
+
+#endif // WORK_POOL_H